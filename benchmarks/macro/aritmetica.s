@@ -0,0 +1,125 @@
+# Mistura de inteiros que passa por todos os caminhos de handle_op_reg/handle_op_imm,
+# loads e stores de 1, 2 e 4 bytes, os seis desvios, lui e auipc. Cada iteração confere
+# a == (a / b) * b + a % b; em caso de erro sai com -1.
+# Saída: exit(a0) com h = (h * 33) ^ mistura, mais lui/auipc no final.
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # rascunho
+    li      s1, 20000               # iterações
+    li      s2, 7                   # estado do LCG
+    li      s3, 0                   # h
+    li      s4, 1103515245
+    li      s5, 12345
+laco:
+    mul     s2, s2, s4
+    add     s2, s2, s5
+    mv      a1, s2                  # a (com sinal)
+    mul     s2, s2, s4
+    add     s2, s2, s5
+    srli    a2, s2, 16
+    ori     a2, a2, 1               # b (positivo e ímpar)
+
+    div     t0, a1, a2
+    rem     t1, a1, a2
+    mul     t2, t0, a2
+    add     t2, t2, t1
+    bne     t2, a1, erro
+    divu    t3, a1, a2
+    remu    t4, a1, a2
+    mulh    t5, a1, a2
+    mulhu   t6, a1, a2
+    xor     a3, t0, t1
+    add     a3, a3, t3
+    sub     a3, a3, t4
+    xor     a3, a3, t5
+    add     a3, a3, t6
+    mulhsu  t0, a1, a2
+    add     a3, a3, t0
+
+    sra     t0, a1, a2
+    srl     t1, a1, a2
+    sll     t2, a2, a1
+    slt     t3, a1, a2
+    sltu    t4, a1, a2
+    slti    t5, a1, -5
+    sltiu   t6, a2, 1000
+    add     a3, a3, t0
+    xor     a3, a3, t1
+    add     a3, a3, t2
+    add     a3, a3, t3
+    add     a3, a3, t4
+    add     a3, a3, t5
+    add     a3, a3, t6
+
+    srai    t0, a1, 7
+    srli    t1, a1, 9
+    slli    t2, a1, 3
+    xori    t3, a1, -1
+    ori     t4, a1, 0x55
+    andi    t5, a1, 0x3F0
+    add     a3, a3, t0
+    add     a3, a3, t1
+    xor     a3, a3, t2
+    add     a3, a3, t3
+    add     a3, a3, t4
+    xor     a3, a3, t5
+
+    and     t0, a1, a2
+    or      t1, a1, a2
+    sub     t2, a1, a2
+    add     a3, a3, t0
+    xor     a3, a3, t1
+    add     a3, a3, t2
+
+    sw      a1, 0(s0)
+    sh      a2, 4(s0)
+    sb      a2, 6(s0)
+    lb      t0, 1(s0)
+    lbu     t1, 3(s0)
+    lh      t2, 2(s0)
+    lhu     t3, 4(s0)
+    lb      t4, 6(s0)
+    lw      t5, 0(s0)
+    add     a3, a3, t0
+    add     a3, a3, t1
+    xor     a3, a3, t2
+    add     a3, a3, t3
+    add     a3, a3, t4
+    xor     a3, a3, t5
+
+    bge     a1, a2, d1
+    addi    a3, a3, 1
+d1:
+    bgeu    a1, a2, d2
+    addi    a3, a3, 2
+d2:
+    blt     a1, zero, d3
+    addi    a3, a3, 4
+d3:
+    bltu    a2, a1, d4
+    addi    a3, a3, 8
+d4:
+    beq     t3, t3, d5
+    addi    a3, a3, 16
+d5:
+    bne     a1, a1, d6
+    addi    a3, a3, 32
+d6:
+    slli    t0, s3, 5
+    add     s3, s3, t0
+    xor     s3, s3, a3
+    addi    s1, s1, -1
+    bnez    s1, laco
+
+    lui     t1, 0x12345
+    add     s3, s3, t1
+marca_auipc:
+    auipc   t0, 0
+    add     a0, s3, t0
+    li      a7, 93
+    ecall
+erro:
+    li      a0, -1
+    li      a7, 93
+    ecall
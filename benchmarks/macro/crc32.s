@@ -0,0 +1,48 @@
+# CRC-32 (polinômio refletido 0xEDB88320), bit a bit, sobre 4 KiB gerados por um LCG.
+# O buffer é processado 8 vezes seguidas (como um fluxo de 32 KiB).
+# Saída: exit(a0) com o CRC final.
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # buffer
+    li      s1, 4096                # tamanho
+    add     s5, s0, s1              # fim do buffer
+
+    # Gera os bytes: x = x * 1103515245 + 12345; byte = x >> 24
+    li      t0, 12345
+    li      t1, 1103515245
+    li      t2, 12345
+    mv      t3, s0
+gera:
+    mul     t0, t0, t1
+    add     t0, t0, t2
+    srli    t5, t0, 24
+    sb      t5, 0(t3)
+    addi    t3, t3, 1
+    bltu    t3, s5, gera
+
+    li      s2, -1                  # crc
+    li      s3, 0xEDB88320
+    li      s4, 8                   # passagens
+passagem:
+    mv      t3, s0
+byte:
+    lbu     t5, 0(t3)
+    xor     s2, s2, t5
+    li      t6, 8
+bit:
+    andi    a1, s2, 1
+    srli    s2, s2, 1
+    beqz    a1, sem_xor
+    xor     s2, s2, s3
+sem_xor:
+    addi    t6, t6, -1
+    bnez    t6, bit
+    addi    t3, t3, 1
+    bltu    t3, s5, byte
+    addi    s4, s4, -1
+    bnez    s4, passagem
+
+    not     a0, s2
+    li      a7, 93
+    ecall
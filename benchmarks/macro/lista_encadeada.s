@@ -0,0 +1,41 @@
+# Percurso de lista encadeada: 4096 nós de 8 bytes (próximo, valor) espalhados por 32 KiB,
+# muito maior que o cache de 4 KiB. O nó k aponta para o nó (k + 1597) mod 4096.
+# São 64 voltas completas; h = rotl(h, 1) + valor. Saída: exit(a0) com h.
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # nós
+    li      s1, 4096
+    li      s2, 4095                # máscara do índice
+    li      s3, 7
+
+    li      t0, 0                   # k
+monta:
+    addi    t1, t0, 1597
+    and     t1, t1, s2
+    slli    t1, t1, 3
+    add     t1, s0, t1              # endereço do próximo
+    slli    t2, t0, 3
+    add     t2, s0, t2              # endereço do nó k
+    sw      t1, 0(t2)
+    mul     t3, t0, s3
+    addi    t3, t3, 3
+    sw      t3, 4(t2)               # valor = 7k + 3
+    addi    t0, t0, 1
+    blt     t0, s1, monta
+
+    li      t0, 262144              # 64 voltas
+    mv      t1, s0
+    li      a0, 0
+percorre:
+    lw      t2, 4(t1)
+    slli    t3, a0, 1
+    srli    t4, a0, 31
+    or      a0, t3, t4
+    add     a0, a0, t2
+    lw      t1, 0(t1)
+    addi    t0, t0, -1
+    bnez    t0, percorre
+
+    li      a7, 93
+    ecall
@@ -0,0 +1,83 @@
+# Multiplicação de matrizes inteiras 48x48 (C = A x B), com A e B gerados por um LCG
+# (valores entre -128 e 127). Saída: exit(a0) com h = h * 31 + C[i][j] em ordem de linhas.
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # A
+    li      s1, 0x44000             # B
+    li      s2, 0x48000             # C
+    li      s3, 48                  # N
+    mul     s4, s3, s3              # N * N
+    slli    s5, s4, 2               # bytes por matriz
+
+    li      t0, 2024
+    li      t1, 1103515245
+    li      t2, 12345
+    mv      t3, s0
+    add     t4, s0, s5
+preenche_a:
+    mul     t0, t0, t1
+    add     t0, t0, t2
+    srli    t5, t0, 16
+    andi    t5, t5, 0xFF
+    addi    t5, t5, -128
+    sw      t5, 0(t3)
+    addi    t3, t3, 4
+    bltu    t3, t4, preenche_a
+
+    mv      t3, s1
+    add     t4, s1, s5
+preenche_b:
+    mul     t0, t0, t1
+    add     t0, t0, t2
+    srli    t5, t0, 16
+    andi    t5, t5, 0xFF
+    addi    t5, t5, -128
+    sw      t5, 0(t3)
+    addi    t3, t3, 4
+    bltu    t3, t4, preenche_b
+
+    slli    t6, s3, 2               # passo de uma linha (N * 4)
+    li      a0, 0                   # i
+linha:
+    li      a1, 0                   # j
+coluna:
+    li      a3, 0                   # soma
+    mul     t3, a0, t6
+    add     t3, s0, t3              # &A[i][0]
+    slli    t4, a1, 2
+    add     t4, s1, t4              # &B[0][j]
+    mv      a2, s3                  # k restantes
+produto:
+    lw      t0, 0(t3)
+    lw      t1, 0(t4)
+    mul     t0, t0, t1
+    add     a3, a3, t0
+    addi    t3, t3, 4
+    add     t4, t4, t6
+    addi    a2, a2, -1
+    bnez    a2, produto
+
+    mul     t5, a0, s3
+    add     t5, t5, a1
+    slli    t5, t5, 2
+    add     t5, s2, t5
+    sw      a3, 0(t5)               # C[i][j]
+    addi    a1, a1, 1
+    blt     a1, s3, coluna
+    addi    a0, a0, 1
+    blt     a0, s3, linha
+
+    li      a0, 0
+    mv      t3, s2
+    add     t4, s2, s5
+    li      t6, 31
+hash:
+    lw      t0, 0(t3)
+    mul     a0, a0, t6
+    add     a0, a0, t0
+    addi    t3, t3, 4
+    bltu    t3, t4, hash
+
+    li      a7, 93
+    ecall
@@ -0,0 +1,95 @@
+# Quicksort recursivo (partição de Lomuto, comparação com sinal) de 2048 palavras geradas por um LCG.
+# Exercita chamadas (jal/jalr), a pilha e desvios dependentes de dados.
+# Saída: exit(a0) com a soma de a[i] * (i + 1) do vetor ordenado.
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # vetor
+    li      s1, 2048                # tamanho
+    slli    s5, s1, 2
+    add     s5, s0, s5              # fim do vetor
+
+    li      t0, 99
+    li      t1, 1103515245
+    li      t2, 12345
+    mv      t3, s0
+preenche:
+    mul     t0, t0, t1
+    add     t0, t0, t2
+    sw      t0, 0(t3)
+    addi    t3, t3, 4
+    bltu    t3, s5, preenche
+
+    mv      a0, s0
+    li      a1, 0
+    addi    a2, s1, -1
+    jal     ra, quicksort
+
+    li      a0, 0
+    li      t1, 1
+    mv      t3, s0
+soma:
+    lw      t0, 0(t3)
+    mul     t0, t0, t1
+    add     a0, a0, t0
+    addi    t1, t1, 1
+    addi    t3, t3, 4
+    bltu    t3, s5, soma
+
+    li      a7, 93
+    ecall
+
+# quicksort(a0 = vetor, a1 = lo, a2 = hi)
+quicksort:
+    bge     a1, a2, qs_fim
+    addi    sp, sp, -16
+    sw      ra, 12(sp)
+    sw      s2, 8(sp)
+    sw      s3, 4(sp)
+    sw      s4, 0(sp)
+    mv      s2, a1                  # lo
+    mv      s3, a2                  # hi
+
+    slli    t0, s3, 2
+    add     t0, a0, t0              # &a[hi]
+    lw      t1, 0(t0)               # pivô
+    addi    t2, s2, -1              # i
+    mv      t3, s2                  # j
+particao:
+    bge     t3, s3, particao_fim
+    slli    t4, t3, 2
+    add     t4, a0, t4
+    lw      t5, 0(t4)
+    blt     t1, t5, proximo         # a[j] > pivô
+    addi    t2, t2, 1
+    slli    t6, t2, 2
+    add     t6, a0, t6
+    lw      a3, 0(t6)
+    sw      t5, 0(t6)
+    sw      a3, 0(t4)
+proximo:
+    addi    t3, t3, 1
+    j       particao
+particao_fim:
+    addi    t2, t2, 1
+    slli    t6, t2, 2
+    add     t6, a0, t6
+    lw      a3, 0(t6)
+    sw      t1, 0(t6)
+    sw      a3, 0(t0)
+    mv      s4, t2                  # posição do pivô
+
+    mv      a1, s2
+    addi    a2, s4, -1
+    jal     ra, quicksort
+    addi    a1, s4, 1
+    mv      a2, s3
+    jal     ra, quicksort
+
+    lw      ra, 12(sp)
+    lw      s2, 8(sp)
+    lw      s3, 4(sp)
+    lw      s4, 0(sp)
+    addi    sp, sp, 16
+qs_fim:
+    ret
@@ -0,0 +1,105 @@
+# Chamadas de função curtas sobre strings, no espírito do Dhrystone: a cada iteração
+# gera uma string de 48 letras, copia (strcpy), mede (strlen), altera um byte da cópia
+# e compara (strcmp). Saída: exit(a0) com h = h * 33 + tamanho + comparação + (semente & 0xFF).
+    .text
+_start:
+    li      sp, 0xF0000
+    li      s0, 0x40000             # buf1
+    li      s1, 0x40100             # buf2
+    li      s2, 1                   # semente
+    li      s3, 0                   # h
+    li      s4, 1500                # iterações
+laco:
+    mv      a0, s0
+    mv      a1, s2
+    li      a2, 48
+    jal     ra, gerar
+    mv      s2, a0
+
+    mv      a0, s1
+    mv      a1, s0
+    jal     ra, copiar
+
+    mv      a0, s1
+    jal     ra, tamanho
+    mv      s5, a0
+
+    remu    t0, s2, s5              # buf2[semente % tamanho] ^= 1
+    add     t0, s1, t0
+    lbu     t1, 0(t0)
+    xori    t1, t1, 1
+    sb      t1, 0(t0)
+
+    mv      a0, s0
+    mv      a1, s1
+    jal     ra, comparar
+    mv      s6, a0
+
+    li      t0, 33
+    mul     s3, s3, t0
+    add     s3, s3, s5
+    add     s3, s3, s6
+    andi    t1, s2, 0xFF
+    add     s3, s3, t1
+    addi    s4, s4, -1
+    bnez    s4, laco
+
+    mv      a0, s3
+    li      a7, 93
+    ecall
+
+# gerar(a0 = destino, a1 = semente, a2 = tamanho) -> a0 = nova semente
+gerar:
+    li      t1, 1103515245
+    li      t2, 12345
+    li      t3, 26
+gerar_laco:
+    mul     a1, a1, t1
+    add     a1, a1, t2
+    srli    t4, a1, 16
+    remu    t4, t4, t3
+    addi    t4, t4, 97
+    sb      t4, 0(a0)
+    addi    a0, a0, 1
+    addi    a2, a2, -1
+    bnez    a2, gerar_laco
+    sb      zero, 0(a0)
+    mv      a0, a1
+    ret
+
+# copiar(a0 = destino, a1 = origem)
+copiar:
+    lbu     t0, 0(a1)
+    sb      t0, 0(a0)
+    addi    a0, a0, 1
+    addi    a1, a1, 1
+    bnez    t0, copiar
+    ret
+
+# tamanho(a0 = string) -> a0
+tamanho:
+    mv      t1, a0
+tamanho_laco:
+    lbu     t0, 0(t1)
+    beqz    t0, tamanho_fim
+    addi    t1, t1, 1
+    j       tamanho_laco
+tamanho_fim:
+    sub     a0, t1, a0
+    ret
+
+# comparar(a0, a1) -> a0 = diferença do primeiro byte diferente (0 se iguais)
+comparar:
+    lbu     t0, 0(a0)
+    lbu     t1, 0(a1)
+    bne     t0, t1, comparar_diferente
+    beqz    t0, comparar_igual
+    addi    a0, a0, 1
+    addi    a1, a1, 1
+    j       comparar
+comparar_diferente:
+    sub     a0, t0, t1
+    ret
+comparar_igual:
+    li      a0, 0
+    ret
@@ -0,0 +1,130 @@
+#include "Barramento.h"
+
+#include <algorithm>
+#include <sstream>
+
+Barramento::Barramento(std::vector<uint8_t> &ram)
+    : ram(ram),
+      limite_ram(static_cast<uint32_t>(std::min<size_t>(ram.size(), UINT32_MAX))) {
+}
+
+std::string Barramento::inserir(Regiao regiao) {
+    uint64_t fim = static_cast<uint64_t>(regiao.base) + regiao.tamanho;
+    if (regiao.tamanho == 0 || fim > (1ull << 32)) {
+        return "[ERRO] Regiao invalida: " + regiao.nome;
+    }
+    if (regiao.base < limite_ram) {
+        return "[ERRO] Regiao " + regiao.nome + " sobrepoe a RAM";
+    }
+
+    auto pos = std::lower_bound(regioes.begin(), regioes.end(), regiao.base,
+                                [](const Regiao& r, uint32_t base) { return r.base < base; });
+    if (pos != regioes.end() && pos->base < fim) {
+        return "[ERRO] Regiao " + regiao.nome + " sobrepoe " + pos->nome;
+    }
+    if (pos != regioes.begin()) {
+        const Regiao& anterior = *std::prev(pos);
+        if (static_cast<uint64_t>(anterior.base) + anterior.tamanho > regiao.base) {
+            return "[ERRO] Regiao " + regiao.nome + " sobrepoe " + anterior.nome;
+        }
+    }
+
+    regioes.insert(pos, std::move(regiao));
+    return "";
+}
+
+std::string Barramento::adicionar_rom(uint32_t base, std::vector<uint8_t> conteudo, const std::string &nome) {
+    Regiao regiao{nome, TipoRegiao::Rom, base, static_cast<uint32_t>(conteudo.size()), std::move(conteudo), nullptr};
+    return inserir(std::move(regiao));
+}
+
+std::string Barramento::adicionar_dispositivo(uint32_t base, uint32_t tamanho, std::unique_ptr<Dispositivo> dispositivo) {
+    std::string nome = dispositivo->nome();
+    Regiao regiao{nome, TipoRegiao::Mmio, base, tamanho, {}, std::move(dispositivo)};
+    return inserir(std::move(regiao));
+}
+
+/**
+ * @brief Busca binária pela região que contém 'endereco'.
+ */
+const Barramento::Regiao* Barramento::procurar(uint32_t endereco) const {
+    auto pos = std::upper_bound(regioes.begin(), regioes.end(), endereco,
+                                [](uint32_t e, const Regiao& r) { return e < r.base; });
+    if (pos == regioes.begin()) return nullptr;
+    const Regiao& regiao = *std::prev(pos);
+    if (endereco - regiao.base >= regiao.tamanho) return nullptr;
+    return &regiao;
+}
+
+bool Barramento::ler(uint32_t endereco, uint32_t tamanho, uint32_t &valor) {
+    const Regiao* regiao = procurar(endereco);
+    if (!regiao || endereco - regiao->base + tamanho > regiao->tamanho) {
+        valor = 0;
+        return false;
+    }
+
+    uint32_t deslocamento = endereco - regiao->base;
+    if (regiao->tipo == TipoRegiao::Rom) {
+        valor = 0;
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            valor |= static_cast<uint32_t>(regiao->conteudo_rom[deslocamento + i]) << (8 * i);
+        }
+        return true;
+    }
+
+    valor = regiao->dispositivo->ler(deslocamento, tamanho);
+    return true;
+}
+
+bool Barramento::escrever(uint32_t endereco, uint32_t valor, uint32_t tamanho) {
+    const Regiao* regiao = procurar(endereco);
+    if (!regiao || endereco - regiao->base + tamanho > regiao->tamanho) {
+        return false;
+    }
+
+    // Escritas em ROM são ignoradas, mas o endereço é válido
+    if (regiao->tipo == TipoRegiao::Mmio) {
+        regiao->dispositivo->escrever(endereco - regiao->base, valor, tamanho);
+    }
+    return true;
+}
+
+bool Barramento::espiar_byte(uint32_t endereco, uint8_t &valor) const {
+    if (endereco < limite_ram) {
+        valor = ram[endereco];
+        return true;
+    }
+    const Regiao* regiao = procurar(endereco);
+    if (!regiao || regiao->tipo != TipoRegiao::Rom) {
+        valor = 0;
+        return regiao != nullptr;
+    }
+    valor = regiao->conteudo_rom[endereco - regiao->base];
+    return true;
+}
+
+bool Barramento::mapeado(uint32_t endereco) const {
+    return endereco < limite_ram || procurar(endereco) != nullptr;
+}
+
+bool Barramento::tipo_regiao(uint32_t endereco, TipoRegiao &tipo) const {
+    if (endereco < limite_ram) {
+        tipo = TipoRegiao::Ram;
+        return true;
+    }
+    const Regiao* regiao = procurar(endereco);
+    if (!regiao) return false;
+    tipo = regiao->tipo;
+    return true;
+}
+
+const std::vector<Barramento::Regiao> &Barramento::get_regioes() const {
+    return regioes;
+}
+
+Dispositivo *Barramento::procurar_dispositivo(const std::string &nome) const {
+    for (const Regiao& regiao : regioes) {
+        if (regiao.tipo == TipoRegiao::Mmio && regiao.nome == nome) return regiao.dispositivo.get();
+    }
+    return nullptr;
+}
@@ -0,0 +1,90 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_BARRAMENTO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_BARRAMENTO_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class Dispositivo
+ * @brief Interface de um dispositivo mapeado em memória (MMIO).
+ *
+ * 'deslocamento' é relativo à base da região do dispositivo e 'tamanho' é 1, 2 ou 4 bytes.
+ */
+class Dispositivo {
+public:
+    virtual ~Dispositivo() = default;
+
+    virtual const char* nome() const = 0;
+    virtual uint32_t ler(uint32_t deslocamento, uint32_t tamanho) = 0;
+    virtual void escrever(uint32_t deslocamento, uint32_t valor, uint32_t tamanho) = 0;
+};
+
+/**
+ * @enum TipoRegiao
+ * @brief Tipo de cada região do mapa de endereços físico.
+ */
+enum class TipoRegiao : uint8_t {
+    Ram,
+    Rom,
+    Mmio
+};
+
+/**
+ * @class Barramento
+ * @brief Mapa de endereços físico: RAM a partir do endereço 0, regiões de ROM e dispositivos MMIO.
+ *
+ * A RAM continua sendo o vetor 'memoria' do Core, acessado pelo Cache. O
+ * Core só consulta o barramento quando o endereço está fora da RAM, então
+ * loads e stores comuns custam apenas uma comparação a mais. Fora da RAM, a
+ * região é encontrada por busca binária e o acesso é despachado para a ROM
+ * ou para o dispositivo.
+ */
+class Barramento {
+public:
+    struct Regiao {
+        std::string nome;
+        TipoRegiao tipo;
+        uint32_t base;
+        uint32_t tamanho;
+        std::vector<uint8_t> conteudo_rom;
+        std::unique_ptr<Dispositivo> dispositivo;
+    };
+
+    explicit Barramento(std::vector<uint8_t>& ram);
+
+    // Retornam uma mensagem de erro (ex: sobreposição de regiões), ou string vazia
+    std::string adicionar_rom(uint32_t base, std::vector<uint8_t> conteudo, const std::string& nome = "ROM");
+    std::string adicionar_dispositivo(uint32_t base, uint32_t tamanho, std::unique_ptr<Dispositivo> dispositivo);
+
+    // Caminho rápido: o acesso cabe inteiro na RAM
+    bool na_ram(uint32_t endereco, uint32_t tamanho) const {
+        return endereco <= limite_ram && limite_ram - endereco >= tamanho;
+    }
+
+    // Caminho lento (ROM e MMIO); retornam false se o endereço não está mapeado
+    bool ler(uint32_t endereco, uint32_t tamanho, uint32_t& valor);
+    bool escrever(uint32_t endereco, uint32_t valor, uint32_t tamanho);
+
+    // Leitura sem efeitos colaterais (não lê registradores de dispositivos), para visualização
+    bool espiar_byte(uint32_t endereco, uint8_t& valor) const;
+    bool mapeado(uint32_t endereco) const;
+    // Tipo da região que contém 'endereco'; false se não está mapeado
+    bool tipo_regiao(uint32_t endereco, TipoRegiao& tipo) const;
+
+    const std::vector<Regiao>& get_regioes() const;
+    Dispositivo* procurar_dispositivo(const std::string& nome) const;
+
+private:
+    const Regiao* procurar(uint32_t endereco) const;
+    std::string inserir(Regiao regiao);
+
+    std::vector<uint8_t>& ram;
+    uint32_t limite_ram;
+
+    // Regiões fora da RAM, ordenadas por endereço base
+    std::vector<Regiao> regioes;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_BARRAMENTO_H
@@ -0,0 +1,191 @@
+#include "Dispositivos.h"
+
+#include "core/Csr.h"
+
+// --- Uart ---
+
+uint32_t Uart::ler(uint32_t deslocamento, [[maybe_unused]] uint32_t tamanho) {
+    switch (deslocamento) {
+        case REG_DADOS: {
+            if (entrada.empty()) return 0;
+            uint8_t c = entrada.front();
+            entrada.pop_front();
+            return c;
+        }
+        case REG_LSR:
+            return LSR_THR_VAZIO | (entrada.empty() ? 0 : LSR_DADO_PRONTO);
+        default:
+            return 0;
+    }
+}
+
+void Uart::escrever(uint32_t deslocamento, uint32_t valor, [[maybe_unused]] uint32_t tamanho) {
+    if (deslocamento == REG_DADOS) {
+        char c = static_cast<char>(valor & 0xFF);
+        if (destino_saida) {
+            destino_saida(c);
+            return;
+        }
+        if (saida.size() >= TAMANHO_MAXIMO_SAIDA) saida.erase(0, saida.size() - TAMANHO_MAXIMO_SAIDA / 2);
+        saida.push_back(c);
+    }
+}
+
+void Uart::enviar_entrada(const std::string &texto) {
+    entrada.insert(entrada.end(), texto.begin(), texto.end());
+}
+
+std::string Uart::consumir_saida() {
+    std::string texto;
+    texto.swap(saida);
+    return texto;
+}
+
+void Uart::definir_destino_saida(DestinoSaida destino) {
+    destino_saida = std::move(destino);
+}
+
+void Uart::reset() {
+    saida.clear();
+    entrada.clear();
+}
+
+void Uart::salvar_estado(ImagemUart &imagem) const {
+    imagem.saida = saida;
+    imagem.entrada.assign(entrada.begin(), entrada.end());
+}
+
+void Uart::restaurar_estado(const ImagemUart &imagem) {
+    saida = imagem.saida;
+    entrada.assign(imagem.entrada.begin(), imagem.entrada.end());
+}
+
+// --- Clint ---
+
+Clint::Clint(const uint64_t &ciclos) : ciclos(ciclos) {
+}
+
+uint64_t Clint::mtime() const {
+    return ciclos / csr::DIVISOR_TIME + deslocamento_mtime;
+}
+
+bool Clint::interrupcao_pendente() const {
+    return mtime() >= mtimecmp || (msip & 0x1);
+}
+
+void Clint::reset() {
+    restaurar_estado(ImagemClint{});
+}
+
+void Clint::salvar_estado(ImagemClint &imagem) const {
+    imagem.deslocamento_mtime = deslocamento_mtime;
+    imagem.mtimecmp = mtimecmp;
+    imagem.msip = msip;
+}
+
+void Clint::restaurar_estado(const ImagemClint &imagem) {
+    deslocamento_mtime = imagem.deslocamento_mtime;
+    mtimecmp = imagem.mtimecmp;
+    msip = imagem.msip;
+}
+
+uint32_t Clint::ler(uint32_t deslocamento, [[maybe_unused]] uint32_t tamanho) {
+    switch (deslocamento) {
+        case REG_MSIP: return msip;
+        case REG_MTIMECMP: return static_cast<uint32_t>(mtimecmp);
+        case REG_MTIMECMP + 4: return static_cast<uint32_t>(mtimecmp >> 32);
+        case REG_MTIME: return static_cast<uint32_t>(mtime());
+        case REG_MTIME + 4: return static_cast<uint32_t>(mtime() >> 32);
+        default: return 0;
+    }
+}
+
+void Clint::escrever(uint32_t deslocamento, uint32_t valor, [[maybe_unused]] uint32_t tamanho) {
+    switch (deslocamento) {
+        case REG_MSIP: msip = valor & 0x1;
+            break;
+        case REG_MTIMECMP: mtimecmp = (mtimecmp & 0xFFFFFFFF00000000ull) | valor;
+            break;
+        case REG_MTIMECMP + 4: mtimecmp = (mtimecmp & 0xFFFFFFFFull) | (static_cast<uint64_t>(valor) << 32);
+            break;
+        case REG_MTIME: {
+            uint64_t novo = (mtime() & 0xFFFFFFFF00000000ull) | valor;
+            deslocamento_mtime = novo - ciclos / csr::DIVISOR_TIME;
+            break;
+        }
+        case REG_MTIME + 4: {
+            uint64_t novo = (mtime() & 0xFFFFFFFFull) | (static_cast<uint64_t>(valor) << 32);
+            deslocamento_mtime = novo - ciclos / csr::DIVISOR_TIME;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// --- DispositivoBloco ---
+
+std::string DispositivoBloco::abrir(const std::string &caminho) {
+    arquivo.open(caminho, std::ios::in | std::ios::out | std::ios::binary);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir a imagem de disco: " + caminho;
+    }
+    arquivo.seekg(0, std::ios::end);
+    num_setores = static_cast<uint32_t>(static_cast<uint64_t>(arquivo.tellg()) / TAMANHO_SETOR);
+    return "";
+}
+
+uint32_t DispositivoBloco::ler(uint32_t deslocamento, uint32_t tamanho) {
+    if (deslocamento >= JANELA_DADOS && deslocamento + tamanho <= JANELA_DADOS + TAMANHO_SETOR) {
+        uint32_t valor = 0;
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            valor |= static_cast<uint32_t>(dados[deslocamento - JANELA_DADOS + i]) << (8 * i);
+        }
+        return valor;
+    }
+
+    switch (deslocamento) {
+        case REG_SETOR: return setor;
+        case REG_STATUS: return status;
+        case REG_NUM_SETORES: return num_setores;
+        default: return 0;
+    }
+}
+
+void DispositivoBloco::escrever(uint32_t deslocamento, uint32_t valor, uint32_t tamanho) {
+    if (deslocamento >= JANELA_DADOS && deslocamento + tamanho <= JANELA_DADOS + TAMANHO_SETOR) {
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            dados[deslocamento - JANELA_DADOS + i] = static_cast<uint8_t>(valor >> (8 * i));
+        }
+        return;
+    }
+
+    switch (deslocamento) {
+        case REG_SETOR: setor = valor;
+            break;
+        case REG_COMANDO: executar_comando(valor);
+            break;
+        default:
+            break;
+    }
+}
+
+void DispositivoBloco::executar_comando(uint32_t comando) {
+    if (!arquivo.is_open() || setor >= num_setores ||
+        (comando != COMANDO_LER && comando != COMANDO_ESCREVER)) {
+        status = 1;
+        return;
+    }
+
+    auto posicao = static_cast<std::streamoff>(setor) * TAMANHO_SETOR;
+    arquivo.clear();
+    if (comando == COMANDO_LER) {
+        arquivo.seekg(posicao);
+        arquivo.read(reinterpret_cast<char*>(dados.data()), TAMANHO_SETOR);
+    } else {
+        arquivo.seekp(posicao);
+        arquivo.write(reinterpret_cast<const char*>(dados.data()), TAMANHO_SETOR);
+        arquivo.flush();
+    }
+    status = arquivo ? 0 : 1;
+}
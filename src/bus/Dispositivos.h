@@ -0,0 +1,149 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_DISPOSITIVOS_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_DISPOSITIVOS_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Barramento.h"
+
+// Mapa de endereços padrão dos dispositivos
+namespace mapa {
+    constexpr uint32_t CLINT_BASE = 0x02000000;
+    constexpr uint32_t CLINT_TAMANHO = 0x10000;
+    constexpr uint32_t UART_BASE = 0x10000000;
+    constexpr uint32_t UART_TAMANHO = 0x100;
+    constexpr uint32_t BLOCO_BASE = 0x10001000;
+    constexpr uint32_t BLOCO_TAMANHO = 0x1000;
+}
+
+// Estado da UART guardado em snapshots e checkpoints: o que ainda não foi lido de cada lado
+struct ImagemUart {
+    std::string saida;
+    std::vector<uint8_t> entrada;
+};
+
+// Estado do CLINT guardado em snapshots e checkpoints; mtime vem dos ciclos do Core
+struct ImagemClint {
+    uint64_t deslocamento_mtime = 0;
+    uint64_t mtimecmp = UINT64_MAX;
+    uint32_t msip = 0;
+};
+
+/**
+ * @class Uart
+ * @brief UART mínima compatível com o 16550: THR/RBR no deslocamento 0 e LSR no 5.
+ *
+ * Os caracteres escritos pelo guest vão para o destino de saída (o Core usa
+ * o mesmo buffer do stdout das syscalls); sem destino, são acumulados, até
+ * TAMANHO_MAXIMO_SAIDA, em um buffer que o host retira com consumir_saida().
+ * A entrada é alimentada com enviar_entrada().
+ */
+class Uart : public Dispositivo {
+public:
+    static constexpr uint32_t REG_DADOS = 0x0;
+    static constexpr uint32_t REG_LSR = 0x5;
+    static constexpr uint32_t LSR_DADO_PRONTO = 0x01;
+    static constexpr uint32_t LSR_THR_VAZIO = 0x60;
+    // Sem destino, os caracteres mais antigos são descartados a partir deste tamanho
+    static constexpr size_t TAMANHO_MAXIMO_SAIDA = 64 * 1024;
+
+    using DestinoSaida = std::function<void(char)>;
+
+    const char* nome() const override { return "UART"; }
+    uint32_t ler(uint32_t deslocamento, uint32_t tamanho) override;
+    void escrever(uint32_t deslocamento, uint32_t valor, uint32_t tamanho) override;
+
+    void enviar_entrada(const std::string& texto);
+    std::string consumir_saida();
+    // Destino nulo volta a acumular a saída para consumir_saida()
+    void definir_destino_saida(DestinoSaida destino);
+    // Esvazia a entrada e a saída pendentes (o destino é mantido)
+    void reset();
+    void salvar_estado(ImagemUart& imagem) const;
+    void restaurar_estado(const ImagemUart& imagem);
+
+private:
+    DestinoSaida destino_saida;
+    std::string saida;
+    std::deque<uint8_t> entrada;
+};
+
+/**
+ * @class Clint
+ * @brief Temporizador do núcleo (CLINT): msip, mtimecmp e mtime.
+ *
+ * mtime avança junto com o contador 'time' do Core (ciclos decorridos / csr::DIVISOR_TIME).
+ * Como o Core ainda não trata interrupções, o guest deve consultar
+ * interrupcao_pendente() por polling de mtime/mtimecmp.
+ */
+class Clint : public Dispositivo {
+public:
+    static constexpr uint32_t REG_MSIP = 0x0000;
+    static constexpr uint32_t REG_MTIMECMP = 0x4000;
+    static constexpr uint32_t REG_MTIME = 0xBFF8;
+
+    // 'ciclos' aponta para os ciclos decorridos do Core (não para mcycle, que o guest escreve e inibe)
+    explicit Clint(const uint64_t& ciclos);
+
+    const char* nome() const override { return "CLINT"; }
+    uint32_t ler(uint32_t deslocamento, uint32_t tamanho) override;
+    void escrever(uint32_t deslocamento, uint32_t valor, uint32_t tamanho) override;
+
+    uint64_t mtime() const;
+    bool interrupcao_pendente() const;
+    // Volta ao estado após o reset: mtime segue os ciclos, sem comparação nem msip
+    void reset();
+    void salvar_estado(ImagemClint& imagem) const;
+    void restaurar_estado(const ImagemClint& imagem);
+
+private:
+    const uint64_t& ciclos;
+    // Ajuste aplicado quando o guest escreve em mtime
+    uint64_t deslocamento_mtime = 0;
+    uint64_t mtimecmp = UINT64_MAX;
+    uint32_t msip = 0;
+};
+
+/**
+ * @class DispositivoBloco
+ * @brief Disco simples com setores de 512 bytes guardados em um arquivo do host.
+ *
+ * Registradores: 0x00 SETOR, 0x04 COMANDO (1 = ler, 2 = escrever),
+ * 0x08 STATUS (0 = ok, 1 = erro), 0x0C NUM_SETORES (somente leitura).
+ * O setor é transferido pela janela de dados em 0x200..0x3FF.
+ */
+class DispositivoBloco : public Dispositivo {
+public:
+    static constexpr uint32_t TAMANHO_SETOR = 512;
+    static constexpr uint32_t REG_SETOR = 0x00;
+    static constexpr uint32_t REG_COMANDO = 0x04;
+    static constexpr uint32_t REG_STATUS = 0x08;
+    static constexpr uint32_t REG_NUM_SETORES = 0x0C;
+    static constexpr uint32_t JANELA_DADOS = 0x200;
+
+    static constexpr uint32_t COMANDO_LER = 1;
+    static constexpr uint32_t COMANDO_ESCREVER = 2;
+
+    // Retorna uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string abrir(const std::string& caminho);
+
+    const char* nome() const override { return "BLOCO"; }
+    uint32_t ler(uint32_t deslocamento, uint32_t tamanho) override;
+    void escrever(uint32_t deslocamento, uint32_t valor, uint32_t tamanho) override;
+
+private:
+    void executar_comando(uint32_t comando);
+
+    std::fstream arquivo;
+    uint32_t num_setores = 0;
+    uint32_t setor = 0;
+    uint32_t status = 0;
+    std::array<uint8_t, TAMANHO_SETOR> dados{};
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_DISPOSITIVOS_H
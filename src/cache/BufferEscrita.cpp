@@ -0,0 +1,196 @@
+#include "BufferEscrita.h"
+#include <algorithm>
+
+BufferEscrita::BufferEscrita(MemoriaDram& dram, uint32_t tamanho_bloco)
+    : dram(dram),
+      tamanho_bloco(tamanho_bloco)
+{
+    entradas.reserve(config.entradas);
+}
+
+std::string BufferEscrita::configurar(const ConfigBufferEscrita& novo)
+{
+    if (novo.entradas > 0 && tamanho_bloco > 64)
+    {
+        return "[ERRO] Buffer de escrita: blocos de mais de 64 bytes nao sao suportados.";
+    }
+    if (novo.entradas > 0 && novo.limite_drenagem > novo.entradas)
+    {
+        return "[ERRO] Buffer de escrita: o limite de drenagem passa do numero de entradas.";
+    }
+    config = novo;
+    entradas.reserve(config.entradas);
+    reset();
+    return "";
+}
+
+const ConfigBufferEscrita& BufferEscrita::getConfig() const
+{
+    return config;
+}
+
+void BufferEscrita::reset()
+{
+    entradas.clear();
+    estatisticas = EstatisticasBufferEscrita{};
+}
+
+void BufferEscrita::definirColetaEstatisticas(bool coletar)
+{
+    coletar_estatisticas = coletar;
+}
+
+const EstatisticasBufferEscrita& BufferEscrita::getEstatisticas() const
+{
+    return estatisticas;
+}
+
+uint64_t BufferEscrita::mascaraBytes(uint32_t endereco, uint32_t tamanho) const
+{
+    uint32_t offset = endereco & (tamanho_bloco - 1);
+    uint64_t bits = tamanho >= 64 ? ~uint64_t{0} : (uint64_t{1} << tamanho) - 1;
+    return bits << offset;
+}
+
+uint32_t BufferEscrita::drenar(size_t quantidade)
+{
+    uint32_t espera = 0;
+    for (size_t i = 0; i < quantidade; ++i)
+    {
+        espera += dram.escrever(entradas[i].bloco);
+    }
+    entradas.erase(entradas.begin(), entradas.begin() + static_cast<std::ptrdiff_t>(quantidade));
+    if (coletar_estatisticas)
+    {
+        estatisticas.drenagens += quantidade;
+    }
+    return espera;
+}
+
+uint32_t BufferEscrita::escrever(uint32_t endereco, uint32_t tamanho)
+{
+    uint32_t bloco = endereco & ~(tamanho_bloco - 1);
+    if (coletar_estatisticas)
+    {
+        estatisticas.escritas++;
+    }
+    if (config.entradas == 0)
+    {
+        if (coletar_estatisticas)
+        {
+            estatisticas.drenagens++;
+        }
+        return dram.escrever(bloco);
+    }
+
+    uint64_t mascara = mascaraBytes(endereco, tamanho);
+    if (config.combinar)
+    {
+        // Com combinação há no máximo uma entrada por bloco
+        for (EntradaBufferEscrita& entrada : entradas)
+        {
+            if (entrada.bloco == bloco)
+            {
+                entrada.mascara |= mascara;
+                if (coletar_estatisticas)
+                {
+                    estatisticas.combinadas++;
+                }
+                return 0;
+            }
+        }
+    }
+
+    uint32_t espera = 0;
+    if (entradas.size() >= config.entradas)
+    {
+        espera = drenar(1);
+        if (coletar_estatisticas)
+        {
+            estatisticas.paradas_cheio++;
+            estatisticas.ciclos_parados_cheio += espera;
+        }
+    }
+    entradas.push_back({bloco, mascara});
+    if (coletar_estatisticas)
+    {
+        estatisticas.ocupacao_maxima = std::max<uint64_t>(estatisticas.ocupacao_maxima, entradas.size());
+    }
+    return espera;
+}
+
+EncaminhamentoBuffer BufferEscrita::consultarLeitura(uint32_t endereco, uint32_t tamanho, uint32_t& espera)
+{
+    espera = 0;
+    uint32_t bloco = endereco & ~(tamanho_bloco - 1);
+
+    // Bytes do bloco cobertos pelo buffer e a entrada mais nova dele (sem combinação pode haver várias)
+    uint64_t presentes = 0;
+    size_t ultima = 0;
+    for (size_t i = 0; i < entradas.size(); ++i)
+    {
+        if (entradas[i].bloco == bloco)
+        {
+            presentes |= entradas[i].mascara;
+            ultima = i + 1;
+        }
+    }
+    if (ultima == 0)
+    {
+        return EncaminhamentoBuffer::Nenhum;
+    }
+
+    uint64_t pedidos = mascaraBytes(endereco, tamanho);
+    if (config.encaminhar && (presentes & pedidos) == pedidos)
+    {
+        if (coletar_estatisticas)
+        {
+            estatisticas.encaminhamentos++;
+        }
+        return presentes == mascaraBytes(bloco, tamanho_bloco) ? EncaminhamentoBuffer::Bloco
+                                                               : EncaminhamentoBuffer::Palavra;
+    }
+
+    // A leitura não pode passar na frente das escritas pendentes do bloco
+    espera = drenar(ultima);
+    if (coletar_estatisticas)
+    {
+        estatisticas.conflitos_leitura++;
+    }
+    return EncaminhamentoBuffer::Conflito;
+}
+
+void BufferEscrita::avancar(uint64_t ciclos)
+{
+    if (coletar_estatisticas)
+    {
+        estatisticas.ocupacao_acumulada += entradas.size() * ciclos;
+        estatisticas.ciclos += ciclos;
+    }
+    // A drenagem em segundo plano só usa vagas livres na fila da DRAM: o Core não espera
+    if (entradas.size() > config.limite_drenagem)
+    {
+        size_t quantidade = std::min<size_t>(entradas.size() - config.limite_drenagem, dram.getVagasFila());
+        if (quantidade > 0)
+        {
+            drenar(quantidade);
+        }
+    }
+}
+
+void BufferEscrita::salvarEstado(ImagemBufferEscrita& imagem) const
+{
+    imagem.entradas = entradas;
+    imagem.estatisticas = estatisticas;
+}
+
+void BufferEscrita::restaurarEstado(const ImagemBufferEscrita& imagem)
+{
+    reset();
+    if (imagem.entradas.size() > config.entradas)
+    {
+        return;
+    }
+    entradas = imagem.entradas;
+    estatisticas = imagem.estatisticas;
+}
@@ -0,0 +1,125 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_BUFFERESCRITA_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_BUFFERESCRITA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MemoriaDram.h"
+
+struct ConfigBufferEscrita
+{
+    // Quantidade de entradas (um bloco do cache cada); 0 desliga o buffer (e ignora o limite)
+    uint32_t entradas = 8;
+    // Acima dessa ocupação, a entrada mais antiga vai para a DRAM assim que houver vaga na fila
+    uint32_t limite_drenagem = 4;
+    // Escritas no mesmo bloco de uma entrada pendente são combinadas nela
+    bool combinar = true;
+    // Leituras cobertas pelo buffer são atendidas por ele, sem esperar a DRAM
+    bool encaminhar = true;
+};
+
+// Contadores do buffer de escrita (acumulados desde o último reset)
+struct EstatisticasBufferEscrita
+{
+    uint64_t escritas = 0;
+    // Escritas absorvidas por uma entrada existente
+    uint64_t combinadas = 0;
+    // Entradas enviadas à DRAM (escritas / drenagens = escritas do Core por escrita na DRAM)
+    uint64_t drenagens = 0;
+    // Escritas que encontraram o buffer cheio e os ciclos esperando a DRAM aceitar a mais antiga
+    uint64_t paradas_cheio = 0;
+    uint64_t ciclos_parados_cheio = 0;
+    // Faltas de leitura atendidas pelo buffer, e as que o acharam só com parte dos bytes
+    // (a entrada é drenada antes da leitura ir para a DRAM)
+    uint64_t encaminhamentos = 0;
+    uint64_t conflitos_leitura = 0;
+    // Soma da ocupação a cada ciclo (ocupação média = ocupacao_acumulada / ciclos)
+    uint64_t ocupacao_acumulada = 0;
+    uint64_t ciclos = 0;
+    uint64_t ocupacao_maxima = 0;
+};
+
+// Uma entrada: o endereço do bloco e os bytes escritos nele (bit i = byte i do bloco)
+struct EntradaBufferEscrita
+{
+    uint32_t bloco = 0;
+    uint64_t mascara = 0;
+};
+
+// Estado do buffer (usado pelos snapshots do Core através da ImagemCache)
+struct ImagemBufferEscrita
+{
+    std::vector<EntradaBufferEscrita> entradas;
+    EstatisticasBufferEscrita estatisticas;
+};
+
+// Resultado da consulta de uma falta de leitura ao buffer
+enum class EncaminhamentoBuffer : uint8_t
+{
+    // Nenhuma escrita pendente no bloco: a leitura vai para a DRAM
+    Nenhum,
+    // Os bytes pedidos estão no buffer (o resto do bloco não); a leitura não espera a DRAM,
+    // mas a linha não é alocada no cache
+    Palavra,
+    // O bloco inteiro está no buffer: a linha é preenchida sem esperar a DRAM
+    Bloco,
+    // O buffer tem só parte dos bytes pedidos: ele foi drenado até a última entrada do bloco
+    Conflito
+};
+
+/**
+ * @class BufferEscrita
+ * @brief Buffer de escrita entre o cache write-through e a DRAM.
+ *
+ * Como o modelo da DRAM, é só temporização: o cache continua gravando os dados na RAM na
+ * hora da escrita. Cada escrita ocupa uma entrada (um bloco) e só vai para a fila da DRAM
+ * quando o buffer passa do limite de drenagem ou fica cheio, em ordem FIFO. Com combinação,
+ * escritas seguidas no mesmo bloco viram uma única escrita na DRAM.
+ *
+ * Nas faltas de leitura, um bloco com escritas pendentes não pode ser lido da DRAM antes
+ * delas: se o buffer tem os bytes pedidos, a leitura é encaminhada dele sem latência (o
+ * cache só preenche a linha se o bloco inteiro estiver no buffer); senão, as entradas são
+ * drenadas até a do bloco e a leitura espera a DRAM normalmente.
+ */
+class BufferEscrita
+{
+public:
+    BufferEscrita(MemoriaDram& dram, uint32_t tamanho_bloco);
+
+    // Retorna uma mensagem de erro ou string vazia; o conteúdo e as estatísticas são zerados
+    std::string configurar(const ConfigBufferEscrita& config);
+    const ConfigBufferEscrita& getConfig() const;
+
+    void reset();
+    // Escrita de 'tamanho' bytes dentro de um bloco; devolve os ciclos parados com o buffer cheio
+    uint32_t escrever(uint32_t endereco, uint32_t tamanho);
+    // Falta de leitura de 'tamanho' bytes; num conflito, 'espera' recebe os ciclos parados drenando
+    EncaminhamentoBuffer consultarLeitura(uint32_t endereco, uint32_t tamanho, uint32_t& espera);
+    // Passa 'ciclos' ciclos: amostra a ocupação e drena o que passou do limite
+    void avancar(uint64_t ciclos);
+
+    void definirColetaEstatisticas(bool coletar);
+    const EstatisticasBufferEscrita& getEstatisticas() const;
+
+    void salvarEstado(ImagemBufferEscrita& imagem) const;
+    // Uma imagem que não cabe na configuração atual (ex.: checkpoint antigo) deixa o buffer vazio
+    void restaurarEstado(const ImagemBufferEscrita& imagem);
+
+private:
+    MemoriaDram& dram;
+    uint32_t tamanho_bloco;
+    ConfigBufferEscrita config;
+
+    // Da mais antiga para a mais nova
+    std::vector<EntradaBufferEscrita> entradas;
+
+    EstatisticasBufferEscrita estatisticas;
+    bool coletar_estatisticas = true;
+
+    uint64_t mascaraBytes(uint32_t endereco, uint32_t tamanho) const;
+    // Envia as 'quantidade' entradas mais antigas para a DRAM; devolve os ciclos esperando vaga
+    uint32_t drenar(size_t quantidade);
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_BUFFERESCRITA_H
@@ -1,11 +1,13 @@
 #include "Cache.h"
+#include <algorithm>
 #include <cmath>
 
 Cache::Cache(uint32_t tamanho_cache, uint32_t tamanho_bloco, std::vector<uint8_t>& memoria_principal)
     : tamanho_cache(tamanho_cache),
       tamanho_bloco(tamanho_bloco),
       qtd_linhas(tamanho_cache / tamanho_bloco),
-      memoria_principal(memoria_principal)
+      memoria_principal(memoria_principal),
+      buffer_escrita(dram, tamanho_bloco)
 {
     linhas.reserve(qtd_linhas);
 
@@ -13,15 +15,171 @@ Cache::Cache(uint32_t tamanho_cache, uint32_t tamanho_bloco, std::vector<uint8_t
     {
         linhas.emplace_back(tamanho_bloco);
     }
+    alteracoes.reserve(qtd_linhas);
+    // O primeiro consumidor recebe o estado de todas as linhas
+    for (uint32_t i = 0; i < qtd_linhas; ++i)
+    {
+        marcarAlteracao(i);
+    }
 }
 
 void Cache::reset()
 {
-    for (LinhaCache& linha : linhas)
+    for (uint32_t i = 0; i < qtd_linhas; ++i)
+    {
+        linhas[i].valida = false;
+        linhas[i].tag = 0;
+        linhas[i].acessos = 0;
+        linhas[i].faltas = 0;
+        marcarAlteracao(i);
+    }
+    estatisticas = EstatisticasCache{};
+    dram.reset();
+    buffer_escrita.reset();
+}
+
+const EstatisticasCache& Cache::getEstatisticas() const
+{
+    return estatisticas;
+}
+
+uint32_t Cache::getQuantidadeLinhas() const
+{
+    return qtd_linhas;
+}
+
+std::string Cache::configurarDram(const ConfigDram& config)
+{
+    std::string erro = MemoriaDram::validar(config);
+    if (erro.empty())
+    {
+        dram.configurar(config);
+    }
+    return erro;
+}
+
+const ConfigDram& Cache::getConfigDram() const
+{
+    return dram.getConfig();
+}
+
+const EstatisticasDram& Cache::getEstatisticasDram() const
+{
+    return dram.getEstatisticas();
+}
+
+std::string Cache::configurarBufferEscrita(const ConfigBufferEscrita& config)
+{
+    return buffer_escrita.configurar(config);
+}
+
+const ConfigBufferEscrita& Cache::getConfigBufferEscrita() const
+{
+    return buffer_escrita.getConfig();
+}
+
+const EstatisticasBufferEscrita& Cache::getEstatisticasBufferEscrita() const
+{
+    return buffer_escrita.getEstatisticas();
+}
+
+void Cache::avancarCiclos(uint64_t ciclos)
+{
+    dram.avancar(ciclos);
+    buffer_escrita.avancar(ciclos);
+}
+
+void Cache::definirColetaEstatisticas(bool coletar)
+{
+    coletar_estatisticas = coletar;
+    dram.definirColetaEstatisticas(coletar);
+    buffer_escrita.definirColetaEstatisticas(coletar);
+}
+
+bool Cache::getColetaEstatisticas() const
+{
+    return coletar_estatisticas;
+}
+
+void Cache::recarregarLinhasValidas()
+{
+    auto num_bits_offset = static_cast<uint32_t>(log2(tamanho_bloco));
+    auto num_bits_indice = static_cast<uint32_t>(log2(qtd_linhas));
+
+    for (uint32_t i = 0; i < qtd_linhas; ++i)
+    {
+        LinhaCache& linha = linhas[i];
+        if (!linha.valida)
+        {
+            continue;
+        }
+        uint32_t endereco_bloco = (linha.tag << (num_bits_offset + num_bits_indice)) | (i << num_bits_offset);
+        std::copy_n(memoria_principal.begin() + endereco_bloco, tamanho_bloco, linha.dados.begin());
+    }
+}
+
+EstadoLinhaCache Cache::getEstadoLinha(uint32_t indice) const
+{
+    const LinhaCache& linha = linhas[indice];
+    return {linha.valida, linha.tag, linha.acessos, linha.faltas};
+}
+
+void Cache::salvarEstado(ImagemCache& imagem) const
+{
+    imagem.valida.resize(qtd_linhas);
+    imagem.tags.resize(qtd_linhas);
+    imagem.acessos.resize(qtd_linhas);
+    imagem.faltas.resize(qtd_linhas);
+    imagem.dados.resize(static_cast<size_t>(qtd_linhas) * tamanho_bloco);
+    for (uint32_t i = 0; i < qtd_linhas; ++i)
+    {
+        const LinhaCache& linha = linhas[i];
+        imagem.valida[i] = linha.valida;
+        imagem.tags[i] = linha.tag;
+        imagem.acessos[i] = linha.acessos;
+        imagem.faltas[i] = linha.faltas;
+        std::copy(linha.dados.begin(), linha.dados.end(), imagem.dados.begin() + static_cast<size_t>(i) * tamanho_bloco);
+    }
+    imagem.estatisticas = estatisticas;
+    dram.salvarEstado(imagem.dram);
+    buffer_escrita.salvarEstado(imagem.buffer_escrita);
+}
+
+void Cache::restaurarEstado(const ImagemCache& imagem)
+{
+    for (uint32_t i = 0; i < qtd_linhas; ++i)
     {
-        linha.valida = false;
-        linha.tag = 0;
+        LinhaCache& linha = linhas[i];
+        linha.valida = imagem.valida[i] != 0;
+        linha.tag = imagem.tags[i];
+        linha.acessos = imagem.acessos[i];
+        linha.faltas = imagem.faltas[i];
+        auto inicio = imagem.dados.begin() + static_cast<size_t>(i) * tamanho_bloco;
+        std::copy(inicio, inicio + tamanho_bloco, linha.dados.begin());
+        marcarAlteracao(i);
     }
+    estatisticas = imagem.estatisticas;
+    dram.restaurarEstado(imagem.dram);
+    buffer_escrita.restaurarEstado(imagem.buffer_escrita);
+}
+
+void Cache::marcarAlteracao(uint32_t indice)
+{
+    if (!linhas[indice].alterada)
+    {
+        linhas[indice].alterada = true;
+        alteracoes.push_back(indice);
+    }
+}
+
+void Cache::consumirAlteracoes(std::vector<uint32_t>& indices)
+{
+    indices.assign(alteracoes.begin(), alteracoes.end());
+    for (uint32_t indice : alteracoes)
+    {
+        linhas[indice].alterada = false;
+    }
+    alteracoes.clear();
 }
 
 uint32_t Cache::lerDados(uint32_t endereco)
@@ -41,16 +199,58 @@ uint32_t Cache::lerDados(uint32_t endereco)
 
     LinhaCache& linha = linhas[indice];
 
+    marcarAlteracao(indice);
+    if (coletar_estatisticas)
+    {
+        estatisticas.leituras++;
+        linha.acessos++;
+    }
 
     // Verifica se é um hit ou miss, se encontrou ou não o dado válido na cache com a tag correta
     if (linha.valida && linha.tag == tag)
     {
+        if (coletar_estatisticas)
+        {
+            estatisticas.acertos_leitura++;
+        }
     }
     else
     {
         // usa operadores bitwise para encontrar o inicio do bloco
         uint32_t endereco_inicio_bloco = endereco & ~(tamanho_bloco - 1);
 
+        if (coletar_estatisticas)
+        {
+            estatisticas.faltas_leitura++;
+            linha.faltas++;
+        }
+
+        // Escritas pendentes no bloco: os bytes podem vir do buffer, senão ele é drenado antes da leitura
+        uint32_t latencia = 0;
+        EncaminhamentoBuffer encaminhamento = buffer_escrita.consultarLeitura(endereco, 4, latencia);
+        // Com o bloco inteiro no buffer, a linha é preenchida sem esperar a DRAM (da RAM, que já tem
+        // os bytes escritos: o buffer só modela a temporização). Com só os bytes pedidos, a leitura
+        // é atendida pelo buffer e a linha não é alocada, porque o resto do bloco viria da DRAM
+        // A DRAM avança mesmo sem coleta, para que o aquecimento deixe as linhas dos bancos abertas
+        if (encaminhamento == EncaminhamentoBuffer::Nenhum || encaminhamento == EncaminhamentoBuffer::Conflito)
+        {
+            latencia += dram.ler(endereco_inicio_bloco);
+        }
+        if (coletar_estatisticas)
+        {
+            estatisticas.ciclos_parados += latencia;
+        }
+
+        if (encaminhamento == EncaminhamentoBuffer::Palavra)
+        {
+            uint32_t valor = 0;
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                valor |= static_cast<uint32_t>(memoria_principal[endereco + i]) << (8 * i);
+            }
+            return valor;
+        }
+
         for (uint32_t i = 0; i < tamanho_bloco; ++i)
         {
             linha.dados[i] = memoria_principal[endereco_inicio_bloco + i];
@@ -73,15 +273,21 @@ uint32_t Cache::lerDados(uint32_t endereco)
     return valor;
 }
 
-void Cache::escreverDados(uint32_t endereco, uint32_t valor)
+void Cache::escreverDados(uint32_t endereco, uint32_t valor, uint32_t tamanho)
 {
     // Política Write-Through: Escrever sempre na Memória Principal
 
-    // Desmonta o valor de 32 bits em 4 bytes e os escreve na memória principal
-    memoria_principal[endereco + 0] = (valor >> 0) & 0xFF;
-    memoria_principal[endereco + 1] = (valor >> 8) & 0xFF;
-    memoria_principal[endereco + 2] = (valor >> 16) & 0xFF;
-    memoria_principal[endereco + 3] = (valor >> 24) & 0xFF;
+    // Desmonta o valor em bytes e os escreve na memória principal
+    for (uint32_t i = 0; i < tamanho; ++i)
+    {
+        memoria_principal[endereco + i] = (valor >> (8 * i)) & 0xFF;
+    }
+    // O Core só para se o buffer de escrita estiver cheio e a DRAM não aceitar a entrada mais antiga
+    uint32_t espera = buffer_escrita.escrever(endereco, tamanho);
+    if (coletar_estatisticas)
+    {
+        estatisticas.ciclos_parados += espera;
+    }
 
     auto num_bits_offset = static_cast<uint32_t>(log2(tamanho_bloco));
     auto num_bits_indice = static_cast<uint32_t>(log2(qtd_linhas));
@@ -91,17 +297,56 @@ void Cache::escreverDados(uint32_t endereco, uint32_t valor)
 
     LinhaCache& linha = linhas[indice];
 
+    marcarAlteracao(indice);
+    if (coletar_estatisticas)
+    {
+        estatisticas.escritas++;
+        linha.acessos++;
+    }
 
     // Apenas se for um HIT, também atualiza o valor no cache.
     if (linha.valida && linha.tag == tag)
     {
+        if (coletar_estatisticas)
+        {
+            estatisticas.acertos_escrita++;
+        }
+
         // O bloco está no cache, então atualiza o valor aqui também.
         uint32_t offset = endereco & (tamanho_bloco - 1);
 
-        linha.dados[offset + 0] = (valor >> 0) & 0xFF;
-        linha.dados[offset + 1] = (valor >> 8) & 0xFF;
-        linha.dados[offset + 2] = (valor >> 16) & 0xFF;
-        linha.dados[offset + 3] = (valor >> 24) & 0xFF;
+        for (uint32_t i = 0; i < tamanho; ++i)
+        {
+            linha.dados[offset + i] = (valor >> (8 * i)) & 0xFF;
+        }
+    }
+    else if (coletar_estatisticas)
+    {
+        estatisticas.faltas_escrita++;
+        linha.faltas++;
     }
     // Política No-Write-Allocate: Se o dado não está no cache nós NÃO o trazemos para o cache. Simplesmente não fazemos nada.
 }
+
+void Cache::sincronizarComMemoria(uint32_t endereco, uint32_t tamanho)
+{
+    auto num_bits_offset = static_cast<uint32_t>(log2(tamanho_bloco));
+    auto num_bits_indice = static_cast<uint32_t>(log2(qtd_linhas));
+
+    uint64_t fim = static_cast<uint64_t>(endereco) + tamanho;
+    for (uint64_t bloco = endereco & ~(tamanho_bloco - 1); bloco < fim; bloco += tamanho_bloco)
+    {
+        auto endereco_bloco = static_cast<uint32_t>(bloco);
+        uint32_t indice = (endereco_bloco >> num_bits_offset) & (qtd_linhas - 1);
+        uint32_t tag = endereco_bloco >> (num_bits_offset + num_bits_indice);
+
+        LinhaCache& linha = linhas[indice];
+        if (linha.valida && linha.tag == tag)
+        {
+            for (uint32_t i = 0; i < tamanho_bloco; ++i)
+            {
+                linha.dados[i] = memoria_principal[endereco_bloco + i];
+            }
+        }
+    }
+}
@@ -1,9 +1,50 @@
 #ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_CACHE_H
 #define SIMULADOR_DE_PROCESSADOR_RISC_V_CACHE_H
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
+#include "BufferEscrita.h"
+#include "MemoriaDram.h"
+
+// Contadores de eventos do cache (acumulados desde o último reset)
+struct EstatisticasCache
+{
+    uint64_t leituras = 0;
+    uint64_t acertos_leitura = 0;
+    uint64_t faltas_leitura = 0;
+    uint64_t escritas = 0;
+    uint64_t acertos_escrita = 0;
+    uint64_t faltas_escrita = 0;
+    // Ciclos gastos esperando a memória principal (faltas de leitura e buffer de escrita cheio)
+    uint64_t ciclos_parados = 0;
+};
+
+// Estado de uma linha para visualização (contadores acumulados desde o último reset)
+struct EstadoLinhaCache
+{
+    bool valida = false;
+    uint32_t tag = 0;
+    uint32_t acessos = 0;
+    uint32_t faltas = 0;
+};
+
+// Cópia do conteúdo de todas as linhas e das estatísticas (usada pelos snapshots do Core)
+struct ImagemCache
+{
+    std::vector<uint8_t> valida;
+    std::vector<uint32_t> tags;
+    std::vector<uint32_t> acessos;
+    std::vector<uint32_t> faltas;
+    // Blocos de todas as linhas, em sequência
+    std::vector<uint8_t> dados;
+    EstatisticasCache estatisticas;
+    ImagemDram dram;
+    ImagemBufferEscrita buffer_escrita;
+};
+
 class Cache
 {
 public:
@@ -11,7 +52,39 @@ public:
 
     void reset();
     uint32_t lerDados(uint32_t endereco);
-    void escreverDados(uint32_t endereco, uint32_t valor);
+    // Escreve 'tamanho' bytes (1, 2 ou 4) sem cruzar o limite de uma palavra
+    void escreverDados(uint32_t endereco, uint32_t valor, uint32_t tamanho = 4);
+    // Atualiza as linhas válidas depois de escritas feitas direto na memória principal
+    void sincronizarComMemoria(uint32_t endereco, uint32_t tamanho);
+
+    const EstatisticasCache& getEstatisticas() const;
+
+    // A memória principal: as faltas de leitura esperam a latência calculada pela DRAM, e
+    // as escritas (write-through) passam pelo buffer de escrita antes da fila do controlador
+    std::string configurarDram(const ConfigDram& config);
+    const ConfigDram& getConfigDram() const;
+    const EstatisticasDram& getEstatisticasDram() const;
+    std::string configurarBufferEscrita(const ConfigBufferEscrita& config);
+    const ConfigBufferEscrita& getConfigBufferEscrita() const;
+    const EstatisticasBufferEscrita& getEstatisticasBufferEscrita() const;
+    // Passa 'ciclos' ciclos sem acessos à memória (o buffer e a DRAM atendem as escritas pendentes)
+    void avancarCiclos(uint64_t ciclos);
+
+    uint32_t getQuantidadeLinhas() const;
+    EstadoLinhaCache getEstadoLinha(uint32_t indice) const;
+    // Registro de alterações: devolve (sem repetir) os índices das linhas que mudaram desde a última chamada
+    void consumirAlteracoes(std::vector<uint32_t>& indices);
+
+    // Sem coleta (aquecimento), as linhas são preenchidas normalmente, mas as estatísticas,
+    // os contadores por linha e os ciclos parados não mudam
+    void definirColetaEstatisticas(bool coletar);
+    bool getColetaEstatisticas() const;
+    // Recarrega da memória principal o bloco de cada linha válida (depois de escritas que não passaram pelo cache)
+    void recarregarLinhasValidas();
+
+    void salvarEstado(ImagemCache& imagem) const;
+    // A imagem deve vir de um cache com a mesma geometria
+    void restaurarEstado(const ImagemCache& imagem);
 
 private:
     struct LinhaCache
@@ -21,6 +94,11 @@ private:
         // ID para identificar o bloco de memória armazenado
         uint32_t tag = 0;
         std::vector<uint8_t> dados;
+        // Contadores por linha, para achar conjuntos disputados (faltas por conflito)
+        uint32_t acessos = 0;
+        uint32_t faltas = 0;
+        // Já está na lista de alterações ainda não consumidas
+        bool alterada = false;
 
         explicit LinhaCache(size_t tamanho_bloco) : dados(tamanho_bloco, 0)
         {
@@ -36,6 +114,16 @@ private:
 
     // O vetor que armazena todas as linhas do cache
     std::vector<LinhaCache> linhas;
+
+    EstatisticasCache estatisticas;
+    bool coletar_estatisticas = true;
+
+    MemoriaDram dram;
+    BufferEscrita buffer_escrita;
+
+    // Índices das linhas alteradas desde o último consumirAlteracoes() (no máximo um por linha)
+    std::vector<uint32_t> alteracoes;
+    void marcarAlteracao(uint32_t indice);
 };
 
 #endif //SIMULADOR_DE_PROCESSADOR_RISC_V_CACHE_H
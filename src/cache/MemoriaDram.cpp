@@ -0,0 +1,287 @@
+#include "MemoriaDram.h"
+#include <algorithm>
+#include <bit>
+
+MemoriaDram::MemoriaDram(const ConfigDram& config)
+{
+    configurar(config);
+}
+
+std::string MemoriaDram::validar(const ConfigDram& config)
+{
+    if (!std::has_single_bit(config.canais) || !std::has_single_bit(config.ranks) ||
+        !std::has_single_bit(config.bancos))
+    {
+        return "[ERRO] DRAM: canais, ranks e bancos devem ser potencias de 2.";
+    }
+    if (!std::has_single_bit(config.tamanho_linha) || config.tamanho_linha < 64)
+    {
+        return "[ERRO] DRAM: o tamanho da linha deve ser uma potencia de 2 de pelo menos 64 bytes.";
+    }
+    if (config.capacidade_fila == 0)
+    {
+        return "[ERRO] DRAM: a fila de requisicoes precisa de pelo menos uma posicao.";
+    }
+    return "";
+}
+
+void MemoriaDram::configurar(const ConfigDram& nova)
+{
+    config = nova;
+    bits_coluna = static_cast<uint32_t>(std::countr_zero(config.tamanho_linha));
+    bits_canal = static_cast<uint32_t>(std::countr_zero(config.canais));
+    bits_banco = static_cast<uint32_t>(std::countr_zero(config.bancos));
+    bits_rank = static_cast<uint32_t>(std::countr_zero(config.ranks));
+    bancos.assign(static_cast<size_t>(config.canais) * config.ranks * config.bancos, Banco{});
+    barramentos_livres.assign(config.canais, 0);
+    fila.reserve(config.capacidade_fila);
+    reset();
+}
+
+const ConfigDram& MemoriaDram::getConfig() const
+{
+    return config;
+}
+
+void MemoriaDram::reset()
+{
+    ciclo = 0;
+    std::fill(bancos.begin(), bancos.end(), Banco{});
+    std::fill(barramentos_livres.begin(), barramentos_livres.end(), 0);
+    fila.clear();
+    estatisticas = EstatisticasDram{};
+}
+
+void MemoriaDram::definirColetaEstatisticas(bool coletar)
+{
+    coletar_estatisticas = coletar;
+}
+
+const EstatisticasDram& MemoriaDram::getEstatisticas() const
+{
+    return estatisticas;
+}
+
+MemoriaDram::Requisicao MemoriaDram::decompor(uint32_t endereco, uint64_t chegada, bool escrita) const
+{
+    // linha | rank | banco | canal | coluna
+    uint32_t resto = endereco >> bits_coluna;
+    uint32_t canal = resto & (config.canais - 1);
+    resto >>= bits_canal;
+    uint32_t banco = resto & (config.bancos - 1);
+    resto >>= bits_banco;
+    uint32_t rank = resto & (config.ranks - 1);
+    resto >>= bits_rank;
+
+    Requisicao requisicao;
+    requisicao.endereco = endereco;
+    requisicao.chegada = chegada;
+    requisicao.escrita = escrita;
+    requisicao.canal = canal;
+    requisicao.banco = (canal * config.ranks + rank) * config.bancos + banco;
+    requisicao.linha = resto;
+    return requisicao;
+}
+
+size_t MemoriaDram::escolher() const
+{
+    // First-Ready: a mais antiga que acerta a linha aberta; senão, First-Come-First-Served
+    for (size_t i = 0; i < fila.size(); ++i)
+    {
+        if (bancos[fila[i].banco].linha_aberta == fila[i].linha)
+        {
+            return i;
+        }
+    }
+    return 0;
+}
+
+uint64_t MemoriaDram::inicioPrevisto(const Requisicao& requisicao) const
+{
+    return std::max(requisicao.chegada, bancos[requisicao.banco].livre_em);
+}
+
+uint64_t MemoriaDram::atender(size_t indice)
+{
+    Requisicao requisicao = fila[indice];
+    fila.erase(fila.begin() + static_cast<std::ptrdiff_t>(indice));
+    Banco& banco = bancos[requisicao.banco];
+
+    uint64_t inicio = inicioPrevisto(requisicao);
+    uint64_t acesso;
+    if (banco.linha_aberta == requisicao.linha)
+    {
+        acesso = config.tCAS;
+        if (coletar_estatisticas) estatisticas.acertos_linha++;
+    }
+    else if (banco.linha_aberta == LINHA_FECHADA)
+    {
+        acesso = static_cast<uint64_t>(config.tRCD) + config.tCAS;
+        if (coletar_estatisticas) estatisticas.linhas_fechadas++;
+    }
+    else
+    {
+        acesso = static_cast<uint64_t>(config.tRP) + config.tRCD + config.tCAS;
+        if (coletar_estatisticas) estatisticas.conflitos_linha++;
+    }
+    if (indice != 0 && coletar_estatisticas)
+    {
+        estatisticas.reordenacoes++;
+    }
+
+    // O bloco ocupa o barramento de dados do canal por tBurst ciclos
+    uint64_t& barramento = barramentos_livres[requisicao.canal];
+    uint64_t fim = std::max(inicio + acesso, barramento) + config.tBurst;
+    barramento = fim;
+
+    // Com a linha aberta, o próximo comando de coluna no banco sai tBurst ciclos depois deste
+    // (acertos seguidos formam um pipeline); a política fechada ainda espera o precharge
+    uint64_t comando_coluna = inicio + acesso - config.tCAS;
+    if (config.politica == PoliticaLinhaDram::Aberta)
+    {
+        banco.linha_aberta = requisicao.linha;
+        banco.livre_em = comando_coluna + config.tBurst;
+    }
+    else
+    {
+        banco.linha_aberta = LINHA_FECHADA;
+        banco.livre_em = comando_coluna + config.tBurst + config.tRP;
+    }
+    return fim;
+}
+
+void MemoriaDram::atenderPendentes()
+{
+    while (!fila.empty())
+    {
+        size_t indice = escolher();
+        if (inicioPrevisto(fila[indice]) > ciclo)
+        {
+            break;
+        }
+        atender(indice);
+    }
+}
+
+uint32_t MemoriaDram::esperarVaga()
+{
+    if (fila.size() < config.capacidade_fila)
+    {
+        return 0;
+    }
+    // A requisição sai da fila quando começa a ser atendida
+    size_t indice = escolher();
+    uint64_t inicio = inicioPrevisto(fila[indice]);
+    auto espera = static_cast<uint32_t>(inicio > ciclo ? inicio - ciclo : 0);
+    ciclo = std::max(ciclo, inicio);
+    atender(indice);
+    if (coletar_estatisticas)
+    {
+        estatisticas.paradas_fila_cheia++;
+        estatisticas.ciclos_fila_cheia += espera;
+    }
+    return espera;
+}
+
+uint32_t MemoriaDram::ler(uint32_t endereco)
+{
+    atenderPendentes();
+    uint32_t espera = esperarVaga();
+    if (coletar_estatisticas)
+    {
+        estatisticas.leituras++;
+    }
+
+    // O Core espera a leitura, então ela é a única na fila; as escritas pendentes podem
+    // passar na frente se acertarem a linha aberta
+    fila.push_back(decompor(endereco, ciclo, false));
+    uint64_t chegada = ciclo;
+    uint64_t fim = chegada;
+    while (!fila.empty())
+    {
+        size_t indice = escolher();
+        bool leitura = !fila[indice].escrita;
+        uint64_t termino = atender(indice);
+        if (leitura)
+        {
+            fim = termino;
+            break;
+        }
+    }
+
+    auto latencia = static_cast<uint32_t>(fim - chegada) + espera;
+    ciclo = fim;
+    if (coletar_estatisticas)
+    {
+        estatisticas.ciclos_leitura += latencia;
+        estatisticas.latencia_maxima_leitura = std::max<uint64_t>(estatisticas.latencia_maxima_leitura, latencia);
+    }
+    return latencia;
+}
+
+uint32_t MemoriaDram::escrever(uint32_t endereco)
+{
+    atenderPendentes();
+    uint32_t espera = esperarVaga();
+    if (coletar_estatisticas)
+    {
+        estatisticas.escritas++;
+    }
+    fila.push_back(decompor(endereco, ciclo, true));
+    return espera;
+}
+
+void MemoriaDram::avancar(uint64_t ciclos)
+{
+    ciclo += ciclos;
+    if (!fila.empty())
+    {
+        atenderPendentes();
+    }
+}
+
+uint32_t MemoriaDram::getVagasFila() const
+{
+    return config.capacidade_fila - static_cast<uint32_t>(fila.size());
+}
+
+void MemoriaDram::salvarEstado(ImagemDram& imagem) const
+{
+    imagem.ciclo = ciclo;
+    imagem.linhas_abertas.resize(bancos.size());
+    imagem.bancos_livres.resize(bancos.size());
+    for (size_t i = 0; i < bancos.size(); ++i)
+    {
+        imagem.linhas_abertas[i] = bancos[i].linha_aberta;
+        imagem.bancos_livres[i] = bancos[i].livre_em;
+    }
+    imagem.barramentos_livres = barramentos_livres;
+    imagem.fila.clear();
+    for (const Requisicao& requisicao : fila)
+    {
+        imagem.fila.push_back({requisicao.endereco, requisicao.chegada, requisicao.escrita});
+    }
+    imagem.estatisticas = estatisticas;
+}
+
+void MemoriaDram::restaurarEstado(const ImagemDram& imagem)
+{
+    reset();
+    if (imagem.linhas_abertas.size() != bancos.size() || imagem.bancos_livres.size() != bancos.size() ||
+        imagem.barramentos_livres.size() != barramentos_livres.size() || imagem.fila.size() > config.capacidade_fila)
+    {
+        return;
+    }
+    ciclo = imagem.ciclo;
+    for (size_t i = 0; i < bancos.size(); ++i)
+    {
+        bancos[i].linha_aberta = imagem.linhas_abertas[i];
+        bancos[i].livre_em = imagem.bancos_livres[i];
+    }
+    barramentos_livres = imagem.barramentos_livres;
+    for (const ImagemDram::Requisicao& requisicao : imagem.fila)
+    {
+        fila.push_back(decompor(requisicao.endereco, requisicao.chegada, requisicao.escrita));
+    }
+    estatisticas = imagem.estatisticas;
+}
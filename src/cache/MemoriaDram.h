@@ -0,0 +1,164 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_MEMORIADRAM_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_MEMORIADRAM_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Política do buffer de linha de cada banco
+enum class PoliticaLinhaDram : uint8_t
+{
+    // A linha fica aberta depois do acesso (acertos baratos, conflitos pagam o precharge)
+    Aberta,
+    // Precharge logo após cada acesso: toda requisição paga ativação + CAS
+    Fechada
+};
+
+// Geometria e temporização da DRAM; os tempos são em ciclos do Core
+struct ConfigDram
+{
+    uint32_t canais = 1;
+    uint32_t ranks = 1;
+    uint32_t bancos = 8;            // por rank
+    uint32_t tamanho_linha = 2048;  // bytes do buffer de linha (row buffer)
+    PoliticaLinhaDram politica = PoliticaLinhaDram::Aberta;
+    uint32_t tRCD = 14;             // ativação da linha até o comando de coluna
+    uint32_t tRP = 14;              // precharge (fechar a linha aberta)
+    uint32_t tCAS = 14;             // comando de coluna até o primeiro dado
+    uint32_t tBurst = 4;            // ocupação do barramento de dados do canal por bloco
+    uint32_t capacidade_fila = 16;  // requisições pendentes no controlador
+};
+
+// Contadores da DRAM (acumulados desde o último reset)
+struct EstatisticasDram
+{
+    uint64_t leituras = 0;
+    uint64_t escritas = 0;
+    // Classificação de cada requisição atendida pelo estado do banco
+    uint64_t acertos_linha = 0;
+    uint64_t linhas_fechadas = 0;
+    uint64_t conflitos_linha = 0;
+    // Requisições atendidas antes de uma mais antiga por acertarem a linha aberta (FR-FCFS)
+    uint64_t reordenacoes = 0;
+    // Latência das leituras (da chegada ao último dado), em ciclos
+    uint64_t ciclos_leitura = 0;
+    uint64_t latencia_maxima_leitura = 0;
+    // Requisições que encontraram a fila cheia e os ciclos esperando por uma vaga
+    uint64_t paradas_fila_cheia = 0;
+    uint64_t ciclos_fila_cheia = 0;
+};
+
+// Estado completo da DRAM (usado pelos snapshots do Core através da ImagemCache)
+struct ImagemDram
+{
+    struct Requisicao
+    {
+        uint32_t endereco = 0;
+        uint64_t chegada = 0;
+        bool escrita = false;
+    };
+
+    uint64_t ciclo = 0;
+    // Por banco (canal, rank, banco): linha aberta (ou LINHA_FECHADA) e ciclo em que fica livre
+    std::vector<uint32_t> linhas_abertas;
+    std::vector<uint64_t> bancos_livres;
+    // Por canal: ciclo em que o barramento de dados fica livre
+    std::vector<uint64_t> barramentos_livres;
+    std::vector<Requisicao> fila;
+    EstatisticasDram estatisticas;
+};
+
+/**
+ * @class MemoriaDram
+ * @brief Modelo de temporização da memória principal, consultado nas faltas e escritas do cache.
+ *
+ * Os dados continuam na RAM do Core; aqui só se calcula quanto cada acesso custa. Cada
+ * requisição (um bloco do cache) é mapeada em canal, rank, banco e linha, com o endereço
+ * dividido como linha | rank | banco | canal | coluna. O controlador guarda as requisições
+ * numa fila e as atende na ordem FR-FCFS: primeiro a mais antiga que acerta a linha aberta
+ * do seu banco, senão a mais antiga de todas.
+ *
+ * As escritas (do cache write-through, via buffer de escrita) entram na fila sem parar o
+ * Core, que só espera se a fila estiver cheia; elas são atendidas em segundo plano conforme
+ * o tempo avança. Uma leitura espera até ser atendida e devolve a latência, incluindo a
+ * disputa com as escritas pendentes. O tempo é contado em ciclos do Core: o próprio modelo
+ * avança até o fim das esperas, e avancar() soma os ciclos em que o Core não esperou a memória.
+ */
+class MemoriaDram
+{
+public:
+    // Marca de banco sem linha aberta (em ImagemDram::linhas_abertas)
+    static constexpr uint32_t LINHA_FECHADA = UINT32_MAX;
+
+    explicit MemoriaDram(const ConfigDram& config = ConfigDram{});
+
+    // Valida a configuração (potências de 2, fila não vazia); retorna uma mensagem de erro ou string vazia
+    static std::string validar(const ConfigDram& config);
+    // A configuração deve ter passado por validar(); o estado e as estatísticas são zerados
+    void configurar(const ConfigDram& config);
+    const ConfigDram& getConfig() const;
+
+    void reset();
+    // Leitura de um bloco: espera o atendimento e devolve a latência em ciclos
+    uint32_t ler(uint32_t endereco);
+    // Escrita de um bloco: entra na fila; devolve os ciclos parados esperando vaga (0 se havia)
+    uint32_t escrever(uint32_t endereco);
+    // Passa 'ciclos' ciclos do Core, atendendo as requisições que já podem começar
+    void avancar(uint64_t ciclos);
+    // Requisições que ainda cabem na fila sem parar o Core
+    uint32_t getVagasFila() const;
+
+    // Sem coleta (aquecimento), o estado dos bancos muda normalmente, mas as estatísticas não
+    void definirColetaEstatisticas(bool coletar);
+    const EstatisticasDram& getEstatisticas() const;
+
+    void salvarEstado(ImagemDram& imagem) const;
+    // Uma imagem vazia ou de outra geometria (ex.: checkpoint antigo) deixa o modelo zerado
+    void restaurarEstado(const ImagemDram& imagem);
+
+private:
+    struct Banco
+    {
+        uint32_t linha_aberta = LINHA_FECHADA;
+        uint64_t livre_em = 0;
+    };
+
+    struct Requisicao
+    {
+        uint32_t endereco = 0;
+        uint64_t chegada = 0;
+        bool escrita = false;
+        // Decomposição do endereço
+        uint32_t canal = 0;
+        uint32_t banco = 0;   // índice global em 'bancos'
+        uint32_t linha = 0;
+    };
+
+    ConfigDram config;
+    uint32_t bits_coluna = 0;
+    uint32_t bits_canal = 0;
+    uint32_t bits_banco = 0;
+    uint32_t bits_rank = 0;
+
+    uint64_t ciclo = 0;
+    std::vector<Banco> bancos;
+    std::vector<uint64_t> barramentos_livres;
+    // Em ordem de chegada
+    std::vector<Requisicao> fila;
+
+    EstatisticasDram estatisticas;
+    bool coletar_estatisticas = true;
+
+    Requisicao decompor(uint32_t endereco, uint64_t chegada, bool escrita) const;
+    // Índice em 'fila' da próxima requisição pela ordem FR-FCFS
+    size_t escolher() const;
+    uint64_t inicioPrevisto(const Requisicao& requisicao) const;
+    // Atende fila[indice], retira-a da fila e devolve o ciclo do último dado
+    uint64_t atender(size_t indice);
+    // Atende as requisições que começam até o ciclo atual
+    void atenderPendentes();
+    // Garante uma vaga na fila, avançando o tempo se preciso; devolve os ciclos esperados
+    uint32_t esperarVaga();
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_MEMORIADRAM_H
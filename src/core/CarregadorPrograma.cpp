@@ -0,0 +1,46 @@
+#include "CarregadorPrograma.h"
+
+#include <fstream>
+#include <sstream>
+
+std::string ler_programa_hex(const std::string &caminho, std::vector<uint32_t> &programa) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o arquivo: " + caminho;
+    }
+
+    programa.clear();
+    std::string linha;
+    int numero_linha = 0;
+    while (std::getline(arquivo, linha)) {
+        numero_linha++;
+
+        // Remove espaços nas pontas (equivalente ao trimmed() da GUI)
+        size_t inicio = linha.find_first_not_of(" \t\r\n");
+        if (inicio == std::string::npos) continue;
+        size_t fim = linha.find_last_not_of(" \t\r\n");
+        linha = linha.substr(inicio, fim - inicio + 1);
+
+        if (linha[0] == '#' || linha.rfind("//", 0) == 0) continue;
+
+        // Base 0 autodetecta "0x" (hex) e decimal, como QString::toUInt(&ok, 0)
+        size_t consumidos = 0;
+        unsigned long valor = 0;
+        try {
+            valor = std::stoul(linha, &consumidos, 0);
+        } catch (const std::exception&) {
+            consumidos = 0;
+        }
+        if (consumidos != linha.size() || valor > 0xFFFFFFFFul) {
+            std::stringstream ss;
+            ss << "Erro ao ler o arquivo na linha " << numero_linha << ": \"" << linha
+               << "\" nao e um numero hexadecimal valido.";
+            return ss.str();
+        }
+
+        programa.push_back(static_cast<uint32_t>(valor));
+    }
+
+    programa.push_back(0x00000000);
+    return "";
+}
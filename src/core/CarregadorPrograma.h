@@ -0,0 +1,17 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_CARREGADORPROGRAMA_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_CARREGADORPROGRAMA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Lê um programa no formato texto usado pela GUI: uma instrução por linha,
+ * em hexadecimal (0x...) ou decimal, ignorando linhas vazias e comentários (# ou //).
+ *
+ * Acrescenta a instrução nula no final, como a MainWindow faz.
+ * Retorna uma mensagem de erro, ou string vazia em caso de sucesso.
+ */
+std::string ler_programa_hex(const std::string& caminho, std::vector<uint32_t>& programa);
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_CARREGADORPROGRAMA_H
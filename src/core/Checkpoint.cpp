@@ -0,0 +1,607 @@
+#include "Checkpoint.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef SIMULADOR_COM_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+    constexpr char MAGICO[4] = {'R', 'V', 'C', 'K'};
+
+    void escrever_u8(std::vector<uint8_t>& saida, uint8_t valor) {
+        saida.push_back(valor);
+    }
+
+    void escrever_u32(std::vector<uint8_t>& saida, uint32_t valor) {
+        for (int i = 0; i < 4; ++i) saida.push_back(static_cast<uint8_t>(valor >> (8 * i)));
+    }
+
+    void escrever_u64(std::vector<uint8_t>& saida, uint64_t valor) {
+        for (int i = 0; i < 8; ++i) saida.push_back(static_cast<uint8_t>(valor >> (8 * i)));
+    }
+
+    // Leitura sequencial com verificação de limites: depois de um erro, todas as leituras falham
+    struct Cursor {
+        const uint8_t* p;
+        const uint8_t* fim;
+        bool ok = true;
+
+        bool ler(void* destino, size_t tamanho) {
+            if (!ok || static_cast<size_t>(fim - p) < tamanho) {
+                ok = false;
+                return false;
+            }
+            std::memcpy(destino, p, tamanho);
+            p += tamanho;
+            return true;
+        }
+
+        uint8_t u8() {
+            uint8_t valor = 0;
+            ler(&valor, 1);
+            return valor;
+        }
+
+        uint32_t u32() {
+            uint8_t bytes[4] = {};
+            ler(bytes, 4);
+            uint32_t valor = 0;
+            for (int i = 0; i < 4; ++i) valor |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+            return valor;
+        }
+
+        uint64_t u64() {
+            uint8_t bytes[8] = {};
+            ler(bytes, 8);
+            uint64_t valor = 0;
+            for (int i = 0; i < 8; ++i) valor |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            return valor;
+        }
+    };
+
+    void escrever_contadores(std::vector<uint8_t>& saida, const ContadoresCore& c) {
+        for (uint64_t valor : {c.ciclos, c.instrucoes, c.loads, c.stores, c.desvios, c.desvios_tomados,
+                               c.saltos, c.multiplicacoes, c.divisoes}) {
+            escrever_u64(saida, valor);
+        }
+    }
+
+    void ler_contadores(Cursor& cursor, ContadoresCore& c) {
+        for (uint64_t* valor : {&c.ciclos, &c.instrucoes, &c.loads, &c.stores, &c.desvios, &c.desvios_tomados,
+                                &c.saltos, &c.multiplicacoes, &c.divisoes}) {
+            *valor = cursor.u64();
+        }
+    }
+
+    void escrever_estatisticas(std::vector<uint8_t>& saida, const EstatisticasCache& e) {
+        for (uint64_t valor : {e.leituras, e.acertos_leitura, e.faltas_leitura, e.escritas, e.acertos_escrita,
+                               e.faltas_escrita, e.ciclos_parados}) {
+            escrever_u64(saida, valor);
+        }
+    }
+
+    void ler_estatisticas(Cursor& cursor, EstatisticasCache& e) {
+        for (uint64_t* valor : {&e.leituras, &e.acertos_leitura, &e.faltas_leitura, &e.escritas,
+                                &e.acertos_escrita, &e.faltas_escrita, &e.ciclos_parados}) {
+            *valor = cursor.u64();
+        }
+    }
+
+    void escrever_dram(std::vector<uint8_t>& saida, const ImagemDram& d) {
+        escrever_u64(saida, d.ciclo);
+        escrever_u32(saida, static_cast<uint32_t>(d.linhas_abertas.size()));
+        for (size_t i = 0; i < d.linhas_abertas.size(); ++i) {
+            escrever_u32(saida, d.linhas_abertas[i]);
+            escrever_u64(saida, d.bancos_livres[i]);
+        }
+        escrever_u32(saida, static_cast<uint32_t>(d.barramentos_livres.size()));
+        for (uint64_t livre : d.barramentos_livres) escrever_u64(saida, livre);
+        escrever_u32(saida, static_cast<uint32_t>(d.fila.size()));
+        for (const ImagemDram::Requisicao& r : d.fila) {
+            escrever_u32(saida, r.endereco);
+            escrever_u64(saida, r.chegada);
+            escrever_u8(saida, r.escrita ? 1 : 0);
+        }
+        const EstatisticasDram& e = d.estatisticas;
+        for (uint64_t valor : {e.leituras, e.escritas, e.acertos_linha, e.linhas_fechadas, e.conflitos_linha,
+                               e.reordenacoes, e.ciclos_leitura, e.latencia_maxima_leitura, e.paradas_fila_cheia,
+                               e.ciclos_fila_cheia}) {
+            escrever_u64(saida, valor);
+        }
+    }
+
+    // Os tamanhos são conferidos contra o que resta do arquivo antes de alocar
+    void ler_dram(Cursor& cursor, ImagemDram& d) {
+        d.ciclo = cursor.u64();
+        uint32_t bancos = cursor.u32();
+        if (!cursor.ok || static_cast<uint64_t>(bancos) * 12 > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        d.linhas_abertas.resize(bancos);
+        d.bancos_livres.resize(bancos);
+        for (uint32_t i = 0; i < bancos; ++i) {
+            d.linhas_abertas[i] = cursor.u32();
+            d.bancos_livres[i] = cursor.u64();
+        }
+        uint32_t canais = cursor.u32();
+        if (!cursor.ok || static_cast<uint64_t>(canais) * 8 > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        d.barramentos_livres.resize(canais);
+        for (uint64_t& livre : d.barramentos_livres) livre = cursor.u64();
+        uint32_t pendentes = cursor.u32();
+        if (!cursor.ok || static_cast<uint64_t>(pendentes) * 13 > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        d.fila.resize(pendentes);
+        for (ImagemDram::Requisicao& r : d.fila) {
+            r.endereco = cursor.u32();
+            r.chegada = cursor.u64();
+            r.escrita = cursor.u8() != 0;
+        }
+        EstatisticasDram& e = d.estatisticas;
+        for (uint64_t* valor : {&e.leituras, &e.escritas, &e.acertos_linha, &e.linhas_fechadas, &e.conflitos_linha,
+                                &e.reordenacoes, &e.ciclos_leitura, &e.latencia_maxima_leitura,
+                                &e.paradas_fila_cheia, &e.ciclos_fila_cheia}) {
+            *valor = cursor.u64();
+        }
+    }
+
+    void escrever_buffer_escrita(std::vector<uint8_t>& saida, const ImagemBufferEscrita& b) {
+        escrever_u32(saida, static_cast<uint32_t>(b.entradas.size()));
+        for (const EntradaBufferEscrita& entrada : b.entradas) {
+            escrever_u32(saida, entrada.bloco);
+            escrever_u64(saida, entrada.mascara);
+        }
+        const EstatisticasBufferEscrita& e = b.estatisticas;
+        for (uint64_t valor : {e.escritas, e.combinadas, e.drenagens, e.paradas_cheio, e.ciclos_parados_cheio,
+                               e.encaminhamentos, e.conflitos_leitura, e.ocupacao_acumulada, e.ciclos,
+                               e.ocupacao_maxima}) {
+            escrever_u64(saida, valor);
+        }
+    }
+
+    void ler_buffer_escrita(Cursor& cursor, ImagemBufferEscrita& b) {
+        uint32_t quantidade = cursor.u32();
+        if (!cursor.ok || static_cast<uint64_t>(quantidade) * 12 > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        b.entradas.resize(quantidade);
+        for (EntradaBufferEscrita& entrada : b.entradas) {
+            entrada.bloco = cursor.u32();
+            entrada.mascara = cursor.u64();
+        }
+        EstatisticasBufferEscrita& e = b.estatisticas;
+        for (uint64_t* valor : {&e.escritas, &e.combinadas, &e.drenagens, &e.paradas_cheio, &e.ciclos_parados_cheio,
+                                &e.encaminhamentos, &e.conflitos_leitura, &e.ocupacao_acumulada, &e.ciclos,
+                                &e.ocupacao_maxima}) {
+            *valor = cursor.u64();
+        }
+    }
+
+    // CLINT e UART; os FIFOs da UART vão com o tamanho na frente
+    void escrever_dispositivos(std::vector<uint8_t>& saida, const ImagemClint& clint, const ImagemUart& uart) {
+        escrever_u64(saida, clint.deslocamento_mtime);
+        escrever_u64(saida, clint.mtimecmp);
+        escrever_u32(saida, clint.msip);
+        escrever_u32(saida, static_cast<uint32_t>(uart.entrada.size()));
+        saida.insert(saida.end(), uart.entrada.begin(), uart.entrada.end());
+        escrever_u32(saida, static_cast<uint32_t>(uart.saida.size()));
+        saida.insert(saida.end(), uart.saida.begin(), uart.saida.end());
+    }
+
+    void ler_dispositivos(Cursor& cursor, ImagemClint& clint, ImagemUart& uart) {
+        clint.deslocamento_mtime = cursor.u64();
+        clint.mtimecmp = cursor.u64();
+        clint.msip = cursor.u32();
+        uint32_t entrada = cursor.u32();
+        if (!cursor.ok || entrada > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        uart.entrada.resize(entrada);
+        cursor.ler(uart.entrada.data(), entrada);
+        uint32_t saida = cursor.u32();
+        if (!cursor.ok || saida > static_cast<uint64_t>(cursor.fim - cursor.p)) {
+            cursor.ok = false;
+            return;
+        }
+        uart.saida.resize(saida);
+        cursor.ler(uart.saida.data(), saida);
+    }
+
+    bool pagina_zerada(const PaginaMemoria& pagina) {
+        return std::all_of(pagina.begin(), pagina.end(), [](uint8_t byte) { return byte == 0; });
+    }
+
+    // Arquivo inteiro visível como um bloco de bytes: mapeado com mmap, ou lido para a memória
+    class ArquivoMapeado {
+    public:
+        ~ArquivoMapeado() {
+#ifndef _WIN32
+            if (mapa) munmap(mapa, tamanho);
+#endif
+        }
+
+        std::string abrir(const std::string& caminho) {
+#ifdef _WIN32
+            std::ifstream arquivo(caminho, std::ios::binary);
+            if (!arquivo) return "[ERRO] Nao foi possivel abrir o checkpoint: " + caminho;
+            copia.assign(std::istreambuf_iterator<char>(arquivo), std::istreambuf_iterator<char>());
+            dados = copia.data();
+            tamanho = copia.size();
+#else
+            int fd = open(caminho.c_str(), O_RDONLY);
+            if (fd < 0) return "[ERRO] Nao foi possivel abrir o checkpoint: " + caminho;
+            struct stat info {};
+            if (fstat(fd, &info) != 0 || info.st_size == 0) {
+                close(fd);
+                return "[ERRO] Checkpoint vazio ou ilegivel: " + caminho;
+            }
+            tamanho = static_cast<size_t>(info.st_size);
+            mapa = mmap(nullptr, tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (mapa == MAP_FAILED) {
+                mapa = nullptr;
+                return "[ERRO] Nao foi possivel mapear o checkpoint: " + caminho;
+            }
+            dados = static_cast<const uint8_t*>(mapa);
+#endif
+            return "";
+        }
+
+        const uint8_t* dados = nullptr;
+        size_t tamanho = 0;
+
+    private:
+#ifdef _WIN32
+        std::vector<uint8_t> copia;
+#else
+        void* mapa = nullptr;
+#endif
+    };
+}
+
+bool checkpoint::zstd_disponivel() {
+#ifdef SIMULADOR_COM_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+// --- GravadorCheckpoint ---
+
+GravadorCheckpoint::~GravadorCheckpoint() {
+    aguardar();
+}
+
+std::string GravadorCheckpoint::iniciar(const SnapshotCore &snapshot, const std::string &caminho,
+                                        checkpoint::Compressao compressao) {
+    aguardar();
+
+    if (!snapshot.memoria) {
+        return "[ERRO] Snapshot vazio.";
+    }
+    if (compressao == checkpoint::Compressao::Zstd && !checkpoint::zstd_disponivel()) {
+        return "[ERRO] Compressao zstd nao disponivel nesta compilacao.";
+    }
+
+    // A cópia compartilha as páginas do snapshot; nada é copiado da RAM aqui
+    this->snapshot = snapshot;
+    this->caminho = caminho;
+    this->compressao = compressao;
+    erro_escrita.clear();
+    bytes_escritos = 0;
+    paginas_escritas = 0;
+    concluido = false;
+    escritor = std::thread(&GravadorCheckpoint::gravar, this);
+    return "";
+}
+
+std::string GravadorCheckpoint::aguardar() {
+    if (escritor.joinable()) escritor.join();
+    // Solta as páginas: o snapshot gravado não precisa mais mantê-las vivas
+    snapshot = SnapshotCore{};
+    return erro_escrita;
+}
+
+bool GravadorCheckpoint::em_andamento() const {
+    return !concluido.load(std::memory_order_acquire);
+}
+
+uint64_t GravadorCheckpoint::get_bytes_escritos() const {
+    return bytes_escritos.load(std::memory_order_relaxed);
+}
+
+uint32_t GravadorCheckpoint::get_paginas_escritas() const {
+    return paginas_escritas.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Corpo da thread escritora: estado, cache, páginas (à medida que são comprimidas) e índice.
+ */
+void GravadorCheckpoint::gravar() {
+    std::FILE* arquivo = std::fopen(caminho.c_str(), "wb");
+    if (!arquivo) {
+        erro_escrita = "[ERRO] Nao foi possivel criar o checkpoint: " + caminho;
+        concluido = true;
+        return;
+    }
+
+    uint64_t posicao = 0;
+    auto escrever = [&](const uint8_t* dados, size_t tamanho) {
+        if (!erro_escrita.empty()) return;
+        if (tamanho > 0 && std::fwrite(dados, 1, tamanho, arquivo) != tamanho) {
+            erro_escrita = "[ERRO] Falha ao gravar o checkpoint.";
+            return;
+        }
+        posicao += tamanho;
+        bytes_escritos = posicao;
+    };
+
+    const std::vector<std::shared_ptr<const PaginaMemoria>>& paginas = snapshot.memoria->paginas;
+    std::vector<uint8_t> bytes;
+    bytes.insert(bytes.end(), MAGICO, MAGICO + 4);
+    escrever_u8(bytes, checkpoint::VERSAO);
+    escrever_u8(bytes, static_cast<uint8_t>(compressao));
+    escrever_u8(bytes, 0);
+    escrever_u8(bytes, 0);
+
+    uint64_t tamanho_memoria = 0;
+    for (const auto& pagina : paginas) tamanho_memoria += pagina->size();
+    escrever_u64(bytes, tamanho_memoria);
+    escrever_u32(bytes, Core::TAMANHO_PAGINA_BASE);
+    for (uint32_t valor : snapshot.registradores) escrever_u32(bytes, valor);
+    escrever_u32(bytes, snapshot.contador_programa);
+    escrever_u32(bytes, snapshot.fim_programa);
+    escrever_u8(bytes, snapshot.finalizado_por_exit ? 1 : 0);
+    escrever_u32(bytes, static_cast<uint32_t>(snapshot.codigo_saida));
+    escrever_u32(bytes, snapshot.mcountinhibit);
+    escrever_u32(bytes, snapshot.mscratch);
+    escrever_contadores(bytes, snapshot.contadores);
+    escrever_u64(bytes, snapshot.ciclos_parados_contabilizados);
+    escrever_u64(bytes, snapshot.ciclos_tempo);
+    for (const auto& hpm : snapshot.contadores_hpm) {
+        escrever_u32(bytes, static_cast<uint32_t>(hpm.evento));
+        escrever_u64(bytes, hpm.base);
+        escrever_u64(bytes, hpm.referencia);
+    }
+    escrever_u32(bytes, vetorial::VLENB);
+    escrever_u32(bytes, snapshot.vl);
+    escrever_u32(bytes, snapshot.vtype);
+    escrever_u32(bytes, snapshot.vstart);
+    escrever_u32(bytes, snapshot.vcsr);
+    bytes.insert(bytes.end(), snapshot.registradores_vetoriais.begin(), snapshot.registradores_vetoriais.end());
+
+    const ImagemCache& cache = snapshot.cache;
+    uint32_t linhas = static_cast<uint32_t>(cache.valida.size());
+    escrever_u32(bytes, linhas);
+    escrever_u32(bytes, linhas ? static_cast<uint32_t>(cache.dados.size() / linhas) : 0);
+    bytes.insert(bytes.end(), cache.valida.begin(), cache.valida.end());
+    for (uint32_t i = 0; i < linhas; ++i) {
+        escrever_u32(bytes, cache.tags[i]);
+        escrever_u32(bytes, cache.acessos[i]);
+        escrever_u32(bytes, cache.faltas[i]);
+    }
+    bytes.insert(bytes.end(), cache.dados.begin(), cache.dados.end());
+    escrever_estatisticas(bytes, cache.estatisticas);
+    escrever_dram(bytes, cache.dram);
+    escrever_buffer_escrita(bytes, cache.buffer_escrita);
+    escrever_dispositivos(bytes, snapshot.clint, snapshot.uart);
+    escrever(bytes.data(), bytes.size());
+
+    // Páginas: as inteiramente zeradas ficam de fora; o índice é montado enquanto elas são gravadas
+    std::vector<uint8_t> indice;
+    uint32_t presentes = 0;
+    std::vector<uint8_t> comprimido;
+    for (uint32_t numero = 0; numero < paginas.size() && erro_escrita.empty(); ++numero) {
+        const PaginaMemoria& pagina = *paginas[numero];
+        if (pagina_zerada(pagina)) continue;
+
+        const uint8_t* dados = pagina.data();
+        size_t tamanho = pagina.size();
+#ifdef SIMULADOR_COM_ZSTD
+        if (compressao == checkpoint::Compressao::Zstd) {
+            comprimido.resize(ZSTD_compressBound(pagina.size()));
+            size_t resultado = ZSTD_compress(comprimido.data(), comprimido.size(), pagina.data(), pagina.size(), 3);
+            if (ZSTD_isError(resultado)) {
+                erro_escrita = std::string("[ERRO] Falha na compressao do checkpoint: ") + ZSTD_getErrorName(resultado);
+                break;
+            }
+            // Se não comprimir, a página vai como está (o leitor reconhece pelo tamanho)
+            if (resultado < pagina.size()) {
+                dados = comprimido.data();
+                tamanho = resultado;
+            }
+        }
+#endif
+        escrever_u32(indice, numero);
+        escrever_u64(indice, posicao);
+        escrever_u32(indice, static_cast<uint32_t>(tamanho));
+        escrever(dados, tamanho);
+        ++presentes;
+        paginas_escritas = presentes;
+    }
+
+    uint64_t posicao_indice = posicao;
+    bytes.clear();
+    escrever_u32(bytes, presentes);
+    bytes.insert(bytes.end(), indice.begin(), indice.end());
+    escrever_u64(bytes, posicao_indice);
+    escrever(bytes.data(), bytes.size());
+
+    if (std::fclose(arquivo) != 0 && erro_escrita.empty()) {
+        erro_escrita = "[ERRO] Falha ao fechar o checkpoint.";
+    }
+    concluido.store(true, std::memory_order_release);
+}
+
+// --- Leitura ---
+
+std::string ler_checkpoint(const std::string &caminho, SnapshotCore &snapshot) {
+    ArquivoMapeado arquivo;
+    std::string erro = arquivo.abrir(caminho);
+    if (!erro.empty()) return erro;
+
+    Cursor cursor{arquivo.dados, arquivo.dados + arquivo.tamanho};
+    char magico[4] = {};
+    cursor.ler(magico, 4);
+    uint8_t versao = cursor.u8();
+    auto compressao = static_cast<checkpoint::Compressao>(cursor.u8());
+    cursor.u8();
+    cursor.u8();
+    if (!cursor.ok || std::memcmp(magico, MAGICO, 4) != 0) {
+        return "[ERRO] Arquivo nao e um checkpoint: " + caminho;
+    }
+    if (versao < 1 || versao > checkpoint::VERSAO) {
+        return "[ERRO] Versao de checkpoint nao suportada: " + std::to_string(versao);
+    }
+    if (compressao == checkpoint::Compressao::Zstd && !checkpoint::zstd_disponivel()) {
+        return "[ERRO] Checkpoint comprimido com zstd, sem suporte nesta compilacao.";
+    }
+
+    SnapshotCore lido;
+    uint64_t tamanho_memoria = cursor.u64();
+    uint32_t tamanho_pagina = cursor.u32();
+    if (tamanho_pagina != Core::TAMANHO_PAGINA_BASE) {
+        return "[ERRO] Checkpoint com tamanho de pagina diferente.";
+    }
+    if (!cursor.ok || tamanho_memoria == 0 || tamanho_memoria > checkpoint::TAMANHO_MAXIMO_MEMORIA) {
+        return "[ERRO] Tamanho de memoria invalido no checkpoint: " + std::to_string(tamanho_memoria);
+    }
+    for (uint32_t& valor : lido.registradores) valor = cursor.u32();
+    lido.contador_programa = cursor.u32();
+    lido.fim_programa = cursor.u32();
+    lido.finalizado_por_exit = cursor.u8() != 0;
+    lido.codigo_saida = static_cast<int32_t>(cursor.u32());
+    lido.mcountinhibit = cursor.u32();
+    lido.mscratch = cursor.u32();
+    ler_contadores(cursor, lido.contadores);
+    lido.ciclos_parados_contabilizados = cursor.u64();
+    // Antes da versão 5, 'time' vinha de mcycle
+    lido.ciclos_tempo = versao >= 5 ? cursor.u64() : lido.contadores.ciclos;
+    for (auto& hpm : lido.contadores_hpm) {
+        hpm.evento = static_cast<EventoHpm>(cursor.u32());
+        hpm.base = cursor.u64();
+        hpm.referencia = cursor.u64();
+    }
+    if (versao >= 2) {
+        uint32_t vlenb = cursor.u32();
+        if (cursor.ok && vlenb != vetorial::VLENB) {
+            return "[ERRO] Checkpoint com outro VLEN: " + caminho;
+        }
+        lido.vl = cursor.u32();
+        lido.vtype = cursor.u32();
+        lido.vstart = cursor.u32();
+        lido.vcsr = cursor.u32();
+        cursor.ler(lido.registradores_vetoriais.data(), lido.registradores_vetoriais.size());
+    }
+
+    ImagemCache& cache = lido.cache;
+    uint32_t linhas = cursor.u32();
+    uint32_t tamanho_bloco = cursor.u32();
+    if (!cursor.ok || static_cast<uint64_t>(linhas) * (13 + tamanho_bloco) > arquivo.tamanho) {
+        return "[ERRO] Checkpoint truncado: " + caminho;
+    }
+    cache.valida.resize(linhas);
+    cache.tags.resize(linhas);
+    cache.acessos.resize(linhas);
+    cache.faltas.resize(linhas);
+    cache.dados.resize(static_cast<size_t>(linhas) * tamanho_bloco);
+    cursor.ler(cache.valida.data(), linhas);
+    for (uint32_t i = 0; i < linhas; ++i) {
+        cache.tags[i] = cursor.u32();
+        cache.acessos[i] = cursor.u32();
+        cache.faltas[i] = cursor.u32();
+    }
+    cursor.ler(cache.dados.data(), cache.dados.size());
+    ler_estatisticas(cursor, cache.estatisticas);
+    if (versao >= 3) {
+        ler_dram(cursor, cache.dram);
+    }
+    if (versao >= 4) {
+        ler_buffer_escrita(cursor, cache.buffer_escrita);
+    }
+    if (versao >= 6) {
+        ler_dispositivos(cursor, lido.clint, lido.uart);
+    }
+    if (!cursor.ok) {
+        return "[ERRO] Checkpoint truncado: " + caminho;
+    }
+
+    // Índice no fim do arquivo
+    Cursor rodape{arquivo.dados + arquivo.tamanho - std::min<size_t>(8, arquivo.tamanho),
+                 arquivo.dados + arquivo.tamanho};
+    uint64_t posicao_indice = rodape.u64();
+    if (!rodape.ok || posicao_indice >= arquivo.tamanho) {
+        return "[ERRO] Checkpoint truncado: " + caminho;
+    }
+    Cursor indice{arquivo.dados + posicao_indice, arquivo.dados + arquivo.tamanho - 8};
+    uint32_t presentes = indice.u32();
+
+    size_t quantidade = (tamanho_memoria + tamanho_pagina - 1) / tamanho_pagina;
+    if (!indice.ok || presentes > quantidade) {
+        return "[ERRO] Indice de paginas invalido no checkpoint: " + caminho;
+    }
+    auto imagem = std::make_shared<ImagemMemoria>();
+    imagem->paginas.resize(quantidade);
+
+    for (uint32_t i = 0; i < presentes; ++i) {
+        uint32_t numero = indice.u32();
+        uint64_t posicao = indice.u64();
+        uint32_t tamanho = indice.u32();
+        if (!indice.ok || numero >= quantidade || posicao + tamanho > posicao_indice) {
+            return "[ERRO] Indice de paginas invalido no checkpoint: " + caminho;
+        }
+
+        size_t tamanho_pagina_atual = std::min<uint64_t>(tamanho_pagina, tamanho_memoria - uint64_t(numero) * tamanho_pagina);
+        auto pagina = std::make_shared<PaginaMemoria>(tamanho_pagina_atual);
+        const uint8_t* origem = arquivo.dados + posicao;
+        if (tamanho == tamanho_pagina_atual) {
+            std::copy_n(origem, tamanho, pagina->begin());
+        } else {
+#ifdef SIMULADOR_COM_ZSTD
+            size_t resultado = ZSTD_decompress(pagina->data(), pagina->size(), origem, tamanho);
+            if (ZSTD_isError(resultado) || resultado != pagina->size()) {
+                return "[ERRO] Pagina corrompida no checkpoint: " + caminho;
+            }
+#else
+            return "[ERRO] Pagina comprimida no checkpoint, sem suporte a zstd nesta compilacao.";
+#endif
+        }
+        imagem->paginas[numero] = std::move(pagina);
+    }
+
+    // As páginas que não estão no arquivo são zeradas e compartilham a mesma cópia
+    std::shared_ptr<const PaginaMemoria> zerada;
+    for (size_t numero = 0; numero < quantidade; ++numero) {
+        if (imagem->paginas[numero]) continue;
+        size_t tamanho_pagina_atual = std::min<uint64_t>(tamanho_pagina, tamanho_memoria - uint64_t(numero) * tamanho_pagina);
+        if (!zerada || zerada->size() != tamanho_pagina_atual) {
+            zerada = std::make_shared<const PaginaMemoria>(tamanho_pagina_atual, 0);
+        }
+        imagem->paginas[numero] = zerada;
+    }
+
+    lido.memoria = std::move(imagem);
+    snapshot = std::move(lido);
+    return "";
+}
@@ -0,0 +1,95 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_CHECKPOINT_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_CHECKPOINT_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+#include "Core.h"
+#include "../bus/Dispositivos.h"
+
+/**
+ * Formato do checkpoint em disco (.rvck), todo em little-endian:
+ *
+ *   cabeçalho: "RVCK", versão (1 byte), compressão (1 byte), 2 bytes reservados
+ *   estado:    tamanho da RAM e da página, registradores, PC, contadores e CSRs de contagem
+ *              (desde a versão 5, com os ciclos decorridos que dão o 'time'); desde a versão 2,
+ *              também VLENB, vl, vtype, vstart, vcsr e os registradores vetoriais
+ *   cache:     geometria, as linhas (válida, tag, contadores, dados) e as estatísticas;
+ *              desde a versão 3, também o estado da DRAM (bancos, barramentos, fila e estatísticas)
+ *              e, desde a versão 4, o do buffer de escrita (entradas e estatísticas)
+ *   dispositivos: desde a versão 6, o CLINT (ajuste de mtime, mtimecmp, msip) e os FIFOs da UART
+ *   páginas:   só as páginas de RAM que não são inteiramente zero, comprimidas uma a uma
+ *   índice:    quantidade de páginas e, para cada uma, número, deslocamento e tamanho
+ *   final:     deslocamento do índice (8 bytes)
+ *
+ * O índice fica no fim para que as páginas possam ser escritas à medida que são
+ * comprimidas. Uma página cujo tamanho gravado é o da página está sem compressão.
+ */
+namespace checkpoint {
+    enum class Compressao : uint8_t {
+        Nenhuma = 0,
+        Zstd = 1
+    };
+
+    // A leitura também aceita as versões 1 (sem o estado da extensão V), 2 (sem a DRAM),
+    // 3 (sem o buffer de escrita), 4 (sem os ciclos decorridos) e 5 (sem o CLINT e a UART)
+    constexpr uint8_t VERSAO = 6;
+    constexpr size_t TAMANHO_CABECALHO = 8;
+    // A RAM começa em 0 e precisa caber abaixo do primeiro dispositivo do mapa
+    constexpr uint64_t TAMANHO_MAXIMO_MEMORIA = mapa::CLINT_BASE;
+
+    // Informa se o binário foi compilado com suporte a zstd
+    bool zstd_disponivel();
+}
+
+/**
+ * @class GravadorCheckpoint
+ * @brief Grava um SnapshotCore em disco a partir de uma thread de fundo.
+ *
+ * As páginas de um snapshot são imutáveis, então a simulação pode continuar
+ * (e escrever na RAM do Core) enquanto o checkpoint é comprimido e gravado.
+ */
+class GravadorCheckpoint {
+public:
+    GravadorCheckpoint() = default;
+    ~GravadorCheckpoint();
+
+    GravadorCheckpoint(const GravadorCheckpoint&) = delete;
+    GravadorCheckpoint& operator=(const GravadorCheckpoint&) = delete;
+
+    // Inicia a gravação; retorna uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string iniciar(const SnapshotCore& snapshot, const std::string& caminho,
+                        checkpoint::Compressao compressao = checkpoint::Compressao::Nenhuma);
+    // Espera a gravação terminar; retorna o erro de escrita, se houve
+    std::string aguardar();
+    bool em_andamento() const;
+
+    uint64_t get_bytes_escritos() const;
+    uint32_t get_paginas_escritas() const;
+
+private:
+    void gravar();
+
+    SnapshotCore snapshot;
+    std::string caminho;
+    checkpoint::Compressao compressao = checkpoint::Compressao::Nenhuma;
+    std::thread escritor;
+    std::atomic<bool> concluido{true};
+    std::string erro_escrita;
+
+    std::atomic<uint64_t> bytes_escritos{0};
+    std::atomic<uint32_t> paginas_escritas{0};
+};
+
+/**
+ * @brief Lê um checkpoint para um SnapshotCore, que depois é restaurado com Core::restaurar_snapshot().
+ *
+ * O arquivo é mapeado em memória (onde houver mmap) e só as páginas presentes no índice
+ * são descomprimidas; as ausentes compartilham uma única página zerada.
+ * Retorna uma mensagem de erro, ou string vazia em caso de sucesso.
+ */
+std::string ler_checkpoint(const std::string& caminho, SnapshotCore& snapshot);
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_CHECKPOINT_H
@@ -1,25 +1,464 @@
 #include "Core.h"
+#include "LogInstrucao.h"
+#include "../bus/Dispositivos.h"
+#include "../syscall/ProxySyscalls.h"
 
+#include <algorithm>
 #include <array>
+#include <cerrno>
+#include <deque>
 #include <iomanip>
 #include <limits>
 #include <ostream>
+#include <sstream>
 
-Core::Core(size_t tamanho_memoria) : memoria(tamanho_memoria, 0) {
+Core::Core(size_t tamanho_memoria) : memoria(tamanho_memoria, 0), barramento(memoria) {
     cache = std::make_unique<Cache>(4096, 16, memoria);
+    proxy_syscalls = std::make_unique<ProxySyscalls>();
+
+    // Dispositivos padrão; o disco é opcional e é adicionado por quem tiver uma imagem
+    auto novo_clint = std::make_unique<Clint>(ciclos_tempo);
+    auto nova_uart = std::make_unique<Uart>();
+    clint = novo_clint.get();
+    uart = nova_uart.get();
+    // A UART escreve no mesmo buffer do stdout das syscalls, que o entrega ao host em blocos
+    uart->definir_destino_saida([this](char c) { proxy_syscalls->escrever_saida(1, &c, 1); });
+    barramento.adicionar_dispositivo(mapa::CLINT_BASE, mapa::CLINT_TAMANHO, std::move(novo_clint));
+    barramento.adicionar_dispositivo(mapa::UART_BASE, mapa::UART_TAMANHO, std::move(nova_uart));
     reset();
 }
 
+// Uma instrução no anel de desfazer: o suficiente para voltar ao estado anterior a ela
+struct EntradaDesfazer {
+    uint32_t pc = 0;
+    uint32_t valor_rd = 0;      // valor anterior do registrador no campo rd
+    uint32_t endereco = 0;      // escrita na RAM (se tamanho != 0)
+    uint32_t dados = 0;         // bytes sobrescritos, em little-endian
+    uint8_t rd = 0;
+    uint8_t tamanho = 0;
+    uint8_t contou = 0;         // a instrução incrementou contadores.instrucoes
+};
+
+struct Core::EstadoReverso {
+    std::vector<EntradaDesfazer> anel;
+    size_t inicio = 0;          // entrada mais antiga
+    size_t quantidade = 0;
+    // Instruções registradas desde o começo do histórico atual (a posição presente)
+    uint64_t passo = 0;
+
+    uint64_t intervalo_snapshots = 0;
+    size_t maximo_snapshots = 0;
+    std::deque<std::pair<uint64_t, SnapshotCore>> snapshots;
+
+    // Instrução em andamento; 'barreira' marca um efeito que não pode ser desfeito
+    EntradaDesfazer atual;
+    uint64_t instrucoes_antes = 0;
+    bool barreira = false;
+};
+
+Core::~Core() = default;
+
 void Core::reset() {
     contador_programa = 0x0;
     for (unsigned int & registradore : registradores) {
         registradore = 0;
     }
     cache->reset();
+
+    contadores = ContadoresCore{};
+    ciclos_parados_contabilizados = 0;
+    ciclos_tempo = 0;
+    contadores_hpm.fill(ContadorHpm{});
+    mcountinhibit = 0;
+    mscratch = 0;
+
+    registradores_vetoriais.fill(0);
+    vl = 0;
+    vtype = vetorial::VTYPE_VILL;
+    vstart = 0;
+    vcsr = 0;
+
+    finalizado_por_exit = false;
+    codigo_saida = 0;
+    proxy_syscalls->reset();
+    clint->reset();
+    uart->reset();
+    if (reverso) descartar_historico_reverso();
+
+    contadores_detalhado = ContadoresDetalhado{};
+    for (GatilhoArmado& armado : gatilhos_modo) {
+        armado.disparado = false;
+    }
+    trocar_modo(modo_inicial);
+}
+
+void Core::marcar_imagem_base() {
+    imagem_base = capturar_memoria();
+    fim_programa_base = fim_programa;
+}
+
+/**
+ * @brief Volta a RAM para a imagem base e reseta o Core.
+ *
+ * O custo é proporcional às páginas escritas desde a marcação (ou a última restauração),
+ * não ao tamanho da memória. Sem imagem base, equivale a reset().
+ */
+void Core::restaurar_imagem_base() {
+    if (imagem_base) {
+        restaurar_memoria(imagem_base);
+        fim_programa = fim_programa_base;
+    }
+    reset();
+}
+
+bool Core::tem_imagem_base() const {
+    return imagem_base != nullptr;
+}
+
+size_t Core::get_paginas_sujas() const {
+    return paginas_sujas.size();
+}
+
+SnapshotCore Core::criar_snapshot() {
+    SnapshotCore snapshot;
+    std::copy_n(registradores, 32, snapshot.registradores.begin());
+    snapshot.contador_programa = contador_programa;
+    snapshot.contadores = contadores;
+    snapshot.ciclos_parados_contabilizados = ciclos_parados_contabilizados;
+    snapshot.ciclos_tempo = ciclos_tempo;
+    snapshot.contadores_hpm = contadores_hpm;
+    snapshot.mcountinhibit = mcountinhibit;
+    snapshot.mscratch = mscratch;
+    snapshot.registradores_vetoriais = registradores_vetoriais;
+    snapshot.vl = vl;
+    snapshot.vtype = vtype;
+    snapshot.vstart = vstart;
+    snapshot.vcsr = vcsr;
+    snapshot.fim_programa = fim_programa;
+    snapshot.finalizado_por_exit = finalizado_por_exit;
+    snapshot.codigo_saida = codigo_saida;
+    // No modo funcional as escritas não passam pelo cache: as linhas podem estar desatualizadas
+    if (modo == ModoExecucao::Funcional) cache->recarregarLinhasValidas();
+    cache->salvarEstado(snapshot.cache);
+    clint->salvar_estado(snapshot.clint);
+    uart->salvar_estado(snapshot.uart);
+    snapshot.memoria = capturar_memoria();
+    return snapshot;
+}
+
+std::string Core::restaurar_snapshot(const SnapshotCore &snapshot) {
+    if (!snapshot.memoria) {
+        return "[ERRO] Snapshot vazio.";
+    }
+    if (snapshot.memoria->paginas.size() != (memoria.size() + TAMANHO_PAGINA_BASE - 1) / TAMANHO_PAGINA_BASE) {
+        return "[ERRO] Snapshot de um Core com outro tamanho de memoria.";
+    }
+
+    aplicar_snapshot(snapshot);
+    if (reverso) descartar_historico_reverso();
+    return "";
+}
+
+void Core::aplicar_snapshot(const SnapshotCore &snapshot) {
+    restaurar_memoria(snapshot.memoria);
+    std::copy_n(snapshot.registradores.begin(), 32, registradores);
+    contador_programa = snapshot.contador_programa;
+    contadores = snapshot.contadores;
+    ciclos_parados_contabilizados = snapshot.ciclos_parados_contabilizados;
+    ciclos_tempo = snapshot.ciclos_tempo;
+    contadores_hpm = snapshot.contadores_hpm;
+    mcountinhibit = snapshot.mcountinhibit;
+    mscratch = snapshot.mscratch;
+    registradores_vetoriais = snapshot.registradores_vetoriais;
+    vl = snapshot.vl;
+    vtype = snapshot.vtype;
+    vstart = snapshot.vstart;
+    vcsr = snapshot.vcsr;
+    fim_programa = snapshot.fim_programa;
+    finalizado_por_exit = snapshot.finalizado_por_exit;
+    codigo_saida = snapshot.codigo_saida;
+    cache->restaurarEstado(snapshot.cache);
+    clint->restaurar_estado(snapshot.clint);
+    uart->restaurar_estado(snapshot.uart);
+}
+
+void Core::definir_execucao_reversa(size_t capacidade, uint64_t intervalo_snapshots, size_t maximo_snapshots) {
+    if (capacidade == 0) {
+        reverso.reset();
+        return;
+    }
+    reverso = std::make_unique<EstadoReverso>();
+    reverso->anel.resize(capacidade);
+    reverso->intervalo_snapshots = std::max<uint64_t>(intervalo_snapshots, 1);
+    reverso->maximo_snapshots = std::max<size_t>(maximo_snapshots, 1);
+}
+
+bool Core::execucao_reversa_ativa() const {
+    return reverso != nullptr;
+}
+
+uint64_t Core::get_passos_reversiveis(bool exato) const {
+    if (!reverso) return 0;
+    // A volta exata parte sempre de um snapshot
+    uint64_t mais_antigo = exato ? reverso->passo : reverso->passo - reverso->quantidade;
+    if (!reverso->snapshots.empty()) {
+        mais_antigo = std::min(mais_antigo, reverso->snapshots.front().first);
+    }
+    return reverso->passo - mais_antigo;
+}
+
+std::string Core::voltar_instrucoes(uint64_t quantidade, bool exato) {
+    if (!reverso) {
+        return "[ERRO] Execucao reversa desligada.";
+    }
+    uint64_t possiveis = get_passos_reversiveis(exato);
+    if (quantidade > possiveis) {
+        std::stringstream ss;
+        ss << "[ERRO] So e possivel voltar " << possiveis << " instrucoes.";
+        return ss.str();
+    }
+
+    if (quantidade == 0) {
+        return "";
+    }
+
+    EstadoReverso &r = *reverso;
+    uint64_t alvo = r.passo - quantidade;
+    if (quantidade <= r.quantidade && !exato) {
+        for (uint64_t i = 0; i < quantidade; ++i) {
+            desfazer_ultima_entrada();
+        }
+    } else {
+        // Além do anel (ou volta exata): parte do último snapshot antes do alvo e reexecuta até ele
+        while (r.snapshots.back().first > alvo) {
+            r.snapshots.pop_back();
+        }
+        aplicar_snapshot(r.snapshots.back().second);
+        r.passo = r.snapshots.back().first;
+        r.inicio = 0;
+        r.quantidade = 0;
+        while (r.passo < alvo) {
+            step();
+            // A reexecução não deveria encontrar efeitos externos: eles recomeçam o histórico
+            if (r.snapshots.empty()) {
+                return "[ERRO] A reexecucao encontrou um efeito externo; historico reiniciado.";
+            }
+        }
+    }
+
+    // Snapshots do futuro que foi desfeito não servem mais
+    while (!r.snapshots.empty() && r.snapshots.back().first > r.passo) {
+        r.snapshots.pop_back();
+    }
+    return "";
+}
+
+std::string Core::voltar_ate_escrita(uint32_t endereco, uint64_t &distancia, bool exato) {
+    distancia = 0;
+    if (!reverso) {
+        return "[ERRO] Execucao reversa desligada.";
+    }
+
+    const EstadoReverso &r = *reverso;
+    for (uint64_t i = 1; i <= r.quantidade; ++i) {
+        const EntradaDesfazer &entrada = r.anel[(r.inicio + r.quantidade - i) % r.anel.size()];
+        if (entrada.tamanho && endereco - entrada.endereco < entrada.tamanho) {
+            distancia = i;
+            return voltar_instrucoes(i, exato);
+        }
+    }
+
+    std::stringstream ss;
+    ss << "[ERRO] Nenhuma escrita em 0x" << std::hex << endereco << std::dec << " nas ultimas "
+       << r.quantidade << " instrucoes.";
+    return ss.str();
+}
+
+/**
+ * @brief Chamada antes de cada instrução: tira o snapshot periódico e prepara a entrada.
+ */
+void Core::iniciar_passo_reverso() {
+    EstadoReverso &r = *reverso;
+    if (r.snapshots.empty() || r.passo - r.snapshots.back().first >= r.intervalo_snapshots) {
+        r.snapshots.emplace_back(r.passo, criar_snapshot());
+        if (r.snapshots.size() > r.maximo_snapshots) {
+            r.snapshots.pop_front();
+        }
+    }
+    r.atual = EntradaDesfazer{};
+    r.atual.pc = contador_programa;
+    r.instrucoes_antes = contadores.instrucoes;
+    r.barreira = false;
+}
+
+/**
+ * @brief Chamada depois de cada instrução: guarda a entrada no anel, ou recomeça o histórico.
+ */
+void Core::concluir_passo_reverso(uint32_t instrucao) {
+    EstadoReverso &r = *reverso;
+
+    // SYSTEM: ecall/ebreak e escritas de CSR (csrrw/csrrwi sempre, as demais com rs1/uimm != 0)
+    uint32_t opcode = instrucao & 0x7F;
+    if (opcode == 0x73) {
+        uint32_t funct3 = (instrucao >> 12) & 0x7;
+        uint32_t rs1 = (instrucao >> 15) & 0x1F;
+        if (funct3 == 0 || (funct3 & 0x3) == 1 || rs1 != 0) {
+            r.barreira = true;
+        }
+    }
+    // Vetoriais: o estado da extensão V e as escritas de vários elementos não cabem na entrada
+    if (opcode == 0x57 || opcode == 0x07 || opcode == 0x27) {
+        r.barreira = true;
+    }
+    if (r.barreira) {
+        descartar_historico_reverso();
+        return;
+    }
+
+    r.atual.contou = contadores.instrucoes != r.instrucoes_antes;
+    if (r.quantidade < r.anel.size()) {
+        r.anel[(r.inicio + r.quantidade) % r.anel.size()] = r.atual;
+        ++r.quantidade;
+    } else {
+        r.anel[r.inicio] = r.atual;
+        r.inicio = (r.inicio + 1) % r.anel.size();
+    }
+    ++r.passo;
+}
+
+void Core::desfazer_ultima_entrada() {
+    EstadoReverso &r = *reverso;
+    --r.quantidade;
+    --r.passo;
+    const EntradaDesfazer &entrada = r.anel[(r.inicio + r.quantidade) % r.anel.size()];
+
+    if (entrada.tamanho) {
+        for (uint32_t i = 0; i < entrada.tamanho; ++i) {
+            memoria[entrada.endereco + i] = static_cast<uint8_t>(entrada.dados >> (8 * i));
+        }
+        cache->sincronizarComMemoria(entrada.endereco, entrada.tamanho);
+        if (imagem_sincronizada) {
+            marcar_pagina_suja(entrada.endereco, entrada.tamanho);
+        }
+        if (!escritas_janela.empty()) {
+            marcar_escrita(entrada.endereco, entrada.tamanho);
+        }
+    }
+    registradores[entrada.rd] = entrada.valor_rd;
+    registradores[0] = 0;
+    contador_programa = entrada.pc;
+    if (entrada.contou) {
+        --contadores.instrucoes;
+    }
+}
+
+/**
+ * @brief Recomeça o histórico no estado atual (o próximo passo tira um snapshot novo).
+ *
+ * Se for chamada durante uma instrução, a instrução também não entra no anel.
+ */
+void Core::descartar_historico_reverso() {
+    EstadoReverso &r = *reverso;
+    r.inicio = 0;
+    r.quantidade = 0;
+    r.passo = 0;
+    r.snapshots.clear();
+    r.barreira = true;
+}
+
+uint32_t SnapshotCore::get_program_counter() const {
+    return contador_programa;
+}
+
+const ContadoresCore &SnapshotCore::get_contadores() const {
+    return contadores;
+}
+
+size_t SnapshotCore::get_tamanho_memoria() const {
+    size_t tamanho = 0;
+    if (memoria) {
+        for (const auto &pagina : memoria->paginas) tamanho += pagina->size();
+    }
+    return tamanho;
+}
+
+/**
+ * @brief Cria uma imagem da RAM atual e passa a rastrear as escritas em relação a ela.
+ *
+ * Páginas não escritas desde a imagem anterior são compartilhadas com ela; só as sujas
+ * (ou todas, na primeira captura) são copiadas.
+ */
+std::shared_ptr<const ImagemMemoria> Core::capturar_memoria() {
+    size_t quantidade = (memoria.size() + TAMANHO_PAGINA_BASE - 1) / TAMANHO_PAGINA_BASE;
+    auto imagem = std::make_shared<ImagemMemoria>();
+    imagem->paginas.resize(quantidade);
+
+    for (size_t pagina = 0; pagina < quantidade; ++pagina) {
+        if (imagem_sincronizada && !pagina_suja[pagina]) {
+            imagem->paginas[pagina] = imagem_sincronizada->paginas[pagina];
+            continue;
+        }
+        size_t inicio = pagina * TAMANHO_PAGINA_BASE;
+        size_t tamanho = std::min<size_t>(TAMANHO_PAGINA_BASE, memoria.size() - inicio);
+        imagem->paginas[pagina] = std::make_shared<const PaginaMemoria>(memoria.begin() + inicio,
+                                                                        memoria.begin() + inicio + tamanho);
+    }
+
+    pagina_suja.assign(quantidade, 0);
+    paginas_sujas.clear();
+    imagem_sincronizada = imagem;
+    return imagem;
+}
+
+/**
+ * @brief Copia para a RAM as páginas que diferem de 'imagem'.
+ *
+ * Voltando à imagem já sincronizada, só as páginas sujas são copiadas; vindo de outra,
+ * são copiadas também as páginas que as duas imagens não compartilham.
+ */
+void Core::restaurar_memoria(const std::shared_ptr<const ImagemMemoria> &imagem) {
+    auto copiar = [&](size_t pagina) {
+        const PaginaMemoria &origem = *imagem->paginas[pagina];
+        std::copy(origem.begin(), origem.end(), memoria.begin() + pagina * TAMANHO_PAGINA_BASE);
+        if (!escritas_janela.empty()) {
+            marcar_escrita(static_cast<uint32_t>(pagina * TAMANHO_PAGINA_BASE), static_cast<uint32_t>(origem.size()));
+        }
+    };
+
+    if (imagem == imagem_sincronizada) {
+        for (uint32_t pagina : paginas_sujas) {
+            copiar(pagina);
+            pagina_suja[pagina] = 0;
+        }
+    } else {
+        for (size_t pagina = 0; pagina < imagem->paginas.size(); ++pagina) {
+            if (!imagem_sincronizada || pagina_suja[pagina] ||
+                imagem_sincronizada->paginas[pagina] != imagem->paginas[pagina]) {
+                copiar(pagina);
+            }
+        }
+        pagina_suja.assign(imagem->paginas.size(), 0);
+    }
+    paginas_sujas.clear();
+    imagem_sincronizada = imagem;
+}
+
+void Core::marcar_pagina_suja(uint32_t endereco, uint32_t tamanho) {
+    // Acessos desalinhados e cópias em bloco podem atravessar o limite da página
+    uint32_t ultima = (endereco + tamanho - 1) / TAMANHO_PAGINA_BASE;
+    for (uint32_t pagina = endereco / TAMANHO_PAGINA_BASE; pagina <= ultima; ++pagina) {
+        if (!pagina_suja[pagina]) {
+            pagina_suja[pagina] = 1;
+            paginas_sujas.push_back(pagina);
+        }
+    }
 }
 
 bool Core::is_finished() const {
-    return contador_programa >= memoria.size();
+    if (barramento.na_ram(contador_programa, 4)) return false;
+    TipoRegiao tipo;
+    return contador_programa == PC_FINALIZADO || !barramento.tipo_regiao(contador_programa, tipo) ||
+           tipo != TipoRegiao::Rom;
 }
 
 std::string Core::step() {
@@ -29,32 +468,62 @@ std::string Core::step() {
         return ss.str();
     }
 
+    if (!gatilhos_modo.empty()) verificar_gatilhos_modo();
+    if (reverso) iniciar_passo_reverso();
     uint32_t instrucao = fetch();
+    if (reverso) {
+        // O campo rd é guardado mesmo quando a instrução não escreve nele: restaurá-lo é inócuo
+        reverso->atual.rd = static_cast<uint8_t>((instrucao >> 7) & 0x1F);
+        reverso->atual.valor_rd = registradores[reverso->atual.rd];
+    }
 
     std::string log = execute(instrucao);
+    if (reverso) concluir_passo_reverso(instrucao);
     return log;
 }
 
 void Core::load_program(const std::vector<uint32_t> &programa) {
+    if (reverso) descartar_historico_reverso();
+    if (imagem_sincronizada && !programa.empty()) {
+        marcar_pagina_suja(0, static_cast<uint32_t>(programa.size() * 4));
+    }
     for (size_t i = 0; i < programa.size(); ++i) {
         memoria[i * 4 + 0] = (programa[i] >> 0) & 0xFF;
         memoria[i * 4 + 1] = (programa[i] >> 8) & 0xFF;
         memoria[i * 4 + 2] = (programa[i] >> 16) & 0xFF;
         memoria[i * 4 + 3] = (programa[i] >> 24) & 0xFF;
     }
+    fim_programa = static_cast<uint32_t>(programa.size() * 4);
 }
 
 uint32_t Core::fetch() {
+    if (!barramento.na_ram(contador_programa, 4)) {
+        // ROM (is_finished() já descartou o resto); uma instrução cortada no fim da região vira nula
+        uint32_t instrucao = 0;
+        barramento.ler(contador_programa, 4, instrucao);
+        return instrucao;
+    }
+    if (modo == ModoExecucao::Funcional) {
+        return static_cast<uint32_t>(memoria[contador_programa]) |
+               static_cast<uint32_t>(memoria[contador_programa + 1]) << 8 |
+               static_cast<uint32_t>(memoria[contador_programa + 2]) << 16 |
+               static_cast<uint32_t>(memoria[contador_programa + 3]) << 24;
+    }
     return cache->lerDados(contador_programa);
 }
 
 std::string Core::execute(uint32_t instrucao) {
     // Decodifica a instrução
     Instruction inst(instrucao);
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
+
+    ultimo_commit = RegistroCommit{};
+    ultimo_commit.pc = contador_programa;
+    ultimo_commit.instrucao = instrucao;
 
     if (inst.palavra_instrucao == 0) {
-        contador_programa = memoria.size();
+        contador_programa = PC_FINALIZADO;
+        proxy_syscalls->descarregar();
         return "Instrucao nula, finalizando.";
     }
 
@@ -76,6 +545,22 @@ std::string Core::execute(uint32_t instrucao) {
             break;
         case 0x37: log_msg = handle_lui(inst);
             break;
+        case 0x17: log_msg = handle_auipc(inst);
+            break;
+        case 0x67: log_msg = handle_jalr(inst);
+            break;
+        case 0x0F: // FENCE: a memória já é sequencialmente consistente
+            log_msg = "Executando FENCE";
+            contador_programa += 4;
+            break;
+        case 0x73: log_msg = handle_system(inst);
+            break;
+        case 0x57: log_msg = handle_op_v(inst);
+            break;
+        case 0x07: log_msg = handle_memoria_v(inst, false);
+            break;
+        case 0x27: log_msg = handle_memoria_v(inst, true);
+            break;
 
         default:
             log_ss << "ERRO: Opcode desconhecido: 0x" << std::hex << inst.opcode();
@@ -87,12 +572,63 @@ std::string Core::execute(uint32_t instrucao) {
     // 3. Garante que x0 seja sempre zero após cada instrução
     registradores[0] = 0;
 
+    if (ecall_interrompida) {
+        ecall_interrompida = false;
+        ultimo_commit = RegistroCommit{};
+        return log_msg;
+    }
+
+    // Completa o registro de commit com a escrita em rd (se houver) e o novo PC
+    switch (inst.opcode()) {
+        case 0x13: case 0x33: case 0x03: case 0x37: case 0x17: case 0x6F: case 0x67:
+            ultimo_commit.rd = inst.rd();
+            ultimo_commit.valor_rd = registradores[inst.rd()];
+            break;
+        case 0x73:
+            if (inst.funct3() != 0) {
+                ultimo_commit.rd = inst.rd();
+                ultimo_commit.valor_rd = registradores[inst.rd()];
+            }
+            break;
+        case 0x57:
+            // vsetvl* e vmv.x.s escrevem em x[rd]
+            if (inst.funct3() == 0x7 || (inst.funct3() == 0x2 && (inst.palavra_instrucao >> 26) == 0x10)) {
+                ultimo_commit.rd = inst.rd();
+                ultimo_commit.valor_rd = registradores[inst.rd()];
+            }
+            break;
+        default:
+            break;
+    }
+    ultimo_commit.proximo_pc = contador_programa;
+
+    // 4. Atualiza os contadores: cada instrução custa 1 ciclo mais a espera do cache
+    if (!(mcountinhibit & 0x4)) {
+        contadores.instrucoes++;
+    }
+    uint64_t parados = cache->getEstatisticas().ciclos_parados;
+    uint64_t ciclos = 1 + (parados - ciclos_parados_contabilizados);
+    if (!(mcountinhibit & 0x1)) {
+        contadores.ciclos += ciclos;
+    }
+    ciclos_tempo += ciclos;
+    ciclos_parados_contabilizados = parados;
+    // As esperas pela memória já avançaram a DRAM; falta o ciclo da própria instrução
+    if (modo != ModoExecucao::Funcional) {
+        cache->avancarCiclos(1);
+    }
+    if (modo == ModoExecucao::Detalhado) {
+        contadores_detalhado.instrucoes++;
+        contadores_detalhado.ciclos += ciclos;
+    }
+
     return log_msg;
 }
 
 std::string Core::set_register(int reg_index, uint32_t valor) {
     if (reg_index > 0 && reg_index < 32) {
         registradores[reg_index] = valor;
+        if (reverso) descartar_historico_reverso();
         return "";
     } else if (reg_index == 0) {
         return "[AVISO] Nao e permitido alterar o registrador x0 (zero).";
@@ -109,12 +645,24 @@ std::array<uint32_t, 32> Core::get_registradores() const {
     return regs;
 }
 
+const Core::BancoVetorial& Core::get_registradores_vetoriais() const {
+    return registradores_vetoriais;
+}
+
+uint32_t Core::get_vl() const {
+    return vl;
+}
+
+uint32_t Core::get_vtype() const {
+    return vtype;
+}
+
 uint32_t Core::get_program_counter() const {
     return contador_programa;
 }
 
 std::string Core::handle_op_imm(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     int32_t imm = inst.imediato_tipo_I();
     uint32_t rd = inst.rd();
@@ -127,7 +675,21 @@ std::string Core::handle_op_imm(const Instruction &inst) {
             break;
         case 0x2: // SLTI
             log_ss << "Executando SLTI x" << std::dec << rd << ", x" << rs1 << ", " << imm;
-            if (rd != 0) registradores[rd] = (static_cast<int32_t>(registradores[rs1]) < imm) ? 1 : 0;
+            if (rd != 0) {
+                registradores[rd] = (static_cast<int32_t>(registradores[rs1]) < imm) ? 1 : 0;
+            } else if (rs1 == 0) {
+                // HINT "slti x0, x0, imm": instrução mágica de troca de modo
+                switch (imm) {
+                    case instrucao_magica::MODO_FUNCIONAL: trocar_modo(ModoExecucao::Funcional); break;
+                    case instrucao_magica::MODO_AQUECIMENTO: trocar_modo(ModoExecucao::Aquecimento); break;
+                    case instrucao_magica::MODO_DETALHADO: trocar_modo(ModoExecucao::Detalhado); break;
+                    default: break;
+                }
+            }
+            break;
+        case 0x3: // SLTIU (o imediato é estendido com sinal e comparado sem sinal)
+            log_ss << "Executando SLTIU x" << std::dec << rd << ", x" << rs1 << ", " << imm;
+            if (rd != 0) registradores[rd] = (registradores[rs1] < static_cast<uint32_t>(imm)) ? 1 : 0;
             break;
         case 0x4: // XORI
             log_ss << "Executando XORI x" << std::dec << rd << ", x" << rs1 << ", " << imm;
@@ -174,7 +736,7 @@ std::string Core::handle_op_imm(const Instruction &inst) {
 }
 
 std::string Core::handle_branch(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     int32_t offset = inst.imediato_tipo_B();
     uint32_t rs1 = inst.rs1();
@@ -190,13 +752,32 @@ std::string Core::handle_branch(const Instruction &inst) {
             log_ss << "Executando BNE x" << std::dec << rs1 << ", x" << rs2 << ", " << offset;
             if (registradores[rs1] != registradores[rs2]) deve_desviar = true;
             break;
+        case 0x4: // BLT
+            log_ss << "Executando BLT x" << std::dec << rs1 << ", x" << rs2 << ", " << offset;
+            if (static_cast<int32_t>(registradores[rs1]) < static_cast<int32_t>(registradores[rs2])) deve_desviar = true;
+            break;
+        case 0x5: // BGE
+            log_ss << "Executando BGE x" << std::dec << rs1 << ", x" << rs2 << ", " << offset;
+            if (static_cast<int32_t>(registradores[rs1]) >= static_cast<int32_t>(registradores[rs2])) deve_desviar = true;
+            break;
+        case 0x6: // BLTU
+            log_ss << "Executando BLTU x" << std::dec << rs1 << ", x" << rs2 << ", " << offset;
+            if (registradores[rs1] < registradores[rs2]) deve_desviar = true;
+            break;
+        case 0x7: // BGEU
+            log_ss << "Executando BGEU x" << std::dec << rs1 << ", x" << rs2 << ", " << offset;
+            if (registradores[rs1] >= registradores[rs2]) deve_desviar = true;
+            break;
         default:
             log_ss << "ERRO: Branch com funct3 desconhecido: 0x" << std::hex << inst.funct3();
             break;
     }
 
+    contadores.desvios++;
+
     // Desvios têm lógica de PC diferente
     if (deve_desviar) {
+        contadores.desvios_tomados++;
         contador_programa += offset;
     } else {
         contador_programa += 4;
@@ -205,7 +786,7 @@ std::string Core::handle_branch(const Instruction &inst) {
 }
 
 std::string Core::handle_op_reg(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     // Decodificação limpa
     uint32_t rd = inst.rd();
@@ -222,6 +803,12 @@ std::string Core::handle_op_reg(const Instruction &inst) {
     uint32_t rs2_val_unsigned = registradores[rs2];
 
     if (funct7 == 0x01) {
+        if (funct3 < 0x4) {
+            contadores.multiplicacoes++;
+        } else {
+            contadores.divisoes++;
+        }
+
         switch (funct3) {
             case 0x0: // MUL: Multiplicação (bits baixos)
                 log_ss << "Executando MUL x" << std::dec << rd << ", x" << rs1 << ", x" << rs2;
@@ -400,7 +987,7 @@ std::string Core::handle_op_reg(const Instruction &inst) {
  * Ex: LW, LB, LH, LBU, LHU
  */
 std::string Core::handle_load(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     // Decodificação limpa
     uint32_t rd = inst.rd();
@@ -408,17 +995,35 @@ std::string Core::handle_load(const Instruction &inst) {
     int32_t imm = inst.imediato_tipo_I();
     uint32_t endereco = registradores[rs1] + imm;
 
-    switch (inst.funct3()) {
-        case 0x2: // LW (Load Word)
-            log_ss << "Executando LW x" << std::dec << rd << ", " << imm << "(x" << rs1 << ")"
+    contadores.loads++;
+
+    static const char* nomes[] = {"LB", "LH", "LW", "", "LBU", "LHU", "", ""};
+    uint32_t funct3 = inst.funct3();
+
+    switch (funct3) {
+        case 0x0: case 0x1: case 0x2: case 0x4: case 0x5: {
+            log_ss << "Executando " << nomes[funct3] << " x" << std::dec << rd << ", " << imm << "(x" << rs1 << ")"
                     << " -> Endereco: 0x" << std::hex << endereco;
+
+            uint32_t tamanho = 1u << (funct3 & 0x3);
+            uint32_t valor = 0;
+            if (!ler_memoria(endereco, tamanho, valor)) {
+                log_ss << " -> ERRO: endereco nao mapeado";
+            }
             if (rd != 0) {
-                // Usa o cache para ler
-                registradores[rd] = cache->lerDados(endereco);
+                // LB e LH estendem o sinal; LBU e LHU completam com zeros
+                if (funct3 == 0x0) registradores[rd] = static_cast<uint32_t>(static_cast<int8_t>(valor));
+                else if (funct3 == 0x1) registradores[rd] = static_cast<uint32_t>(static_cast<int16_t>(valor));
+                else registradores[rd] = valor;
             }
+            ultimo_commit.acesso = AcessoMemoria::Leitura;
+            ultimo_commit.tamanho_acesso = tamanho;
+            ultimo_commit.endereco_memoria = endereco;
+            ultimo_commit.dado_memoria = valor;
             break;
+        }
         default:
-            log_ss << "ERRO: Load com funct3 desconhecido: 0x" << std::hex << inst.funct3();
+            log_ss << "ERRO: Load com funct3 desconhecido: 0x" << std::hex << funct3;
             break;
     }
 
@@ -431,7 +1036,7 @@ std::string Core::handle_load(const Instruction &inst) {
  * Ex: SW, SB, SH
  */
 std::string Core::handle_store(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     // Decodificação limpa
     uint32_t rs1 = inst.rs1();
@@ -439,18 +1044,31 @@ std::string Core::handle_store(const Instruction &inst) {
     int32_t imm = inst.imediato_tipo_S();
     auto endereco = static_cast<uint32_t>(static_cast<int32_t>(registradores[rs1]) + imm);
 
-    switch (inst.funct3()) {
-        case 0x2: {
-            log_ss << "Executando SW x" << std::dec << rs2 << ", " << imm << "(x" << rs1 << ")"
+    contadores.stores++;
+
+    static const char* nomes[] = {"SB", "SH", "SW"};
+    uint32_t funct3 = inst.funct3();
+
+    switch (funct3) {
+        case 0x0: case 0x1: case 0x2: {
+            log_ss << "Executando " << nomes[funct3] << " x" << std::dec << rs2 << ", " << imm << "(x" << rs1 << ")"
                     << " -> Endereco: 0x" << std::hex << endereco;
 
-            uint32_t valor = registradores[rs2]; // Agora esta inicialização é segura
-            cache->escreverDados(endereco, valor);
+            uint32_t tamanho = 1u << funct3;
+            uint32_t valor = registradores[rs2];
+            if (tamanho < 4) valor &= (1u << (8 * tamanho)) - 1;
+            if (!escrever_memoria(endereco, valor, tamanho)) {
+                log_ss << " -> ERRO: endereco nao mapeado";
+            }
 
+            ultimo_commit.acesso = AcessoMemoria::Escrita;
+            ultimo_commit.tamanho_acesso = tamanho;
+            ultimo_commit.endereco_memoria = endereco;
+            ultimo_commit.dado_memoria = valor;
             break;
         }
         default:
-            log_ss << "ERRO: Store com funct3 desconhecido: 0x" << std::hex << inst.funct3();
+            log_ss << "ERRO: Store com funct3 desconhecido: 0x" << std::hex << funct3;
             break;
     }
 
@@ -462,7 +1080,7 @@ std::string Core::handle_store(const Instruction &inst) {
  * @brief (Opcode 0x37) Trata instrução LUI (Load Upper Immediate).
  */
 std::string Core::handle_lui(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     // Decodificação limpa
     uint32_t rd = inst.rd();
@@ -478,11 +1096,30 @@ std::string Core::handle_lui(const Instruction &inst) {
     return log_ss.str();
 }
 
+/**
+ * @brief (Opcode 0x17) Trata instrução AUIPC (Add Upper Immediate to PC).
+ */
+std::string Core::handle_auipc(const Instruction &inst) {
+    LogInstrucao log_ss(log_ativo);
+
+    uint32_t rd = inst.rd();
+    int32_t imm = inst.imediato_tipo_U();
+
+    log_ss << "Executando AUIPC x" << std::dec << rd << ", 0x" << std::hex << (static_cast<uint32_t>(imm) >> 12);
+
+    if (rd != 0) {
+        registradores[rd] = contador_programa + imm;
+    }
+
+    contador_programa += 4;
+    return log_ss.str();
+}
+
 /**
  * @brief (Opcode 0x6F) Trata instrução JAL (Jump and Link).
  */
 std::string Core::handle_jal(const Instruction &inst) {
-    std::stringstream log_ss;
+    LogInstrucao log_ss(log_ativo);
 
     // Decodificação limpa
     uint32_t rd = inst.rd();
@@ -490,6 +1127,8 @@ std::string Core::handle_jal(const Instruction &inst) {
 
     log_ss << "Executando JAL x" << std::dec << rd << ", " << offset;
 
+    contadores.saltos++;
+
     // Salva o endereço da PRÓXIMA instrução (PC+4) em rd
     if (rd != 0) {
         registradores[rd] = contador_programa + 4;
@@ -502,11 +1141,561 @@ std::string Core::handle_jal(const Instruction &inst) {
     return log_ss.str();
 }
 
+/**
+ * @brief (Opcode 0x67) Trata instrução JALR (Jump and Link Register).
+ */
+std::string Core::handle_jalr(const Instruction &inst) {
+    LogInstrucao log_ss(log_ativo);
+
+    uint32_t rd = inst.rd();
+    uint32_t rs1 = inst.rs1();
+    int32_t imm = inst.imediato_tipo_I();
+
+    log_ss << "Executando JALR x" << std::dec << rd << ", " << imm << "(x" << rs1 << ")";
+
+    contadores.saltos++;
+
+    // O destino é calculado antes de escrever rd, pois rd pode ser igual a rs1
+    uint32_t destino = (registradores[rs1] + imm) & ~1u;
+    if (rd != 0) {
+        registradores[rd] = contador_programa + 4;
+    }
+    contador_programa = destino;
+    return log_ss.str();
+}
+
+const RegistroCommit& Core::get_ultimo_commit() const {
+    return ultimo_commit;
+}
+
+const ContadoresCore& Core::get_contadores() const {
+    return contadores;
+}
+
+const EstatisticasCache& Core::get_estatisticas_cache() const {
+    return cache->getEstatisticas();
+}
+
+std::string Core::configurar_dram(const ConfigDram &config) {
+    return cache->configurarDram(config);
+}
+
+const ConfigDram& Core::get_config_dram() const {
+    return cache->getConfigDram();
+}
+
+const EstatisticasDram& Core::get_estatisticas_dram() const {
+    return cache->getEstatisticasDram();
+}
+
+std::string Core::configurar_buffer_escrita(const ConfigBufferEscrita &config) {
+    return cache->configurarBufferEscrita(config);
+}
+
+const ConfigBufferEscrita& Core::get_config_buffer_escrita() const {
+    return cache->getConfigBufferEscrita();
+}
+
+const EstatisticasBufferEscrita& Core::get_estatisticas_buffer_escrita() const {
+    return cache->getEstatisticasBufferEscrita();
+}
+
+uint32_t Core::get_linhas_cache() const {
+    return cache->getQuantidadeLinhas();
+}
+
+EstadoLinhaCache Core::get_estado_linha_cache(uint32_t indice) const {
+    return cache->getEstadoLinha(indice);
+}
+
+void Core::consumir_alteracoes_cache(std::vector<uint32_t> &indices) {
+    cache->consumirAlteracoes(indices);
+}
+
+Barramento& Core::get_barramento() {
+    return barramento;
+}
+
+ProxySyscalls& Core::get_proxy_syscalls() {
+    return *proxy_syscalls;
+}
+
+Uart& Core::get_uart() {
+    return *uart;
+}
+
+size_t Core::get_tamanho_memoria() const {
+    return memoria.size();
+}
+
+uint32_t Core::get_fim_programa() const {
+    return fim_programa;
+}
+
+void Core::encerrar(int32_t codigo) {
+    codigo_saida = codigo;
+    finalizado_por_exit = true;
+    contador_programa = PC_FINALIZADO;
+    if (reverso) descartar_historico_reverso();
+}
+
+bool Core::encerrado() const {
+    return finalizado_por_exit;
+}
+
+int32_t Core::get_codigo_saida() const {
+    return codigo_saida;
+}
+
+bool Core::ler_memoria(uint32_t endereco, uint32_t tamanho, uint32_t &valor) {
+    if (!barramento.na_ram(endereco, tamanho)) {
+        // Leituras de dispositivos podem ter efeito (ex.: consumir um byte da UART)
+        if (reverso) reverso->barreira = true;
+        return barramento.ler(endereco, tamanho, valor);
+    }
+
+    if (modo == ModoExecucao::Funcional) {
+        valor = 0;
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            valor |= static_cast<uint32_t>(memoria[endereco + i]) << (8 * i);
+        }
+        return true;
+    }
+
+    // O cache entrega palavras alinhadas; bytes e meias-palavras são extraídos delas
+    uint32_t deslocamento = endereco & 0x3;
+    uint64_t palavras = cache->lerDados(endereco - deslocamento);
+    if (deslocamento + tamanho > 4) {
+        // Acesso desalinhado que atravessa a palavra: busca também a seguinte
+        palavras |= static_cast<uint64_t>(cache->lerDados(endereco - deslocamento + 4)) << 32;
+    }
+    valor = static_cast<uint32_t>(palavras >> (8 * deslocamento));
+    if (tamanho < 4) valor &= (1u << (8 * tamanho)) - 1;
+    return true;
+}
+
+bool Core::escrever_memoria(uint32_t endereco, uint32_t valor, uint32_t tamanho) {
+    if (!escritas_janela.empty()) {
+        marcar_escrita(endereco, tamanho);
+    }
+    if (!barramento.na_ram(endereco, tamanho)) {
+        if (reverso) reverso->barreira = true;
+        return barramento.escrever(endereco, valor, tamanho);
+    }
+    if (imagem_sincronizada) {
+        marcar_pagina_suja(endereco, tamanho);
+    }
+    if (reverso) {
+        // O cache é write-through: a RAM tem o valor que será sobrescrito
+        EntradaDesfazer &entrada = reverso->atual;
+        entrada.endereco = endereco;
+        entrada.tamanho = static_cast<uint8_t>(tamanho);
+        entrada.dados = 0;
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            entrada.dados |= static_cast<uint32_t>(memoria[endereco + i]) << (8 * i);
+        }
+    }
+
+    if (modo == ModoExecucao::Funcional) {
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            memoria[endereco + i] = (valor >> (8 * i)) & 0xFF;
+        }
+    } else if ((endereco & 0x3) + tamanho <= 4) {
+        cache->escreverDados(endereco, valor, tamanho);
+    } else {
+        // Acesso desalinhado que atravessa a palavra: escreve byte a byte
+        for (uint32_t i = 0; i < tamanho; ++i) {
+            cache->escreverDados(endereco + i, (valor >> (8 * i)) & 0xFF, 1);
+        }
+    }
+    return true;
+}
+
+bool Core::ler_bloco_memoria(uint32_t endereco, uint8_t *destino, uint32_t tamanho) const {
+    // O cache é write-through, então a RAM está sempre atualizada
+    if (!barramento.na_ram(endereco, tamanho)) return false;
+    std::copy_n(memoria.begin() + endereco, tamanho, destino);
+    return true;
+}
+
+bool Core::escrever_bloco_memoria(uint32_t endereco, const uint8_t *origem, uint32_t tamanho) {
+    if (!barramento.na_ram(endereco, tamanho)) return false;
+    std::copy_n(origem, tamanho, memoria.begin() + endereco);
+    cache->sincronizarComMemoria(endereco, tamanho);
+    if (imagem_sincronizada && tamanho > 0) {
+        marcar_pagina_suja(endereco, tamanho);
+    }
+    if (reverso) descartar_historico_reverso();
+    if (!escritas_janela.empty()) {
+        marcar_escrita(endereco, tamanho);
+    }
+    return true;
+}
+
+void Core::marcar_escrita(uint32_t endereco, uint32_t tamanho) {
+    for (uint32_t i = 0; i < tamanho; ++i) {
+        uint32_t deslocamento = endereco + i - janela_escritas_inicio;
+        if (deslocamento < escritas_janela.size()) {
+            escritas_janela[deslocamento] = 1;
+        }
+    }
+}
+
+void Core::definir_janela_escritas(uint32_t inicio, uint32_t tamanho) {
+    janela_escritas_inicio = inicio;
+    escritas_janela.assign(tamanho, 0);
+}
+
+std::vector<uint8_t> Core::consumir_escritas_janela() {
+    std::vector<uint8_t> marcas(escritas_janela.size(), 0);
+    marcas.swap(escritas_janela);
+    return marcas;
+}
+
+/**
+ * @brief (Opcode 0x73) Trata instruções SYSTEM: ECALL, CSRRW, CSRRS, CSRRC e as versões com imediato.
+ */
+std::string Core::handle_system(const Instruction &inst) {
+    LogInstrucao log_ss(log_ativo);
+
+    uint32_t rd = inst.rd();
+    uint32_t rs1 = inst.rs1(); // Nas versões com imediato, é o próprio zimm
+    uint32_t endereco_csr = static_cast<uint32_t>(inst.imediato_tipo_I()) & 0xFFF;
+    uint32_t funct3 = inst.funct3();
+
+    static const char* nomes[] = {"", "CSRRW", "CSRRS", "CSRRC", "", "CSRRWI", "CSRRSI", "CSRRCI"};
+
+    if (funct3 == 0x0 && endereco_csr == 0x0 && rd == 0 && rs1 == 0) {
+        return handle_ecall();
+    }
+
+    if (funct3 == 0x0 || funct3 == 0x4) {
+        log_ss << "ERRO: Instrucao SYSTEM nao suportada: 0x" << std::hex << inst.palavra_instrucao;
+        contador_programa += 4;
+        return log_ss.str();
+    }
+
+    if (funct3 >= 0x5) {
+        log_ss << "Executando " << nomes[funct3] << " x" << std::dec << rd << ", 0x"
+                << std::hex << endereco_csr << ", " << std::dec << rs1;
+    } else {
+        log_ss << "Executando " << nomes[funct3] << " x" << std::dec << rd << ", 0x"
+                << std::hex << endereco_csr << ", x" << std::dec << rs1;
+    }
+
+    uint32_t antigo = 0;
+    if (!ler_csr(endereco_csr, antigo)) {
+        log_ss << " -> ERRO: CSR inexistente";
+        contador_programa += 4;
+        return log_ss.str();
+    }
+
+    uint32_t operando = (funct3 >= 0x5) ? rs1 : registradores[rs1];
+
+    // CSRRS/CSRRC com operando x0 (ou zimm 0) apenas leem o CSR
+    bool escreve = (funct3 & 0x3) == 0x1 || rs1 != 0;
+    if (escreve) {
+        uint32_t novo = operando;
+        if ((funct3 & 0x3) == 0x2) novo = antigo | operando;
+        if ((funct3 & 0x3) == 0x3) novo = antigo & ~operando;
+
+        if (!escrever_csr(endereco_csr, novo)) {
+            log_ss << " -> ERRO: CSR somente leitura";
+            contador_programa += 4;
+            return log_ss.str();
+        }
+    }
+
+    if (rd != 0) {
+        registradores[rd] = antigo;
+    }
+
+    contador_programa += 4;
+    return log_ss.str();
+}
+
+uint64_t Core::valor_evento(EventoHpm evento) const {
+    const EstatisticasCache& ec = cache->getEstatisticas();
+    switch (evento) {
+        case EventoHpm::Loads: return contadores.loads;
+        case EventoHpm::Stores: return contadores.stores;
+        case EventoHpm::Desvios: return contadores.desvios;
+        case EventoHpm::DesviosTomados: return contadores.desvios_tomados;
+        case EventoHpm::Saltos: return contadores.saltos;
+        case EventoHpm::Multiplicacoes: return contadores.multiplicacoes;
+        case EventoHpm::Divisoes: return contadores.divisoes;
+        case EventoHpm::LeiturasCache: return ec.leituras;
+        case EventoHpm::AcertosLeituraCache: return ec.acertos_leitura;
+        case EventoHpm::FaltasLeituraCache: return ec.faltas_leitura;
+        case EventoHpm::EscritasCache: return ec.escritas;
+        case EventoHpm::AcertosEscritaCache: return ec.acertos_escrita;
+        case EventoHpm::FaltasEscritaCache: return ec.faltas_escrita;
+        case EventoHpm::CiclosParadosMemoria: return ec.ciclos_parados;
+        default: return 0;
+    }
+}
+
+uint64_t Core::valor_contador(uint32_t indice) const {
+    switch (indice) {
+        case 0: return contadores.ciclos;
+        case 1: return ciclos_tempo / csr::DIVISOR_TIME;
+        case 2: return contadores.instrucoes;
+        default: {
+            const ContadorHpm& c = contadores_hpm[indice - 3];
+            if (mcountinhibit & (1u << indice)) return c.base;
+            return c.base + (valor_evento(c.evento) - c.referencia);
+        }
+    }
+}
+
+void Core::definir_contador(uint32_t indice, uint64_t valor) {
+    switch (indice) {
+        case 0: contadores.ciclos = valor;
+            break;
+        case 2: contadores.instrucoes = valor;
+            break;
+        default: {
+            ContadorHpm& c = contadores_hpm[indice - 3];
+            c.base = valor;
+            c.referencia = valor_evento(c.evento);
+            break;
+        }
+    }
+}
+
+bool Core::ler_csr(uint32_t endereco, uint32_t &valor) const {
+    uint32_t indice = endereco & 0x1F;
+
+    if ((endereco >= csr::CYCLE && endereco <= csr::HPMCOUNTER31) ||
+        (endereco >= csr::MCYCLE && endereco <= csr::MHPMCOUNTER31 && endereco != csr::MCYCLE + 1)) {
+        valor = static_cast<uint32_t>(valor_contador(indice));
+        return true;
+    }
+    if ((endereco >= csr::CYCLEH && endereco <= csr::HPMCOUNTER31H) ||
+        (endereco >= csr::MCYCLEH && endereco <= csr::MHPMCOUNTER31H && endereco != csr::MCYCLEH + 1)) {
+        valor = static_cast<uint32_t>(valor_contador(indice) >> 32);
+        return true;
+    }
+    if (endereco >= csr::MHPMEVENT3 && endereco <= csr::MHPMEVENT31) {
+        valor = static_cast<uint32_t>(contadores_hpm[endereco - csr::MHPMEVENT3].evento);
+        return true;
+    }
+
+    switch (endereco) {
+        case csr::MCOUNTINHIBIT: valor = mcountinhibit;
+            return true;
+        case csr::MSCRATCH: valor = mscratch;
+            return true;
+        case csr::MHARTID: valor = 0;
+            return true;
+        case csr::VSTART: valor = vstart;
+            return true;
+        case csr::VXSAT: valor = vcsr & 0x1;
+            return true;
+        case csr::VXRM: valor = (vcsr >> 1) & 0x3;
+            return true;
+        case csr::VCSR: valor = vcsr;
+            return true;
+        case csr::VL: valor = vl;
+            return true;
+        case csr::VTYPE: valor = vtype;
+            return true;
+        case csr::VLENB: valor = vetorial::VLENB;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool Core::escrever_csr(uint32_t endereco, uint32_t valor) {
+    uint32_t indice = endereco & 0x1F;
+
+    if (endereco >= csr::MCYCLE && endereco <= csr::MHPMCOUNTER31 && endereco != csr::MCYCLE + 1) {
+        uint64_t atual = valor_contador(indice);
+        definir_contador(indice, (atual & 0xFFFFFFFF00000000ull) | valor);
+        return true;
+    }
+    if (endereco >= csr::MCYCLEH && endereco <= csr::MHPMCOUNTER31H && endereco != csr::MCYCLEH + 1) {
+        uint64_t atual = valor_contador(indice);
+        definir_contador(indice, (atual & 0xFFFFFFFFull) | (static_cast<uint64_t>(valor) << 32));
+        return true;
+    }
+    if (endereco >= csr::MHPMEVENT3 && endereco <= csr::MHPMEVENT31) {
+        uint32_t n = endereco - csr::MHPMEVENT3 + 3;
+        // Congela o valor atual antes de trocar o evento contado
+        uint64_t atual = valor_contador(n);
+        ContadorHpm& c = contadores_hpm[n - 3];
+        c.evento = valor < static_cast<uint32_t>(EventoHpm::Total) ? static_cast<EventoHpm>(valor) : EventoHpm::Nenhum;
+        c.base = atual;
+        c.referencia = valor_evento(c.evento);
+        return true;
+    }
+
+    switch (endereco) {
+        case csr::MCOUNTINHIBIT: {
+            // Ao inibir, guarda o valor atual; ao liberar, recomeça a contar a partir dele
+            for (uint32_t n = 3; n < 32; ++n) {
+                ContadorHpm& c = contadores_hpm[n - 3];
+                bool estava_inibido = mcountinhibit & (1u << n);
+                bool fica_inibido = valor & (1u << n);
+                if (!estava_inibido && fica_inibido) {
+                    c.base = valor_contador(n);
+                } else if (estava_inibido && !fica_inibido) {
+                    c.referencia = valor_evento(c.evento);
+                }
+            }
+            mcountinhibit = valor & ~0x2u; // 'time' não pode ser inibido
+            return true;
+        }
+        case csr::MSCRATCH: mscratch = valor;
+            return true;
+        case csr::VSTART: vstart = valor & (vetorial::VLEN - 1);
+            return true;
+        case csr::VXSAT: vcsr = (vcsr & ~0x1u) | (valor & 0x1);
+            return true;
+        case csr::VXRM: vcsr = (vcsr & 0x1) | ((valor & 0x3) << 1);
+            return true;
+        case csr::VCSR: vcsr = valor & 0x7;
+            return true;
+        default:
+            return false;
+    }
+}
+
+std::string Core::configurar_evento_hpm(uint32_t contador, EventoHpm evento) {
+    if (contador < 3 || contador > 31) {
+        std::stringstream ss;
+        ss << "[ERRO] Contador de desempenho invalido: " << contador;
+        return ss.str();
+    }
+    escrever_csr(csr::MHPMEVENT3 + contador - 3, static_cast<uint32_t>(evento));
+    return "";
+}
+
+void Core::definir_modo(ModoExecucao novo) {
+    modo_inicial = novo;
+    trocar_modo(novo);
+}
+
+void Core::definir_log(bool ativo) {
+    log_ativo = ativo;
+}
+
+bool Core::log_ligado() const {
+    return log_ativo;
+}
+
+ModoExecucao Core::get_modo() const {
+    return modo;
+}
+
+void Core::adicionar_gatilho_modo(const GatilhoModo &gatilho) {
+    gatilhos_modo.push_back({gatilho, false});
+}
+
+void Core::limpar_gatilhos_modo() {
+    gatilhos_modo.clear();
+}
+
+const ContadoresDetalhado &Core::get_contadores_detalhado() const {
+    return contadores_detalhado;
+}
+
+/**
+ * @brief Troca o modo de execução.
+ *
+ * Ao sair do modo funcional, as linhas válidas do cache são recarregadas da RAM,
+ * porque as escritas feitas nesse modo não passaram por ele. As estatísticas do
+ * cache só são coletadas no modo detalhado.
+ */
+void Core::trocar_modo(ModoExecucao novo) {
+    if (novo == modo) return;
+    if (modo == ModoExecucao::Funcional) {
+        cache->recarregarLinhasValidas();
+    }
+    cache->definirColetaEstatisticas(novo == ModoExecucao::Detalhado);
+    modo = novo;
+}
+
+void Core::verificar_gatilhos_modo() {
+    for (GatilhoArmado &armado : gatilhos_modo) {
+        const GatilhoModo &gatilho = armado.gatilho;
+        if (gatilho.tipo == GatilhoModo::Tipo::Pc) {
+            if (contador_programa == gatilho.valor) trocar_modo(gatilho.modo);
+        } else if (!armado.disparado && contadores.instrucoes >= gatilho.valor) {
+            armado.disparado = true;
+            trocar_modo(gatilho.modo);
+        }
+    }
+}
+
 uint8_t Core::get_byte_memoria(uint32_t endereco) const {
-    if (endereco >= memoria.size()) {
-        // Endereço fora dos limites, retorna 0
-        return 0;
+    // Lê direto da RAM (ou ROM); endereços não mapeados e de dispositivos retornam 0
+    uint8_t valor = 0;
+    barramento.espiar_byte(endereco, valor);
+    return valor;
+}
+
+void Core::espiar_bloco_memoria(uint32_t endereco, uint8_t *destino, uint32_t tamanho) const {
+    if (barramento.na_ram(endereco, tamanho)) {
+        std::copy_n(memoria.begin() + endereco, tamanho, destino);
+        return;
+    }
+    for (uint32_t i = 0; i < tamanho; ++i) {
+        destino[i] = get_byte_memoria(endereco + i);
     }
-    // Retorna o byte diretamente da memória principal
-    return memoria[endereco];
+}
+
+bool Core::tipo_memoria(uint32_t endereco, TipoRegiao &tipo) const {
+    return barramento.tipo_regiao(endereco, tipo);
+}
+
+/**
+ * @brief Lê uma palavra (little-endian) direto da memória principal, sem passar pelo cache.
+ */
+uint32_t Core::get_palavra_memoria(uint32_t endereco) const {
+    uint32_t valor = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        valor |= static_cast<uint32_t>(get_byte_memoria(endereco + i)) << (8 * i);
+    }
+    return valor;
+}
+
+/**
+ * @brief ECALL: repassa a chamada de sistema (número em a7, argumentos em a0..a5) ao ProxySyscalls.
+ */
+std::string Core::handle_ecall() {
+    LogInstrucao log_ss(log_ativo);
+
+    uint32_t numero = registradores[17];
+    std::array<uint32_t, 6> argumentos{};
+    std::copy_n(registradores + 10, argumentos.size(), argumentos.begin());
+
+    log_ss << "Executando ECALL " << ProxySyscalls::nome_syscall(numero) << " (a7=" << std::dec << numero << ")";
+
+    contador_programa += 4;
+    int32_t resultado = proxy_syscalls->executar(*this, numero, argumentos);
+
+    if (proxy_syscalls->consumir_interrupcao()) {
+        // A ECALL não se completa: o PC volta para ela e nada é escrito nem contado
+        contador_programa -= 4;
+        ecall_interrompida = true;
+        log_ss << " -> interrompida esperando entrada; sera refeita";
+        return log_ss.str();
+    }
+
+    if (finalizado_por_exit) {
+        log_ss << " -> programa encerrado com codigo " << codigo_saida;
+        return log_ss.str();
+    }
+
+    if (resultado == -ENOSYS) {
+        log_ss << " -> ERRO: syscall nao suportada";
+    } else {
+        log_ss << " -> a0 = " << resultado;
+    }
+    registradores[10] = static_cast<uint32_t>(resultado);
+    ultimo_commit.rd = 10;
+    ultimo_commit.valor_rd = registradores[10];
+    return log_ss.str();
 }
@@ -3,23 +3,193 @@
 #ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_CORE_H
 #define SIMULADOR_DE_PROCESSADOR_RISC_V_CORE_H
 
+#include <array>
 #include <vector>
 #include <memory>
+#include <string>
 
+#include "Csr.h"
 #include "Instruction.h"
+#include "KernelsVetoriais.h"
+#include "RegistroCommit.h"
 #include "../cache/Cache.h"
+#include "../bus/Barramento.h"
+#include "../bus/Dispositivos.h"
+
+class ProxySyscalls;
+
+// Contadores de instruções mantidos pelo Core (acumulados desde o último reset)
+struct ContadoresCore {
+    uint64_t ciclos = 0;
+    uint64_t instrucoes = 0;
+    uint64_t loads = 0;
+    uint64_t stores = 0;
+    uint64_t desvios = 0;
+    uint64_t desvios_tomados = 0;
+    uint64_t saltos = 0;
+    uint64_t multiplicacoes = 0;
+    uint64_t divisoes = 0;
+};
+
+// Modos de execução, trocáveis no meio da simulação:
+//   Funcional:   acessa a RAM direto, sem passar pelo cache (o mais rápido)
+//   Aquecimento: atualiza as linhas do cache, sem contar estatísticas nem ciclos parados
+//   Detalhado:   modela e conta tudo
+enum class ModoExecucao : uint8_t {
+    Funcional,
+    Aquecimento,
+    Detalhado
+};
+
+// Troca de modo agendada. Instrucoes: uma vez, quando minstret chegar a 'valor'.
+// Pc: toda vez que o PC for 'valor', antes de buscar a instrução.
+struct GatilhoModo {
+    enum class Tipo : uint8_t { Instrucoes, Pc };
+    Tipo tipo = Tipo::Instrucoes;
+    uint64_t valor = 0;
+    ModoExecucao modo = ModoExecucao::Detalhado;
+};
+
+// O guest troca de modo com "slti x0, x0, imm", um HINT de uso livre (nop no hardware real)
+namespace instrucao_magica {
+    constexpr int32_t MODO_FUNCIONAL = 1;
+    constexpr int32_t MODO_AQUECIMENTO = 2;
+    constexpr int32_t MODO_DETALHADO = 3;
+}
+
+// Instruções e ciclos executados em modo Detalhado (a região de interesse), desde o último reset
+struct ContadoresDetalhado {
+    uint64_t instrucoes = 0;
+    uint64_t ciclos = 0;
+};
+
+// Página de RAM imutável: compartilhada entre snapshots, e com o Core até ser escrita
+using PaginaMemoria = std::vector<uint8_t>;
+
+// RAM inteira como uma tabela de páginas; duas imagens compartilham as páginas iguais
+struct ImagemMemoria {
+    std::vector<std::shared_ptr<const PaginaMemoria>> paginas;
+};
+
+class SnapshotCore;
 
 class Core {
 public:
     explicit Core(size_t tamanho_memoria);
+    ~Core();
     void reset();
+
+    // Imagem base para reexecução rápida: a partir da marcação, as páginas de RAM escritas
+    // são rastreadas, e restaurar_imagem_base() copia de volta só essas páginas antes do reset()
+    static constexpr uint32_t TAMANHO_PAGINA_BASE = 4096;
+    void marcar_imagem_base();
+    void restaurar_imagem_base();
+    bool tem_imagem_base() const;
+    size_t get_paginas_sujas() const;
+
+    // Snapshot do estado arquitetural (registradores, PC, contadores, RAM, cache, CLINT e UART). A RAM
+    // é guardada em páginas compartilhadas: o custo é proporcional às páginas escritas
+    // desde o último snapshot ou restauração. Um snapshot pode ser restaurado em quantos
+    // Cores (ou quantas vezes) for preciso; cada um segue de forma independente.
+    // Outros dispositivos do barramento (ROM, disco) e o estado das syscalls não fazem parte do snapshot.
+    SnapshotCore criar_snapshot();
+    std::string restaurar_snapshot(const SnapshotCore& snapshot);
+
+    // Execução reversa: cada instrução guarda num anel de 'capacidade' entradas o PC, o valor
+    // anterior de rd e os bytes que sobrescreveu na RAM, e a cada 'intervalo_snapshots'
+    // instruções é tirado um snapshot. Voltar até o tamanho do anel desfaz as entradas; mais
+    // longe, restaura o snapshot anterior ao ponto pedido e reexecuta até ele. O custo é
+    // proporcional à distância percorrida (no máximo um intervalo de reexecução).
+    // Ecall, escrita de CSR, instruções vetoriais e acesso a dispositivos não cabem numa
+    // entrada do anel: o histórico recomeça depois deles, assim como depois de reset,
+    // load_program e set_register.
+    // Desfazer entradas não volta os contadores de desempenho (só 'instrucoes') nem o estado e
+    // as estatísticas do cache, do buffer de escrita e da DRAM; com 'exato', a volta sempre
+    // restaura um snapshot e reexecuta, e todo esse estado volta junto. Capacidade 0 desliga.
+    void definir_execucao_reversa(size_t capacidade, uint64_t intervalo_snapshots = 65536,
+                                  size_t maximo_snapshots = 32);
+    bool execucao_reversa_ativa() const;
+    // Quantas instruções é possível voltar a partir do ponto atual
+    uint64_t get_passos_reversiveis(bool exato = false) const;
+    // Retornam uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string voltar_instrucoes(uint64_t quantidade, bool exato = false);
+    // Volta até antes da última instrução (dentro do anel) que escreveu em 'endereco'
+    std::string voltar_ate_escrita(uint32_t endereco, uint64_t& distancia, bool exato = false);
+
     std::array<uint32_t, 32> get_registradores() const;
+    // Extensão V: VLENB bytes por registrador, de v0 a v31, com os elementos em little-endian
+    using BancoVetorial = std::array<uint8_t, vetorial::NUM_REGISTRADORES * vetorial::VLENB>;
+    const BancoVetorial& get_registradores_vetoriais() const;
+    uint32_t get_vl() const;
+    uint32_t get_vtype() const;
     void load_program(const std::vector<uint32_t>& programa);
     std::string step();
+    // Texto devolvido por step() (ligado por padrão). Desligado, step() devolve string vazia
+    // e as instruções não formatam nada, o que deixa o passo bem mais rápido
+    void definir_log(bool ativo);
+    bool log_ligado() const;
     uint32_t get_program_counter() const;
+    // PC depois da instrução nula ou do exit do guest: ímpar, nenhum desvio chega nele
+    static constexpr uint32_t PC_FINALIZADO = UINT32_MAX;
+    // Terminou quando o PC não está numa região executável do mapa (RAM ou ROM)
     bool is_finished() const;
     std::string set_register(int reg_index, uint32_t valor);
     uint8_t get_byte_memoria(uint32_t endereco) const;
+    uint32_t get_palavra_memoria(uint32_t endereco) const;
+    // Cópia em bloco para visualização, sem efeitos colaterais (MMIO e não mapeado viram 0)
+    void espiar_bloco_memoria(uint32_t endereco, uint8_t* destino, uint32_t tamanho) const;
+    bool tipo_memoria(uint32_t endereco, TipoRegiao& tipo) const;
+
+    // Rastreamento de escritas: marca os bytes escritos dentro de [inicio, inicio + tamanho)
+    void definir_janela_escritas(uint32_t inicio, uint32_t tamanho);
+    // Uma marca por byte da janela (1 = escrito desde a chamada anterior); zera as marcas
+    std::vector<uint8_t> consumir_escritas_janela();
+    const RegistroCommit& get_ultimo_commit() const;
+    const ContadoresCore& get_contadores() const;
+    const EstatisticasCache& get_estatisticas_cache() const;
+    // Modelo de DRAM atrás do cache (só usado fora do modo funcional); reconfigurar zera o
+    // estado dos bancos e as estatísticas. Retorna uma mensagem de erro ou string vazia
+    std::string configurar_dram(const ConfigDram& config);
+    const ConfigDram& get_config_dram() const;
+    const EstatisticasDram& get_estatisticas_dram() const;
+    // Buffer de escrita entre o cache e a DRAM (entradas = 0 desliga); reconfigurar o esvazia
+    std::string configurar_buffer_escrita(const ConfigBufferEscrita& config);
+    const ConfigBufferEscrita& get_config_buffer_escrita() const;
+    const EstatisticasBufferEscrita& get_estatisticas_buffer_escrita() const;
+    // Estado das linhas do cache para visualização, e os índices das que mudaram desde a última consulta
+    uint32_t get_linhas_cache() const;
+    EstadoLinhaCache get_estado_linha_cache(uint32_t indice) const;
+    void consumir_alteracoes_cache(std::vector<uint32_t>& indices);
+    Barramento& get_barramento();
+    ProxySyscalls& get_proxy_syscalls();
+    // A saída da UART vai para o stdout do guest (ver ProxySyscalls); a entrada vem de enviar_entrada()
+    Uart& get_uart();
+    size_t get_tamanho_memoria() const;
+
+    // Cópia direta entre o host e a RAM do guest (usada pelas syscalls); false se sair da RAM
+    bool ler_bloco_memoria(uint32_t endereco, uint8_t* destino, uint32_t tamanho) const;
+    bool escrever_bloco_memoria(uint32_t endereco, const uint8_t* origem, uint32_t tamanho);
+
+    // Primeiro endereço depois do programa carregado (início do heap do brk)
+    uint32_t get_fim_programa() const;
+
+    // Termina a simulação como a chamada exit do guest
+    void encerrar(int32_t codigo);
+    bool encerrado() const;
+    int32_t get_codigo_saida() const;
+
+    // Programa o evento contado por mhpmcounterN (N entre 3 e 31), como uma escrita em mhpmeventN
+    std::string configurar_evento_hpm(uint32_t contador, EventoHpm evento);
+
+    // Modo de execução atual, que também passa a ser o modo depois de cada reset.
+    // Gatilhos e instruções mágicas mudam só o modo atual; o reset rearma os gatilhos.
+    void definir_modo(ModoExecucao modo);
+    // Muda só o modo atual, como um gatilho (ex: nas fronteiras de uma amostragem)
+    void trocar_modo(ModoExecucao novo);
+    ModoExecucao get_modo() const;
+    void adicionar_gatilho_modo(const GatilhoModo& gatilho);
+    void limpar_gatilhos_modo();
+    const ContadoresDetalhado& get_contadores_detalhado() const;
 
 private:
     uint32_t fetch();
@@ -31,14 +201,155 @@ private:
     std::string handle_store(const Instruction& inst);   // 0x23
     std::string handle_branch(const Instruction& inst); // 0x63
     std::string handle_lui(const Instruction& inst);      // 0x37
+    std::string handle_auipc(const Instruction& inst);    // 0x17
     std::string handle_jal(const Instruction& inst);      // 0x6F
+    std::string handle_jalr(const Instruction& inst);     // 0x67
+    std::string handle_system(const Instruction& inst);   // 0x73
+    std::string handle_ecall();
+
+    // Extensão V (CoreVetorial.cpp)
+    std::string handle_op_v(const Instruction& inst);                     // 0x57
+    std::string handle_memoria_v(const Instruction& inst, bool gravar);   // 0x07 e 0x27
+    std::string handle_vsetvl(const Instruction& inst);
+    uint8_t* registrador_vetorial(uint32_t indice);
+
+    // Acesso de 1, 2 ou 4 bytes: RAM pelo cache, o resto pelo barramento; false se não mapeado
+    bool ler_memoria(uint32_t endereco, uint32_t tamanho, uint32_t& valor);
+    bool escrever_memoria(uint32_t endereco, uint32_t valor, uint32_t tamanho);
+    void marcar_escrita(uint32_t endereco, uint32_t tamanho);
+    void marcar_pagina_suja(uint32_t endereco, uint32_t tamanho);
+    std::shared_ptr<const ImagemMemoria> capturar_memoria();
+    void restaurar_memoria(const std::shared_ptr<const ImagemMemoria>& imagem);
+    void aplicar_snapshot(const SnapshotCore& snapshot);
+
+    // Execução reversa (estado em Core.cpp)
+    struct EstadoReverso;
+    void iniciar_passo_reverso();
+    void concluir_passo_reverso(uint32_t instrucao);
+    void desfazer_ultima_entrada();
+    void descartar_historico_reverso();
+
+    void verificar_gatilhos_modo();
+
+    // Acesso aos CSRs (Zicsr); retornam false se o CSR não existe ou é somente leitura
+    bool ler_csr(uint32_t endereco, uint32_t& valor) const;
+    bool escrever_csr(uint32_t endereco, uint32_t valor);
+
+    // Contadores de 64 bits indexados como em cycle/time/instret/hpmcounterN (0..31)
+    uint64_t valor_contador(uint32_t indice) const;
+    void definir_contador(uint32_t indice, uint64_t valor);
+    uint64_t valor_evento(EventoHpm evento) const;
 
     uint32_t registradores[32];
     uint32_t contador_programa;
     std::vector<uint8_t> memoria;
 
+    // Mapa de endereços: a RAM é 'memoria'; ROM e dispositivos ficam acima dela
+    Barramento barramento;
+    // Dispositivos padrão, que pertencem ao barramento; o reset os reinicia
+    Clint* clint = nullptr;
+    Uart* uart = nullptr;
+
+    // Resumo da última instrução executada (ver RegistroCommit)
+    RegistroCommit ultimo_commit;
+
+    ContadoresCore contadores;
+    // Ciclos parados do cache já somados em contadores.ciclos
+    uint64_t ciclos_parados_contabilizados = 0;
+    // Ciclos decorridos desde o reset: base de 'time' e do mtime do CLINT. Ao contrário de
+    // contadores.ciclos (mcycle), não pode ser escrito pelo guest nem inibido
+    uint64_t ciclos_tempo = 0;
+
+    // mhpmcounterN = base + (evento atual - referencia), calculado só na leitura
+    struct ContadorHpm {
+        EventoHpm evento = EventoHpm::Nenhum;
+        uint64_t base = 0;
+        uint64_t referencia = 0;
+    };
+    std::array<ContadorHpm, csr::NUM_HPM> contadores_hpm;
+    uint32_t mcountinhibit = 0;
+    uint32_t mscratch = 0;
+
+    // Estado da extensão V; vcsr guarda vxrm (bits 2:1) e vxsat (bit 0)
+    BancoVetorial registradores_vetoriais{};
+    uint32_t vl = 0;
+    uint32_t vtype = vetorial::VTYPE_VILL;
+    uint32_t vstart = 0;
+    uint32_t vcsr = 0;
+
+    // Janela observada pelo rastreamento de escritas (vazia = desligado)
+    uint32_t janela_escritas_inicio = 0;
+    std::vector<uint8_t> escritas_janela;
+
+    // Cada página não suja da RAM é igual à página correspondente de imagem_sincronizada
+    // (a do último snapshot, marcação ou restauração; nula = rastreamento desligado).
+    // A marca por página evita repetir a página na lista de sujas.
+    std::shared_ptr<const ImagemMemoria> imagem_sincronizada;
+    std::vector<uint8_t> pagina_suja;
+    std::vector<uint32_t> paginas_sujas;
+
+    std::shared_ptr<const ImagemMemoria> imagem_base;
+    uint32_t fim_programa_base = 0;
+
+    uint32_t fim_programa = 0;
+    bool finalizado_por_exit = false;
+    int32_t codigo_saida = 0;
+    std::unique_ptr<ProxySyscalls> proxy_syscalls;
+    // A ECALL do passo atual foi interrompida pelo cancelamento do ProxySyscalls
+    bool ecall_interrompida = false;
+
     // ponteiro para o cache
     std::unique_ptr<Cache> cache;
+
+    // Anel de desfazer e snapshots periódicos (nulo = execução reversa desligada)
+    std::unique_ptr<EstadoReverso> reverso;
+
+    ModoExecucao modo = ModoExecucao::Detalhado;
+    ModoExecucao modo_inicial = ModoExecucao::Detalhado;
+    bool log_ativo = true;
+    struct GatilhoArmado {
+        GatilhoModo gatilho;
+        bool disparado = false;
+    };
+    std::vector<GatilhoArmado> gatilhos_modo;
+    ContadoresDetalhado contadores_detalhado;
+
+    friend class SnapshotCore;
+};
+
+// Estado salvo por Core::criar_snapshot(); copiar um snapshot é barato (a RAM é compartilhada)
+class SnapshotCore {
+public:
+    uint32_t get_program_counter() const;
+    const ContadoresCore& get_contadores() const;
+    size_t get_tamanho_memoria() const;
+
+private:
+    friend class Core;
+    // Serialização em disco (Checkpoint.h)
+    friend class GravadorCheckpoint;
+    friend std::string ler_checkpoint(const std::string& caminho, SnapshotCore& snapshot);
+
+    std::array<uint32_t, 32> registradores{};
+    uint32_t contador_programa = 0;
+    ContadoresCore contadores;
+    uint64_t ciclos_parados_contabilizados = 0;
+    uint64_t ciclos_tempo = 0;
+    std::array<Core::ContadorHpm, csr::NUM_HPM> contadores_hpm;
+    uint32_t mcountinhibit = 0;
+    uint32_t mscratch = 0;
+    Core::BancoVetorial registradores_vetoriais{};
+    uint32_t vl = 0;
+    uint32_t vtype = vetorial::VTYPE_VILL;
+    uint32_t vstart = 0;
+    uint32_t vcsr = 0;
+    uint32_t fim_programa = 0;
+    bool finalizado_por_exit = false;
+    int32_t codigo_saida = 0;
+    ImagemCache cache;
+    ImagemClint clint;
+    ImagemUart uart;
+    std::shared_ptr<const ImagemMemoria> memoria;
 };
 
 #endif //SIMULADOR_DE_PROCESSADOR_RISC_V_CORE_H
\ No newline at end of file
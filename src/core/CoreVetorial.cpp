@@ -0,0 +1,492 @@
+#include "Core.h"
+#include "LogInstrucao.h"
+#include "Desmontador.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+// Extensão V do Core: vsetvl*, aritmética inteira, comparações, reduções e loads/stores
+// unitários, espaçados e indexados. As operações elemento a elemento rodam nos kernels
+// SIMD de KernelsVetoriais; elementos inativos (máscara) e de cauda nunca são alterados.
+
+namespace {
+
+// vtype decodificado
+struct ConfigVetorial {
+    uint32_t sew = 0;          // bytes por elemento
+    int32_t lmul_log2 = 0;     // -3 (mf8) a 3 (m8)
+    bool valida = false;
+};
+
+ConfigVetorial decodificar_vtype(uint32_t vtype) {
+    ConfigVetorial config;
+    uint32_t vsew = (vtype >> 3) & 0x7;
+    uint32_t vlmul = vtype & 0x7;
+    // Bits reservados (ou vill), SEW acima de ELEN e vlmul reservado
+    if ((vtype & ~0xFFu) || vsew > 2 || vlmul == 0x4) return config;
+    config.sew = 1u << vsew;
+    config.lmul_log2 = vlmul < 4 ? static_cast<int32_t>(vlmul) : static_cast<int32_t>(vlmul) - 8;
+    // LMUL fracionário exige SEW <= LMUL * ELEN
+    if (config.lmul_log2 < 0 && ((8 * config.sew) << -config.lmul_log2) > vetorial::ELEN) return config;
+    config.valida = true;
+    return config;
+}
+
+uint32_t log2_bytes(uint32_t bytes) {
+    return bytes == 1 ? 0 : bytes == 2 ? 1 : 2;
+}
+
+// Elementos de 'sew' bytes num grupo de 2^lmul_log2 registradores
+uint32_t calcular_vlmax(uint32_t sew, int32_t lmul_log2) {
+    uint32_t bytes = lmul_log2 >= 0 ? vetorial::VLENB << lmul_log2 : vetorial::VLENB >> -lmul_log2;
+    return bytes / sew;
+}
+
+// Registradores ocupados por um grupo (LMUL fracionário ocupa um)
+uint32_t registros_grupo(int32_t lmul_log2) {
+    return lmul_log2 > 0 ? 1u << lmul_log2 : 1u;
+}
+
+enum class TipoOpV : uint8_t {
+    Aritmetica,
+    Comparacao,
+    Mesclagem,
+    Reducao,
+    MoverParaEscalar,
+    MoverDeEscalar,
+    Indice
+};
+
+struct DecodificacaoOpV {
+    TipoOpV tipo = TipoOpV::Aritmetica;
+    vetorial::Operacao op = vetorial::Operacao::Add;
+    vetorial::Comparacao cmp = vetorial::Comparacao::Eq;
+};
+
+// Semântica de uma instrução OP-V já validada pelo Desmontador (a forma existe)
+DecodificacaoOpV decodificar_op_v(uint32_t funct3, uint32_t funct6) {
+    using vetorial::Operacao;
+    DecodificacaoOpV d;
+    if (funct3 == 0x2 || funct3 == 0x6) {
+        static const Operacao reducoes[] = {Operacao::Add, Operacao::And, Operacao::Or, Operacao::Xor,
+                                            Operacao::MinU, Operacao::Min, Operacao::MaxU, Operacao::Max};
+        static const Operacao multiplicacoes[] = {Operacao::MulhU, Operacao::Mul, Operacao::MulhSU, Operacao::Mulh};
+        if (funct6 < 0x08) {
+            d.tipo = TipoOpV::Reducao;
+            d.op = reducoes[funct6];
+        } else if (funct6 == 0x10) {
+            d.tipo = funct3 == 0x2 ? TipoOpV::MoverParaEscalar : TipoOpV::MoverDeEscalar;
+        } else if (funct6 == 0x14) {
+            d.tipo = TipoOpV::Indice;
+        } else {
+            d.op = multiplicacoes[funct6 - 0x24];
+        }
+        return d;
+    }
+
+    switch (funct6) {
+        case 0x00: d.op = Operacao::Add;
+            break;
+        case 0x02: d.op = Operacao::Sub;
+            break;
+        case 0x03: d.op = Operacao::Rsub;
+            break;
+        case 0x04: d.op = Operacao::MinU;
+            break;
+        case 0x05: d.op = Operacao::Min;
+            break;
+        case 0x06: d.op = Operacao::MaxU;
+            break;
+        case 0x07: d.op = Operacao::Max;
+            break;
+        case 0x09: d.op = Operacao::And;
+            break;
+        case 0x0A: d.op = Operacao::Or;
+            break;
+        case 0x0B: d.op = Operacao::Xor;
+            break;
+        case 0x17: d.tipo = TipoOpV::Mesclagem;
+            break;
+        case 0x25: d.op = Operacao::Sll;
+            break;
+        case 0x28: d.op = Operacao::Srl;
+            break;
+        case 0x29: d.op = Operacao::Sra;
+            break;
+        default:
+            // 0x18..0x1F: vmseq, vmsne, vmsltu, vmslt, vmsleu, vmsle, vmsgtu, vmsgt
+            d.tipo = TipoOpV::Comparacao;
+            d.cmp = static_cast<vetorial::Comparacao>(funct6 - 0x18);
+            break;
+    }
+    return d;
+}
+
+}
+
+uint8_t* Core::registrador_vetorial(uint32_t indice) {
+    return registradores_vetoriais.data() + static_cast<size_t>(indice) * vetorial::VLENB;
+}
+
+/**
+ * @brief vsetvli, vsetivli e vsetvl: define vtype e vl = min(AVL, VLMAX).
+ *
+ * rs1 = x0 com rd != x0 pede VLMAX; com rd = x0 também, mantém o vl atual.
+ * Um vtype inválido liga vill e zera vl.
+ */
+std::string Core::handle_vsetvl(const Instruction &inst) {
+    LogInstrucao log_ss(log_ativo);
+    uint32_t palavra = inst.palavra_instrucao;
+    uint32_t rd = inst.rd();
+    uint32_t rs1 = inst.rs1();
+
+    log_ss << "Executando " << desmontar(palavra);
+    contador_programa += 4;
+
+    uint32_t novo_vtype = 0;
+    uint64_t avl = 0;
+    if (!(palavra >> 31)) {
+        novo_vtype = (palavra >> 20) & 0x7FF;
+    } else if ((palavra >> 30) == 0x3) {
+        novo_vtype = (palavra >> 20) & 0x3FF;
+    } else if ((palavra >> 25) == 0x40) {
+        novo_vtype = registradores[inst.rs2()];
+    } else {
+        log_ss << " -> ERRO: Instrucao vetorial nao suportada";
+        return log_ss.str();
+    }
+
+    if ((palavra >> 30) == 0x3) {
+        avl = rs1;
+    } else if (rs1 != 0) {
+        avl = registradores[rs1];
+    } else if (rd != 0) {
+        avl = UINT64_MAX;
+    } else {
+        avl = vl;
+    }
+
+    ConfigVetorial config = decodificar_vtype(novo_vtype);
+    if (config.valida) {
+        vtype = novo_vtype;
+        vl = static_cast<uint32_t>(std::min<uint64_t>(avl, calcular_vlmax(config.sew, config.lmul_log2)));
+        log_ss << " -> vl = " << std::dec << vl;
+    } else {
+        vtype = vetorial::VTYPE_VILL;
+        vl = 0;
+        log_ss << " -> vtype invalido (vill)";
+    }
+    vstart = 0;
+    if (rd != 0) {
+        registradores[rd] = vl;
+    }
+    return log_ss.str();
+}
+
+/**
+ * @brief (Opcode 0x57) Trata instruções OP-V: vsetvl*, aritmética inteira, comparações,
+ * vmerge/vmv, reduções, vmv.x.s/vmv.s.x, vid.v e vmv<nr>r.v.
+ *
+ * Os elementos de [vstart, vl) com a máscara ligada (v0, quando vm = 0) recebem o
+ * resultado; os demais e a cauda ficam como estavam.
+ */
+std::string Core::handle_op_v(const Instruction &inst) {
+    uint32_t funct3 = inst.funct3();
+    if (funct3 == 0x7) {
+        return handle_vsetvl(inst);
+    }
+
+    LogInstrucao log_ss(log_ativo);
+    uint32_t palavra = inst.palavra_instrucao;
+    contador_programa += 4;
+
+    const char* nome = mnemonico(palavra);
+    if (std::strcmp(nome, "desconhecida") == 0) {
+        log_ss << "ERRO: Instrucao vetorial nao suportada: 0x" << std::hex << palavra;
+        return log_ss.str();
+    }
+    log_ss << "Executando " << desmontar(palavra);
+
+    uint32_t funct6 = palavra >> 26;
+    bool vm = (palavra >> 25) & 0x1;
+    uint32_t vd = inst.rd();
+    uint32_t vs1 = inst.rs1();
+    uint32_t vs2 = inst.rs2();
+
+    // vmv<nr>r.v copia registradores inteiros, sem depender de vtype
+    if (funct3 == 0x3 && funct6 == 0x27) {
+        uint32_t registros = vs1 + 1;
+        if (vd % registros || vs2 % registros) {
+            log_ss << " -> ERRO: grupo de registradores desalinhado";
+            return log_ss.str();
+        }
+        std::copy_n(registrador_vetorial(vs2), registros * vetorial::VLENB, registrador_vetorial(vd));
+        vstart = 0;
+        return log_ss.str();
+    }
+
+    ConfigVetorial config = decodificar_vtype(vtype);
+    if (!config.valida) {
+        log_ss << " -> ERRO: vtype invalido (vill)";
+        return log_ss.str();
+    }
+
+    DecodificacaoOpV d = decodificar_op_v(funct3, funct6);
+    uint32_t sew = config.sew;
+    uint32_t grupo = registros_grupo(config.lmul_log2);
+    bool vetor_vetor = funct3 == 0x0 || funct3 == 0x2;
+    // OPIVI usa o simm5 estendido (os deslocamentos só olham os bits baixos, como o uimm5)
+    uint32_t escalar = funct3 == 0x3 ? static_cast<uint32_t>(static_cast<int32_t>(vs1 << 27) >> 27)
+                                     : registradores[vs1];
+    const uint8_t* mascara = vm ? nullptr : registrador_vetorial(0);
+    uint8_t* destino = registrador_vetorial(vd);
+    const uint8_t* fonte2 = registrador_vetorial(vs2);
+    const uint8_t* fonte1 = registrador_vetorial(vs1);
+
+    // Movimentos de um elemento: não dependem de LMUL
+    if (d.tipo == TipoOpV::MoverParaEscalar) {
+        uint32_t valor = vetorial::ler_elemento(fonte2, 0, sew);
+        uint32_t deslocamento = 32 - 8 * sew;
+        if (vd != 0) {
+            registradores[vd] = static_cast<uint32_t>(static_cast<int32_t>(valor << deslocamento) >> deslocamento);
+        }
+        vstart = 0;
+        return log_ss.str();
+    }
+    if (d.tipo == TipoOpV::MoverDeEscalar) {
+        if (vstart < vl) {
+            vetorial::escrever_elemento(destino, 0, sew, registradores[vs1]);
+        }
+        vstart = 0;
+        return log_ss.str();
+    }
+
+    // Comparações e reduções escrevem num registrador só (a máscara ou o elemento 0)
+    bool destino_unico = d.tipo == TipoOpV::Comparacao || d.tipo == TipoOpV::Reducao;
+    bool desalinhado = vs2 % grupo || (vetor_vetor && d.tipo != TipoOpV::Reducao && vs1 % grupo) ||
+                       (!destino_unico && vd % grupo);
+    if (desalinhado) {
+        log_ss << " -> ERRO: grupo de registradores desalinhado";
+        return log_ss.str();
+    }
+    // Com máscara (ou no vmerge, que usa v0 como seletor), o destino não pode ser v0
+    if (!vm && vd == 0 && !destino_unico) {
+        log_ss << " -> ERRO: destino sobrepoe a mascara v0";
+        return log_ss.str();
+    }
+
+    uint32_t n = vl;
+    log_ss << " -> vl = " << std::dec << n;
+    if (vstart >= n) {
+        vstart = 0;
+        return log_ss.str();
+    }
+
+    // Resultado completo de [0, vl) antes de aplicar vstart e a máscara (cabe num grupo de 8 registradores)
+    std::array<uint8_t, 8 * vetorial::VLENB> resultado;
+    // Sem máscara e sem vstart, o kernel escreve direto no destino
+    bool direto = !mascara && vstart == 0;
+
+    switch (d.tipo) {
+        case TipoOpV::Aritmetica: {
+            uint8_t* saida = direto ? destino : resultado.data();
+            if (vetor_vetor) {
+                vetorial::operar(d.op, sew, saida, fonte2, fonte1, n);
+            } else {
+                vetorial::operar_escalar(d.op, sew, saida, fonte2, escalar, n);
+            }
+            if (!direto) vetorial::mesclar(sew, destino, resultado.data(), mascara, vstart, n);
+            break;
+        }
+        case TipoOpV::Comparacao:
+            if (vetor_vetor) {
+                vetorial::comparar(d.cmp, sew, resultado.data(), fonte2, fonte1, n);
+            } else {
+                vetorial::comparar_escalar(d.cmp, sew, resultado.data(), fonte2, escalar, n);
+            }
+            vetorial::mesclar_bits(destino, resultado.data(), mascara, vstart, n);
+            break;
+        case TipoOpV::Mesclagem: {
+            // vmerge: o operando onde v0 = 1 e vs2 onde v0 = 0; vmv.v.*: só o operando
+            const uint8_t* operando = fonte1;
+            if (!vetor_vetor) {
+                vetorial::preencher(sew, resultado.data(), escalar, n);
+                operando = resultado.data();
+            }
+            if (mascara) {
+                std::array<uint8_t, 8 * vetorial::VLENB> selecionado;
+                std::copy_n(fonte2, static_cast<size_t>(n) * sew, selecionado.begin());
+                vetorial::mesclar(sew, selecionado.data(), operando, mascara, 0, n);
+                vetorial::mesclar(sew, destino, selecionado.data(), nullptr, vstart, n);
+            } else {
+                vetorial::mesclar(sew, destino, operando, nullptr, vstart, n);
+            }
+            break;
+        }
+        case TipoOpV::Reducao: {
+            // vd[0] = vs1[0] op (elementos ativos de vs2)
+            uint32_t acumulado = vetorial::ler_elemento(fonte1, 0, sew);
+            for (uint32_t i = 0; i < n; ++i) {
+                if (!mascara || vetorial::bit_mascara(mascara, i)) {
+                    acumulado = vetorial::operar_elemento(d.op, sew, acumulado, vetorial::ler_elemento(fonte2, i, sew));
+                }
+            }
+            vetorial::escrever_elemento(destino, 0, sew, acumulado);
+            break;
+        }
+        case TipoOpV::Indice:
+            for (uint32_t i = 0; i < n; ++i) {
+                vetorial::escrever_elemento(resultado.data(), i, sew, i);
+            }
+            vetorial::mesclar(sew, destino, resultado.data(), mascara, vstart, n);
+            break;
+        default:
+            break;
+    }
+
+    vstart = 0;
+    return log_ss.str();
+}
+
+/**
+ * @brief (Opcodes 0x07 e 0x27) Loads e stores vetoriais: unitários (inclusive vlm/vsm e os
+ * de registradores inteiros), espaçados e indexados. Segmentos (nf > 0) não são suportados.
+ *
+ * Cada elemento passa por ler_memoria/escrever_memoria (cache e barramento); no modo
+ * funcional, um acesso contíguo sem máscara que está todo na RAM vira uma cópia só.
+ * A instrução conta como um load ou um store.
+ */
+std::string Core::handle_memoria_v(const Instruction &inst, bool gravar) {
+    LogInstrucao log_ss(log_ativo);
+    uint32_t palavra = inst.palavra_instrucao;
+    contador_programa += 4;
+
+    const char* nome = mnemonico(palavra);
+    if (std::strcmp(nome, "desconhecida") == 0) {
+        log_ss << "ERRO: " << (gravar ? "Store" : "Load") << " vetorial nao suportado: 0x" << std::hex << palavra;
+        return log_ss.str();
+    }
+    log_ss << "Executando " << desmontar(palavra);
+
+    uint32_t funct3 = inst.funct3();
+    uint32_t eew = funct3 == 0x0 ? 1 : funct3 == 0x5 ? 2 : 4;
+    uint32_t mop = (palavra >> 26) & 0x3;
+    uint32_t lumop = inst.rs2();
+    bool vm = (palavra >> 25) & 0x1;
+    uint32_t vd = inst.rd();
+    bool registradores_inteiros = mop == 0x0 && lumop == 0x08;
+    bool mascara_unitaria = mop == 0x0 && lumop == 0x0B;
+    bool indexado = mop & 0x1;
+
+    // Largura de cada dado, elementos acessados e registradores do grupo de dados
+    uint32_t largura = eew;
+    uint32_t n = 0;
+    uint32_t registros = 1;
+    if (registradores_inteiros) {
+        registros = (palavra >> 29) + 1;
+        n = registros * vetorial::VLENB / eew;
+    } else {
+        ConfigVetorial config = decodificar_vtype(vtype);
+        if (!config.valida) {
+            log_ss << " -> ERRO: vtype invalido (vill)";
+            return log_ss.str();
+        }
+        if (mascara_unitaria) {
+            largura = 1;
+            n = (vl + 7) / 8;
+        } else {
+            // EMUL = EEW / SEW * LMUL; nos indexados isso vale para os índices, e os dados usam SEW e LMUL
+            int32_t emul_log2 = config.lmul_log2 + static_cast<int32_t>(log2_bytes(eew)) -
+                                static_cast<int32_t>(log2_bytes(config.sew));
+            if (emul_log2 < -3 || emul_log2 > 3) {
+                log_ss << " -> ERRO: EMUL fora do intervalo";
+                return log_ss.str();
+            }
+            n = vl;
+            if (indexado) {
+                largura = config.sew;
+                registros = registros_grupo(config.lmul_log2);
+                if (inst.rs2() % registros_grupo(emul_log2)) {
+                    log_ss << " -> ERRO: grupo de registradores desalinhado";
+                    return log_ss.str();
+                }
+            } else {
+                registros = registros_grupo(emul_log2);
+            }
+        }
+    }
+    if (vd % registros) {
+        log_ss << " -> ERRO: grupo de registradores desalinhado";
+        return log_ss.str();
+    }
+    // vlm/vsm e os de registradores inteiros não têm máscara
+    const uint8_t* mascara = (vm || registradores_inteiros || mascara_unitaria) ? nullptr : registrador_vetorial(0);
+    if (mascara && vd == 0 && !gravar) {
+        log_ss << " -> ERRO: destino sobrepoe a mascara v0";
+        return log_ss.str();
+    }
+
+    uint32_t base = registradores[inst.rs1()];
+    auto passo = static_cast<int32_t>(mop == 0x2 ? registradores[inst.rs2()] : largura);
+    uint8_t* dados = registrador_vetorial(vd);
+    const uint8_t* indices = registrador_vetorial(inst.rs2());
+
+    if (gravar) {
+        contadores.stores++;
+    } else {
+        contadores.loads++;
+    }
+    ultimo_commit.acesso = gravar ? AcessoMemoria::Escrita : AcessoMemoria::Leitura;
+    ultimo_commit.tamanho_acesso = largura;
+
+    auto endereco_elemento = [&](uint32_t i) {
+        if (indexado) return base + vetorial::ler_elemento(indices, i, eew);
+        return base + static_cast<uint32_t>(static_cast<int64_t>(i) * passo);
+    };
+
+    uint32_t inicio = vstart;
+    bool contiguo = !indexado && !mascara && passo == static_cast<int32_t>(largura);
+    uint32_t bytes = inicio < n ? (n - inicio) * largura : 0;
+    bool primeiro = true;
+    if (modo == ModoExecucao::Funcional && contiguo && bytes > 0 &&
+        barramento.na_ram(endereco_elemento(inicio), bytes)) {
+        uint32_t endereco = endereco_elemento(inicio);
+        uint8_t* bloco = dados + static_cast<size_t>(inicio) * largura;
+        if (gravar) {
+            escrever_bloco_memoria(endereco, bloco, bytes);
+        } else {
+            ler_bloco_memoria(endereco, bloco, bytes);
+        }
+        ultimo_commit.endereco_memoria = endereco;
+        ultimo_commit.dado_memoria = vetorial::ler_elemento(dados, inicio, largura);
+    } else {
+        bool falhou = false;
+        for (uint32_t i = inicio; i < n; ++i) {
+            if (mascara && !vetorial::bit_mascara(mascara, i)) continue;
+            uint32_t endereco = endereco_elemento(i);
+            uint32_t valor = 0;
+            bool ok;
+            if (gravar) {
+                valor = vetorial::ler_elemento(dados, i, largura);
+                ok = escrever_memoria(endereco, valor, largura);
+            } else {
+                ok = ler_memoria(endereco, largura, valor);
+                vetorial::escrever_elemento(dados, i, largura, valor);
+            }
+            if (primeiro) {
+                ultimo_commit.endereco_memoria = endereco;
+                ultimo_commit.dado_memoria = valor;
+                primeiro = false;
+            }
+            if (!ok && !falhou) {
+                log_ss << " -> ERRO: endereco nao mapeado (0x" << std::hex << endereco << ")";
+                falhou = true;
+            }
+        }
+    }
+
+    log_ss << " -> " << std::dec << (inicio < n ? n - inicio : 0) << " elementos";
+    vstart = 0;
+    return log_ss.str();
+}
@@ -0,0 +1,83 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_CSR_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_CSR_H
+
+#include <cstdint>
+
+/**
+ * Endereços dos CSRs (Zicsr) implementados pelo Core.
+ * Todo o código roda em modo máquina, então os contadores de usuário
+ * (cycle, time, instret, hpmcounterN) são apenas cópias somente-leitura
+ * dos contadores de máquina.
+ */
+namespace csr {
+    // Contadores de usuário (somente leitura)
+    constexpr uint32_t CYCLE = 0xC00;
+    constexpr uint32_t TIME = 0xC01;
+    constexpr uint32_t INSTRET = 0xC02;
+    constexpr uint32_t HPMCOUNTER3 = 0xC03;
+    constexpr uint32_t HPMCOUNTER31 = 0xC1F;
+    constexpr uint32_t CYCLEH = 0xC80;
+    constexpr uint32_t TIMEH = 0xC81;
+    constexpr uint32_t INSTRETH = 0xC82;
+    constexpr uint32_t HPMCOUNTER3H = 0xC83;
+    constexpr uint32_t HPMCOUNTER31H = 0xC9F;
+
+    // Contadores de máquina (leitura e escrita)
+    constexpr uint32_t MCYCLE = 0xB00;
+    constexpr uint32_t MINSTRET = 0xB02;
+    constexpr uint32_t MHPMCOUNTER3 = 0xB03;
+    constexpr uint32_t MHPMCOUNTER31 = 0xB1F;
+    constexpr uint32_t MCYCLEH = 0xB80;
+    constexpr uint32_t MINSTRETH = 0xB82;
+    constexpr uint32_t MHPMCOUNTER3H = 0xB83;
+    constexpr uint32_t MHPMCOUNTER31H = 0xB9F;
+
+    // Configuração dos contadores
+    constexpr uint32_t MCOUNTINHIBIT = 0x320;
+    constexpr uint32_t MHPMEVENT3 = 0x323;
+    constexpr uint32_t MHPMEVENT31 = 0x33F;
+
+    // Extensão V: vl, vtype e vlenb são somente leitura (vl e vtype mudam com vsetvl*)
+    constexpr uint32_t VSTART = 0x008;
+    constexpr uint32_t VXSAT = 0x009;
+    constexpr uint32_t VXRM = 0x00A;
+    constexpr uint32_t VCSR = 0x00F;
+    constexpr uint32_t VL = 0xC20;
+    constexpr uint32_t VTYPE = 0xC21;
+    constexpr uint32_t VLENB = 0xC22;
+
+    // Outros CSRs de máquina
+    constexpr uint32_t MSCRATCH = 0x340;
+    constexpr uint32_t MHARTID = 0xF14;
+
+    // Número de contadores programáveis (mhpmcounter3..31)
+    constexpr uint32_t NUM_HPM = 29;
+
+    // 'time' avança uma vez a cada DIVISOR_TIME ciclos simulados
+    constexpr uint64_t DIVISOR_TIME = 10;
+}
+
+/**
+ * @enum EventoHpm
+ * @brief Eventos que podem ser atribuídos a mhpmcounter3..31 via mhpmeventN.
+ */
+enum class EventoHpm : uint32_t {
+    Nenhum = 0,
+    Loads,
+    Stores,
+    Desvios,
+    DesviosTomados,
+    Saltos,
+    Multiplicacoes,
+    Divisoes,
+    LeiturasCache,
+    AcertosLeituraCache,
+    FaltasLeituraCache,
+    EscritasCache,
+    AcertosEscritaCache,
+    FaltasEscritaCache,
+    CiclosParadosMemoria,
+    Total
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_CSR_H
@@ -0,0 +1,373 @@
+#include "Desmontador.h"
+
+#include <cstdio>
+#include <cstring>
+
+#include "Instruction.h"
+
+namespace {
+
+// Formas de uma instrução vetorial aritmética por funct6 (nullptr = a forma não existe)
+struct NomesVetoriais {
+    uint32_t funct6;
+    const char* vv;
+    const char* vx;
+    const char* vi;
+};
+
+// OPIVV, OPIVX e OPIVI
+const NomesVetoriais NOMES_OPI[] = {
+    {0x00, "vadd.vv", "vadd.vx", "vadd.vi"},
+    {0x02, "vsub.vv", "vsub.vx", nullptr},
+    {0x03, nullptr, "vrsub.vx", "vrsub.vi"},
+    {0x04, "vminu.vv", "vminu.vx", nullptr},
+    {0x05, "vmin.vv", "vmin.vx", nullptr},
+    {0x06, "vmaxu.vv", "vmaxu.vx", nullptr},
+    {0x07, "vmax.vv", "vmax.vx", nullptr},
+    {0x09, "vand.vv", "vand.vx", "vand.vi"},
+    {0x0A, "vor.vv", "vor.vx", "vor.vi"},
+    {0x0B, "vxor.vv", "vxor.vx", "vxor.vi"},
+    {0x17, "vmerge.vvm", "vmerge.vxm", "vmerge.vim"},
+    {0x18, "vmseq.vv", "vmseq.vx", "vmseq.vi"},
+    {0x19, "vmsne.vv", "vmsne.vx", "vmsne.vi"},
+    {0x1A, "vmsltu.vv", "vmsltu.vx", nullptr},
+    {0x1B, "vmslt.vv", "vmslt.vx", nullptr},
+    {0x1C, "vmsleu.vv", "vmsleu.vx", "vmsleu.vi"},
+    {0x1D, "vmsle.vv", "vmsle.vx", "vmsle.vi"},
+    {0x1E, nullptr, "vmsgtu.vx", "vmsgtu.vi"},
+    {0x1F, nullptr, "vmsgt.vx", "vmsgt.vi"},
+    {0x25, "vsll.vv", "vsll.vx", "vsll.vi"},
+    {0x28, "vsrl.vv", "vsrl.vx", "vsrl.vi"},
+    {0x29, "vsra.vv", "vsra.vx", "vsra.vi"},
+};
+
+// OPMVV e OPMVX
+const NomesVetoriais NOMES_OPM[] = {
+    {0x00, "vredsum.vs", nullptr, nullptr},
+    {0x01, "vredand.vs", nullptr, nullptr},
+    {0x02, "vredor.vs", nullptr, nullptr},
+    {0x03, "vredxor.vs", nullptr, nullptr},
+    {0x04, "vredminu.vs", nullptr, nullptr},
+    {0x05, "vredmin.vs", nullptr, nullptr},
+    {0x06, "vredmaxu.vs", nullptr, nullptr},
+    {0x07, "vredmax.vs", nullptr, nullptr},
+    {0x24, "vmulhu.vv", "vmulhu.vx", nullptr},
+    {0x25, "vmul.vv", "vmul.vx", nullptr},
+    {0x26, "vmulhsu.vv", "vmulhsu.vx", nullptr},
+    {0x27, "vmulh.vv", "vmulh.vx", nullptr},
+};
+
+template <size_t N>
+const char* buscar_nome(const NomesVetoriais (&tabela)[N], uint32_t funct6, uint32_t funct3) {
+    for (const NomesVetoriais& nomes : tabela) {
+        if (nomes.funct6 != funct6) continue;
+        if (funct3 == 0x0 || funct3 == 0x2) return nomes.vv;
+        return (funct3 == 0x4 || funct3 == 0x6) ? nomes.vx : nomes.vi;
+    }
+    return nullptr;
+}
+
+const char* mnemonico_op_v(uint32_t instrucao) {
+    uint32_t funct3 = (instrucao >> 12) & 0x7;
+    uint32_t funct6 = instrucao >> 26;
+    bool vm = (instrucao >> 25) & 0x1;
+    uint32_t vs1 = (instrucao >> 15) & 0x1F;
+    uint32_t vs2 = (instrucao >> 20) & 0x1F;
+
+    switch (funct3) {
+        case 0x7:
+            if (!(instrucao >> 31)) return "vsetvli";
+            if ((instrucao >> 30) == 0x3) return "vsetivli";
+            return (instrucao >> 25) == 0x40 ? "vsetvl" : nullptr;
+        case 0x0:
+        case 0x3:
+        case 0x4:
+            // vmerge sem máscara é a cópia vmv.v.*
+            if (funct6 == 0x17 && vm) {
+                if (vs2 != 0) return nullptr;
+                return funct3 == 0x0 ? "vmv.v.v" : (funct3 == 0x4 ? "vmv.v.x" : "vmv.v.i");
+            }
+            if (funct6 == 0x27 && funct3 == 0x3) {
+                static const char* nomes[] = {"vmv1r.v", "vmv2r.v", nullptr, "vmv4r.v",
+                                              nullptr, nullptr, nullptr, "vmv8r.v"};
+                return vs1 < 8 ? nomes[vs1] : nullptr;
+            }
+            return buscar_nome(NOMES_OPI, funct6, funct3);
+        case 0x2:
+            if (funct6 == 0x10) return vs1 == 0 ? "vmv.x.s" : nullptr;
+            if (funct6 == 0x14) return vs1 == 0x11 && vs2 == 0 ? "vid.v" : nullptr;
+            return buscar_nome(NOMES_OPM, funct6, funct3);
+        case 0x6:
+            if (funct6 == 0x10) return vs2 == 0 ? "vmv.s.x" : nullptr;
+            return buscar_nome(NOMES_OPM, funct6, funct3);
+        default:
+            return nullptr;
+    }
+}
+
+// Largura do elemento pelo campo width: 0 = 8, 1 = 16, 2 = 32 bits; -1 se não for um acesso vetorial
+// que o Core executa (os demais valores são loads/stores de ponto flutuante, e 64 bits passa de ELEN)
+int indice_largura(uint32_t funct3) {
+    switch (funct3) {
+        case 0x0: return 0;
+        case 0x5: return 1;
+        case 0x6: return 2;
+        default: return -1;
+    }
+}
+
+const char* mnemonico_memoria_v(uint32_t instrucao, bool store) {
+    int largura = indice_largura((instrucao >> 12) & 0x7);
+    uint32_t nf = instrucao >> 29;
+    uint32_t mop = (instrucao >> 26) & 0x3;
+    uint32_t lumop = (instrucao >> 20) & 0x1F;
+    if (largura < 0 || ((instrucao >> 28) & 0x1)) return nullptr;
+
+    if (mop == 0x0 && lumop == 0x08) {
+        // Registradores inteiros: nf + 1 registradores, ignorando vl e vtype
+        static const char* cargas[4][3] = {{"vl1re8.v", "vl1re16.v", "vl1re32.v"},
+                                           {"vl2re8.v", "vl2re16.v", "vl2re32.v"},
+                                           {"vl4re8.v", "vl4re16.v", "vl4re32.v"},
+                                           {"vl8re8.v", "vl8re16.v", "vl8re32.v"}};
+        static const char* gravacoes[4] = {"vs1r.v", "vs2r.v", "vs4r.v", "vs8r.v"};
+        int grupo = nf == 0 ? 0 : nf == 1 ? 1 : nf == 3 ? 2 : nf == 7 ? 3 : -1;
+        if (grupo < 0) return nullptr;
+        if (store) return largura == 0 ? gravacoes[grupo] : nullptr;
+        return cargas[grupo][largura];
+    }
+    // Segmentos (nf > 0) não são suportados
+    if (nf != 0) return nullptr;
+
+    static const char* unitarios[2][3] = {{"vle8.v", "vle16.v", "vle32.v"}, {"vse8.v", "vse16.v", "vse32.v"}};
+    static const char* espacados[2][3] = {{"vlse8.v", "vlse16.v", "vlse32.v"}, {"vsse8.v", "vsse16.v", "vsse32.v"}};
+    static const char* indexados[2][3] = {{"vluxei8.v", "vluxei16.v", "vluxei32.v"},
+                                          {"vsuxei8.v", "vsuxei16.v", "vsuxei32.v"}};
+    static const char* ordenados[2][3] = {{"vloxei8.v", "vloxei16.v", "vloxei32.v"},
+                                          {"vsoxei8.v", "vsoxei16.v", "vsoxei32.v"}};
+    static const char* primeira_falta[3] = {"vle8ff.v", "vle16ff.v", "vle32ff.v"};
+    switch (mop) {
+        case 0x0:
+            if (lumop == 0x0B) return largura == 0 ? (store ? "vsm.v" : "vlm.v") : nullptr;
+            if (lumop == 0x10) return store ? nullptr : primeira_falta[largura];
+            return lumop == 0x0 ? unitarios[store][largura] : nullptr;
+        case 0x1: return indexados[store][largura];
+        case 0x2: return espacados[store][largura];
+        default: return ordenados[store][largura];
+    }
+}
+
+// "e32, m1, ta, mu"; vtype reservado sai em hexadecimal
+void texto_vtype(uint32_t vtype, char* texto, size_t tamanho) {
+    uint32_t vsew = (vtype >> 3) & 0x7;
+    uint32_t vlmul = vtype & 0x7;
+    if (vsew > 3 || vlmul == 0x4 || (vtype >> 8)) {
+        std::snprintf(texto, tamanho, "0x%x", vtype);
+        return;
+    }
+    static const char* lmul[] = {"m1", "m2", "m4", "m8", "", "mf8", "mf4", "mf2"};
+    std::snprintf(texto, tamanho, "e%u, %s, %s, %s", 8u << vsew, lmul[vlmul], (vtype & 0x40) ? "ta" : "tu",
+                  (vtype & 0x80) ? "ma" : "mu");
+}
+
+void desmontar_op_v(uint32_t instrucao, const char* nome, char* texto, size_t tamanho) {
+    Instruction inst(instrucao);
+    uint32_t funct6 = instrucao >> 26;
+    uint32_t vd = inst.rd();
+    uint32_t vs1 = inst.rs1();
+    uint32_t vs2 = inst.rs2();
+    int32_t simm5 = static_cast<int32_t>(vs1 << 27) >> 27;
+    bool vm = (instrucao >> 25) & 0x1;
+    const char* mascara = vm ? "" : ", v0.t";
+    char tipo[32];
+
+    switch (inst.funct3()) {
+        case 0x7:
+            if (!(instrucao >> 31)) {
+                texto_vtype((instrucao >> 20) & 0x7FF, tipo, sizeof(tipo));
+                std::snprintf(texto, tamanho, "%s x%u, x%u, %s", nome, vd, vs1, tipo);
+            } else if ((instrucao >> 30) == 0x3) {
+                texto_vtype((instrucao >> 20) & 0x3FF, tipo, sizeof(tipo));
+                std::snprintf(texto, tamanho, "%s x%u, %u, %s", nome, vd, vs1, tipo);
+            } else {
+                std::snprintf(texto, tamanho, "%s x%u, x%u, x%u", nome, vd, vs1, vs2);
+            }
+            return;
+        case 0x2:
+            if (funct6 == 0x10) {
+                std::snprintf(texto, tamanho, "%s x%u, v%u", nome, vd, vs2);
+            } else if (funct6 == 0x14) {
+                std::snprintf(texto, tamanho, "%s v%u%s", nome, vd, mascara);
+            } else {
+                std::snprintf(texto, tamanho, "%s v%u, v%u, v%u%s", nome, vd, vs2, vs1, mascara);
+            }
+            return;
+        case 0x6:
+            if (funct6 == 0x10) {
+                std::snprintf(texto, tamanho, "%s v%u, x%u", nome, vd, vs1);
+            } else {
+                std::snprintf(texto, tamanho, "%s v%u, v%u, x%u%s", nome, vd, vs2, vs1, mascara);
+            }
+            return;
+        default:
+            break;
+    }
+
+    // OPI: vmv<nr>r.v e vmv.v.* têm um operando só; vmerge usa v0 sem o ".t"
+    if (funct6 == 0x27) {
+        std::snprintf(texto, tamanho, "%s v%u, v%u", nome, vd, vs2);
+        return;
+    }
+    if (funct6 == 0x17) {
+        if (vm) {
+            if (inst.funct3() == 0x0) std::snprintf(texto, tamanho, "%s v%u, v%u", nome, vd, vs1);
+            else if (inst.funct3() == 0x4) std::snprintf(texto, tamanho, "%s v%u, x%u", nome, vd, vs1);
+            else std::snprintf(texto, tamanho, "%s v%u, %d", nome, vd, simm5);
+            return;
+        }
+        mascara = ", v0";
+    }
+    if (inst.funct3() == 0x0) std::snprintf(texto, tamanho, "%s v%u, v%u, v%u%s", nome, vd, vs2, vs1, mascara);
+    else if (inst.funct3() == 0x4) std::snprintf(texto, tamanho, "%s v%u, v%u, x%u%s", nome, vd, vs2, vs1, mascara);
+    else std::snprintf(texto, tamanho, "%s v%u, v%u, %d%s", nome, vd, vs2, simm5, mascara);
+}
+
+void desmontar_memoria_v(uint32_t instrucao, const char* nome, char* texto, size_t tamanho) {
+    Instruction inst(instrucao);
+    const char* mascara = ((instrucao >> 25) & 0x1) ? "" : ", v0.t";
+    uint32_t mop = (instrucao >> 26) & 0x3;
+    if (mop == 0x2) {
+        std::snprintf(texto, tamanho, "%s v%u, (x%u), x%u%s", nome, inst.rd(), inst.rs1(), inst.rs2(), mascara);
+    } else if (mop != 0x0) {
+        std::snprintf(texto, tamanho, "%s v%u, (x%u), v%u%s", nome, inst.rd(), inst.rs1(), inst.rs2(), mascara);
+    } else {
+        std::snprintf(texto, tamanho, "%s v%u, (x%u)%s", nome, inst.rd(), inst.rs1(), mascara);
+    }
+}
+
+}
+
+const char* mnemonico(uint32_t instrucao) {
+    Instruction inst(instrucao);
+    uint32_t funct3 = inst.funct3();
+    uint32_t funct7 = inst.funct7();
+
+    switch (inst.opcode()) {
+        case 0x13: {
+            static const char* nomes[] = {"addi", "slli", "slti", "sltiu", "xori", "", "ori", "andi"};
+            if (funct3 == 0x5) return (funct7 == 0x20) ? "srai" : "srli";
+            return nomes[funct3][0] ? nomes[funct3] : "desconhecida";
+        }
+        case 0x33: {
+            if (funct7 == 0x01) {
+                static const char* nomes[] = {"mul", "mulh", "mulhsu", "mulhu", "div", "divu", "rem", "remu"};
+                return nomes[funct3];
+            }
+            static const char* nomes[] = {"add", "sll", "slt", "sltu", "xor", "srl", "or", "and"};
+            if (funct7 == 0x20 && funct3 == 0x0) return "sub";
+            if (funct7 == 0x20 && funct3 == 0x5) return "sra";
+            return nomes[funct3];
+        }
+        case 0x03: {
+            static const char* nomes[] = {"lb", "lh", "lw", "", "lbu", "lhu", "", ""};
+            return nomes[funct3][0] ? nomes[funct3] : "desconhecida";
+        }
+        case 0x23: {
+            static const char* nomes[] = {"sb", "sh", "sw"};
+            return funct3 < 3 ? nomes[funct3] : "desconhecida";
+        }
+        case 0x63: {
+            static const char* nomes[] = {"beq", "bne", "", "", "blt", "bge", "bltu", "bgeu"};
+            return nomes[funct3][0] ? nomes[funct3] : "desconhecida";
+        }
+        case 0x37: return "lui";
+        case 0x17: return "auipc";
+        case 0x6F: return "jal";
+        case 0x67: return "jalr";
+        case 0x0F: return "fence";
+        case 0x73: {
+            static const char* nomes[] = {"", "csrrw", "csrrs", "csrrc", "", "csrrwi", "csrrsi", "csrrci"};
+            if (funct3 == 0x0) {
+                if (instrucao == 0x00000073) return "ecall";
+                if (instrucao == 0x00100073) return "ebreak";
+                return "desconhecida";
+            }
+            return nomes[funct3][0] ? nomes[funct3] : "desconhecida";
+        }
+        case 0x57: {
+            const char* nome = mnemonico_op_v(instrucao);
+            return nome ? nome : "desconhecida";
+        }
+        case 0x07:
+        case 0x27: {
+            const char* nome = mnemonico_memoria_v(instrucao, inst.opcode() == 0x27);
+            return nome ? nome : "desconhecida";
+        }
+        default:
+            return "desconhecida";
+    }
+}
+
+std::string desmontar(uint32_t instrucao) {
+    Instruction inst(instrucao);
+    const char* nome = mnemonico(instrucao);
+    uint32_t rd = inst.rd();
+    uint32_t rs1 = inst.rs1();
+    uint32_t rs2 = inst.rs2();
+
+    char texto[64];
+    bool conhecida = std::strcmp(nome, "desconhecida") != 0;
+    switch (inst.opcode()) {
+        case 0x13:
+            if (inst.funct3() == 0x1 || inst.funct3() == 0x5) {
+                std::snprintf(texto, sizeof(texto), "%s x%u, x%u, %d", nome, rd, rs1, inst.imediato_tipo_I() & 0x1F);
+            } else {
+                std::snprintf(texto, sizeof(texto), "%s x%u, x%u, %d", nome, rd, rs1, inst.imediato_tipo_I());
+            }
+            break;
+        case 0x33:
+            std::snprintf(texto, sizeof(texto), "%s x%u, x%u, x%u", nome, rd, rs1, rs2);
+            break;
+        case 0x03:
+        case 0x67:
+            std::snprintf(texto, sizeof(texto), "%s x%u, %d(x%u)", nome, rd, inst.imediato_tipo_I(), rs1);
+            break;
+        case 0x23:
+            std::snprintf(texto, sizeof(texto), "%s x%u, %d(x%u)", nome, rs2, inst.imediato_tipo_S(), rs1);
+            break;
+        case 0x63:
+            std::snprintf(texto, sizeof(texto), "%s x%u, x%u, %d", nome, rs1, rs2, inst.imediato_tipo_B());
+            break;
+        case 0x37:
+        case 0x17:
+            std::snprintf(texto, sizeof(texto), "%s x%u, 0x%x", nome, rd,
+                          static_cast<uint32_t>(inst.imediato_tipo_U()) >> 12);
+            break;
+        case 0x6F:
+            std::snprintf(texto, sizeof(texto), "%s x%u, %d", nome, rd, inst.imediato_tipo_J());
+            break;
+        case 0x73:
+            if (inst.funct3() == 0x0) {
+                std::snprintf(texto, sizeof(texto), "%s", nome);
+            } else if (inst.funct3() >= 0x5) {
+                std::snprintf(texto, sizeof(texto), "%s x%u, 0x%x, %u", nome, rd,
+                              static_cast<uint32_t>(inst.imediato_tipo_I()) & 0xFFF, rs1);
+            } else {
+                std::snprintf(texto, sizeof(texto), "%s x%u, 0x%x, x%u", nome, rd,
+                              static_cast<uint32_t>(inst.imediato_tipo_I()) & 0xFFF, rs1);
+            }
+            break;
+        case 0x57:
+            if (conhecida) desmontar_op_v(instrucao, nome, texto, sizeof(texto));
+            else std::snprintf(texto, sizeof(texto), "%s", nome);
+            break;
+        case 0x07:
+        case 0x27:
+            if (conhecida) desmontar_memoria_v(instrucao, nome, texto, sizeof(texto));
+            else std::snprintf(texto, sizeof(texto), "%s", nome);
+            break;
+        default:
+            std::snprintf(texto, sizeof(texto), "%s", nome);
+            break;
+    }
+    return texto;
+}
@@ -0,0 +1,13 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_DESMONTADOR_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_DESMONTADOR_H
+
+#include <cstdint>
+#include <string>
+
+// Mnemônico da instrução (ex: "addi", "lw"); "desconhecida" se o Core não a executa
+const char* mnemonico(uint32_t instrucao);
+
+// Texto em assembly da instrução (ex: "addi x5, x5, -1"), no mesmo subconjunto que o Core executa
+std::string desmontar(uint32_t instrucao);
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_DESMONTADOR_H
@@ -0,0 +1,502 @@
+#include "KernelsVetoriais.h"
+
+#include <algorithm>
+
+// Os kernels usam a maior largura habilitada na compilação (SIMULADOR_AVX2 no CMake liga o AVX2);
+// SSE2 faz parte de todo x86-64
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VETORIAL_AVX2 1
+#define VETORIAL_SIMD 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VETORIAL_SIMD 1
+#endif
+
+namespace vetorial {
+
+namespace {
+
+uint32_t mascara_sew(uint32_t sew) {
+    return sew == 4 ? 0xFFFFFFFFu : (1u << (8 * sew)) - 1;
+}
+
+int64_t com_sinal(uint32_t valor, uint32_t sew) {
+    uint32_t deslocamento = 32 - 8 * sew;
+    return static_cast<int32_t>(valor << deslocamento) >> deslocamento;
+}
+
+void definir_bit(uint8_t* mascara, uint32_t indice, bool valor) {
+    if (valor) mascara[indice >> 3] |= static_cast<uint8_t>(1u << (indice & 7));
+}
+
+#ifdef VETORIAL_SIMD
+
+#ifdef VETORIAL_AVX2
+using Vetor = __m256i;
+#define SIMD(nome) _mm256_##nome
+#define SIMD_SI(nome) _mm256_##nome##_si256
+#else
+using Vetor = __m128i;
+#define SIMD(nome) _mm_##nome
+#define SIMD_SI(nome) _mm_##nome##_si128
+#endif
+
+constexpr uint32_t LARGURA = sizeof(Vetor);
+
+inline Vetor carregar(const uint8_t* p) {
+    return SIMD_SI(loadu)(reinterpret_cast<const Vetor*>(p));
+}
+
+inline void armazenar(uint8_t* p, Vetor v) {
+    SIMD_SI(storeu)(reinterpret_cast<Vetor*>(p), v);
+}
+
+inline Vetor difundir(uint32_t sew, uint32_t valor) {
+    switch (sew) {
+        case 1: return SIMD(set1_epi8)(static_cast<char>(valor));
+        case 2: return SIMD(set1_epi16)(static_cast<short>(valor));
+        default: return SIMD(set1_epi32)(static_cast<int>(valor));
+    }
+}
+
+inline Vetor negar(Vetor v) {
+    return SIMD_SI(xor)(v, SIMD(set1_epi32)(-1));
+}
+
+// Pistas com todos os bits ligados onde 'm' é verdadeiro
+inline Vetor selecionar(Vetor m, Vetor se_verdadeiro, Vetor se_falso) {
+    return SIMD_SI(or)(SIMD_SI(and)(m, se_verdadeiro), SIMD_SI(andnot)(m, se_falso));
+}
+
+inline Vetor igual(uint32_t sew, Vetor a, Vetor b) {
+    switch (sew) {
+        case 1: return SIMD(cmpeq_epi8)(a, b);
+        case 2: return SIMD(cmpeq_epi16)(a, b);
+        default: return SIMD(cmpeq_epi32)(a, b);
+    }
+}
+
+inline Vetor maior(uint32_t sew, Vetor a, Vetor b) {
+    switch (sew) {
+        case 1: return SIMD(cmpgt_epi8)(a, b);
+        case 2: return SIMD(cmpgt_epi16)(a, b);
+        default: return SIMD(cmpgt_epi32)(a, b);
+    }
+}
+
+// Comparação sem sinal: inverter o bit de sinal transforma a ordem sem sinal na com sinal
+inline Vetor maior_sem_sinal(uint32_t sew, Vetor a, Vetor b) {
+    Vetor sinal = difundir(sew, 1u << (8 * sew - 1));
+    return maior(sew, SIMD_SI(xor)(a, sinal), SIMD_SI(xor)(b, sinal));
+}
+
+inline Vetor multiplicar(uint32_t sew, Vetor a, Vetor b) {
+    switch (sew) {
+        case 1: {
+            // Não há multiplicação de bytes: os pares e os ímpares são multiplicados como palavras de 16 bits
+            Vetor pares = SIMD(mullo_epi16)(a, b);
+            Vetor impares = SIMD(mullo_epi16)(SIMD(srli_epi16)(a, 8), SIMD(srli_epi16)(b, 8));
+            return SIMD_SI(or)(SIMD_SI(and)(pares, SIMD(set1_epi16)(0x00FF)), SIMD(slli_epi16)(impares, 8));
+        }
+        case 2: return SIMD(mullo_epi16)(a, b);
+        default: {
+#ifdef VETORIAL_AVX2
+            return _mm256_mullo_epi32(a, b);
+#else
+            // SSE2 só multiplica 32x32->64 nas pistas pares; as ímpares são deslocadas para elas
+            Vetor pares = _mm_mul_epu32(a, b);
+            Vetor impares = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(pares, 0x08), _mm_shuffle_epi32(impares, 0x08));
+#endif
+        }
+    }
+}
+
+// Deslocamento com a mesma quantidade em todas as pistas (.vx e .vi)
+inline Vetor deslocar(Operacao op, uint32_t sew, Vetor a, uint32_t quantidade) {
+    __m128i contagem = _mm_cvtsi32_si128(static_cast<int>(quantidade));
+    switch (sew) {
+        case 1: {
+            // Não há deslocamento de bytes: desloca palavras e descarta os bits que passaram para o byte vizinho
+            if (op == Operacao::Sll) {
+                return SIMD_SI(and)(SIMD(sll_epi16)(a, contagem), difundir(1, 0xFFu << quantidade));
+            }
+            Vetor restantes = difundir(1, 0xFFu >> quantidade);
+            if (op == Operacao::Srl) {
+                return SIMD_SI(and)(SIMD(srl_epi16)(a, contagem), restantes);
+            }
+            // sra(x) = srl(x ^ 0x80) - (0x80 >> quantidade)
+            Vetor deslocado = SIMD_SI(and)(SIMD(srl_epi16)(SIMD_SI(xor)(a, difundir(1, 0x80)), contagem), restantes);
+            return SIMD(sub_epi8)(deslocado, difundir(1, 0x80u >> quantidade));
+        }
+        case 2:
+            if (op == Operacao::Sll) return SIMD(sll_epi16)(a, contagem);
+            return op == Operacao::Srl ? SIMD(srl_epi16)(a, contagem) : SIMD(sra_epi16)(a, contagem);
+        default:
+            if (op == Operacao::Sll) return SIMD(sll_epi32)(a, contagem);
+            return op == Operacao::Srl ? SIMD(srl_epi32)(a, contagem) : SIMD(sra_epi32)(a, contagem);
+    }
+}
+
+// Se a operação tem kernel SIMD; 'escalar' = o segundo operando é o mesmo em todas as pistas
+bool tem_kernel(Operacao op, uint32_t sew, bool escalar) {
+    switch (op) {
+        case Operacao::Mulh:
+        case Operacao::MulhU: return sew == 2;
+        case Operacao::MulhSU: return false;
+        case Operacao::Sll:
+        case Operacao::Srl:
+        case Operacao::Sra:
+            if (escalar) return true;
+#ifdef VETORIAL_AVX2
+            return sew == 4;
+#else
+            return false;
+#endif
+        default: return true;
+    }
+}
+
+Vetor operar_bloco(Operacao op, uint32_t sew, Vetor a, Vetor b) {
+    switch (op) {
+        case Operacao::Add:
+            if (sew == 1) return SIMD(add_epi8)(a, b);
+            return sew == 2 ? SIMD(add_epi16)(a, b) : SIMD(add_epi32)(a, b);
+        case Operacao::Sub:
+        case Operacao::Rsub: {
+            if (op == Operacao::Rsub) std::swap(a, b);
+            if (sew == 1) return SIMD(sub_epi8)(a, b);
+            return sew == 2 ? SIMD(sub_epi16)(a, b) : SIMD(sub_epi32)(a, b);
+        }
+        case Operacao::And: return SIMD_SI(and)(a, b);
+        case Operacao::Or: return SIMD_SI(or)(a, b);
+        case Operacao::Xor: return SIMD_SI(xor)(a, b);
+        case Operacao::MinU: return selecionar(maior_sem_sinal(sew, a, b), b, a);
+        case Operacao::Min: return selecionar(maior(sew, a, b), b, a);
+        case Operacao::MaxU: return selecionar(maior_sem_sinal(sew, a, b), a, b);
+        case Operacao::Max: return selecionar(maior(sew, a, b), a, b);
+        case Operacao::Mul: return multiplicar(sew, a, b);
+        case Operacao::Mulh: return SIMD(mulhi_epi16)(a, b);
+        case Operacao::MulhU: return SIMD(mulhi_epu16)(a, b);
+#ifdef VETORIAL_AVX2
+        case Operacao::Sll: return _mm256_sllv_epi32(a, SIMD_SI(and)(b, difundir(4, 31)));
+        case Operacao::Srl: return _mm256_srlv_epi32(a, SIMD_SI(and)(b, difundir(4, 31)));
+        case Operacao::Sra: return _mm256_srav_epi32(a, SIMD_SI(and)(b, difundir(4, 31)));
+#endif
+        default: return a;
+    }
+}
+
+Vetor comparar_bloco(Comparacao cmp, uint32_t sew, Vetor a, Vetor b) {
+    switch (cmp) {
+        case Comparacao::Eq: return igual(sew, a, b);
+        case Comparacao::Ne: return negar(igual(sew, a, b));
+        case Comparacao::LtU: return maior_sem_sinal(sew, b, a);
+        case Comparacao::Lt: return maior(sew, b, a);
+        case Comparacao::LeU: return negar(maior_sem_sinal(sew, a, b));
+        case Comparacao::Le: return negar(maior(sew, a, b));
+        case Comparacao::GtU: return maior_sem_sinal(sew, a, b);
+        default: return maior(sew, a, b);
+    }
+}
+
+// Um bit por pista (pistas com todos os bits ligados viram 1)
+uint32_t bits_pistas(uint32_t sew, Vetor m) {
+    switch (sew) {
+        case 1: return static_cast<uint32_t>(SIMD(movemask_epi8)(m));
+        case 2: {
+#ifdef VETORIAL_AVX2
+            // packs trabalha em cada metade de 128 bits: a permutação junta as duas partes baixas
+            Vetor juntos = _mm256_permute4x64_epi64(_mm256_packs_epi16(m, m), 0xD8);
+            return static_cast<uint32_t>(_mm256_movemask_epi8(juntos)) & 0xFFFF;
+#else
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(m, m))) & 0xFF;
+#endif
+        }
+        default:
+#ifdef VETORIAL_AVX2
+            return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+#else
+            return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+#endif
+    }
+}
+
+// Inverso de bits_pistas: a pista j fica com todos os bits ligados se o bit j estiver ligado
+Vetor expandir_bits(uint32_t sew, uint32_t bits) {
+    Vetor seletor;
+    Vetor replicado;
+    switch (sew) {
+        case 1: {
+#ifdef VETORIAL_AVX2
+            replicado = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)),
+                                            _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                             2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+#else
+            // Cada byte da máscara repetido 8 vezes
+            replicado = _mm_cvtsi32_si128(static_cast<int>(bits));
+            replicado = _mm_unpacklo_epi8(replicado, replicado);
+            replicado = _mm_unpacklo_epi16(replicado, replicado);
+            replicado = _mm_unpacklo_epi32(replicado, replicado);
+#endif
+            seletor = SIMD(set1_epi64x)(0x8040201008040201ll);
+            return SIMD(cmpeq_epi8)(SIMD_SI(and)(replicado, seletor), seletor);
+        }
+        case 2:
+            replicado = SIMD(set1_epi16)(static_cast<short>(bits));
+#ifdef VETORIAL_AVX2
+            seletor = _mm256_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400, 0x800,
+                                        0x1000, 0x2000, 0x4000, static_cast<short>(0x8000));
+#else
+            seletor = _mm_setr_epi16(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80);
+#endif
+            return SIMD(cmpeq_epi16)(SIMD_SI(and)(replicado, seletor), seletor);
+        default:
+            replicado = SIMD(set1_epi32)(static_cast<int>(bits));
+#ifdef VETORIAL_AVX2
+            seletor = _mm256_setr_epi32(0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80);
+#else
+            seletor = _mm_setr_epi32(0x1, 0x2, 0x4, 0x8);
+#endif
+            return SIMD(cmpeq_epi32)(SIMD_SI(and)(replicado, seletor), seletor);
+    }
+}
+
+// 'quantidade' (até 32) bits da máscara a partir do bit 'inicio'
+uint32_t ler_bits(const uint8_t* mascara, uint32_t inicio, uint32_t quantidade) {
+    uint32_t primeiro = inicio & 7;
+    uint32_t bytes = (primeiro + quantidade + 7) / 8;
+    uint64_t bits = 0;
+    for (uint32_t k = 0; k < bytes; ++k) {
+        bits |= static_cast<uint64_t>(mascara[(inicio >> 3) + k]) << (8 * k);
+    }
+    return static_cast<uint32_t>(bits >> primeiro);
+}
+
+void gravar_bits(uint8_t* mascara, uint32_t inicio, uint32_t bits, uint32_t quantidade) {
+    uint64_t deslocados = static_cast<uint64_t>(bits) << (inicio & 7);
+    uint32_t bytes = ((inicio & 7) + quantidade + 7) / 8;
+    for (uint32_t k = 0; k < bytes; ++k) {
+        mascara[(inicio >> 3) + k] |= static_cast<uint8_t>(deslocados >> (8 * k));
+    }
+}
+
+#endif // VETORIAL_SIMD
+
+}
+
+uint32_t ler_elemento(const uint8_t* base, uint32_t indice, uint32_t sew) {
+    const uint8_t* p = base + static_cast<size_t>(indice) * sew;
+    uint32_t valor = 0;
+    for (uint32_t i = 0; i < sew; ++i) {
+        valor |= static_cast<uint32_t>(p[i]) << (8 * i);
+    }
+    return valor;
+}
+
+void escrever_elemento(uint8_t* base, uint32_t indice, uint32_t sew, uint32_t valor) {
+    uint8_t* p = base + static_cast<size_t>(indice) * sew;
+    for (uint32_t i = 0; i < sew; ++i) {
+        p[i] = static_cast<uint8_t>(valor >> (8 * i));
+    }
+}
+
+uint32_t operar_elemento(Operacao op, uint32_t sew, uint32_t a, uint32_t b) {
+    uint32_t bits = 8 * sew;
+    uint32_t mascara = mascara_sew(sew);
+    a &= mascara;
+    b &= mascara;
+    int64_t sa = com_sinal(a, sew);
+    int64_t sb = com_sinal(b, sew);
+    uint32_t deslocamento = b & (bits - 1);
+
+    uint32_t resultado = 0;
+    switch (op) {
+        case Operacao::Add: resultado = a + b;
+            break;
+        case Operacao::Sub: resultado = a - b;
+            break;
+        case Operacao::Rsub: resultado = b - a;
+            break;
+        case Operacao::And: resultado = a & b;
+            break;
+        case Operacao::Or: resultado = a | b;
+            break;
+        case Operacao::Xor: resultado = a ^ b;
+            break;
+        case Operacao::MinU: resultado = std::min(a, b);
+            break;
+        case Operacao::Min: resultado = sa < sb ? a : b;
+            break;
+        case Operacao::MaxU: resultado = std::max(a, b);
+            break;
+        case Operacao::Max: resultado = sa > sb ? a : b;
+            break;
+        case Operacao::Sll: resultado = a << deslocamento;
+            break;
+        case Operacao::Srl: resultado = a >> deslocamento;
+            break;
+        case Operacao::Sra: resultado = static_cast<uint32_t>(sa >> deslocamento);
+            break;
+        case Operacao::Mul: resultado = a * b;
+            break;
+        case Operacao::Mulh: resultado = static_cast<uint32_t>((sa * sb) >> bits);
+            break;
+        case Operacao::MulhU: resultado = static_cast<uint32_t>((static_cast<uint64_t>(a) * b) >> bits);
+            break;
+        case Operacao::MulhSU: resultado = static_cast<uint32_t>((sa * static_cast<int64_t>(b)) >> bits);
+            break;
+    }
+    return resultado & mascara;
+}
+
+bool comparar_elemento(Comparacao cmp, uint32_t sew, uint32_t a, uint32_t b) {
+    uint32_t mascara = mascara_sew(sew);
+    a &= mascara;
+    b &= mascara;
+    int64_t sa = com_sinal(a, sew);
+    int64_t sb = com_sinal(b, sew);
+    switch (cmp) {
+        case Comparacao::Eq: return a == b;
+        case Comparacao::Ne: return a != b;
+        case Comparacao::LtU: return a < b;
+        case Comparacao::Lt: return sa < sb;
+        case Comparacao::LeU: return a <= b;
+        case Comparacao::Le: return sa <= sb;
+        case Comparacao::GtU: return a > b;
+        default: return sa > sb;
+    }
+}
+
+void operar(Operacao op, uint32_t sew, uint8_t* destino, const uint8_t* vs2, const uint8_t* vs1, uint32_t n) {
+    uint32_t e = 0;
+#ifdef VETORIAL_SIMD
+    if (tem_kernel(op, sew, false)) {
+        uint32_t por_bloco = LARGURA / sew;
+        for (; e + por_bloco <= n; e += por_bloco) {
+            size_t i = static_cast<size_t>(e) * sew;
+            armazenar(destino + i, operar_bloco(op, sew, carregar(vs2 + i), carregar(vs1 + i)));
+        }
+    }
+#endif
+    for (; e < n; ++e) {
+        escrever_elemento(destino, e, sew,
+                          operar_elemento(op, sew, ler_elemento(vs2, e, sew), ler_elemento(vs1, e, sew)));
+    }
+}
+
+void operar_escalar(Operacao op, uint32_t sew, uint8_t* destino, const uint8_t* vs2, uint32_t escalar, uint32_t n) {
+    uint32_t e = 0;
+#ifdef VETORIAL_SIMD
+    if (tem_kernel(op, sew, true)) {
+        uint32_t por_bloco = LARGURA / sew;
+        bool deslocamento = op == Operacao::Sll || op == Operacao::Srl || op == Operacao::Sra;
+        uint32_t quantidade = escalar & (8 * sew - 1);
+        Vetor b = difundir(sew, escalar);
+        for (; e + por_bloco <= n; e += por_bloco) {
+            size_t i = static_cast<size_t>(e) * sew;
+            Vetor a = carregar(vs2 + i);
+            armazenar(destino + i, deslocamento ? deslocar(op, sew, a, quantidade) : operar_bloco(op, sew, a, b));
+        }
+    }
+#endif
+    for (; e < n; ++e) {
+        escrever_elemento(destino, e, sew, operar_elemento(op, sew, ler_elemento(vs2, e, sew), escalar));
+    }
+}
+
+void comparar(Comparacao cmp, uint32_t sew, uint8_t* mascara, const uint8_t* vs2, const uint8_t* vs1, uint32_t n) {
+    std::fill_n(mascara, (n + 7) / 8, 0);
+    uint32_t e = 0;
+#ifdef VETORIAL_SIMD
+    uint32_t por_bloco = LARGURA / sew;
+    for (; e + por_bloco <= n; e += por_bloco) {
+        size_t i = static_cast<size_t>(e) * sew;
+        gravar_bits(mascara, e, bits_pistas(sew, comparar_bloco(cmp, sew, carregar(vs2 + i), carregar(vs1 + i))),
+                    por_bloco);
+    }
+#endif
+    for (; e < n; ++e) {
+        definir_bit(mascara, e, comparar_elemento(cmp, sew, ler_elemento(vs2, e, sew), ler_elemento(vs1, e, sew)));
+    }
+}
+
+void comparar_escalar(Comparacao cmp, uint32_t sew, uint8_t* mascara, const uint8_t* vs2, uint32_t escalar,
+                      uint32_t n) {
+    std::fill_n(mascara, (n + 7) / 8, 0);
+    uint32_t e = 0;
+#ifdef VETORIAL_SIMD
+    uint32_t por_bloco = LARGURA / sew;
+    Vetor b = difundir(sew, escalar);
+    for (; e + por_bloco <= n; e += por_bloco) {
+        size_t i = static_cast<size_t>(e) * sew;
+        gravar_bits(mascara, e, bits_pistas(sew, comparar_bloco(cmp, sew, carregar(vs2 + i), b)), por_bloco);
+    }
+#endif
+    for (; e < n; ++e) {
+        definir_bit(mascara, e, comparar_elemento(cmp, sew, ler_elemento(vs2, e, sew), escalar));
+    }
+}
+
+void preencher(uint32_t sew, uint8_t* destino, uint32_t valor, uint32_t n) {
+    uint32_t e = 0;
+#ifdef VETORIAL_SIMD
+    uint32_t por_bloco = LARGURA / sew;
+    Vetor v = difundir(sew, valor);
+    for (; e + por_bloco <= n; e += por_bloco) {
+        armazenar(destino + static_cast<size_t>(e) * sew, v);
+    }
+#endif
+    for (; e < n; ++e) {
+        escrever_elemento(destino, e, sew, valor);
+    }
+}
+
+void mesclar(uint32_t sew, uint8_t* destino, const uint8_t* origem, const uint8_t* mascara,
+             uint32_t inicio, uint32_t fim) {
+    if (inicio >= fim) return;
+    if (!mascara) {
+        std::copy(origem + static_cast<size_t>(inicio) * sew, origem + static_cast<size_t>(fim) * sew,
+                  destino + static_cast<size_t>(inicio) * sew);
+        return;
+    }
+    uint32_t e = inicio;
+#ifdef VETORIAL_SIMD
+    uint32_t por_bloco = LARGURA / sew;
+    for (; e + por_bloco <= fim; e += por_bloco) {
+        size_t i = static_cast<size_t>(e) * sew;
+        Vetor ativos = expandir_bits(sew, ler_bits(mascara, e, por_bloco));
+        armazenar(destino + i, selecionar(ativos, carregar(origem + i), carregar(destino + i)));
+    }
+#endif
+    for (; e < fim; ++e) {
+        if (bit_mascara(mascara, e)) {
+            escrever_elemento(destino, e, sew, ler_elemento(origem, e, sew));
+        }
+    }
+}
+
+void mesclar_bits(uint8_t* destino, const uint8_t* origem, const uint8_t* mascara, uint32_t inicio, uint32_t fim) {
+    uint32_t i = inicio;
+    while (i < fim) {
+        uint32_t primeiro = i & 7;
+        uint32_t ultimo = std::min<uint32_t>(8, primeiro + (fim - i));
+        auto bits = static_cast<uint8_t>(((1u << ultimo) - 1) & ~((1u << primeiro) - 1));
+        if (mascara) bits &= mascara[i >> 3];
+        destino[i >> 3] = static_cast<uint8_t>((destino[i >> 3] & ~bits) | (origem[i >> 3] & bits));
+        i += ultimo - primeiro;
+    }
+}
+
+const char* implementacao() {
+#if defined(VETORIAL_AVX2)
+    return "AVX2";
+#elif defined(VETORIAL_SIMD)
+    return "SSE2";
+#else
+    return "escalar";
+#endif
+}
+
+}
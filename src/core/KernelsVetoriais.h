@@ -0,0 +1,72 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_KERNELSVETORIAIS_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_KERNELSVETORIAIS_H
+
+#include <cstdint>
+
+/**
+ * Parâmetros da extensão V implementada pelo Core e os kernels que executam as
+ * operações elemento a elemento no host.
+ *
+ * Os elementos ficam em little-endian, como no banco de registradores do guest, e
+ * 'sew' é a largura do elemento em bytes (1, 2 ou 4). Os blocos inteiros de elementos
+ * são processados com SSE2 ou AVX2 (conforme a compilação); o que sobra no fim, e as
+ * operações sem versão SIMD, usam a mesma semântica elemento a elemento.
+ */
+namespace vetorial {
+    // VLEN em bits; ELEN = 32 (Zve32x: elementos inteiros de até 32 bits)
+    constexpr uint32_t VLEN = 256;
+    constexpr uint32_t VLENB = VLEN / 8;
+    constexpr uint32_t ELEN = 32;
+    constexpr uint32_t NUM_REGISTRADORES = 32;
+
+    // Bit vill de vtype: configuração inválida
+    constexpr uint32_t VTYPE_VILL = 0x80000000u;
+
+    // Operações binárias: destino[i] = vs2[i] op vs1[i] (ou vs2[i] op escalar)
+    enum class Operacao : uint8_t {
+        Add, Sub, Rsub,
+        And, Or, Xor,
+        MinU, Min, MaxU, Max,
+        Sll, Srl, Sra,
+        Mul, Mulh, MulhU, MulhSU
+    };
+
+    // Comparações que geram máscara: bit i = vs2[i] cmp vs1[i]
+    enum class Comparacao : uint8_t {
+        Eq, Ne, LtU, Lt, LeU, Le, GtU, Gt
+    };
+
+    // Semântica de referência de um elemento (operandos e resultado com 'sew' bytes)
+    uint32_t operar_elemento(Operacao op, uint32_t sew, uint32_t a, uint32_t b);
+    bool comparar_elemento(Comparacao cmp, uint32_t sew, uint32_t a, uint32_t b);
+
+    uint32_t ler_elemento(const uint8_t* base, uint32_t indice, uint32_t sew);
+    void escrever_elemento(uint8_t* base, uint32_t indice, uint32_t sew, uint32_t valor);
+    inline bool bit_mascara(const uint8_t* mascara, uint32_t indice) {
+        return (mascara[indice >> 3] >> (indice & 7)) & 1;
+    }
+
+    // n elementos; o destino pode ser o próprio vs2 ou vs1
+    void operar(Operacao op, uint32_t sew, uint8_t* destino, const uint8_t* vs2, const uint8_t* vs1, uint32_t n);
+    void operar_escalar(Operacao op, uint32_t sew, uint8_t* destino, const uint8_t* vs2, uint32_t escalar, uint32_t n);
+
+    // Grava os bits 0..n-1 de 'mascara' (os bits seguintes do último byte ficam zerados)
+    void comparar(Comparacao cmp, uint32_t sew, uint8_t* mascara, const uint8_t* vs2, const uint8_t* vs1, uint32_t n);
+    void comparar_escalar(Comparacao cmp, uint32_t sew, uint8_t* mascara, const uint8_t* vs2, uint32_t escalar,
+                          uint32_t n);
+
+    void preencher(uint32_t sew, uint8_t* destino, uint32_t valor, uint32_t n);
+
+    // destino[i] = origem[i] para i em [inicio, fim) com o bit i de 'mascara' ligado (nula = todos);
+    // os demais elementos do destino não mudam
+    void mesclar(uint32_t sew, uint8_t* destino, const uint8_t* origem, const uint8_t* mascara,
+                 uint32_t inicio, uint32_t fim);
+    // O mesmo para máscaras: copia os bits [inicio, fim) de 'origem' onde 'mascara' permite
+    void mesclar_bits(uint8_t* destino, const uint8_t* origem, const uint8_t* mascara, uint32_t inicio,
+                      uint32_t fim);
+
+    // Conjunto de instruções usado pelos kernels ("AVX2", "SSE2" ou "escalar")
+    const char* implementacao();
+}
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_KERNELSVETORIAIS_H
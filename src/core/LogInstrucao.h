@@ -0,0 +1,42 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_LOGINSTRUCAO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_LOGINSTRUCAO_H
+
+#include <optional>
+#include <sstream>
+#include <string>
+
+/**
+ * @class LogInstrucao
+ * @brief Texto de uma instrução executada, montado só se o log do Core estiver ligado.
+ *
+ * Usado como um std::stringstream. Desligado, o fluxo nem é construído e os
+ * operadores << não formatam nada: nos modos rápidos, formatar o texto custaria
+ * mais que executar a instrução.
+ */
+class LogInstrucao {
+public:
+    explicit LogInstrucao(bool ativo) {
+        if (ativo) fluxo.emplace();
+    }
+
+    template <typename T>
+    LogInstrucao& operator<<(const T& valor) {
+        if (fluxo) *fluxo << valor;
+        return *this;
+    }
+
+    // Manipuladores como std::hex e std::dec
+    LogInstrucao& operator<<(std::ios_base& (*manipulador)(std::ios_base&)) {
+        if (fluxo) *fluxo << manipulador;
+        return *this;
+    }
+
+    std::string str() const {
+        return fluxo ? fluxo->str() : std::string();
+    }
+
+private:
+    std::optional<std::ostringstream> fluxo;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_LOGINSTRUCAO_H
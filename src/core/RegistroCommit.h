@@ -0,0 +1,42 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_REGISTROCOMMIT_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_REGISTROCOMMIT_H
+
+#include <cstdint>
+
+/**
+ * @enum AcessoMemoria
+ * @brief Tipo de acesso à memória feito por uma instrução.
+ */
+enum class AcessoMemoria : uint8_t {
+    Nenhum,
+    Leitura,
+    Escrita
+};
+
+/**
+ * @struct RegistroCommit
+ * @brief Resumo de uma instrução que acabou de ser executada pelo Core.
+ *
+ * É preenchido por Core::execute a cada passo e serve de entrada para os
+ * modelos que consomem o fluxo de instruções (timing, trace, etc.).
+ * Uma instrução nula (palavra 0) gera um registro com instrucao == 0,
+ * que deve ser ignorado pelos consumidores.
+ */
+struct RegistroCommit {
+    // Endereço da instrução executada e o PC resultante.
+    uint32_t pc = 0;
+    uint32_t proximo_pc = 0;
+    uint32_t instrucao = 0;
+
+    // Registrador de destino escrito (0 = nenhuma escrita) e o valor escrito.
+    uint32_t rd = 0;
+    uint32_t valor_rd = 0;
+
+    // Acesso à memória (apenas loads e stores).
+    AcessoMemoria acesso = AcessoMemoria::Nenhum;
+    uint32_t tamanho_acesso = 0;
+    uint32_t endereco_memoria = 0;
+    uint32_t dado_memoria = 0;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_REGISTROCOMMIT_H
@@ -0,0 +1,360 @@
+#include "CoSimulacao.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    constexpr size_t TAMANHO_BUFFER = 1 << 16;
+
+    const char* pular_espacos(const char* p, const char* fim) {
+        while (p < fim && (*p == ' ' || *p == '\t')) ++p;
+        return p;
+    }
+
+    const char* pular_token(const char* p, const char* fim) {
+        while (p < fim && *p != ' ' && *p != '\t') ++p;
+        return p;
+    }
+
+    int valor_hex(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    // Lê "0x<hex>"; 'digitos' recebe quantos dígitos foram lidos
+    bool ler_hex(const char*& p, const char* fim, uint64_t& valor, int& digitos) {
+        if (fim - p < 3 || p[0] != '0' || (p[1] != 'x' && p[1] != 'X')) return false;
+        p += 2;
+        valor = 0;
+        digitos = 0;
+        int d;
+        while (p < fim && (d = valor_hex(*p)) >= 0) {
+            valor = (valor << 4) | static_cast<uint64_t>(d);
+            ++p;
+            ++digitos;
+        }
+        return digitos > 0;
+    }
+
+    bool ler_hex32(const char*& p, const char* fim, uint32_t& valor) {
+        uint64_t v;
+        int digitos;
+        if (!ler_hex(p, fim, v, digitos)) return false;
+        valor = static_cast<uint32_t>(v);
+        return true;
+    }
+}
+
+// --- LeitorLogCommits ---
+
+LeitorLogCommits::~LeitorLogCommits() {
+    if (arquivo) std::fclose(arquivo);
+}
+
+std::string LeitorLogCommits::abrir(const std::string &caminho) {
+    arquivo = std::fopen(caminho.c_str(), "rb");
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o log de referencia: " + caminho;
+    }
+    buffer.resize(TAMANHO_BUFFER);
+    inicio = fim = 0;
+    fim_arquivo = false;
+    linha = 0;
+    return "";
+}
+
+uint64_t LeitorLogCommits::get_linha() const {
+    return linha;
+}
+
+/**
+ * @brief Localiza a próxima linha completa no buffer, lendo mais do arquivo se preciso.
+ * As linhas são devolvidas como ponteiros para o próprio buffer.
+ */
+bool LeitorLogCommits::proxima_linha(const char *&inicio_linha, const char *&fim_linha) {
+    while (true) {
+        const char* base = buffer.data();
+        const void* quebra = std::memchr(base + inicio, '\n', fim - inicio);
+        if (quebra) {
+            inicio_linha = base + inicio;
+            fim_linha = static_cast<const char*>(quebra);
+            inicio = static_cast<size_t>(fim_linha - base) + 1;
+            ++linha;
+            return true;
+        }
+
+        if (fim_arquivo) {
+            // Última linha sem '\n'
+            if (inicio == fim) return false;
+            inicio_linha = base + inicio;
+            fim_linha = base + fim;
+            inicio = fim;
+            ++linha;
+            return true;
+        }
+
+        // Move o resto da linha para o início e completa o buffer
+        std::memmove(buffer.data(), buffer.data() + inicio, fim - inicio);
+        fim -= inicio;
+        inicio = 0;
+        if (fim == buffer.size()) buffer.resize(buffer.size() * 2); // linha maior que o buffer
+        size_t lidos = std::fread(buffer.data() + fim, 1, buffer.size() - fim, arquivo);
+        if (lidos == 0) fim_arquivo = true;
+        fim += lidos;
+    }
+}
+
+bool LeitorLogCommits::interpretar(const char *p, const char *fim, RegistroCommit &registro) {
+    p = pular_espacos(p, fim);
+    if (fim - p < 4 || std::memcmp(p, "core", 4) != 0) return false;
+
+    const char* dois_pontos = static_cast<const char*>(std::memchr(p, ':', fim - p));
+    if (!dois_pontos) return false;
+    p = pular_espacos(dois_pontos + 1, fim);
+    p = pular_espacos(pular_token(p, fim), fim); // nível de privilégio
+
+    registro = RegistroCommit{};
+    if (!ler_hex32(p, fim, registro.pc)) return false;
+    p = pular_espacos(p, fim);
+    if (p == fim || *p != '(') return false;
+    ++p;
+    if (!ler_hex32(p, fim, registro.instrucao)) return false;
+    if (p < fim && *p == ')') ++p;
+
+    while (true) {
+        p = pular_espacos(p, fim);
+        if (p >= fim) break;
+
+        if (*p == 'x' && p + 1 < fim && p[1] >= '0' && p[1] <= '9') {
+            // Escrita em registrador inteiro: "x5  0x..."
+            uint32_t reg = 0;
+            ++p;
+            while (p < fim && *p >= '0' && *p <= '9') reg = reg * 10 + static_cast<uint32_t>(*p++ - '0');
+            p = pular_espacos(p, fim);
+            uint32_t valor;
+            if (!ler_hex32(p, fim, valor)) return false;
+            if (reg != 0 && reg < 32) {
+                registro.rd = reg;
+                registro.valor_rd = valor;
+            }
+        } else if (fim - p >= 3 && std::memcmp(p, "mem", 3) == 0) {
+            // "mem 0xENDERECO" (load) ou "mem 0xENDERECO 0xDADO" (store)
+            p = pular_espacos(p + 3, fim);
+            if (!ler_hex32(p, fim, registro.endereco_memoria)) return false;
+            const char* depois = pular_espacos(p, fim);
+            uint64_t dado;
+            int digitos;
+            const char* q = depois;
+            if (ler_hex(q, fim, dado, digitos)) {
+                registro.acesso = AcessoMemoria::Escrita;
+                registro.dado_memoria = static_cast<uint32_t>(dado);
+                registro.tamanho_acesso = static_cast<uint32_t>((digitos + 1) / 2);
+                p = q;
+            } else {
+                registro.acesso = AcessoMemoria::Leitura;
+                p = depois;
+            }
+        } else {
+            // Outros campos (CSRs, registradores de ponto flutuante...) são ignorados com seu valor
+            p = pular_espacos(pular_token(p, fim), fim);
+            if (p < fim && p[0] == '0' && p + 1 < fim && p[1] == 'x') p = pular_token(p, fim);
+        }
+    }
+    return true;
+}
+
+bool LeitorLogCommits::proximo(RegistroCommit &registro) {
+    const char* inicio_linha;
+    const char* fim_linha;
+    while (proxima_linha(inicio_linha, fim_linha)) {
+        if (interpretar(inicio_linha, fim_linha, registro)) return true;
+    }
+    return false;
+}
+
+// --- CoSimulacao ---
+
+std::string formatar_commit(const RegistroCommit &registro) {
+    char linha[128];
+    int n = std::snprintf(linha, sizeof(linha), "0x%08x (0x%08x)", registro.pc, registro.instrucao);
+    if (registro.rd != 0) {
+        n += std::snprintf(linha + n, sizeof(linha) - n, " x%-2u 0x%08x", registro.rd, registro.valor_rd);
+    }
+    if (registro.acesso == AcessoMemoria::Leitura) {
+        std::snprintf(linha + n, sizeof(linha) - n, " mem 0x%08x", registro.endereco_memoria);
+    } else if (registro.acesso == AcessoMemoria::Escrita) {
+        std::snprintf(linha + n, sizeof(linha) - n, " mem 0x%08x 0x%08x", registro.endereco_memoria,
+                      registro.dado_memoria);
+    }
+    return linha;
+}
+
+CoSimulacao::CoSimulacao(Core &core, LeitorLogCommits &referencia, size_t tamanho_contexto)
+    : core(core), referencia(referencia), janela(tamanho_contexto > 0 ? tamanho_contexto : 1) {
+}
+
+void CoSimulacao::definir_base_referencia(uint32_t base, uint32_t tamanho) {
+    base_referencia = base;
+    tamanho_janela = tamanho;
+}
+
+uint32_t CoSimulacao::rebasear(uint32_t valor) const {
+    return valor - base_referencia < tamanho_janela ? valor - base_referencia : valor;
+}
+
+bool CoSimulacao::valor_confere(uint32_t nosso, uint32_t ref) const {
+    return nosso == ref || (tamanho_janela != 0 && nosso == rebasear(ref));
+}
+
+bool CoSimulacao::proxima_referencia(RegistroCommit &registro) {
+    if (!referencia.proximo(registro)) return false;
+    if (tamanho_janela != 0) {
+        registro.pc = rebasear(registro.pc);
+        registro.proximo_pc = rebasear(registro.proximo_pc);
+        if (registro.acesso != AcessoMemoria::Nenhum) registro.endereco_memoria = rebasear(registro.endereco_memoria);
+    }
+    return true;
+}
+
+bool CoSimulacao::sincronizar(uint64_t maximo_descartes) {
+    uint32_t pc = core.get_program_counter();
+    RegistroCommit registro;
+    for (uint64_t i = 0; i <= maximo_descartes && proxima_referencia(registro); ++i) {
+        if (registro.pc == pc) {
+            pendente = registro;
+            tem_pendente = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Único lugar com as regras de comparação; não monta mensagem, pois roda a cada passo.
+ */
+Divergencia CoSimulacao::classificar(const RegistroCommit &nosso, const RegistroCommit &ref) const {
+    if (nosso.pc != ref.pc) return Divergencia::Pc;
+    if (nosso.instrucao != ref.instrucao) return Divergencia::Instrucao;
+    if (nosso.rd != ref.rd || (ref.rd != 0 && !valor_confere(nosso.valor_rd, ref.valor_rd))) {
+        return Divergencia::Registrador;
+    }
+    if (ref.acesso == AcessoMemoria::Escrita) {
+        uint32_t mascara = ref.tamanho_acesso >= 4 ? 0xFFFFFFFFu : (1u << (8 * ref.tamanho_acesso)) - 1;
+        bool confere = nosso.acesso == AcessoMemoria::Escrita && nosso.endereco_memoria == ref.endereco_memoria &&
+                       ((nosso.dado_memoria & mascara) == (ref.dado_memoria & mascara) ||
+                        (mascara == 0xFFFFFFFFu && valor_confere(nosso.dado_memoria, ref.dado_memoria)));
+        return confere ? Divergencia::Nenhuma : Divergencia::Store;
+    }
+    if (ref.acesso == AcessoMemoria::Leitura && nosso.acesso == AcessoMemoria::Leitura &&
+        nosso.endereco_memoria != ref.endereco_memoria) {
+        return Divergencia::EnderecoLoad;
+    }
+    return Divergencia::Nenhuma;
+}
+
+std::string CoSimulacao::descrever(Divergencia divergencia, const RegistroCommit &nosso,
+                                   const RegistroCommit &ref) const {
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0');
+
+    switch (divergencia) {
+        case Divergencia::Nenhuma:
+            break;
+        case Divergencia::Pc:
+            ss << "PC diverge: simulador 0x" << std::setw(8) << nosso.pc << ", referencia 0x" << std::setw(8)
+               << ref.pc;
+            break;
+        case Divergencia::Instrucao:
+            ss << "Instrucao diverge em 0x" << std::setw(8) << nosso.pc << ": simulador 0x" << std::setw(8)
+               << nosso.instrucao << ", referencia 0x" << std::setw(8) << ref.instrucao;
+            break;
+        case Divergencia::Registrador:
+            ss << "Escrita em registrador diverge em 0x" << std::setw(8) << nosso.pc << ": simulador x" << std::dec
+               << nosso.rd << "=0x" << std::hex << std::setw(8) << nosso.valor_rd << ", referencia x" << std::dec
+               << ref.rd << "=0x" << std::hex << std::setw(8) << ref.valor_rd;
+            break;
+        case Divergencia::Store:
+            ss << "Store diverge em 0x" << std::setw(8) << nosso.pc << ": simulador [0x" << std::setw(8)
+               << nosso.endereco_memoria << "]=0x" << std::setw(8) << nosso.dado_memoria << ", referencia [0x"
+               << std::setw(8) << ref.endereco_memoria << "]=0x" << std::setw(8) << ref.dado_memoria;
+            break;
+        case Divergencia::EnderecoLoad:
+            ss << "Endereco de load diverge em 0x" << std::setw(8) << nosso.pc << ": simulador 0x" << std::setw(8)
+               << nosso.endereco_memoria << ", referencia 0x" << std::setw(8) << ref.endereco_memoria;
+            break;
+    }
+    return ss.str();
+}
+
+std::string CoSimulacao::formatar_contexto() const {
+    std::stringstream ss;
+    ss << "Ultimas " << preenchidos << " instrucoes (simulador | referencia):\n";
+    size_t primeiro = (proximo_slot + janela.size() - preenchidos) % janela.size();
+    for (size_t i = 0; i < preenchidos; ++i) {
+        const auto& [nosso, ref] = janela[(primeiro + i) % janela.size()];
+        ss << "  " << std::left << std::setw(56) << formatar_commit(nosso) << " | " << formatar_commit(ref) << "\n";
+    }
+
+    ss << "Registradores do simulador:\n" << std::hex << std::setfill('0');
+    std::array<uint32_t, 32> regs = core.get_registradores();
+    for (int i = 0; i < 32; ++i) {
+        ss << "  x" << std::dec << std::setfill(' ') << std::left << std::setw(2) << i << " = 0x"
+           << std::hex << std::right << std::setfill('0') << std::setw(8) << regs[i];
+        if (i % 4 == 3) ss << "\n";
+    }
+    return ss.str();
+}
+
+ResultadoCoSim CoSimulacao::executar(uint64_t maximo_instrucoes) {
+    ResultadoCoSim resultado;
+    RegistroCommit ref;
+    // Só o commit de cada passo é comparado; o texto da instrução não é usado
+    bool log_ligado = core.log_ligado();
+    core.definir_log(false);
+
+    while (resultado.instrucoes < maximo_instrucoes) {
+        bool tem_ref;
+        if (tem_pendente) {
+            ref = pendente;
+            tem_pendente = false;
+            tem_ref = true;
+        } else {
+            tem_ref = proxima_referencia(ref);
+        }
+        if (!tem_ref) break; // Fim do log de referência: tudo conferiu
+
+        if (core.is_finished()) {
+            resultado.divergiu = true;
+            resultado.motivo = "Simulador finalizou, mas a referencia continua";
+            break;
+        }
+
+        core.step();
+        const RegistroCommit& nosso = core.get_ultimo_commit();
+        janela[proximo_slot] = {nosso, ref};
+        proximo_slot = (proximo_slot + 1) % janela.size();
+        if (preenchidos < janela.size()) ++preenchidos;
+
+        Divergencia divergencia = classificar(nosso, ref);
+        if (divergencia != Divergencia::Nenhuma) {
+            resultado.motivo = descrever(divergencia, nosso, ref);
+            resultado.divergiu = true;
+            break;
+        }
+        ++resultado.instrucoes;
+    }
+
+    core.definir_log(log_ligado);
+
+    if (resultado.divergiu) {
+        std::stringstream ss;
+        ss << resultado.motivo << " (instrucao " << resultado.instrucoes << ", linha "
+           << referencia.get_linha() << " da referencia)";
+        resultado.motivo = ss.str();
+        resultado.contexto = formatar_contexto();
+    }
+    return resultado;
+}
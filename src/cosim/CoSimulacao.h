@@ -0,0 +1,110 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_COSIMULACAO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_COSIMULACAO_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "core/Core.h"
+#include "core/RegistroCommit.h"
+
+/**
+ * @class LeitorLogCommits
+ * @brief Lê em fluxo um log de commits no formato do Spike (--log-commits).
+ *
+ * Exemplo de linhas aceitas:
+ *   core   0: 3 0x80000000 (0x00000297) x5  0x80000000
+ *   core   0: 3 0x80000010 (0x0062a023) mem 0x80001000 0x00000001
+ *
+ * O arquivo é lido em blocos de tamanho fixo e cada linha é interpretada no
+ * próprio buffer, sem alocações por linha. Linhas que não começam com "core"
+ * são ignoradas.
+ */
+class LeitorLogCommits {
+public:
+    LeitorLogCommits() = default;
+    ~LeitorLogCommits();
+
+    LeitorLogCommits(const LeitorLogCommits&) = delete;
+    LeitorLogCommits& operator=(const LeitorLogCommits&) = delete;
+
+    std::string abrir(const std::string& caminho);
+    // Retorna false no fim do arquivo
+    bool proximo(RegistroCommit& registro);
+    uint64_t get_linha() const;
+
+private:
+    bool proxima_linha(const char*& inicio, const char*& fim);
+    static bool interpretar(const char* p, const char* fim, RegistroCommit& registro);
+
+    std::FILE* arquivo = nullptr;
+    std::vector<char> buffer;
+    size_t inicio = 0;
+    size_t fim = 0;
+    bool fim_arquivo = false;
+    uint64_t linha = 0;
+};
+
+/**
+ * @struct ResultadoCoSim
+ * @brief Resultado da comparação em lockstep.
+ */
+struct ResultadoCoSim {
+    bool divergiu = false;
+    uint64_t instrucoes = 0;
+    std::string motivo;
+    // Últimas instruções comparadas e estado dos registradores no ponto de divergência
+    std::string contexto;
+};
+
+// Primeira regra de comparação que falhou num par (simulador, referência)
+enum class Divergencia { Nenhuma, Pc, Instrucao, Registrador, Store, EnderecoLoad };
+
+/**
+ * @class CoSimulacao
+ * @brief Executa o Core em lockstep com um log de referência e para na primeira divergência
+ * de PC, instrução, escrita em registrador ou store.
+ */
+class CoSimulacao {
+public:
+    CoSimulacao(Core& core, LeitorLogCommits& referencia, size_t tamanho_contexto = 16);
+
+    // A referência roda com a RAM em [base, base + tamanho) e o simulador em [0, tamanho)
+    // (ex: o Spike carrega em 0x80000000). Os PCs e endereços de memória da referência dentro
+    // dessa janela são rebaseados; fora dela (ex: a ROM de boot do Spike) ficam como estão.
+    // Valores de rd e de stores podem ou não ser endereços, então conferem de um jeito ou do outro.
+    void definir_base_referencia(uint32_t base, uint32_t tamanho);
+
+    // Descarta registros da referência até o PC atual do Core (ex: código de boot do Spike)
+    bool sincronizar(uint64_t maximo_descartes = 1000);
+    ResultadoCoSim executar(uint64_t maximo_instrucoes = UINT64_MAX);
+
+private:
+    bool proxima_referencia(RegistroCommit& registro);
+    uint32_t rebasear(uint32_t valor) const;
+    bool valor_confere(uint32_t nosso, uint32_t referencia) const;
+    Divergencia classificar(const RegistroCommit& nosso, const RegistroCommit& referencia) const;
+    std::string descrever(Divergencia divergencia, const RegistroCommit& nosso,
+                          const RegistroCommit& referencia) const;
+    std::string formatar_contexto() const;
+
+    Core& core;
+    LeitorLogCommits& referencia;
+
+    // Janela circular com os últimos pares (nosso, referência)
+    std::vector<std::pair<RegistroCommit, RegistroCommit>> janela;
+    size_t proximo_slot = 0;
+    size_t preenchidos = 0;
+
+    RegistroCommit pendente;
+    bool tem_pendente = false;
+
+    uint32_t base_referencia = 0;
+    uint32_t tamanho_janela = 0;
+};
+
+// Formata um commit como uma linha do log do Spike
+std::string formatar_commit(const RegistroCommit& registro);
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_COSIMULACAO_H
@@ -0,0 +1,35 @@
+#include "EspelhoCache.h"
+
+void EspelhoCache::sincronizar(Core &core) {
+    core.consumir_alteracoes_cache(indices_core);
+
+    std::lock_guard<std::mutex> trava(mutex);
+    if (linhas.size() != core.get_linhas_cache()) {
+        linhas.assign(core.get_linhas_cache(), EstadoLinhaCache{});
+        pendente.assign(linhas.size(), 0);
+        alteradas.clear();
+    }
+    for (uint32_t indice : indices_core) {
+        linhas[indice] = core.get_estado_linha_cache(indice);
+        if (!pendente[indice]) {
+            pendente[indice] = 1;
+            alteradas.push_back(indice);
+        }
+    }
+}
+
+void EspelhoCache::consumir(std::vector<uint32_t> &indices, std::vector<EstadoLinhaCache> &estados) {
+    std::lock_guard<std::mutex> trava(mutex);
+    indices.assign(alteradas.begin(), alteradas.end());
+    estados.clear();
+    for (uint32_t indice : alteradas) {
+        estados.push_back(linhas[indice]);
+        pendente[indice] = 0;
+    }
+    alteradas.clear();
+}
+
+size_t EspelhoCache::quantidade_linhas() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return linhas.size();
+}
@@ -0,0 +1,37 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_ESPELHOCACHE_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_ESPELHOCACHE_H
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "core/Core.h"
+
+/**
+ * @class EspelhoCache
+ * @brief Cópia do estado das linhas do cache, atualizada só nas linhas que mudaram.
+ *
+ * Quem possui o Core (a thread de execução, ou a interface fora do Run)
+ * chama sincronizar(), que consome o registro de alterações do Cache e copia
+ * apenas essas linhas. A interface chama consumir() para saber quais linhas
+ * redesenhar. As alterações se acumulam entre duas leituras (cada linha
+ * aparece uma vez), então nenhuma se perde se a interface pular quadros.
+ */
+class EspelhoCache {
+public:
+    void sincronizar(Core& core);
+
+    // Índices alterados desde a última chamada e o estado atual de cada um
+    void consumir(std::vector<uint32_t>& indices, std::vector<EstadoLinhaCache>& estados);
+    size_t quantidade_linhas() const;
+
+private:
+    std::vector<EstadoLinhaCache> linhas;
+    std::vector<uint8_t> pendente;
+    std::vector<uint32_t> alteradas;
+    // Reaproveitado entre sincronizações para não alocar a cada quadro
+    std::vector<uint32_t> indices_core;
+    mutable std::mutex mutex;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_ESPELHOCACHE_H
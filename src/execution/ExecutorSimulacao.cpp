@@ -0,0 +1,139 @@
+#include "ExecutorSimulacao.h"
+
+#include "syscall/ProxySyscalls.h"
+
+ExecutorSimulacao::ExecutorSimulacao(Core &core) : core(core) {
+}
+
+ExecutorSimulacao::~ExecutorSimulacao() {
+    parar();
+}
+
+void ExecutorSimulacao::iniciar() {
+    if (rodando.load(std::memory_order_acquire)) return;
+    // A thread anterior pode ter terminado sozinha e ainda não ter sido recolhida
+    if (thread.joinable()) thread.join();
+
+    parada_solicitada.store(false, std::memory_order_relaxed);
+    rodando.store(true, std::memory_order_release);
+    thread = std::thread(&ExecutorSimulacao::laco, this);
+}
+
+void ExecutorSimulacao::parar() {
+    parada_solicitada.store(true, std::memory_order_relaxed);
+    if (thread.joinable()) thread.join();
+    rodando.store(false, std::memory_order_release);
+}
+
+bool ExecutorSimulacao::executando() const {
+    return rodando.load(std::memory_order_acquire);
+}
+
+void ExecutorSimulacao::definir_historico(HistoricoExecucao *historico) {
+    this->historico = historico;
+}
+
+void ExecutorSimulacao::definir_metricas(SerieMetricas *metricas, std::chrono::milliseconds intervalo) {
+    this->metricas = metricas;
+    intervalo_amostragem = intervalo;
+}
+
+void ExecutorSimulacao::definir_espelho_cache(EspelhoCache *espelho) {
+    espelho_cache = espelho;
+}
+
+void ExecutorSimulacao::definir_gravador_trace(GravadorTrace *gravador) {
+    gravador_trace = gravador;
+}
+
+void ExecutorSimulacao::definir_intervalo_publicacao(std::chrono::milliseconds intervalo) {
+    intervalo_publicacao = intervalo;
+}
+
+const InstantaneoCore* ExecutorSimulacao::consumir_instantaneo() {
+    return instantaneos.atualizar() ? &instantaneos.leitura() : nullptr;
+}
+
+void ExecutorSimulacao::laco() {
+    // Sem log, o Core só devolve mensagens de fim e de erro; o texto da instrução publicada
+    // é montado a partir do commit, uma vez por publicação em vez de uma vez por passo
+    bool log_anterior = core.log_ligado();
+    core.definir_log(false);
+    std::string mensagem;
+    uint64_t executadas = 0;
+    uint64_t executadas_na_publicacao = 0;
+    auto ultima_publicacao = std::chrono::steady_clock::now();
+    auto ultima_amostra = ultima_publicacao;
+    std::vector<RegistroCommit> lote;
+    lote.reserve(TAMANHO_LOTE);
+    GravadorTrace* gravador = gravador_trace && gravador_trace->aberto() ? gravador_trace : nullptr;
+    // Só enquanto esta thread é dona do Core: um passo dado pela interface pode bloquear no read
+    core.get_proxy_syscalls().definir_cancelamento(&parada_solicitada);
+    if (metricas) {
+        metricas->iniciar_intervalo(core.get_contadores(), core.get_estatisticas_cache());
+    }
+
+    while (!parada_solicitada.load(std::memory_order_relaxed) && !core.is_finished()) {
+        lote.clear();
+        for (uint32_t i = 0; i < TAMANHO_LOTE && !core.is_finished(); ++i) {
+            mensagem = core.step();
+            ++executadas;
+            const RegistroCommit& commit = core.get_ultimo_commit();
+            if (commit.instrucao == 0) continue;
+            if (historico) lote.push_back(commit);
+            if (gravador) gravador->registrar(commit);
+        }
+        if (historico && !lote.empty()) {
+            historico->adicionar_lote(lote.data(), lote.size());
+        }
+
+        auto agora = std::chrono::steady_clock::now();
+        if (metricas && agora - ultima_amostra >= intervalo_amostragem) {
+            metricas->amostrar(core.get_contadores(), core.get_estatisticas_cache());
+            ultima_amostra = agora;
+        }
+        if (agora - ultima_publicacao >= intervalo_publicacao) {
+            publicar(mensagem, executadas - executadas_na_publicacao, ultima_publicacao);
+            executadas_na_publicacao = executadas;
+            ultima_publicacao = agora;
+        }
+    }
+
+    // O último instantâneo (e a última amostra) sempre refletem o estado final
+    if (metricas) {
+        metricas->amostrar(core.get_contadores(), core.get_estatisticas_cache());
+    }
+    publicar(mensagem, executadas - executadas_na_publicacao, ultima_publicacao);
+    core.get_proxy_syscalls().definir_cancelamento(nullptr);
+    core.definir_log(log_anterior);
+    rodando.store(false, std::memory_order_release);
+}
+
+void ExecutorSimulacao::publicar(const std::string &mensagem, uint64_t instrucoes,
+                                 std::chrono::steady_clock::time_point inicio) {
+    if (espelho_cache) {
+        espelho_cache->sincronizar(core);
+    }
+
+    InstantaneoCore& destino = instantaneos.escrita();
+    destino.registradores = core.get_registradores();
+    destino.pc = core.get_program_counter();
+    destino.contadores = core.get_contadores();
+    destino.estatisticas_cache = core.get_estatisticas_cache();
+    destino.finalizado = core.is_finished();
+    destino.encerrado = core.encerrado();
+    destino.codigo_saida = core.get_codigo_saida();
+    const RegistroCommit& commit = core.get_ultimo_commit();
+    if (!mensagem.empty()) {
+        destino.ultimo_log = mensagem;
+    } else if (commit.instrucao != 0) {
+        destino.ultimo_log = HistoricoExecucao::formatar(core.get_contadores().instrucoes, commit);
+    } else {
+        destino.ultimo_log.clear();
+    }
+
+    std::chrono::duration<double> decorrido = std::chrono::steady_clock::now() - inicio;
+    destino.instrucoes_por_segundo = decorrido.count() > 0 ? instrucoes / decorrido.count() : 0.0;
+
+    instantaneos.publicar();
+}
@@ -0,0 +1,103 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_EXECUTORSIMULACAO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_EXECUTORSIMULACAO_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EspelhoCache.h"
+#include "HistoricoExecucao.h"
+#include "SerieMetricas.h"
+#include "TriploBuffer.h"
+#include "core/Core.h"
+#include "trace/TraceBinario.h"
+
+/**
+ * @struct InstantaneoCore
+ * @brief Cópia do estado do Core publicada pela thread de execução para a interface.
+ */
+struct InstantaneoCore {
+    std::array<uint32_t, 32> registradores{};
+    uint32_t pc = 0;
+    ContadoresCore contadores;
+    EstatisticasCache estatisticas_cache;
+    bool finalizado = false;
+    bool encerrado = false;
+    int32_t codigo_saida = 0;
+    // Última instrução executada antes da publicação, ou a mensagem do Core (ex: fim do programa)
+    std::string ultimo_log;
+    // Instruções por segundo medidas desde a publicação anterior
+    double instrucoes_por_segundo = 0.0;
+};
+
+/**
+ * @class ExecutorSimulacao
+ * @brief Executa o Core em uma thread própria, em lotes, publicando instantâneos por um TriploBuffer.
+ *
+ * Enquanto a thread roda, ninguém mais pode tocar no Core: a interface lê
+ * apenas os instantâneos. O pedido de parada é checado a cada lote, então
+ * parar() volta em no máximo um lote (alguns milissegundos); depois dele o
+ * Core pode ser usado normalmente pela thread que chamou. Um read de stdin
+ * do guest também é interrompido pela parada (e refeito no próximo iniciar()).
+ */
+class ExecutorSimulacao {
+public:
+    // Instruções executadas entre duas checagens de parada/relógio
+    static constexpr uint32_t TAMANHO_LOTE = 2048;
+
+    explicit ExecutorSimulacao(Core& core);
+    ~ExecutorSimulacao();
+
+    ExecutorSimulacao(const ExecutorSimulacao&) = delete;
+    ExecutorSimulacao& operator=(const ExecutorSimulacao&) = delete;
+
+    // Começa a executar até o fim do programa ou até parar(); não faz nada se já estiver rodando
+    void iniciar();
+    // Pede a parada e espera a thread terminar o lote atual
+    void parar();
+    // false quando a thread terminou sozinha (fim do programa) ou foi parada
+    bool executando() const;
+
+    // Se definido, cada instrução executada é registrada no histórico (um lote por vez)
+    void definir_historico(HistoricoExecucao* historico);
+    // Se definida, os contadores do Core e do cache são amostrados na série a cada 'intervalo'
+    void definir_metricas(SerieMetricas* metricas,
+                          std::chrono::milliseconds intervalo = std::chrono::milliseconds(100));
+
+    // Se definido (e aberto), cada instrução executada é gravada no trace binário
+    void definir_gravador_trace(GravadorTrace* gravador);
+
+    // Se definido, as linhas do cache alteradas são copiadas para o espelho a cada publicação
+    void definir_espelho_cache(EspelhoCache* espelho);
+
+    // Intervalo mínimo entre duas publicações (padrão: 16 ms)
+    void definir_intervalo_publicacao(std::chrono::milliseconds intervalo);
+
+    // Consumidor: retorna o instantâneo mais recente, ou nullptr se não houve publicação nova
+    const InstantaneoCore* consumir_instantaneo();
+
+private:
+    void laco();
+    // 'mensagem' é o retorno do último passo; vazia, a instrução é formatada a partir do commit
+    void publicar(const std::string& mensagem, uint64_t instrucoes,
+                  std::chrono::steady_clock::time_point inicio);
+
+    Core& core;
+    std::thread thread;
+    std::atomic<bool> parada_solicitada{false};
+    std::atomic<bool> rodando{false};
+    std::chrono::milliseconds intervalo_publicacao{16};
+    HistoricoExecucao* historico = nullptr;
+    SerieMetricas* metricas = nullptr;
+    EspelhoCache* espelho_cache = nullptr;
+    GravadorTrace* gravador_trace = nullptr;
+    std::chrono::milliseconds intervalo_amostragem{100};
+
+    TriploBuffer<InstantaneoCore> instantaneos;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_EXECUTORSIMULACAO_H
@@ -0,0 +1,118 @@
+#include "HistoricoExecucao.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include "core/Desmontador.h"
+
+HistoricoExecucao::HistoricoExecucao(size_t capacidade) : anel(capacidade > 0 ? capacidade : 1) {
+}
+
+void HistoricoExecucao::adicionar(const RegistroCommit &registro) {
+    std::lock_guard<std::mutex> trava(mutex);
+    anel[total % anel.size()] = registro;
+    ++total;
+}
+
+void HistoricoExecucao::adicionar_lote(const RegistroCommit *registros, size_t quantidade) {
+    std::lock_guard<std::mutex> trava(mutex);
+    // Se o lote for maior que o anel, só os últimos registros sobrevivem
+    if (quantidade > anel.size()) {
+        total += quantidade - anel.size();
+        registros += quantidade - anel.size();
+        quantidade = anel.size();
+    }
+    for (size_t i = 0; i < quantidade; ++i) {
+        anel[(total + i) % anel.size()] = registros[i];
+    }
+    total += quantidade;
+}
+
+void HistoricoExecucao::limpar() {
+    std::lock_guard<std::mutex> trava(mutex);
+    total = 0;
+}
+
+void HistoricoExecucao::descartar_ultimos(uint64_t quantidade) {
+    std::lock_guard<std::mutex> trava(mutex);
+    uint64_t primeiro = total > anel.size() ? total - anel.size() : 0;
+    total -= std::min(quantidade, total - primeiro);
+}
+
+size_t HistoricoExecucao::capacidade() const {
+    return anel.size();
+}
+
+uint64_t HistoricoExecucao::primeiro_sequencial() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return total > anel.size() ? total - anel.size() : 0;
+}
+
+uint64_t HistoricoExecucao::fim_sequencial() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return total;
+}
+
+bool HistoricoExecucao::obter(uint64_t sequencial, RegistroCommit &registro) const {
+    std::lock_guard<std::mutex> trava(mutex);
+    if (sequencial >= total || total - sequencial > anel.size()) return false;
+    registro = anel[sequencial % anel.size()];
+    return true;
+}
+
+uint64_t HistoricoExecucao::copiar(uint64_t inicio, uint64_t fim, std::vector<RegistroCommit> &destino) const {
+    std::lock_guard<std::mutex> trava(mutex);
+    uint64_t primeiro = total > anel.size() ? total - anel.size() : 0;
+    if (inicio < primeiro) inicio = primeiro;
+    if (fim > total) fim = total;
+
+    destino.clear();
+    for (uint64_t s = inicio; s < fim; ++s) {
+        destino.push_back(anel[s % anel.size()]);
+    }
+    return inicio;
+}
+
+std::string HistoricoExecucao::formatar(uint64_t sequencial, const RegistroCommit &registro) {
+    char linha[160];
+    int n = std::snprintf(linha, sizeof(linha), "%8llu  0x%08x  (0x%08x)  %-28s",
+                          static_cast<unsigned long long>(sequencial), registro.pc, registro.instrucao,
+                          desmontar(registro.instrucao).c_str());
+    if (registro.rd != 0) {
+        n += std::snprintf(linha + n, sizeof(linha) - n, " x%u=0x%08x", registro.rd, registro.valor_rd);
+    }
+    if (registro.acesso == AcessoMemoria::Leitura) {
+        std::snprintf(linha + n, sizeof(linha) - n, " mem[0x%08x]->0x%x", registro.endereco_memoria,
+                      registro.dado_memoria);
+    } else if (registro.acesso == AcessoMemoria::Escrita) {
+        std::snprintf(linha + n, sizeof(linha) - n, " mem[0x%08x]<-0x%x", registro.endereco_memoria,
+                      registro.dado_memoria);
+    }
+    return linha;
+}
+
+std::string HistoricoExecucao::exportar(const std::string &caminho) const {
+    std::ofstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel criar o arquivo: " + caminho;
+    }
+
+    // Copia em blocos para não segurar o mutex durante a escrita no disco
+    std::vector<RegistroCommit> bloco;
+    uint64_t inicio = primeiro_sequencial();
+    uint64_t fim = fim_sequencial();
+    while (inicio < fim) {
+        uint64_t s = copiar(inicio, std::min<uint64_t>(fim, inicio + 4096), bloco);
+        for (const RegistroCommit& registro : bloco) {
+            arquivo << formatar(s++, registro) << '\n';
+        }
+        inicio = s;
+        if (bloco.empty()) break;
+    }
+
+    if (!arquivo) {
+        return "[ERRO] Falha ao escrever o arquivo: " + caminho;
+    }
+    return "";
+}
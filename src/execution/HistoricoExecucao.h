@@ -0,0 +1,57 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_HISTORICOEXECUCAO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_HISTORICOEXECUCAO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "core/RegistroCommit.h"
+
+/**
+ * @class HistoricoExecucao
+ * @brief Anel de capacidade fixa com os últimos RegistroCommit executados.
+ *
+ * Cada registro recebe um número sequencial crescente; quando o anel enche,
+ * os mais antigos são sobrescritos. A memória usada não cresce com o tamanho
+ * da execução. O texto só é gerado na exibição ou na exportação. Um mutex
+ * protege o anel porque a thread de execução insere em lotes enquanto a
+ * interface lê as linhas visíveis.
+ */
+class HistoricoExecucao {
+public:
+    static constexpr size_t CAPACIDADE_PADRAO = 1u << 18;
+
+    explicit HistoricoExecucao(size_t capacidade = CAPACIDADE_PADRAO);
+
+    void adicionar(const RegistroCommit& registro);
+    void adicionar_lote(const RegistroCommit* registros, size_t quantidade);
+    void limpar();
+    // Remove os registros mais recentes (ex: instruções desfeitas pela execução reversa)
+    void descartar_ultimos(uint64_t quantidade);
+
+    size_t capacidade() const;
+    // Intervalo [primeiro_sequencial, fim_sequencial) dos registros ainda no anel
+    uint64_t primeiro_sequencial() const;
+    uint64_t fim_sequencial() const;
+
+    // false se o registro já foi sobrescrito ou ainda não existe
+    bool obter(uint64_t sequencial, RegistroCommit& registro) const;
+    // Copia os registros de [inicio, fim) ainda disponíveis; retorna o sequencial do primeiro copiado
+    uint64_t copiar(uint64_t inicio, uint64_t fim, std::vector<RegistroCommit>& destino) const;
+
+    // Grava todo o anel em texto (uma instrução desmontada por linha); retorna erro ou string vazia
+    std::string exportar(const std::string& caminho) const;
+
+    // Linha de texto de um registro: sequencial, pc, instrução, assembly e efeitos
+    static std::string formatar(uint64_t sequencial, const RegistroCommit& registro);
+
+private:
+    std::vector<RegistroCommit> anel;
+    // Total de registros já inseridos (o próximo sequencial)
+    uint64_t total = 0;
+    mutable std::mutex mutex;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_HISTORICOEXECUCAO_H
@@ -0,0 +1,108 @@
+#include "SerieMetricas.h"
+
+SerieMetricas::SerieMetricas(size_t capacidade) : anel(capacidade > 0 ? capacidade : 1) {
+}
+
+void SerieMetricas::iniciar_intervalo(const ContadoresCore &contadores, const EstatisticasCache &cache) {
+    std::lock_guard<std::mutex> trava(mutex);
+    base_contadores = contadores;
+    base_cache = cache;
+    base_tempo = std::chrono::steady_clock::now();
+}
+
+void SerieMetricas::amostrar(const ContadoresCore &contadores, const EstatisticasCache &cache) {
+    auto agora = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> trava(mutex);
+
+    // Um reset do Core no meio do intervalo zeraria os contadores: recomeça dali
+    if (contadores.instrucoes < base_contadores.instrucoes) {
+        base_contadores = contadores;
+        base_cache = cache;
+        base_tempo = agora;
+        return;
+    }
+    uint64_t instrucoes = contadores.instrucoes - base_contadores.instrucoes;
+    if (instrucoes == 0) return;
+
+    double segundos = std::chrono::duration<double>(agora - base_tempo).count();
+    tempo_acumulado += segundos;
+
+    AmostraMetricas amostra;
+    amostra.tempo = tempo_acumulado;
+    amostra.instrucoes = contadores.instrucoes;
+    amostra.instrucoes_por_segundo = segundos > 0 ? instrucoes / segundos : 0.0;
+
+    uint64_t acessos = (cache.leituras - base_cache.leituras) + (cache.escritas - base_cache.escritas);
+    uint64_t acertos = (cache.acertos_leitura - base_cache.acertos_leitura) +
+                       (cache.acertos_escrita - base_cache.acertos_escrita);
+    uint64_t faltas = (cache.faltas_leitura - base_cache.faltas_leitura) +
+                      (cache.faltas_escrita - base_cache.faltas_escrita);
+    amostra.taxa_acerto_cache = acessos > 0 ? 100.0 * acertos / acessos : 0.0;
+    amostra.faltas_por_mil = 1000.0 * faltas / instrucoes;
+
+    uint64_t loads = contadores.loads - base_contadores.loads;
+    uint64_t stores = contadores.stores - base_contadores.stores;
+    uint64_t desvios = contadores.desvios - base_contadores.desvios;
+    uint64_t saltos = contadores.saltos - base_contadores.saltos;
+    uint64_t mul_div = (contadores.multiplicacoes - base_contadores.multiplicacoes) +
+                       (contadores.divisoes - base_contadores.divisoes);
+    uint64_t classificadas = loads + stores + desvios + saltos + mul_div;
+    uint64_t outras = instrucoes > classificadas ? instrucoes - classificadas : 0;
+    const uint64_t por_classe[NUMERO_CLASSES_INSTRUCAO] = {loads, stores, desvios, saltos, mul_div, outras};
+    for (size_t i = 0; i < NUMERO_CLASSES_INSTRUCAO; ++i) {
+        amostra.mix[i] = 100.0 * por_classe[i] / instrucoes;
+    }
+
+    anel[total % anel.size()] = amostra;
+    ++total;
+
+    base_contadores = contadores;
+    base_cache = cache;
+    base_tempo = agora;
+}
+
+void SerieMetricas::limpar() {
+    std::lock_guard<std::mutex> trava(mutex);
+    total = 0;
+    tempo_acumulado = 0.0;
+    ++geracao_atual;
+}
+
+uint64_t SerieMetricas::primeiro_sequencial() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return total > anel.size() ? total - anel.size() : 0;
+}
+
+uint64_t SerieMetricas::fim_sequencial() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return total;
+}
+
+uint64_t SerieMetricas::geracao() const {
+    std::lock_guard<std::mutex> trava(mutex);
+    return geracao_atual;
+}
+
+uint64_t SerieMetricas::copiar(uint64_t inicio, std::vector<AmostraMetricas> &destino) const {
+    std::lock_guard<std::mutex> trava(mutex);
+    uint64_t primeiro = total > anel.size() ? total - anel.size() : 0;
+    if (inicio < primeiro) inicio = primeiro;
+
+    destino.clear();
+    for (uint64_t s = inicio; s < total; ++s) {
+        destino.push_back(anel[s % anel.size()]);
+    }
+    return inicio;
+}
+
+const char* SerieMetricas::nome_classe(ClasseInstrucao classe) {
+    switch (classe) {
+        case ClasseInstrucao::Loads: return "Loads";
+        case ClasseInstrucao::Stores: return "Stores";
+        case ClasseInstrucao::Desvios: return "Desvios";
+        case ClasseInstrucao::Saltos: return "Saltos";
+        case ClasseInstrucao::MulDiv: return "Mul/Div";
+        case ClasseInstrucao::Outras: return "Outras";
+    }
+    return "?";
+}
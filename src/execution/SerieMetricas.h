@@ -0,0 +1,79 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_SERIEMETRICAS_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_SERIEMETRICAS_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "core/Core.h"
+
+// Classes do mix de instruções, na ordem de AmostraMetricas::mix
+enum class ClasseInstrucao { Loads, Stores, Desvios, Saltos, MulDiv, Outras };
+constexpr size_t NUMERO_CLASSES_INSTRUCAO = 6;
+
+/**
+ * @struct AmostraMetricas
+ * @brief Métricas de um intervalo de amostragem, calculadas pela diferença entre dois conjuntos de contadores.
+ */
+struct AmostraMetricas {
+    // Segundos de execução (sem contar as pausas) desde o último limpar()
+    double tempo = 0.0;
+    // Total de instruções retiradas no fim do intervalo
+    uint64_t instrucoes = 0;
+    double instrucoes_por_segundo = 0.0;
+    // Acertos / acessos ao cache no intervalo, em %
+    double taxa_acerto_cache = 0.0;
+    // Faltas no cache por mil instruções no intervalo
+    double faltas_por_mil = 0.0;
+    // Porcentagem das instruções do intervalo em cada ClasseInstrucao
+    std::array<double, NUMERO_CLASSES_INSTRUCAO> mix{};
+};
+
+/**
+ * @class SerieMetricas
+ * @brief Série temporal de AmostraMetricas em um anel de capacidade fixa.
+ *
+ * A thread de execução chama amostrar() a intervalos fixos com os contadores
+ * do Core e do cache; a janela de desempenho copia só as amostras novas
+ * (pelo número sequencial), sem tocar no Core. Um mutex protege o anel.
+ */
+class SerieMetricas {
+public:
+    static constexpr size_t CAPACIDADE_PADRAO = 4096;
+
+    explicit SerieMetricas(size_t capacidade = CAPACIDADE_PADRAO);
+
+    // Marca o início de um intervalo sem gerar amostra (ex.: ao começar um Run)
+    void iniciar_intervalo(const ContadoresCore& contadores, const EstatisticasCache& cache);
+    // Fecha o intervalo atual gerando uma amostra e abre o próximo; ignora intervalos sem instruções
+    void amostrar(const ContadoresCore& contadores, const EstatisticasCache& cache);
+    void limpar();
+
+    // Intervalo [primeiro_sequencial, fim_sequencial) das amostras ainda no anel
+    uint64_t primeiro_sequencial() const;
+    uint64_t fim_sequencial() const;
+    // Muda a cada limpar(), para quem lê saber que os sequenciais recomeçaram
+    uint64_t geracao() const;
+    // Copia as amostras a partir de 'inicio' ainda disponíveis; retorna o sequencial da primeira copiada
+    uint64_t copiar(uint64_t inicio, std::vector<AmostraMetricas>& destino) const;
+
+    static const char* nome_classe(ClasseInstrucao classe);
+
+private:
+    std::vector<AmostraMetricas> anel;
+    uint64_t total = 0;
+    uint64_t geracao_atual = 0;
+    double tempo_acumulado = 0.0;
+
+    // Contadores no início do intervalo atual
+    ContadoresCore base_contadores;
+    EstatisticasCache base_cache;
+    std::chrono::steady_clock::time_point base_tempo;
+
+    mutable std::mutex mutex;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_SERIEMETRICAS_H
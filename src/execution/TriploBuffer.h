@@ -0,0 +1,55 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_TRIPLOBUFFER_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_TRIPLOBUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @class TriploBuffer
+ * @brief Troca de "último valor" sem locks entre um produtor e um consumidor.
+ *
+ * O produtor escreve sempre em 'escrita()' e chama publicar(); o consumidor
+ * chama atualizar() e lê 'leitura()'. O terceiro slot fica no meio e é
+ * trocado atomicamente, então nenhum dos lados espera o outro e valores
+ * intermediários que o consumidor não chegou a ver são simplesmente descartados.
+ */
+template<typename T>
+class TriploBuffer {
+public:
+    // Produtor: slot livre para montar o próximo valor
+    T& escrita() {
+        return slots[indice_escrita];
+    }
+
+    // Produtor: entrega o slot de escrita e recebe o antigo slot do meio
+    void publicar() {
+        uint8_t anterior = meio.exchange(static_cast<uint8_t>(indice_escrita | NOVO), std::memory_order_acq_rel);
+        indice_escrita = anterior & INDICE;
+    }
+
+    // Consumidor: pega o valor mais recente, se houver; retorna false se nada mudou
+    bool atualizar() {
+        if (!(meio.load(std::memory_order_relaxed) & NOVO)) return false;
+        uint8_t anterior = meio.exchange(indice_leitura, std::memory_order_acq_rel);
+        indice_leitura = anterior & INDICE;
+        return true;
+    }
+
+    // Consumidor: último valor obtido por atualizar()
+    const T& leitura() const {
+        return slots[indice_leitura];
+    }
+
+private:
+    static constexpr uint8_t INDICE = 0x3;
+    static constexpr uint8_t NOVO = 0x4;
+
+    std::array<T, 3> slots{};
+    // Índice do slot do meio mais o bit NOVO
+    alignas(64) std::atomic<uint8_t> meio{1};
+    alignas(64) uint8_t indice_escrita = 0;
+    alignas(64) uint8_t indice_leitura = 2;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_TRIPLOBUFFER_H
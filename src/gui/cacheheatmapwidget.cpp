@@ -0,0 +1,179 @@
+#include "cacheheatmapwidget.h"
+
+#include <QHelpEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <algorithm>
+#include <cmath>
+
+// Menor potência de 2 maior ou igual a 'valor'
+static uint32_t scaleFor(uint32_t valor)
+{
+    uint32_t escala = 1;
+    while (escala < valor && escala < (1u << 31)) {
+        escala <<= 1;
+    }
+    return escala;
+}
+
+CacheHeatmapWidget::CacheHeatmapWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(200, 200);
+}
+
+void CacheHeatmapWidget::setMirror(EspelhoCache *mirror)
+{
+    m_mirror = mirror;
+    refresh();
+}
+
+void CacheHeatmapWidget::setMode(Mode mode)
+{
+    m_mode = mode;
+    recolorAll();
+}
+
+QColor CacheHeatmapWidget::colorFor(const EstadoLinhaCache &state) const
+{
+    if (!state.valida && state.acessos == 0) {
+        return QColor(40, 40, 40);
+    }
+
+    if (m_mode == Mode::Tag) {
+        if (!state.valida) {
+            return QColor(40, 40, 40);
+        }
+        // Tags diferentes no mesmo conjunto ganham cores diferentes
+        return QColor::fromHsv(static_cast<int>((state.tag * 47u) % 360u), 160, 220);
+    }
+
+    // Escala logarítmica: azul (pouco) -> amarelo -> vermelho (muito)
+    uint32_t valor = m_mode == Mode::Accesses ? state.acessos : state.faltas;
+    uint32_t escala = m_mode == Mode::Accesses ? m_scaleAccesses : m_scaleMisses;
+    double t = std::log2(1.0 + valor) / std::log2(1.0 + escala);
+    return QColor::fromHsvF((1.0 - t) * 0.66, 0.9, 0.35 + 0.65 * t);
+}
+
+void CacheHeatmapWidget::recolorAll()
+{
+    m_scaleAccesses = 1;
+    m_scaleMisses = 1;
+    for (const EstadoLinhaCache &state : m_lines) {
+        m_scaleAccesses = std::max(m_scaleAccesses, scaleFor(state.acessos));
+        m_scaleMisses = std::max(m_scaleMisses, scaleFor(state.faltas));
+    }
+
+    const int count = static_cast<int>(m_lines.size());
+    for (int i = 0; i < count; ++i) {
+        m_image.setPixelColor(i % m_columns, i / m_columns, colorFor(m_lines[i]));
+    }
+    update();
+}
+
+void CacheHeatmapWidget::refresh()
+{
+    if (!m_mirror) {
+        return;
+    }
+
+    // Grade quase quadrada, com largura potência de 2 para os índices ficarem alinhados
+    size_t count = m_mirror->quantidade_linhas();
+    if (count != m_lines.size()) {
+        m_lines.assign(count, EstadoLinhaCache{});
+        m_columns = 1;
+        while (static_cast<size_t>(m_columns) * m_columns < count) {
+            m_columns <<= 1;
+        }
+        int rows = count > 0 ? static_cast<int>((count + m_columns - 1) / m_columns) : 1;
+        m_image = QImage(m_columns, rows, QImage::Format_RGB32);
+        m_image.fill(QColor(20, 20, 20));
+        recolorAll();
+    }
+
+    m_mirror->consumir(m_changed, m_changedStates);
+    if (m_changed.empty()) {
+        return;
+    }
+
+    bool rescale = false;
+    bool shrink = false;
+    for (size_t i = 0; i < m_changed.size(); ++i) {
+        const EstadoLinhaCache &previous = m_lines[m_changed[i]];
+        const EstadoLinhaCache &state = m_changedStates[i];
+        // Contadores que diminuem indicam um reset: a escala pode ter encolhido
+        shrink = shrink || state.acessos < previous.acessos;
+        rescale = rescale || state.acessos > m_scaleAccesses || state.faltas > m_scaleMisses;
+        m_lines[m_changed[i]] = state;
+    }
+
+    if (rescale || shrink) {
+        recolorAll();
+        return;
+    }
+    for (uint32_t indice : m_changed) {
+        m_image.setPixelColor(static_cast<int>(indice) % m_columns, static_cast<int>(indice) / m_columns,
+                              colorFor(m_lines[indice]));
+    }
+    update();
+}
+
+QRectF CacheHeatmapWidget::gridRect() const
+{
+    // Células quadradas, centralizadas
+    double cell = std::min(static_cast<double>(width()) / m_image.width(),
+                           static_cast<double>(height()) / m_image.height());
+    double w = cell * m_image.width();
+    double h = cell * m_image.height();
+    return QRectF((width() - w) / 2, (height() - h) / 2, w, h);
+}
+
+int CacheHeatmapWidget::lineAt(const QPoint &position) const
+{
+    if (m_image.isNull()) {
+        return -1;
+    }
+    QRectF grid = gridRect();
+    if (!grid.contains(position)) {
+        return -1;
+    }
+    int column = static_cast<int>((position.x() - grid.left()) * m_image.width() / grid.width());
+    int row = static_cast<int>((position.y() - grid.top()) * m_image.height() / grid.height());
+    int indice = row * m_columns + column;
+    return indice < static_cast<int>(m_lines.size()) ? indice : -1;
+}
+
+void CacheHeatmapWidget::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(30, 30, 30));
+    if (m_image.isNull()) {
+        return;
+    }
+    // Sem suavização: cada pixel da imagem vira uma célula nítida
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(gridRect(), m_image);
+}
+
+bool CacheHeatmapWidget::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip) {
+        auto *help = static_cast<QHelpEvent *>(event);
+        int indice = lineAt(help->pos());
+        if (indice < 0) {
+            QToolTip::hideText();
+        } else {
+            const EstadoLinhaCache &state = m_lines[indice];
+            QToolTip::showText(help->globalPos(),
+                               QString("Conjunto %1\n%2\nTag: 0x%3\nAcessos: %4\nFaltas: %5")
+                               .arg(indice)
+                               .arg(state.valida ? "Valida" : "Invalida")
+                               .arg(state.tag, 0, 16)
+                               .arg(state.acessos)
+                               .arg(state.faltas),
+                               this);
+        }
+        return true;
+    }
+    return QWidget::event(event);
+}
@@ -0,0 +1,57 @@
+#ifndef CACHEHEATMAPWIDGET_H
+#define CACHEHEATMAPWIDGET_H
+
+#include <QImage>
+#include <QWidget>
+#include <cstdint>
+#include <vector>
+
+#include "execution/EspelhoCache.h"
+
+/**
+ * @class CacheHeatmapWidget
+ * @brief Mapa de calor das linhas do cache: uma célula por conjunto (o cache é diretamente mapeado).
+ *
+ * A imagem tem um pixel por linha e é ampliada na pintura; refresh() só
+ * recolore os pixels das linhas que o EspelhoCache informou como alteradas.
+ * A imagem inteira só é refeita quando muda o modo ou a escala de cores.
+ */
+class CacheHeatmapWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class Mode { Accesses, Misses, Tag };
+
+    explicit CacheHeatmapWidget(QWidget *parent = nullptr);
+
+    void setMirror(EspelhoCache *mirror);
+    void setMode(Mode mode);
+    // Aplica as alterações pendentes no espelho
+    void refresh();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    QColor colorFor(const EstadoLinhaCache &state) const;
+    void recolorAll();
+    int lineAt(const QPoint &position) const;
+    QRectF gridRect() const;
+
+    EspelhoCache *m_mirror = nullptr;
+    Mode m_mode = Mode::Accesses;
+
+    std::vector<EstadoLinhaCache> m_lines;
+    // Topo da escala (potência de 2): a imagem só é refeita quando um contador o ultrapassa
+    uint32_t m_scaleAccesses = 1;
+    uint32_t m_scaleMisses = 1;
+    int m_columns = 1;
+    QImage m_image;
+
+    std::vector<uint32_t> m_changed;
+    std::vector<EstadoLinhaCache> m_changedStates;
+};
+
+#endif // CACHEHEATMAPWIDGET_H
@@ -0,0 +1,106 @@
+#include "dashboardwindow.h"
+#include "ui_dashboardwindow.h"
+
+#include <QColor>
+
+// Cores das classes do mix, na ordem de ClasseInstrucao
+static const QColor mixColors[NUMERO_CLASSES_INSTRUCAO] = {
+    QColor(86, 156, 214), QColor(206, 145, 120), QColor(220, 220, 120),
+    QColor(197, 134, 192), QColor(244, 71, 71), QColor(160, 160, 160)
+};
+
+DashboardWindow::DashboardWindow(const SerieMetricas *metricas, QWidget *parent)
+    : QMainWindow(parent)
+    , ui(new Ui::DashboardWindow)
+    , m_metricas(metricas)
+{
+    ui->setupUi(this);
+
+    ui->ipsPlot->setTitle("Instruções por segundo");
+    ui->ipsPlot->addSeries("IPS", QColor(78, 201, 176));
+
+    ui->instructionsPlot->setTitle("Instruções retiradas");
+    ui->instructionsPlot->addSeries("Total", QColor(86, 156, 214));
+
+    ui->hitRatePlot->setTitle("Taxa de acerto do cache (%)");
+    ui->hitRatePlot->setFixedRange(0.0, 100.0);
+    ui->hitRatePlot->addSeries("Acertos", QColor(106, 153, 85));
+
+    ui->mpkiPlot->setTitle("Faltas no cache por mil instruções (MPKI)");
+    ui->mpkiPlot->addSeries("MPKI", QColor(244, 71, 71));
+
+    ui->mixPlot->setTitle("Mix de instruções (%)");
+    ui->mixPlot->setFixedRange(0.0, 100.0);
+    for (size_t i = 0; i < NUMERO_CLASSES_INSTRUCAO; ++i) {
+        ui->mixPlot->addSeries(SerieMetricas::nome_classe(static_cast<ClasseInstrucao>(i)), mixColors[i]);
+    }
+
+    // As amostras são geradas a cada 100 ms; o painel as busca em lotes, 4 vezes por segundo
+    m_refreshTimer = new QTimer(this);
+    m_refreshTimer->setInterval(250);
+    connect(m_refreshTimer, &QTimer::timeout, this, &DashboardWindow::on_refresh_timer_timeout);
+}
+
+DashboardWindow::~DashboardWindow()
+{
+    delete ui;
+}
+
+// Só atualiza enquanto a janela está aberta; ao reabrir, recupera o que ainda estiver na série
+void DashboardWindow::showEvent(QShowEvent *event)
+{
+    QMainWindow::showEvent(event);
+    on_refresh_timer_timeout();
+    m_refreshTimer->start();
+}
+
+void DashboardWindow::hideEvent(QHideEvent *event)
+{
+    m_refreshTimer->stop();
+    QMainWindow::hideEvent(event);
+}
+
+void DashboardWindow::clearPlots()
+{
+    ui->ipsPlot->clear();
+    ui->instructionsPlot->clear();
+    ui->hitRatePlot->clear();
+    ui->mpkiPlot->clear();
+    ui->mixPlot->clear();
+}
+
+/**
+ * @brief Acrescenta aos gráficos só as amostras publicadas desde a última chamada.
+ */
+void DashboardWindow::on_refresh_timer_timeout()
+{
+    // A série foi limpa (reset ou novo programa no simulador)
+    if (m_metricas->geracao() != m_generation) {
+        clearPlots();
+        m_nextSample = 0;
+        m_generation = m_metricas->geracao();
+    }
+
+    uint64_t first = m_metricas->copiar(m_nextSample, m_newSamples);
+    if (m_newSamples.empty()) {
+        return;
+    }
+    m_nextSample = first + m_newSamples.size();
+
+    for (const AmostraMetricas &amostra : m_newSamples) {
+        ui->ipsPlot->append(0, amostra.tempo, amostra.instrucoes_por_segundo);
+        ui->instructionsPlot->append(0, amostra.tempo, static_cast<double>(amostra.instrucoes));
+        ui->hitRatePlot->append(0, amostra.tempo, amostra.taxa_acerto_cache);
+        ui->mpkiPlot->append(0, amostra.tempo, amostra.faltas_por_mil);
+        for (size_t i = 0; i < NUMERO_CLASSES_INSTRUCAO; ++i) {
+            ui->mixPlot->append(static_cast<int>(i), amostra.tempo, amostra.mix[i]);
+        }
+    }
+
+    const AmostraMetricas &ultima = m_newSamples.back();
+    ui->summaryLabel->setText(QString("%1 instrucoes | %2 MIPS | acerto do cache %3% | %4 MPKI")
+                              .arg(ultima.instrucoes)
+                              .arg(ultima.instrucoes_por_segundo / 1e6, 0, 'f', 2)
+                              .arg(ultima.taxa_acerto_cache, 0, 'f', 1)
+                              .arg(ultima.faltas_por_mil, 0, 'f', 2));
+}
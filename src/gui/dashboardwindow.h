@@ -0,0 +1,54 @@
+#ifndef DASHBOARDWINDOW_H
+#define DASHBOARDWINDOW_H
+
+#include <QMainWindow>
+#include <QTimer>
+#include <cstdint>
+#include <vector>
+
+#include "execution/SerieMetricas.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace Ui {
+    class DashboardWindow;
+}
+
+QT_END_NAMESPACE
+
+/**
+ * @class DashboardWindow
+ * @brief Painel de desempenho: gráficos ao vivo das amostras da SerieMetricas.
+ *
+ * Não acessa o Core: a thread de execução amostra os contadores na série, e
+ * o painel só acrescenta aos gráficos as amostras novas desde a última
+ * atualização.
+ */
+class DashboardWindow : public QMainWindow {
+    Q_OBJECT
+
+public:
+    // Recebe a série, mas não a possui
+    explicit DashboardWindow(const SerieMetricas *metricas, QWidget *parent = nullptr);
+
+    ~DashboardWindow();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void on_refresh_timer_timeout();
+    void clearPlots();
+
+    Ui::DashboardWindow *ui;
+    const SerieMetricas *m_metricas;
+    QTimer *m_refreshTimer;
+
+    // Próxima amostra a ser desenhada
+    uint64_t m_nextSample = 0;
+    uint64_t m_generation = 0;
+    std::vector<AmostraMetricas> m_newSamples;
+};
+
+#endif // DASHBOARDWINDOW_H
@@ -3,44 +3,23 @@
 #include <sstream>
 #include <iomanip>
 
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
-#include <QBrush>
-
-static const std::array<QString, 32> abiNames = {
-    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
-    "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
-    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
-    "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
-};
+#include <QApplication>
+#include <QRegularExpression>
 
 // Construtor
 DemoWindow::DemoWindow(Core *core, QWidget *parent) : QMainWindow(parent),
                                                       ui(new Ui::DemoWindow),
                                                       m_core(core), // Armazena o ponteiro do Core
-                                                      m_highlightBrush(QColor(80, 80, 80)) {
+                                                      m_modelAntes(new RegisterTableModel(this)),
+                                                      m_modelDepois(new RegisterTableModel(this)) {
     ui->setupUi(this);
     ui->logView->setReadOnly(true);
 
     // Configura AMBAS as tabelas
-    for (QTableWidget *table: {ui->registersTableAntes, ui->registersTableDepois}) {
-        table->setColumnCount(4);
-        table->setHorizontalHeaderLabels(QStringList() << "Reg" << "ABI" << "Hex" << "Dec");
-        table->setRowCount(33); // x0-x31 + pc
-
-        // Adiciona os nomes dos registradores
-        for (int i = 0; i < 32; ++i) {
-            table->setItem(i, 0, new QTableWidgetItem(QString("x%1").arg(i)));
-            table->setItem(i, 1, new QTableWidgetItem(abiNames[i]));
-        }
-        table->setItem(32, 0, new QTableWidgetItem("pc"));
-        table->setItem(32, 1, new QTableWidgetItem("-"));
-
-        // Trava a edição e o tamanho
-        table->setEditTriggers(QAbstractItemView::NoEditTriggers);
-        table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-        table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
-    }
+    setupRegistersView(ui->registersTableAntes, m_modelAntes);
+    setupRegistersView(ui->registersTableDepois, m_modelDepois);
 
     // Preenche o ComboBox com as instruções
     ui->comboInstrucao->addItem("ADD", 0x33);
@@ -63,11 +42,30 @@ DemoWindow::DemoWindow(Core *core, QWidget *parent) : QMainWindow(parent),
     ui->spinRs2->setRange(0, 31);
     ui->spinImm->setRange(-2048, 2047);
 
+    // Tabela de comparação do benchmark: uma linha por medida
+    m_benchModel = new QStandardItemModel(0, 5, this);
+    m_benchModel->setHorizontalHeaderLabels({"Instrução", "ns/instr. (host)", "Ciclos/instr. (modelo)",
+                                             "MIPS", "Instruções"});
+    ui->benchTable->setModel(m_benchModel);
+    ui->benchTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->benchTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->benchTable->verticalHeader()->hide();
+
     // Inicia a UI
     on_comboInstrucao_currentIndexChanged(0);
     m_core->reset();
-    updateRegistersView(ui->registersTableAntes, -1); // -1 = sem destaque
-    updateRegistersView(ui->registersTableDepois, -1);
+    m_modelAntes->updateFromCore(*m_core);
+    m_modelDepois->updateFromCore(*m_core);
+    m_modelAntes->clearHighlights(); // sem destaque
+    m_modelDepois->clearHighlights();
+}
+
+// Liga a tabela ao modelo e trava a edição e o tamanho
+void DemoWindow::setupRegistersView(QTableView *view, RegisterTableModel *model) {
+    view->setModel(model);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 }
 
 DemoWindow::~DemoWindow() {
@@ -104,8 +102,8 @@ void DemoWindow::on_setRegButtonRs1_clicked() {
     m_core->set_register(highlightReg1, valor);
     ui->logView->append(QString("Valor %1 definido em x%2 (rs1).").arg(valor).arg(highlightReg1));
 
-    // Mostra o estado "Antes"
-    updateRegistersView(ui->registersTableAntes, highlightReg1);
+    // Mostra o estado "Antes" (o registrador alterado fica destacado)
+    m_modelAntes->updateFromCore(*m_core);
 }
 
 /**
@@ -119,25 +117,22 @@ void DemoWindow::on_setRegButtonRs2_clicked() {
     m_core->set_register(highlightReg2, valor);
     ui->logView->append(QString("Valor %1 definido em x%2 (rs2).").arg(valor).arg(highlightReg2));
 
-    // Mostra o estado "Antes"
-    updateRegistersView(ui->registersTableAntes, highlightReg2);
+    // Mostra o estado "Antes" (o registrador alterado fica destacado)
+    m_modelAntes->updateFromCore(*m_core);
 }
 
-// Slot do botão "Executar Instrução"
-void DemoWindow::on_execButton_clicked() {
-    // 1. Pega os operandos da UI
+// Monta a operação 'instrucao' (nome do ComboBox) com os operandos escolhidos na UI
+uint32_t DemoWindow::montarInstrucao(const QString &instrucao) {
     uint32_t rd = ui->spinRd->value();
     uint32_t rs1 = ui->spinRs1->value();
     uint32_t rs2 = ui->spinRs2->value();
     int32_t imm = ui->spinImm->value();
-    QString instrucao = ui->comboInstrucao->currentText();
 
     uint32_t instrucao_codificada = 0;
     const uint32_t OPCODE_R = 0x33;
     const uint32_t OPCODE_I = 0x13;
     const uint32_t FUNCT7_M = 0x01; // Funct7 para a Extensão "M"
 
-    // 2. Monta a instrução
     if (instrucao == "ADD") {
         instrucao_codificada = montar_tipo_R(0x00, rs2, rs1, 0x0, rd, OPCODE_R);
     } else if (instrucao == "SUB") {
@@ -156,7 +151,6 @@ void DemoWindow::on_execButton_clicked() {
         instrucao_codificada = montar_tipo_R(FUNCT7_M, rs2, rs1, 0x6, rd, OPCODE_R);
     } else if (instrucao == "REMU") {
         instrucao_codificada = montar_tipo_R(FUNCT7_M, rs2, rs1, 0x7, rd, OPCODE_R);
-        // --- FIM DOS NOVOS BLOCOS ---
     } else if (instrucao == "ADDI") {
         instrucao_codificada = montar_tipo_I(imm, rs1, 0x0, rd, OPCODE_I);
     } else if (instrucao == "ANDI") {
@@ -164,64 +158,27 @@ void DemoWindow::on_execButton_clicked() {
     } else if (instrucao == "ORI") {
         instrucao_codificada = montar_tipo_I(imm, rs1, 0x6, rd, OPCODE_I);
     }
+    return instrucao_codificada;
+}
+
+// Slot do botão "Executar Instrução"
+void DemoWindow::on_execButton_clicked() {
+    // 1 e 2. Monta a instrução com os operandos da UI
+    uint32_t instrucao_codificada = montarInstrucao(ui->comboInstrucao->currentText());
 
     // 3. Carrega e executa
     std::vector<uint32_t> programa_demo = {instrucao_codificada, 0x00000000};
     m_core->load_program(programa_demo);
 
+    // "Depois" parte do estado atual, para destacar só o que a instrução mudar
+    m_modelDepois->updateFromCore(*m_core);
+    m_modelDepois->clearHighlights();
+
     std::string log = m_core->step();
     ui->logView->append(QString::fromStdString(log));
 
     // 4. Mostra o resultado
-    updateRegistersView(ui->registersTableDepois, rd);
-}
-
-/**
- * @brief Função para exibir registradores em uma tabela, com destaque opcional.
- */
-void DemoWindow::updateRegistersView(QTableWidget *view, int highlightedRd) {
-    std::array<uint32_t, 32> regs = m_core->get_registradores();
-    uint32_t pc = m_core->get_program_counter();
-
-    // Reseta a cor de fundo padrão (necessário para limpar destaques antigos)
-    const QBrush defaultBrush = view->palette().base();
-
-    // 1. Formata e preenche os registradores (x0-x31)
-    for (int i = 0; i < 32; ++i) { // O loop agora é 'i < 32'
-        uint32_t valor = regs[i];
-
-        // Coluna 2: Hexadecimal
-        QString hexVal = QString("0x%1").arg(valor, 8, 16, QChar('0'));
-        QTableWidgetItem* hexItem = new QTableWidgetItem(hexVal);
-
-        // Coluna 3: Decimal
-        QString decVal = QString::number(static_cast<int32_t>(valor));
-        QTableWidgetItem* decItem = new QTableWidgetItem(decVal);
-
-        // Define o destaque (ou reseta)
-        if (i == highlightedRd && i != 0) { // Destaca se for o 'rd' (e não for x0)
-            hexItem->setBackground(m_highlightBrush);
-            decItem->setBackground(m_highlightBrush);
-        } else {
-            hexItem->setBackground(defaultBrush);
-            decItem->setBackground(defaultBrush);
-        }
-
-        view->setItem(i, 2, hexItem);
-        view->setItem(i, 3, decItem);
-    }
-
-    // 2. Formata e preenche o PC (Linha 32)
-    QString hexPC = QString("0x%1").arg(pc, 8, 16, QChar('0'));
-    QString decPC = QString::number(pc);
-
-    QTableWidgetItem* pcHexItem = new QTableWidgetItem(hexPC);
-    QTableWidgetItem* pcDecItem = new QTableWidgetItem(decPC);
-    pcHexItem->setBackground(defaultBrush); // Garante que o PC não tenha destaque
-    pcDecItem->setBackground(defaultBrush);
-
-    view->setItem(32, 2, pcHexItem);
-    view->setItem(32, 3, pcDecItem);
+    m_modelDepois->updateFromCore(*m_core);
 }
 
 /**
@@ -234,10 +191,12 @@ void DemoWindow::on_resetRegsButton_clicked()
     m_core->reset(); //
 
     // 2. Atualiza a tabela "Antes" (agora zerada)
-    updateRegistersView(ui->registersTableAntes, -1); // -1 = sem destaque
+    m_modelAntes->updateFromCore(*m_core);
+    m_modelAntes->clearHighlights(); // sem destaque
 
     // 3. Atualiza a tabela "Depois" (agora zerada)
-    updateRegistersView(ui->registersTableDepois, -1);
+    m_modelDepois->updateFromCore(*m_core);
+    m_modelDepois->clearHighlights();
 
     // 4. Adiciona uma mensagem ao log
     ui->logView->append("Registradores resetados para 0.");
@@ -252,3 +211,85 @@ uint32_t DemoWindow::montar_tipo_R(uint32_t funct7, uint32_t rs2, uint32_t rs1,
 uint32_t DemoWindow::montar_tipo_I(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
     return (static_cast<uint32_t>(imm) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
 }
+
+/**
+ * @brief Mede 'sequencia' no microbenchmark e acrescenta uma linha à tabela de comparação.
+ * Os registradores de partida são os do Core da demonstração (os valores definidos em rs1/rs2).
+ */
+bool DemoWindow::runBenchmark(const QString &nome, const std::vector<uint32_t> &sequencia) {
+    ResultadoMicroBenchmark resultado;
+    std::string erro = microbenchmark::medir(sequencia, m_core->get_registradores(),
+                                             static_cast<uint64_t>(ui->benchIterations->value()), resultado);
+    if (!erro.empty()) {
+        ui->logView->append(QString::fromStdString(erro));
+        return false;
+    }
+
+    double mips = resultado.segundos > 0 ? resultado.instrucoes / resultado.segundos / 1e6 : 0.0;
+    QList<QStandardItem *> linha = {
+        new QStandardItem(nome),
+        new QStandardItem(QString::number(resultado.nanossegundos_por_instrucao, 'f', 1)),
+        new QStandardItem(QString::number(resultado.ciclos_por_instrucao, 'f', 2)),
+        new QStandardItem(QString::number(mips, 'f', 2)),
+        new QStandardItem(QString::number(resultado.instrucoes))
+    };
+    for (int coluna = 1; coluna < linha.size(); ++coluna) {
+        linha[coluna]->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    m_benchModel->appendRow(linha);
+    ui->benchTable->scrollToBottom();
+    return true;
+}
+
+/**
+ * @brief Slot do botão "Medir": a sequência digitada, ou a operação escolhida no ComboBox.
+ */
+void DemoWindow::on_benchButton_clicked() {
+    QString texto = ui->benchSequence->text().trimmed();
+    std::vector<uint32_t> sequencia;
+    QString nome;
+
+    if (texto.isEmpty()) {
+        nome = ui->comboInstrucao->currentText();
+        sequencia.push_back(montarInstrucao(nome));
+    } else {
+        // Palavras separadas por vírgula ou espaço, em qualquer base aceita por toUInt (0x..., decimal)
+        const QStringList palavras = texto.split(QRegularExpression("[,\\s]+"), Qt::SkipEmptyParts);
+        for (const QString &palavra : palavras) {
+            bool ok;
+            uint32_t instrucao = palavra.toUInt(&ok, 0);
+            if (!ok) {
+                ui->logView->append("[ERRO] Instrucao invalida na sequencia: " + palavra);
+                return;
+            }
+            sequencia.push_back(instrucao);
+        }
+        nome = QString("Sequência (%1)").arg(sequencia.size());
+    }
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    runBenchmark(nome, sequencia);
+    QApplication::restoreOverrideCursor();
+}
+
+/**
+ * @brief Slot do botão "Comparar todas": mede cada operação do ComboBox com os mesmos operandos.
+ */
+void DemoWindow::on_benchCompareButton_clicked() {
+    ui->benchButton->setEnabled(false);
+    ui->benchCompareButton->setEnabled(false);
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+
+    for (int i = 0; i < ui->comboInstrucao->count(); ++i) {
+        QString nome = ui->comboInstrucao->itemText(i);
+        if (!runBenchmark(nome, {montarInstrucao(nome)})) {
+            break;
+        }
+        // Cada medida leva cerca de um segundo: deixa a janela redesenhar a tabela entre elas
+        QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+
+    QApplication::restoreOverrideCursor();
+    ui->benchButton->setEnabled(true);
+    ui->benchCompareButton->setEnabled(true);
+}
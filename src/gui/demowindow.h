@@ -2,10 +2,14 @@
 #define DEMOWINDOW_H
 
 #include <QMainWindow>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
+#include <QStandardItemModel>
+#include <vector>
 
 #include "core/Core.h"
+#include "profiling/MicroBenchmark.h"
+#include "registertablemodel.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -36,8 +40,14 @@ private slots:
 
     void on_resetRegsButton_clicked();
 
+    // Benchmark: executa a instrução (ou sequência) milhões de vezes e compara o custo
+    void on_benchButton_clicked();
+    void on_benchCompareButton_clicked();
+
 private:
-    void updateRegistersView(QTableWidget *view, int highlightedRd);
+    void setupRegistersView(QTableView *view, RegisterTableModel *model);
+    uint32_t montarInstrucao(const QString &instrucao);
+    bool runBenchmark(const QString &nome, const std::vector<uint32_t> &sequencia);
 
     // Funções helper portadas do seu main.cpp
     uint32_t montar_tipo_R(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode);
@@ -46,7 +56,12 @@ private:
     Ui::DemoWindow *ui;
     Core *m_core; // Ponteiro para o Core (não o possui)
 
-    const QBrush m_highlightBrush;
+    // Estado antes e depois da instrução; cada modelo destaca o que mudou na última atualização
+    RegisterTableModel *m_modelAntes;
+    RegisterTableModel *m_modelDepois;
+
+    // Resultados do benchmark, lado a lado
+    QStandardItemModel *m_benchModel;
 };
 
 #endif // DEMOWINDOW_H
@@ -6,7 +6,8 @@ LauncherWindow::LauncherWindow(QWidget *parent) :
     ui(new Ui::LauncherWindow), 
     m_core(std::make_unique<Core>(1024 * 1024)), // O Launcher cria o Core!
     m_mainWindow(nullptr),
-    m_demoWindow(nullptr) {
+    m_demoWindow(nullptr),
+    m_dashboardWindow(nullptr) {
     ui->setupUi(this);
 }
 
@@ -20,7 +21,7 @@ void LauncherWindow::on_simuladorButton_clicked()
 {
     if (!m_mainWindow) {
         // Passa o ponteiro bruto (m_core.get()) para a MainWindow
-        m_mainWindow = new MainWindow(m_core.get());
+        m_mainWindow = new MainWindow(m_core.get(), &m_metricas);
     }
     m_mainWindow->show();
 }
@@ -33,3 +34,12 @@ void LauncherWindow::on_demoButton_clicked()
     }
     m_demoWindow->show();
 }
+
+// Abre o painel de desempenho (gráficos do Run do simulador)
+void LauncherWindow::on_dashboardButton_clicked()
+{
+    if (!m_dashboardWindow) {
+        m_dashboardWindow = new DashboardWindow(&m_metricas);
+    }
+    m_dashboardWindow->show();
+}
@@ -6,6 +6,8 @@
 #include "core/Core.h"
 #include "mainwindow.h"
 #include "demowindow.h"
+#include "dashboardwindow.h"
+#include "execution/SerieMetricas.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -25,6 +27,7 @@ public:
 private slots:
     void on_simuladorButton_clicked();
     void on_demoButton_clicked();
+    void on_dashboardButton_clicked();
 
 private:
     Ui::LauncherWindow *ui;
@@ -32,9 +35,13 @@ private:
     // O Launcher VAI POSSUIR o Core
     std::unique_ptr<Core> m_core;
 
+    // Métricas amostradas durante o Run do simulador e exibidas no painel de desempenho
+    SerieMetricas m_metricas;
+
     // Ponteiros para as janelas (para que não abram várias)
     MainWindow* m_mainWindow;
     DemoWindow* m_demoWindow;
+    DashboardWindow* m_dashboardWindow;
 };
 
 #endif // LAUNCHERWINDOW_H
\ No newline at end of file
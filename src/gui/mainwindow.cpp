@@ -2,45 +2,48 @@
 #include "ui_mainwindow.h"
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <QFileDialog>
 #include <QFile>
 #include <QTextStream>
 #include <QMessageBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
 #include <QTabWidget>
 #include <QLineEdit>
-
-static const std::array<QString, 32> abiNames = {
-    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
-    "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
-    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
-    "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
-};
+#include <QStatusBar>
+#include <QListView>
+#include <QFontDatabase>
+#include <QScrollBar>
 
 // O construtor cria a janela e inicializa seu Core
-MainWindow::MainWindow(Core* core, QWidget *parent)
+MainWindow::MainWindow(Core* core, SerieMetricas* metricas, QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow)
     , m_core(core) // Armazena o ponteiro recebido
+    , m_metricas(metricas)
 {
     ui->setupUi(this);
 
-    m_runTimer = new QTimer(this);
-    connect(m_runTimer, &QTimer::timeout, this, &MainWindow::on_run_timer_timeout);
+    // Execução reversa: ~1M instruções no anel de desfazer e snapshots para voltar mais longe
+    m_core->definir_execucao_reversa(1 << 20);
+
+    m_executor = std::make_unique<ExecutorSimulacao>(*m_core);
+    m_executor->definir_historico(&m_historico);
+    m_executor->definir_espelho_cache(&m_espelhoCache);
+    if (m_metricas) {
+        m_executor->definir_metricas(m_metricas);
+    }
+
+    // Durante o Run, a tela é redesenhada em uma taxa fixa (~30 quadros por segundo)
+    m_frameTimer = new QTimer(this);
+    m_frameTimer->setInterval(33);
+    connect(m_frameTimer, &QTimer::timeout, this, &MainWindow::on_frame_timer_timeout);
 
     // Deixa as caixas de texto como "somente leitura"
     ui->logView->setReadOnly(true);
-    ui->registersTable->setColumnCount(4);
-    ui->registersTable->setHorizontalHeaderLabels(QStringList() << "Reg" << "ABI" << "Hexadecimal" << "Decimal");
-    ui->registersTable->setRowCount(33); // x0-x31 + pc
-
-    for (int i = 0; i < 32; ++i) {
-        ui->registersTable->setItem(i, 0, new QTableWidgetItem(QString("x%1").arg(i)));
-        ui->registersTable->setItem(i, 1, new QTableWidgetItem(abiNames[i]));
-    }
-    ui->registersTable->setItem(32, 0, new QTableWidgetItem("pc"));
-    ui->registersTable->setItem(32, 1, new QTableWidgetItem("-"));
+    m_registerModel = new RegisterTableModel(this);
+    ui->registersTable->setModel(m_registerModel);
 
     ui->registersTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
 
@@ -50,25 +53,26 @@ MainWindow::MainWindow(Core* core, QWidget *parent)
 
     ui->registersTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
 
-    // Configura a tabela de memória (16 bytes por linha)
-    const int memCols = 17; // 1 Endereço + 16 Bytes
-    ui->memoryTable->setColumnCount(memCols + 1); // +1 para a coluna ASCII
-    ui->memoryTable->setRowCount(16); // Vamos mostrar 16 linhas (16 * 16 = 256 bytes)
-
-    // Configura os cabeçalhos das colunas
-    QStringList memHeaders;
-    memHeaders << "Endereço";
-    for(int i = 0; i < 16; ++i) {
-        memHeaders << QString("+%1").arg(i, 2, 16, QChar('0')).toUpper();
-    }
-    memHeaders << "ASCII";
-    ui->memoryTable->setHorizontalHeaderLabels(memHeaders);
+    // Configura a tabela de memória: todo o espaço de 4 GiB, 16 bytes por linha + coluna ASCII
+    m_memoryModel = new MemoryTableModel(m_core, this);
+    ui->memoryTable->setModel(m_memoryModel);
+    // Com 2^28 linhas, a altura precisa ser fixa para a view não medir linha por linha
+    ui->memoryTable->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui->memoryTable->verticalHeader()->hide();
 
     // Trava a edição
     ui->memoryTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
     // Ajusta o tamanho das colunas
     ui->memoryTable->resizeColumnsToContents();
 
+    // Histórico de execução: o texto de cada linha só é gerado quando ela aparece na tela
+    m_traceModel = new TraceListModel(&m_historico, this);
+    ui->traceView->setModel(m_traceModel);
+    ui->traceView->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    ui->traceView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+
+    ui->cacheHeatmap->setMirror(&m_espelhoCache);
+
     m_core->reset(); // Garante que o core esteja zerado
     ui->logView->append("Simulador iniciado. Use 'Load' para carregar um programa.");
     updateUI(); // Atualiza a exibição (registradores zerados)
@@ -76,10 +80,12 @@ MainWindow::MainWindow(Core* core, QWidget *parent)
     // Desativa os botões de execução até que um programa seja carregado
     ui->runButton->setEnabled(false);
     ui->stepButton->setEnabled(false);
+    ui->stepBackButton->setEnabled(false);
 }
 
 MainWindow::~MainWindow()
 {
+    m_executor->parar();
     delete ui;
 }
 
@@ -110,11 +116,17 @@ void MainWindow::on_loadButton_clicked()
  */
 void MainWindow::on_resetButton_clicked()
 {
-    m_runTimer->stop();
-    ui->runButton->setText("Run");
+    stopRun();
     m_core->reset(); // Chama o reset do core
+    m_memoryModel->reload();
+    m_historico.limpar();
+    syncTrace();
+    if (m_metricas) {
+        m_metricas->limpar();
+    }
     ui->logView->clear();
     ui->logView->append("Processador resetado.");
+    ui->stepBackButton->setEnabled(false);
     updateUI(); // Atualiza a exibição
 }
 
@@ -125,6 +137,10 @@ void MainWindow::on_stepButton_clicked()
 {
     // Chama a função step() do SEU Core
     std::string log_msg = m_core->step();
+    if (m_core->get_ultimo_commit().instrucao != 0) {
+        m_historico.adicionar(m_core->get_ultimo_commit());
+    }
+    syncTrace();
 
     // Coloca o log retornado na caixa de texto 'logView'
     ui->logView->append(QString::fromStdString(log_msg));
@@ -134,67 +150,187 @@ void MainWindow::on_stepButton_clicked()
 
     // Se a simulação terminou, desativa os botões
     if (m_core->is_finished()) {
-        m_runTimer->stop();
-        ui->runButton->setText("Run");
         ui->runButton->setEnabled(false);
         ui->stepButton->setEnabled(false);
         ui->logView->append("Simulacao finalizada.");
     }
+    ui->stepBackButton->setEnabled(m_core->get_passos_reversiveis(true) > 0);
 }
 
 /**
- * @brief Opção 2 (Executar Run)
- * Esta é a principal diferença: em vez de chamar core.run() (que trava),
- * nós iniciamos um timer que clica no "Step" muito rápido.
+ * @brief Volta o número de instruções pedido (desfazendo, ou reexecutando a partir de um snapshot).
  */
-void MainWindow::on_runButton_clicked()
+void MainWindow::on_stepBackButton_clicked()
 {
-    if (m_runTimer->isActive()) {
-        m_runTimer->stop();
-        ui->runButton->setText("Run");
+    uint64_t quantidade = static_cast<uint64_t>(ui->stepBackCount->value());
+    uint64_t possiveis = m_core->get_passos_reversiveis(true);
+    std::string erro = m_core->voltar_instrucoes(std::min(quantidade, possiveis), true);
+    if (!erro.empty()) {
+        ui->logView->append(QString::fromStdString(erro));
+    } else if (quantidade > possiveis) {
+        ui->logView->append(QString("[AVISO] Só foi possível voltar %1 instrucoes.").arg(possiveis));
     } else {
-        m_runTimer->start(50);
-        ui->runButton->setText("Stop");
+        ui->logView->append(QString("Voltou %1 instrucoes.").arg(quantidade));
     }
+    afterStepBack(erro.empty() ? std::min(quantidade, possiveis) : 0);
 }
 
 /**
- * @brief Esta função é chamada pelo timer (a cada 50ms)
- * quando o "Run" está ativo.
+ * @brief Executa para trás até a última instrução que escreveu no endereço da aba Memória.
  */
-void MainWindow::on_run_timer_timeout()
+void MainWindow::on_lastWriteButton_clicked()
 {
-    on_stepButton_clicked();
+    bool ok;
+    uint32_t address = ui->memAddressInput->text().toUInt(&ok, 0);
+    if (!ok) {
+        ui->logView->append("[ERRO] Endereço de memória inválido: " + ui->memAddressInput->text());
+        return;
+    }
+
+    uint64_t distancia = 0;
+    std::string erro = m_core->voltar_ate_escrita(address, distancia, true);
+    if (!erro.empty()) {
+        ui->logView->append(QString::fromStdString(erro));
+        return;
+    }
+    ui->logView->append(QString("Voltou %1 instrucoes: a próxima instrução (PC 0x%2) escreve em 0x%3.")
+                        .arg(distancia)
+                        .arg(m_core->get_program_counter(), 8, 16, QChar('0'))
+                        .arg(address, 8, 16, QChar('0')));
+    afterStepBack(distancia);
 }
 
 /**
- * @brief Opção 4 (Exibir Registradores)
- * Esta função é chamada automaticamente após cada ação.
+ * @brief A volta é exata (cache incluído): o trace perde as instruções desfeitas e
+ * o mapa de calor e a memória são ressincronizados com o Core.
  */
-void MainWindow::updateUI()
+void MainWindow::afterStepBack(uint64_t desfeitas)
+{
+    m_historico.descartar_ultimos(desfeitas);
+    syncTrace();
+    bool terminou = m_core->is_finished();
+    ui->runButton->setEnabled(!terminou);
+    ui->stepButton->setEnabled(!terminou);
+    ui->stepBackButton->setEnabled(m_core->get_passos_reversiveis(true) > 0);
+    updateUI();
+}
+
+/**
+ * @brief Opção 2 (Executar Run)
+ * O Core roda em lotes na thread do ExecutorSimulacao; a cada quadro a tela
+ * mostra o instantâneo mais recente. O botão vira "Stop" enquanto executa.
+ */
+void MainWindow::on_runButton_clicked()
 {
-    std::array<uint32_t, 32> regs = m_core->get_registradores();
-    uint32_t pc = m_core->get_program_counter();
+    if (m_executor->executando()) {
+        stopRun();
+        ui->logView->append("Execucao interrompida.");
+        updateUI();
+        return;
+    }
+
+    // Enquanto a thread roda, nada além dela pode tocar no Core
+    ui->stepButton->setEnabled(false);
+    ui->stepBackButton->setEnabled(false);
+    ui->lastWriteButton->setEnabled(false);
+    ui->loadButton->setEnabled(false);
+    ui->memInspectButton->setEnabled(false);
+    ui->runButton->setText("Stop");
+    m_memoryModel->setCoreAccessible(false);
+
+    m_executor->iniciar();
+    m_frameTimer->start();
+}
 
-    // 1. Formata e preenche os registradores (x0-x31)
-    for (int i = 0; i < 32; ++i) {
-        uint32_t valor = regs[i];
+/**
+ * @brief Para a thread de execução (no máximo um lote) e devolve o Core à interface.
+ */
+void MainWindow::stopRun()
+{
+    m_frameTimer->stop();
+    m_executor->parar();
+    m_memoryModel->setCoreAccessible(true);
 
-        // Coluna 2: Hexadecimal
-        QString hexVal = QString("0x%1").arg(valor, 8, 16, QChar('0'));
-        ui->registersTable->setItem(i, 2, new QTableWidgetItem(hexVal));
+    ui->runButton->setText("Run");
+    ui->loadButton->setEnabled(true);
+    ui->memInspectButton->setEnabled(true);
+    bool terminou = m_core->is_finished();
+    ui->runButton->setEnabled(!terminou);
+    ui->stepButton->setEnabled(!terminou);
+    ui->stepBackButton->setEnabled(m_core->get_passos_reversiveis(true) > 0);
+    ui->lastWriteButton->setEnabled(true);
+}
 
-        // Coluna 3: Decimal
-        // Converte para int32_t para exibir valores negativos corretamente
-        QString decVal = QString::number(static_cast<int32_t>(valor));
-        ui->registersTable->setItem(i, 3, new QTableWidgetItem(decVal));
+/**
+ * @brief Chamada a cada quadro durante o Run: mostra o último instantâneo publicado.
+ */
+void MainWindow::on_frame_timer_timeout()
+{
+    const InstantaneoCore* instantaneo = m_executor->consumir_instantaneo();
+    if (instantaneo) {
+        updateRegisters(instantaneo->registradores, instantaneo->pc);
+        // A thread de execução já copiou para o espelho as linhas alteradas até este instantâneo
+        ui->cacheHeatmap->refresh();
+        statusBar()->showMessage(QString("%1 instrucoes | %2 MIPS")
+                                 .arg(instantaneo->contadores.instrucoes)
+                                 .arg(instantaneo->instrucoes_por_segundo / 1e6, 0, 'f', 2));
     }
+    syncTrace();
 
-    // 2. Formata e preenche o PC (Linha 32)
-    QString hexPC = QString("0x%1").arg(pc, 8, 16, QChar('0'));
-    QString decPC = QString::number(pc);
-    ui->registersTable->setItem(32, 2, new QTableWidgetItem(hexPC));
-    ui->registersTable->setItem(32, 3, new QTableWidgetItem(decPC));
+    if (!m_executor->executando()) {
+        // O instantâneo final é publicado logo antes de a thread terminar
+        if (const InstantaneoCore* final = m_executor->consumir_instantaneo()) {
+            instantaneo = final;
+        }
+        stopRun();
+        updateUI();
+        if (instantaneo) {
+            ui->logView->append(QString::fromStdString(instantaneo->ultimo_log));
+        }
+        if (m_core->encerrado()) {
+            ui->logView->append(QString("Programa encerrado com codigo %1.").arg(m_core->get_codigo_saida()));
+        }
+        ui->logView->append("Simulacao finalizada.");
+    }
+}
+
+/**
+ * @brief Traz as instruções novas do histórico para a lista; se ela estava no fim, continua no fim.
+ */
+void MainWindow::syncTrace()
+{
+    QScrollBar *barra = ui->traceView->verticalScrollBar();
+    bool noFim = barra->value() == barra->maximum();
+    m_traceModel->sync();
+    if (noFim) {
+        ui->traceView->scrollToBottom();
+    }
+}
+
+/**
+ * @brief Fora do Run a interface possui o Core: copia as linhas alteradas do cache e redesenha só elas.
+ */
+void MainWindow::syncCacheHeatmap()
+{
+    m_espelhoCache.sincronizar(*m_core);
+    ui->cacheHeatmap->refresh();
+}
+
+/**
+ * @brief Opção 4 (Exibir Registradores)
+ * Esta função é chamada automaticamente após cada ação.
+ */
+void MainWindow::updateUI()
+{
+    updateRegisters(m_core->get_registradores(), m_core->get_program_counter());
+    m_memoryModel->refresh();
+    syncCacheHeatmap();
+}
+
+void MainWindow::updateRegisters(const std::array<uint32_t, 32> &regs, uint32_t pc)
+{
+    // O modelo compara com os valores anteriores e avisa a tabela só do que mudou
+    m_registerModel->updateValues(regs, pc);
 }
 
 /**
@@ -248,13 +384,19 @@ void MainWindow::loadProgramFromFile(const QString &filePath)
     // caso o usuário esqueça.
     programa.push_back(0x00000000);
 
-    m_runTimer->stop(); // Para a simulação se estiver rodando
-    ui->runButton->setText("Run");
+    stopRun(); // Para a simulação se estiver rodando
     ui->runButton->setEnabled(true);
     ui->stepButton->setEnabled(true);
+    ui->stepBackButton->setEnabled(false);
 
     m_core->reset(); // Reseta o processador
     m_core->load_program(programa); // Carrega o NOVO programa
+    m_memoryModel->reload();
+    m_historico.limpar();
+    syncTrace();
+    if (m_metricas) {
+        m_metricas->limpar();
+    }
 
     ui->logView->clear(); // Limpa o log
     ui->logView->append(QString("Programa carregado de %1. Total de %2 instrucoes (+1 nula).")
@@ -274,41 +416,76 @@ void MainWindow::on_memInspectButton_clicked()
         return;
     }
 
-    // 2. Alinhar o endereço para 16 bytes (opcional, mas limpo)
-    startAddress &= ~0x0F; // Zera os últimos 4 bits
+    // 2. Rola a tabela até a linha do endereço; o modelo lê só as linhas que ficarem visíveis
+    startAddress &= ~0x0F; // Alinha em 16 bytes
+    QModelIndex index = m_memoryModel->index(MemoryTableModel::rowForAddress(startAddress), 0);
+    ui->memoryTable->scrollTo(index, QAbstractItemView::PositionAtTop);
+    ui->memoryTable->selectRow(index.row());
 
-    // 3. Preencher a tabela (16 linhas x 16 bytes)
-    for (int row = 0; row < 16; ++row) {
-        uint32_t rowAddress = startAddress + (row * 16);
-
-        // Coluna 0: Endereço da Linha
-        QString hexAddr = QString("0x%1").arg(rowAddress, 8, 16, QChar('0'));
-        ui->memoryTable->setItem(row, 0, new QTableWidgetItem(hexAddr));
+    ui->logView->append(QString("[INFO] Visualização da memória posicionada em %1").arg(QString("0x%1").arg(startAddress, 8, 16, QChar('0'))));
+}
 
-        QString asciiString = ""; // String para a última coluna
+/**
+ * @brief Mostra só as instruções com o opcode e/ou a faixa de PC informados.
+ */
+void MainWindow::on_traceFilterButton_clicked()
+{
+    bool ok = true;
+    uint32_t pcMin = 0;
+    uint32_t pcMax = UINT32_MAX;
+    if (!ui->tracePcMin->text().trimmed().isEmpty()) {
+        pcMin = ui->tracePcMin->text().trimmed().toUInt(&ok, 0);
+    }
+    if (ok && !ui->tracePcMax->text().trimmed().isEmpty()) {
+        pcMax = ui->tracePcMax->text().trimmed().toUInt(&ok, 0);
+    }
+    if (!ok || pcMin > pcMax) {
+        ui->logView->append("[ERRO] Faixa de PC inválida.");
+        return;
+    }
 
-        // Colunas 1-16: Bytes de Dados
-        for (int col = 0; col < 16; ++col) {
-            uint32_t currentAddress = rowAddress + col;
-            uint8_t byte = m_core->get_byte_memoria(currentAddress);
+    if (!m_traceModel->setFilter(ui->traceOpcodeFilter->text(), pcMin, pcMax)) {
+        ui->logView->append("[ERRO] Opcode inválido: " + ui->traceOpcodeFilter->text());
+        return;
+    }
+    ui->traceView->scrollToBottom();
+}
 
-            // Coluna de Byte (Hex)
-            QString hexByte = QString("%1").arg(byte, 2, 16, QChar('0')).toUpper();
-            ui->memoryTable->setItem(row, col + 1, new QTableWidgetItem(hexByte));
+void MainWindow::on_traceClearFilterButton_clicked()
+{
+    ui->traceOpcodeFilter->clear();
+    ui->tracePcMin->clear();
+    ui->tracePcMax->clear();
+    m_traceModel->clearFilter();
+    ui->traceView->scrollToBottom();
+}
 
-            // Constrói a string ASCII
-            if (byte >= 32 && byte <= 126) { // Caractere imprimível
-                asciiString += static_cast<char>(byte);
-            } else {
-                asciiString += "."; // caractere não imprimível
-            }
-        }
+/**
+ * @brief Grava todo o histórico (sem filtro) em um arquivo de texto.
+ */
+void MainWindow::on_traceExportButton_clicked()
+{
+    QString filePath = QFileDialog::getSaveFileName(
+        this,
+        "Exportar Histórico de Execução",
+        "execucao.txt",
+        "Arquivos de Texto (*.txt);;Todos os Arquivos (*)"
+    );
+    if (filePath.isEmpty()) {
+        return;
+    }
 
-        // Coluna 17: String ASCII
-        ui->memoryTable->setItem(row, 17, new QTableWidgetItem(asciiString));
+    std::string erro = m_historico.exportar(filePath.toStdString());
+    if (!erro.empty()) {
+        ui->logView->append(QString::fromStdString(erro));
+        return;
     }
+    ui->logView->append(QString("[INFO] Histórico exportado para %1 (%2 instrucoes).")
+                        .arg(filePath)
+                        .arg(m_historico.fim_sequencial() - m_historico.primeiro_sequencial()));
+}
 
-    // 4. Ajustar colunas (apenas na primeira vez, opcional)
-    ui->memoryTable->resizeColumnsToContents();
-    ui->logView->append(QString("[INFO] Visualização da memória atualizada a partir de %1").arg(QString("0x%1").arg(startAddress, 8, 16, QChar('0'))));
-}
\ No newline at end of file
+void MainWindow::on_cacheHeatmapMode_currentIndexChanged(int index)
+{
+    ui->cacheHeatmap->setMode(static_cast<CacheHeatmapWidget::Mode>(index));
+}
@@ -10,9 +10,16 @@
 #include <QMessageBox>
 #include <QTabWidget>
 #include <QLineEdit>
-#include <QTableWidget>
+#include <QTableView>
 
 #include "core/Core.h"
+#include "execution/ExecutorSimulacao.h"
+#include "execution/EspelhoCache.h"
+#include "execution/HistoricoExecucao.h"
+#include "execution/SerieMetricas.h"
+#include "registertablemodel.h"
+#include "memorytablemodel.h"
+#include "tracelistmodel.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui {
@@ -24,25 +31,52 @@ class MainWindow : public QMainWindow {
     Q_OBJECT
 
 public:
-    explicit MainWindow(Core* core, QWidget *parent = nullptr);
+    // 'metricas' (opcional) recebe as amostras de desempenho de cada Run; a janela não a possui
+    explicit MainWindow(Core* core, SerieMetricas* metricas = nullptr, QWidget *parent = nullptr);
     ~MainWindow();
 
 private slots:
     void on_stepButton_clicked();
+    void on_stepBackButton_clicked();
+    void on_lastWriteButton_clicked();
     void on_runButton_clicked();
     void on_resetButton_clicked();
     void on_loadButton_clicked();
     void on_memInspectButton_clicked();
+    void on_traceFilterButton_clicked();
+    void on_traceClearFilterButton_clicked();
+    void on_traceExportButton_clicked();
+    void on_cacheHeatmapMode_currentIndexChanged(int index);
 
 private:
     Ui::MainWindow *ui;
 
     void updateUI(); // Função helper
-    void on_run_timer_timeout();
+    void updateRegisters(const std::array<uint32_t, 32>& regs, uint32_t pc);
+    void on_frame_timer_timeout();
+    void stopRun();
+    void syncTrace();
+    void syncCacheHeatmap();
     void loadProgramFromFile(const QString& filePath);
+    void afterStepBack(uint64_t desfeitas);
 
     Core* m_core;
-    QTimer *m_runTimer;
+    SerieMetricas* m_metricas;
+
+    // Modelos das tabelas: só as células que mudaram são redesenhadas
+    RegisterTableModel *m_registerModel;
+    MemoryTableModel *m_memoryModel;
+
+    // Últimas instruções executadas (anel de tamanho fixo) e a lista que mostra só as linhas visíveis
+    HistoricoExecucao m_historico;
+    TraceListModel *m_traceModel;
+
+    // Estado das linhas do cache para o mapa de calor (só as linhas alteradas são copiadas)
+    EspelhoCache m_espelhoCache;
+
+    // O Run executa o Core nesta thread; a tela só lê os instantâneos publicados por ela
+    std::unique_ptr<ExecutorSimulacao> m_executor;
+    QTimer *m_frameTimer;
 };
 
 #endif // MAINWINDOW_H
\ No newline at end of file
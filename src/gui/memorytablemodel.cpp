@@ -0,0 +1,170 @@
+#include "memorytablemodel.h"
+
+#include <algorithm>
+
+MemoryTableModel::MemoryTableModel(Core *core, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_core(core)
+    , m_highlightBrush(QColor(80, 80, 80))
+    , m_unmappedBrush(QColor(45, 45, 45))
+{
+}
+
+int MemoryTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ROW_COUNT;
+}
+
+int MemoryTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ASCII_COLUMN + 1; // Endereço + 16 bytes + ASCII
+}
+
+int MemoryTableModel::rowForAddress(uint32_t address)
+{
+    return static_cast<int>(address / BYTES_PER_ROW);
+}
+
+bool MemoryTableModel::inBlock(int row) const
+{
+    return m_blockFirstRow >= 0 && row >= m_blockFirstRow && row < m_blockFirstRow + BLOCK_ROWS;
+}
+
+void MemoryTableModel::loadBlock(int row) const
+{
+    m_blockFirstRow = std::clamp(row - BLOCK_ROWS / 2, 0, ROW_COUNT - BLOCK_ROWS);
+    uint32_t inicio = static_cast<uint32_t>(m_blockFirstRow) * BYTES_PER_ROW;
+    uint32_t tamanho = BLOCK_ROWS * BYTES_PER_ROW;
+
+    m_bytes.resize(tamanho);
+    m_core->espiar_bloco_memoria(inicio, m_bytes.data(), tamanho);
+
+    m_rowKinds.resize(BLOCK_ROWS);
+    for (int i = 0; i < BLOCK_ROWS; ++i) {
+        TipoRegiao tipo;
+        if (!m_core->tipo_memoria(inicio + i * BYTES_PER_ROW, tipo)) {
+            m_rowKinds[i] = RowKind::Unmapped;
+        } else {
+            m_rowKinds[i] = tipo == TipoRegiao::Mmio ? RowKind::Device : RowKind::Readable;
+        }
+    }
+
+    // Daqui em diante o Core marca as escritas feitas neste bloco
+    m_core->definir_janela_escritas(inicio, tamanho);
+    m_written.assign(tamanho, 0);
+}
+
+QVariant MemoryTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) {
+        return {};
+    }
+
+    int row = index.row();
+    int col = index.column();
+
+    if (role == Qt::DisplayRole && col == 0) {
+        return QString("0x%1").arg(static_cast<uint32_t>(row) * BYTES_PER_ROW, 8, 16, QChar('0'));
+    }
+
+    if (!inBlock(row)) {
+        if (!m_coreAccessible) {
+            return {};
+        }
+        loadBlock(row);
+    }
+
+    int local = row - m_blockFirstRow;
+    RowKind kind = m_rowKinds[local];
+    size_t primeiro = static_cast<size_t>(local) * BYTES_PER_ROW;
+
+    if (role == Qt::DisplayRole) {
+        if (col == ASCII_COLUMN) {
+            if (kind != RowKind::Readable) {
+                return {};
+            }
+            QString ascii;
+            for (int i = 0; i < BYTES_PER_ROW; ++i) {
+                uint8_t byte = m_bytes[primeiro + i];
+                ascii += (byte >= 32 && byte <= 126) ? QChar(static_cast<char16_t>(byte)) : QChar('.');
+            }
+            return ascii;
+        }
+        if (kind == RowKind::Unmapped) {
+            return QString("--");
+        }
+        if (kind == RowKind::Device) {
+            return QString("??");
+        }
+        return QString("%1").arg(m_bytes[primeiro + col - 1], 2, 16, QChar('0')).toUpper();
+    }
+
+    if (role == Qt::BackgroundRole && col >= 1) {
+        if (kind == RowKind::Unmapped) {
+            return m_unmappedBrush;
+        }
+        if (col <= BYTES_PER_ROW && m_written[primeiro + col - 1]) {
+            return m_highlightBrush;
+        }
+    }
+
+    return {};
+}
+
+QVariant MemoryTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    if (section == 0) {
+        return QString("Endereço");
+    }
+    if (section == ASCII_COLUMN) {
+        return QString("ASCII");
+    }
+    return QString("+%1").arg(section - 1, 2, 16, QChar('0')).toUpper();
+}
+
+void MemoryTableModel::refresh()
+{
+    if (m_blockFirstRow < 0 || !m_coreAccessible) {
+        return;
+    }
+
+    static const QList<int> roles = {Qt::DisplayRole, Qt::BackgroundRole};
+    std::vector<uint8_t> escritos = m_core->consumir_escritas_janela();
+    uint32_t inicio = static_cast<uint32_t>(m_blockFirstRow) * BYTES_PER_ROW;
+
+    // Só as linhas com bytes escritos agora ou destacados antes precisam ser relidas e redesenhadas
+    for (int local = 0; local < BLOCK_ROWS; ++local) {
+        size_t primeiro = static_cast<size_t>(local) * BYTES_PER_ROW;
+        bool escrita = false;
+        bool destacada = false;
+        for (int i = 0; i < BYTES_PER_ROW; ++i) {
+            escrita = escrita || escritos[primeiro + i];
+            destacada = destacada || m_written[primeiro + i];
+        }
+        if (!escrita && !destacada) {
+            continue;
+        }
+
+        std::copy_n(escritos.begin() + primeiro, BYTES_PER_ROW, m_written.begin() + primeiro);
+        if (escrita) {
+            m_core->espiar_bloco_memoria(inicio + primeiro, m_bytes.data() + primeiro, BYTES_PER_ROW);
+        }
+        int row = m_blockFirstRow + local;
+        emit dataChanged(index(row, 1), index(row, ASCII_COLUMN), roles);
+    }
+}
+
+void MemoryTableModel::reload()
+{
+    m_blockFirstRow = -1;
+    m_core->definir_janela_escritas(0, 0);
+    emit dataChanged(index(0, 0), index(ROW_COUNT - 1, ASCII_COLUMN));
+}
+
+void MemoryTableModel::setCoreAccessible(bool accessible)
+{
+    m_coreAccessible = accessible;
+}
@@ -0,0 +1,73 @@
+#ifndef MEMORYTABLEMODEL_H
+#define MEMORYTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QBrush>
+#include <cstdint>
+#include <vector>
+
+#include "core/Core.h"
+
+/**
+ * @class MemoryTableModel
+ * @brief Visualizador hexadecimal virtual de todo o espaço de endereçamento (4 GiB, 2^28 linhas).
+ *
+ * A view só pede as linhas visíveis; o modelo guarda um bloco de linhas ao
+ * redor delas, lido do Core de uma vez com espiar_bloco_memoria(). O mesmo
+ * bloco é a janela de rastreamento de escritas do Core, então refresh()
+ * destaca exatamente os bytes escritos desde a atualização anterior, sem
+ * comparar a memória inteira. Páginas não mapeadas aparecem como "--" e
+ * registradores de dispositivos (que não podem ser lidos sem efeitos) como "??".
+ */
+class MemoryTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    static constexpr int BYTES_PER_ROW = 16;
+    static constexpr int ASCII_COLUMN = BYTES_PER_ROW + 1;
+    static constexpr int ROW_COUNT = static_cast<int>((1ull << 32) / BYTES_PER_ROW);
+    // Linhas lidas de uma vez ao redor da área visível (8 KiB)
+    static constexpr int BLOCK_ROWS = 512;
+
+    explicit MemoryTableModel(Core *core, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    static int rowForAddress(uint32_t address);
+
+    // Relê o bloco atual e destaca os bytes que o Core marcou como escritos
+    void refresh();
+    // Descarta o bloco e os destaques (ex: depois de reset ou de carregar um programa)
+    void reload();
+
+    // Enquanto a simulação roda em outra thread, o Core não pode ser lido: só o bloco já lido é exibido
+    void setCoreAccessible(bool accessible);
+
+private:
+    enum class RowKind : uint8_t {
+        Unmapped,
+        Readable,
+        Device
+    };
+
+    // Lê o bloco que contém 'row' (centralizado nela) e o define como janela de escritas
+    void loadBlock(int row) const;
+    bool inBlock(int row) const;
+
+    Core *m_core;
+    bool m_coreAccessible = true;
+
+    // Cache das linhas ao redor da área visível; mutável porque é preenchido sob demanda em data()
+    mutable int m_blockFirstRow = -1;
+    mutable std::vector<uint8_t> m_bytes;
+    mutable std::vector<uint8_t> m_written;
+    mutable std::vector<RowKind> m_rowKinds;
+
+    const QBrush m_highlightBrush;
+    const QBrush m_unmappedBrush;
+};
+
+#endif // MEMORYTABLEMODEL_H
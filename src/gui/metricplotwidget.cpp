@@ -0,0 +1,144 @@
+#include "metricplotwidget.h"
+
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPen>
+#include <QPolygonF>
+#include <algorithm>
+
+MetricPlotWidget::MetricPlotWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setMinimumSize(240, 140);
+}
+
+void MetricPlotWidget::setTitle(const QString &title)
+{
+    m_title = title;
+    update();
+}
+
+void MetricPlotWidget::setFixedRange(double minimum, double maximum)
+{
+    m_fixedRange = true;
+    m_minimum = minimum;
+    m_maximum = maximum;
+    update();
+}
+
+int MetricPlotWidget::addSeries(const QString &name, const QColor &color)
+{
+    m_series.append({name, color, {}});
+    return static_cast<int>(m_series.size()) - 1;
+}
+
+void MetricPlotWidget::append(int series, double x, double y)
+{
+    QVector<QPointF> &points = m_series[series].points;
+    // Remove em blocos para não deslocar o vetor a cada ponto novo
+    if (points.size() >= MAX_POINTS + MAX_POINTS / 4) {
+        points.remove(0, points.size() - MAX_POINTS);
+    }
+    points.append(QPointF(x, y));
+    update();
+}
+
+void MetricPlotWidget::clear()
+{
+    for (Series &series : m_series) {
+        series.points.clear();
+    }
+    update();
+}
+
+QString MetricPlotWidget::formatValue(double value)
+{
+    if (value >= 1e9) {
+        return QString::number(value / 1e9, 'f', 2) + "G";
+    }
+    if (value >= 1e6) {
+        return QString::number(value / 1e6, 'f', 2) + "M";
+    }
+    if (value >= 1e3) {
+        return QString::number(value / 1e3, 'f', 1) + "k";
+    }
+    return QString::number(value, 'f', value < 10 ? 2 : 0);
+}
+
+void MetricPlotWidget::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor(30, 30, 30));
+
+    QFontMetrics metrics(font());
+    const int lineHeight = metrics.height();
+    QRectF area = QRectF(rect()).adjusted(52, lineHeight + 8, -10, -(lineHeight + 6));
+
+    // Título e legenda na primeira linha
+    painter.setPen(Qt::white);
+    painter.drawText(6, lineHeight, m_title);
+    int legendX = width() - 6;
+    for (int i = static_cast<int>(m_series.size()) - 1; i >= 0 && m_series.size() > 1; --i) {
+        legendX -= metrics.horizontalAdvance(m_series[i].name) + 14;
+        painter.setPen(m_series[i].color);
+        painter.drawText(legendX, lineHeight, m_series[i].name);
+    }
+
+    // Faixa visível: X cobre os pontos retidos, Y vai de 0 (ou do mínimo fixo) ao maior valor
+    double xMin = 0.0;
+    double xMax = 0.0;
+    double dataMax = 0.0;
+    bool hasPoints = false;
+    for (const Series &series : m_series) {
+        if (series.points.isEmpty()) {
+            continue;
+        }
+        int start = std::max(0, static_cast<int>(series.points.size()) - MAX_POINTS);
+        double first = series.points[start].x();
+        double last = series.points.last().x();
+        xMin = hasPoints ? std::min(xMin, first) : first;
+        xMax = hasPoints ? std::max(xMax, last) : last;
+        for (int i = start; i < series.points.size(); ++i) {
+            dataMax = std::max(dataMax, series.points[i].y());
+        }
+        hasPoints = true;
+    }
+    double yMin = m_fixedRange ? m_minimum : 0.0;
+    double yMax = m_fixedRange ? m_maximum : (dataMax > 0 ? dataMax * 1.1 : 1.0);
+    if (xMax <= xMin) {
+        xMax = xMin + 1.0;
+    }
+
+    // Eixos e rótulos
+    painter.setPen(QColor(80, 80, 80));
+    painter.drawRect(area);
+    painter.setPen(Qt::lightGray);
+    painter.drawText(QRectF(0, area.top() - lineHeight / 2, area.left() - 4, lineHeight),
+                     Qt::AlignRight | Qt::AlignVCenter, formatValue(yMax));
+    painter.drawText(QRectF(0, area.bottom() - lineHeight / 2, area.left() - 4, lineHeight),
+                     Qt::AlignRight | Qt::AlignVCenter, formatValue(yMin));
+    if (hasPoints) {
+        painter.drawText(QRectF(area.left(), area.bottom() + 2, area.width(), lineHeight),
+                         Qt::AlignLeft, QString("%1 s").arg(xMin, 0, 'f', 1));
+        painter.drawText(QRectF(area.left(), area.bottom() + 2, area.width(), lineHeight),
+                         Qt::AlignRight, QString("%1 s").arg(xMax, 0, 'f', 1));
+    }
+
+    // Séries
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setClipRect(area);
+    const double scaleX = area.width() / (xMax - xMin);
+    const double scaleY = area.height() / (yMax - yMin);
+    for (const Series &series : m_series) {
+        int start = std::max(0, static_cast<int>(series.points.size()) - MAX_POINTS);
+        QPolygonF polyline;
+        polyline.reserve(series.points.size() - start);
+        for (int i = start; i < series.points.size(); ++i) {
+            const QPointF &point = series.points[i];
+            polyline.append(QPointF(area.left() + (point.x() - xMin) * scaleX,
+                                    area.bottom() - (point.y() - yMin) * scaleY));
+        }
+        painter.setPen(QPen(series.color, 1.5));
+        painter.drawPolyline(polyline);
+    }
+}
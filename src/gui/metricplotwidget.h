@@ -0,0 +1,56 @@
+#ifndef METRICPLOTWIDGET_H
+#define METRICPLOTWIDGET_H
+
+#include <QColor>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <QWidget>
+
+/**
+ * @class MetricPlotWidget
+ * @brief Gráfico de linhas simples (uma ou mais séries) que recebe pontos novos incrementalmente.
+ *
+ * Guarda no máximo MAX_POINTS pontos por série; os mais antigos saem pelo
+ * início, então o eixo X mostra sempre a janela mais recente. O eixo Y se
+ * ajusta ao maior valor visível, a menos que uma faixa fixa seja definida.
+ */
+class MetricPlotWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_POINTS = 600;
+
+    explicit MetricPlotWidget(QWidget *parent = nullptr);
+
+    void setTitle(const QString &title);
+    // Ex.: 0 a 100 para porcentagens; sem isso o eixo vai de 0 ao maior valor
+    void setFixedRange(double minimum, double maximum);
+
+    // Retorna o índice da série criada
+    int addSeries(const QString &name, const QColor &color);
+    void append(int series, double x, double y);
+    void clear();
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    struct Series
+    {
+        QString name;
+        QColor color;
+        QVector<QPointF> points;
+    };
+
+    static QString formatValue(double value);
+
+    QString m_title;
+    QVector<Series> m_series;
+    bool m_fixedRange = false;
+    double m_minimum = 0.0;
+    double m_maximum = 1.0;
+};
+
+#endif // METRICPLOTWIDGET_H
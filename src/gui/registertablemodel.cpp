@@ -0,0 +1,105 @@
+#include "registertablemodel.h"
+
+static const std::array<const char*, 32> abiNames = {
+    "zero", "ra", "sp", "gp", "tp", "t0", "t1", "t2",
+    "s0", "s1", "a0", "a1", "a2", "a3", "a4", "a5",
+    "a6", "a7", "s2", "s3", "s4", "s5", "s6", "s7",
+    "s8", "s9", "s10", "s11", "t3", "t4", "t5", "t6"
+};
+
+RegisterTableModel::RegisterTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_highlightBrush(QColor(80, 80, 80))
+{
+}
+
+int RegisterTableModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 33; // x0-x31 + pc
+}
+
+int RegisterTableModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : 4;
+}
+
+QVariant RegisterTableModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) {
+        return {};
+    }
+
+    int row = index.row();
+    uint32_t valor = m_values[row];
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case 0: return row == PC_ROW ? QString("pc") : QString("x%1").arg(row);
+            case 1: return row == PC_ROW ? QString("-") : QString(abiNames[row]);
+            case 2: return QString("0x%1").arg(valor, 8, 16, QChar('0'));
+            // O pc é sem sinal; os registradores aparecem como int32_t para mostrar negativos
+            case 3: return row == PC_ROW ? QString::number(valor) : QString::number(static_cast<int32_t>(valor));
+            default: return {};
+        }
+    }
+
+    if (role == Qt::BackgroundRole && index.column() >= 2 && m_changed[row]) {
+        return m_highlightBrush;
+    }
+
+    return {};
+}
+
+QVariant RegisterTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const std::array<const char*, 4> headers = {"Reg", "ABI", "Hexadecimal", "Decimal"};
+    return section >= 0 && section < 4 ? QString(headers[section]) : QVariant();
+}
+
+void RegisterTableModel::updateValues(const std::array<uint32_t, 32> &regs, uint32_t pc)
+{
+    std::array<bool, 33> dirty{};
+    for (int i = 0; i < 33; ++i) {
+        uint32_t novo = i == PC_ROW ? pc : regs[i];
+        bool mudou = novo != m_values[i];
+        // Também avisa as linhas que estavam destacadas e agora devem voltar ao normal
+        dirty[i] = mudou || m_changed[i];
+        m_values[i] = novo;
+        // O pc muda a toda instrução, então não é destacado
+        m_changed[i] = mudou && i != PC_ROW;
+    }
+    notifyRows(dirty);
+}
+
+void RegisterTableModel::updateFromCore(const Core &core)
+{
+    updateValues(core.get_registradores(), core.get_program_counter());
+}
+
+void RegisterTableModel::clearHighlights()
+{
+    std::array<bool, 33> dirty = m_changed;
+    m_changed.fill(false);
+    notifyRows(dirty);
+}
+
+/**
+ * @brief Emite um dataChanged por faixa contínua de linhas alteradas (colunas de valor).
+ */
+void RegisterTableModel::notifyRows(const std::array<bool, 33> &rows)
+{
+    static const QList<int> roles = {Qt::DisplayRole, Qt::BackgroundRole};
+    int inicio = -1;
+    for (int i = 0; i <= 33; ++i) {
+        bool marcada = i < 33 && rows[i];
+        if (marcada && inicio < 0) {
+            inicio = i;
+        } else if (!marcada && inicio >= 0) {
+            emit dataChanged(index(inicio, 2), index(i - 1, 3), roles);
+            inicio = -1;
+        }
+    }
+}
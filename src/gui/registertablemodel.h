@@ -0,0 +1,47 @@
+#ifndef REGISTERTABLEMODEL_H
+#define REGISTERTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QBrush>
+#include <array>
+#include <cstdint>
+
+#include "core/Core.h"
+
+/**
+ * @class RegisterTableModel
+ * @brief Modelo da tabela de registradores (x0-x31 + pc): Reg, ABI, Hex e Decimal.
+ *
+ * Guarda apenas os 33 valores; o texto é formatado em data() sob demanda.
+ * A cada atualização, só as linhas cujo valor mudou (ou que perderam o
+ * destaque da atualização anterior) são avisadas à view com dataChanged.
+ */
+class RegisterTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    static constexpr int PC_ROW = 32;
+
+    explicit RegisterTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Compara com os valores atuais e destaca os registradores que mudaram
+    void updateValues(const std::array<uint32_t, 32> &regs, uint32_t pc);
+    void updateFromCore(const Core &core);
+
+    // Remove todos os destaques sem mudar os valores
+    void clearHighlights();
+
+private:
+    void notifyRows(const std::array<bool, 33> &rows);
+
+    std::array<uint32_t, 33> m_values{};
+    std::array<bool, 33> m_changed{};
+    const QBrush m_highlightBrush;
+};
+
+#endif // REGISTERTABLEMODEL_H
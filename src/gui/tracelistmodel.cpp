@@ -0,0 +1,186 @@
+#include "tracelistmodel.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "core/Desmontador.h"
+
+TraceListModel::TraceListModel(const HistoricoExecucao *historico, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_historico(historico)
+{
+}
+
+int TraceListModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return m_filtered ? static_cast<int>(m_rows.size()) : static_cast<int>(m_end - m_first);
+}
+
+uint64_t TraceListModel::sequenceAt(int row) const
+{
+    return m_filtered ? m_rows[row] : m_first + row;
+}
+
+QVariant TraceListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole) {
+        return {};
+    }
+
+    uint64_t sequencial = sequenceAt(index.row());
+    RegistroCommit registro;
+    if (!m_historico->obter(sequencial, registro)) {
+        // Sobrescrito pela thread de execução depois do último sync()
+        return QString("%1  (sobrescrito)").arg(sequencial, 8);
+    }
+    return QString::fromStdString(HistoricoExecucao::formatar(sequencial, registro));
+}
+
+bool TraceListModel::matches(const RegistroCommit &registro) const
+{
+    if (registro.pc < m_pcMin || registro.pc > m_pcMax) {
+        return false;
+    }
+    if (m_opcode >= 0 && static_cast<int>(registro.instrucao & 0x7F) != m_opcode) {
+        return false;
+    }
+    if (!m_mnemonic.empty() && m_mnemonic != mnemonico(registro.instrucao)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Filtra os registros [inicio, fim) do histórico e acrescenta os que passam em m_rows.
+ */
+void TraceListModel::appendRange(uint64_t inicio, uint64_t fim)
+{
+    std::vector<RegistroCommit> bloco;
+    std::vector<uint64_t> novos;
+    while (inicio < fim) {
+        uint64_t s = m_historico->copiar(inicio, std::min<uint64_t>(fim, inicio + 4096), bloco);
+        if (bloco.empty()) {
+            break;
+        }
+        for (const RegistroCommit &registro : bloco) {
+            if (matches(registro)) {
+                novos.push_back(s);
+            }
+            ++s;
+        }
+        inicio = s;
+    }
+
+    if (novos.empty()) {
+        return;
+    }
+    int linha = static_cast<int>(m_rows.size());
+    beginInsertRows(QModelIndex(), linha, linha + static_cast<int>(novos.size()) - 1);
+    m_rows.insert(m_rows.end(), novos.begin(), novos.end());
+    endInsertRows();
+}
+
+void TraceListModel::sync()
+{
+    uint64_t primeiro = m_historico->primeiro_sequencial();
+    uint64_t fim = m_historico->fim_sequencial();
+
+    // O histórico foi limpo ou encurtado (reset, novo programa ou execução reversa)
+    if (fim < m_end) {
+        beginResetModel();
+        m_rows.clear();
+        m_first = m_end = 0;
+        endResetModel();
+    }
+
+    if (m_filtered) {
+        size_t removidas = 0;
+        while (removidas < m_rows.size() && m_rows[removidas] < primeiro) {
+            ++removidas;
+        }
+        if (removidas > 0) {
+            beginRemoveRows(QModelIndex(), 0, static_cast<int>(removidas) - 1);
+            m_rows.erase(m_rows.begin(), m_rows.begin() + static_cast<std::ptrdiff_t>(removidas));
+            endRemoveRows();
+        }
+        appendRange(std::max(m_end, primeiro), fim);
+        m_first = primeiro;
+        m_end = fim;
+        return;
+    }
+
+    // Linhas sobrescritas saem do início...
+    uint64_t novo_primeiro = std::min(std::max(primeiro, m_first), m_end);
+    if (novo_primeiro > m_first) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(novo_primeiro - m_first) - 1);
+        m_first = novo_primeiro;
+        endRemoveRows();
+    }
+    // ...e se tudo foi sobrescrito, a lista recomeça no primeiro registro ainda disponível
+    if (m_first == m_end && primeiro > m_first) {
+        m_first = m_end = primeiro;
+    }
+
+    // ...e as novas entram no fim
+    if (fim > m_end) {
+        int linha = static_cast<int>(m_end - m_first);
+        beginInsertRows(QModelIndex(), linha, linha + static_cast<int>(fim - m_end) - 1);
+        m_end = fim;
+        endInsertRows();
+    }
+}
+
+bool TraceListModel::setFilter(const QString &opcode, uint32_t pcMin, uint32_t pcMax)
+{
+    std::string mnemonic;
+    int numero = -1;
+    QString texto = opcode.trimmed().toLower();
+    if (!texto.isEmpty()) {
+        if (texto[0].isDigit()) {
+            bool ok = false;
+            numero = static_cast<int>(texto.toUInt(&ok, 0));
+            if (!ok || numero > 0x7F) {
+                return false;
+            }
+        } else {
+            mnemonic = texto.toStdString();
+        }
+    }
+
+    beginResetModel();
+    m_filtered = true;
+    m_mnemonic = mnemonic;
+    m_opcode = numero;
+    m_pcMin = pcMin;
+    m_pcMax = pcMax;
+    m_rows.clear();
+    endResetModel();
+
+    m_first = m_historico->primeiro_sequencial();
+    m_end = m_first;
+    appendRange(m_first, m_historico->fim_sequencial());
+    m_end = m_historico->fim_sequencial();
+    return true;
+}
+
+void TraceListModel::clearFilter()
+{
+    beginResetModel();
+    m_filtered = false;
+    m_rows.clear();
+    m_mnemonic.clear();
+    m_opcode = -1;
+    m_pcMin = 0;
+    m_pcMax = UINT32_MAX;
+    m_first = m_historico->primeiro_sequencial();
+    m_end = m_historico->fim_sequencial();
+    endResetModel();
+}
+
+bool TraceListModel::filterActive() const
+{
+    return m_filtered;
+}
@@ -0,0 +1,58 @@
+#ifndef TRACELISTMODEL_H
+#define TRACELISTMODEL_H
+
+#include <QAbstractListModel>
+#include <cstdint>
+#include <deque>
+#include <string>
+
+#include "execution/HistoricoExecucao.h"
+
+/**
+ * @class TraceListModel
+ * @brief Lista virtual das instruções guardadas no HistoricoExecucao.
+ *
+ * Cada linha é só um número sequencial; o texto é montado em data() apenas
+ * para as linhas visíveis. sync() acompanha o anel: remove do início as
+ * linhas sobrescritas e acrescenta as novas, sem recriar a lista. Com um
+ * filtro ativo (opcode e/ou faixa de PC), o modelo guarda apenas os
+ * sequenciais que passam no filtro.
+ */
+class TraceListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit TraceListModel(const HistoricoExecucao *historico, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // Acompanha as inserções (e um eventual limpar()) feitas no histórico desde a última chamada
+    void sync();
+
+    // 'opcode' é um mnemônico ("lw") ou um número ("0x03"); vazio aceita qualquer um.
+    // Retorna false se o texto do opcode não for válido.
+    bool setFilter(const QString &opcode, uint32_t pcMin, uint32_t pcMax);
+    void clearFilter();
+    bool filterActive() const;
+
+private:
+    bool matches(const RegistroCommit &registro) const;
+    void appendRange(uint64_t inicio, uint64_t fim);
+    uint64_t sequenceAt(int row) const;
+
+    const HistoricoExecucao *m_historico;
+
+    // Sem filtro, as linhas são os sequenciais [m_first, m_end)
+    uint64_t m_first = 0;
+    uint64_t m_end = 0;
+
+    bool m_filtered = false;
+    std::deque<uint64_t> m_rows;
+    std::string m_mnemonic;
+    int m_opcode = -1;
+    uint32_t m_pcMin = 0;
+    uint32_t m_pcMax = UINT32_MAX;
+};
+
+#endif // TRACELISTMODEL_H
@@ -0,0 +1,74 @@
+#include "MicroBenchmark.h"
+
+#include <chrono>
+
+#include "core/Core.h"
+
+namespace microbenchmark {
+
+std::string medir(const std::vector<uint32_t> &sequencia, const std::array<uint32_t, 32> &registradores,
+                  uint64_t instrucoes, ResultadoMicroBenchmark &resultado) {
+    if (sequencia.empty()) {
+        return "[ERRO] Sequencia vazia.";
+    }
+    for (uint32_t instrucao : sequencia) {
+        uint32_t opcode = instrucao & 0x7F;
+        // Desvios, saltos e ecall mudariam o fluxo do laço; a instrução nula encerraria o programa
+        if (instrucao == 0 || opcode == 0x63 || opcode == 0x6F || opcode == 0x67 || opcode == 0x73) {
+            return "[ERRO] A sequencia nao pode conter desvios, saltos, ecall ou a instrucao nula.";
+        }
+    }
+
+    return executar_laco(montar_laco(sequencia), registradores, instrucoes, resultado);
+}
+
+std::vector<uint32_t> montar_laco(const std::vector<uint32_t> &sequencia) {
+    // Corpo desenrolado + "jal x0, -tamanho_do_corpo"
+    std::vector<uint32_t> programa;
+    while (programa.size() < CORPO_MINIMO) {
+        programa.insert(programa.end(), sequencia.begin(), sequencia.end());
+    }
+    int32_t deslocamento = -static_cast<int32_t>(programa.size() * 4);
+    auto imm = static_cast<uint32_t>(deslocamento);
+    uint32_t jal = (((imm >> 20) & 0x1) << 31) | (((imm >> 1) & 0x3FF) << 21) |
+                   (((imm >> 11) & 0x1) << 20) | (((imm >> 12) & 0xFF) << 12) | 0x6F;
+    programa.push_back(jal);
+    return programa;
+}
+
+std::string executar_laco(const std::vector<uint32_t> &programa, const std::array<uint32_t, 32> &registradores,
+                          uint64_t instrucoes, ResultadoMicroBenchmark &resultado) {
+    Core core(1024 * 1024);
+    core.reset();
+    core.load_program(programa);
+    for (int i = 1; i < 32; ++i) {
+        core.set_register(i, registradores[i]);
+    }
+
+    // Aquece o cache e os preditores do host antes de medir
+    for (uint64_t i = 0; i < AQUECIMENTO && !core.is_finished(); ++i) {
+        core.step();
+    }
+
+    const ContadoresCore inicio = core.get_contadores();
+    auto relogio_inicio = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < instrucoes && !core.is_finished(); ++i) {
+        core.step();
+    }
+    auto relogio_fim = std::chrono::steady_clock::now();
+
+    if (core.is_finished()) {
+        return "[ERRO] O programa terminou durante a medicao (acesso invalido a memoria?).";
+    }
+
+    const ContadoresCore &fim = core.get_contadores();
+    resultado.instrucoes = fim.instrucoes - inicio.instrucoes;
+    resultado.segundos = std::chrono::duration<double>(relogio_fim - relogio_inicio).count();
+    resultado.nanossegundos_por_instrucao =
+            resultado.instrucoes > 0 ? resultado.segundos * 1e9 / resultado.instrucoes : 0.0;
+    resultado.ciclos_por_instrucao =
+            resultado.instrucoes > 0 ? static_cast<double>(fim.ciclos - inicio.ciclos) / resultado.instrucoes : 0.0;
+    return "";
+}
+
+}
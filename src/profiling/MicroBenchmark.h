@@ -0,0 +1,43 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_MICROBENCHMARK_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_MICROBENCHMARK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ResultadoMicroBenchmark
+ * @brief Custo no host e custo modelado de uma sequência executada muitas vezes pelo Core.
+ */
+struct ResultadoMicroBenchmark {
+    uint64_t instrucoes = 0;
+    double segundos = 0.0;
+    // Tempo de host por instrução simulada (inclui decodificação, execução e o log de step())
+    double nanossegundos_por_instrucao = 0.0;
+    // Ciclos do modelo de tempo do Core (contadores.ciclos) por instrução
+    double ciclos_por_instrucao = 0.0;
+};
+
+/**
+ * Mede 'sequencia' (uma ou mais instruções sem desvios) repetida até somar
+ * 'instrucoes' passos de Core::step(), em um Core próprio que começa com
+ * 'registradores'. A sequência é desenrolada até CORPO_MINIMO instruções e
+ * seguida de um salto de volta ao início, então o salto pesa menos de 0,2%
+ * da medida. Retorna uma mensagem de erro, ou string vazia em caso de sucesso.
+ */
+namespace microbenchmark {
+    constexpr size_t CORPO_MINIMO = 512;
+    constexpr uint64_t AQUECIMENTO = 10000;
+
+    std::string medir(const std::vector<uint32_t>& sequencia, const std::array<uint32_t, 32>& registradores,
+                      uint64_t instrucoes, ResultadoMicroBenchmark& resultado);
+
+    // Partes de medir(), sem a validação da sequência (para quem monta laços com desvios não tomados, etc.)
+    std::vector<uint32_t> montar_laco(const std::vector<uint32_t>& sequencia);
+    std::string executar_laco(const std::vector<uint32_t>& programa, const std::array<uint32_t, 32>& registradores,
+                              uint64_t instrucoes, ResultadoMicroBenchmark& resultado);
+}
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_MICROBENCHMARK_H
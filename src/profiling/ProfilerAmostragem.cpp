@@ -0,0 +1,132 @@
+#include "ProfilerAmostragem.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    // Registradores da ABI usados no desenrolar da pilha
+    constexpr int REG_RA = 1;
+    constexpr int REG_S0 = 8;
+
+    std::vector<std::pair<std::string, uint64_t>> ordenar_decrescente(
+        const std::unordered_map<std::string, uint64_t>& contagens) {
+        std::vector<std::pair<std::string, uint64_t>> resultado(contagens.begin(), contagens.end());
+        std::sort(resultado.begin(), resultado.end(), [](const auto& a, const auto& b) {
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return resultado;
+    }
+}
+
+ProfilerAmostragem::ProfilerAmostragem(const ConfigProfiler &config) : config(config) {
+    if (this->config.intervalo == 0) this->config.intervalo = 1;
+    reset();
+}
+
+void ProfilerAmostragem::reset() {
+    restante = config.intervalo;
+    proximo_ciclo = config.intervalo;
+    total_amostras = 0;
+    amostras_pc.clear();
+    amostras_pilha.clear();
+}
+
+uint64_t ProfilerAmostragem::get_total_amostras() const {
+    return total_amostras;
+}
+
+/**
+ * @brief Registra o PC atual e, se configurado, a pilha de chamadas.
+ *
+ * Com frame pointer, cada quadro guarda o endereço de retorno em fp-4 e o
+ * fp do chamador em fp-8. A cadeia termina quando o fp é nulo, desalinhado
+ * ou deixa de crescer (a pilha cresce para endereços menores).
+ */
+void ProfilerAmostragem::amostrar(const Core &core) {
+    const RegistroCommit& commit = core.get_ultimo_commit();
+    uint32_t pc = commit.pc;
+
+    total_amostras++;
+    amostras_pc[pc]++;
+
+    pilha_atual.clear();
+    pilha_atual.push_back(pc);
+
+    if (config.pilha != ConfigProfiler::Pilha::Nenhuma) {
+        std::array<uint32_t, 32> regs = core.get_registradores();
+
+        if (config.pilha == ConfigProfiler::Pilha::EnderecoRetorno) {
+            if (regs[REG_RA] != 0) pilha_atual.push_back(regs[REG_RA] - 4);
+        } else {
+            uint32_t fp = regs[REG_S0];
+            while (fp != 0 && (fp & 0x3) == 0 && pilha_atual.size() < config.profundidade_maxima) {
+                uint32_t retorno = core.get_palavra_memoria(fp - 4);
+                uint32_t fp_anterior = core.get_palavra_memoria(fp - 8);
+                if (retorno == 0) break;
+
+                // Aponta para a instrução de chamada, não para a de retorno
+                pilha_atual.push_back(retorno - 4);
+                if (fp_anterior <= fp) break;
+                fp = fp_anterior;
+            }
+        }
+    }
+
+    amostras_pilha[pilha_atual]++;
+}
+
+std::vector<std::pair<std::string, uint64_t>> ProfilerAmostragem::histograma_funcoes(
+    const TabelaSimbolos &simbolos) const {
+    std::unordered_map<std::string, uint64_t> por_funcao;
+    for (const auto& [pc, contagem] : amostras_pc) {
+        por_funcao[simbolos.funcao(pc)] += contagem;
+    }
+    return ordenar_decrescente(por_funcao);
+}
+
+std::vector<std::pair<std::string, uint64_t>> ProfilerAmostragem::histograma_linhas(
+    const TabelaSimbolos &simbolos) const {
+    std::unordered_map<std::string, uint64_t> por_linha;
+    for (const auto& [pc, contagem] : amostras_pc) {
+        por_linha[simbolos.linha(pc)] += contagem;
+    }
+    return ordenar_decrescente(por_linha);
+}
+
+void ProfilerAmostragem::exportar_pilhas_dobradas(std::ostream &saida, const TabelaSimbolos &simbolos) const {
+    // Pilhas diferentes podem resultar na mesma sequência de funções
+    std::map<std::string, uint64_t> dobradas;
+    for (const auto& [pilha, contagem] : amostras_pilha) {
+        std::string linha;
+        for (auto it = pilha.rbegin(); it != pilha.rend(); ++it) {
+            if (!linha.empty()) linha += ';';
+            linha += simbolos.funcao(*it);
+        }
+        dobradas[linha] += contagem;
+    }
+
+    for (const auto& [linha, contagem] : dobradas) {
+        saida << linha << ' ' << contagem << '\n';
+    }
+}
+
+std::string ProfilerAmostragem::formatar_relatorio(const TabelaSimbolos &simbolos, size_t maximo_linhas) const {
+    std::stringstream ss;
+    ss << "--- Profiler (" << total_amostras << " amostras) ---\n";
+    if (total_amostras == 0) return ss.str();
+
+    auto imprimir = [&](const char* titulo, const std::vector<std::pair<std::string, uint64_t>>& hist) {
+        ss << titulo << ":\n";
+        for (size_t i = 0; i < hist.size() && i < maximo_linhas; ++i) {
+            ss << "  " << std::fixed << std::setprecision(2) << std::setw(6)
+               << 100.0 * hist[i].second / total_amostras << "%  "
+               << std::setw(8) << hist[i].second << "  " << hist[i].first << "\n";
+        }
+    };
+
+    imprimir("Funcoes", histograma_funcoes(simbolos));
+    ss << "\n";
+    imprimir("Linhas", histograma_linhas(simbolos));
+    return ss.str();
+}
@@ -0,0 +1,83 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_PROFILERAMOSTRAGEM_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_PROFILERAMOSTRAGEM_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/Core.h"
+#include "TabelaSimbolos.h"
+
+/**
+ * @struct ConfigProfiler
+ * @brief Parâmetros de amostragem do profiler.
+ */
+struct ConfigProfiler {
+    enum class Base { Instrucoes, Ciclos };
+    enum class Pilha { Nenhuma, EnderecoRetorno, FramePointer };
+
+    // Uma amostra a cada 'intervalo' instruções retiradas (ou ciclos modelados)
+    Base base = Base::Instrucoes;
+    uint64_t intervalo = 1000;
+
+    // Como reconstruir a pilha de chamadas: só o PC, PC + ra, ou a cadeia de
+    // frame pointers (s0) gerada por -fno-omit-frame-pointer
+    Pilha pilha = Pilha::FramePointer;
+    uint32_t profundidade_maxima = 64;
+};
+
+/**
+ * @class ProfilerAmostragem
+ * @brief Amostra o PC do programa simulado a intervalos fixos, sem alterar o código do guest.
+ *
+ * Deve ser chamado após cada Core::step(); fora dos pontos de amostragem o
+ * custo é um decremento e uma comparação.
+ */
+class ProfilerAmostragem {
+public:
+    explicit ProfilerAmostragem(const ConfigProfiler& config = ConfigProfiler{});
+
+    void reset();
+
+    void registrar(const Core& core) {
+        if (config.base == ConfigProfiler::Base::Instrucoes) {
+            if (--restante != 0) return;
+            restante = config.intervalo;
+        } else {
+            if (core.get_contadores().ciclos < proximo_ciclo) return;
+            proximo_ciclo = core.get_contadores().ciclos + config.intervalo;
+        }
+        amostrar(core);
+    }
+
+    uint64_t get_total_amostras() const;
+
+    // Amostras próprias (self) por função e por linha, em ordem decrescente
+    std::vector<std::pair<std::string, uint64_t>> histograma_funcoes(const TabelaSimbolos& simbolos) const;
+    std::vector<std::pair<std::string, uint64_t>> histograma_linhas(const TabelaSimbolos& simbolos) const;
+
+    // Formato "pilhas dobradas" (raiz;...;folha contagem) usado pelo flamegraph.pl
+    void exportar_pilhas_dobradas(std::ostream& saida, const TabelaSimbolos& simbolos) const;
+
+    std::string formatar_relatorio(const TabelaSimbolos& simbolos, size_t maximo_linhas = 20) const;
+
+private:
+    void amostrar(const Core& core);
+
+    ConfigProfiler config;
+    uint64_t restante = 0;
+    uint64_t proximo_ciclo = 0;
+    uint64_t total_amostras = 0;
+
+    // Amostras por PC (folha da pilha)
+    std::unordered_map<uint32_t, uint64_t> amostras_pc;
+    // Amostras por pilha completa, da folha para a raiz
+    std::map<std::vector<uint32_t>, uint64_t> amostras_pilha;
+    std::vector<uint32_t> pilha_atual;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_PROFILERAMOSTRAGEM_H
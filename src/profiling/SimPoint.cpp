@@ -0,0 +1,470 @@
+#include "SimPoint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+namespace {
+    using Ponto = std::vector<double>;
+
+    constexpr double PI = 3.14159265358979323846;
+
+    // Mistura de bits do splitmix64: gera a matriz de projeção sem guardá-la
+    uint64_t misturar(uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Elemento (bloco, dimensão) da matriz de projeção, uniforme em [-1, 1)
+    double coeficiente_projecao(uint32_t bloco, uint32_t dimensao, uint64_t semente) {
+        uint64_t h = misturar(semente ^ misturar((static_cast<uint64_t>(bloco) << 32) | dimensao));
+        return static_cast<double>(h >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+    }
+
+    // Normaliza o BBV (frequências somando 1) e o projeta em 'dimensoes' dimensões
+    Ponto projetar(const VetorBlocos& vetor, uint32_t dimensoes, uint64_t semente) {
+        Ponto ponto(dimensoes, 0.0);
+        if (vetor.instrucoes == 0) return ponto;
+        for (const auto& [bloco, instrucoes] : vetor.blocos) {
+            double frequencia = static_cast<double>(instrucoes) / vetor.instrucoes;
+            for (uint32_t d = 0; d < dimensoes; ++d) {
+                ponto[d] += frequencia * coeficiente_projecao(bloco, d, semente);
+            }
+        }
+        return ponto;
+    }
+
+    double distancia2(const Ponto& a, const Ponto& b) {
+        double soma = 0.0;
+        for (size_t d = 0; d < a.size(); ++d) {
+            double diferenca = a[d] - b[d];
+            soma += diferenca * diferenca;
+        }
+        return soma;
+    }
+
+    struct ResultadoKMeans {
+        std::vector<Ponto> centroides;
+        std::vector<uint32_t> cluster;
+        // Soma ponderada das distâncias ao quadrado até o centroide
+        double distorcao = 0.0;
+    };
+
+    // k-means ponderado (o peso de um intervalo é sua fração de um intervalo completo),
+    // com os centroides iniciais escolhidos por k-means++
+    ResultadoKMeans kmeans(const std::vector<Ponto>& pontos, const std::vector<double>& pesos,
+                           uint32_t k, uint32_t iteracoes, std::mt19937_64& gerador) {
+        const size_t n = pontos.size();
+        ResultadoKMeans r;
+        r.cluster.assign(n, 0);
+
+        std::uniform_int_distribution<size_t> primeiro(0, n - 1);
+        r.centroides.push_back(pontos[primeiro(gerador)]);
+        std::vector<double> menor(n);
+        while (r.centroides.size() < k) {
+            double total = 0.0;
+            for (size_t i = 0; i < n; ++i) {
+                menor[i] = std::numeric_limits<double>::max();
+                for (const Ponto& c : r.centroides) menor[i] = std::min(menor[i], distancia2(pontos[i], c));
+                total += menor[i] * pesos[i];
+            }
+            size_t escolhido = primeiro(gerador);
+            if (total > 0.0) {
+                double alvo = std::uniform_real_distribution<double>(0.0, total)(gerador);
+                for (escolhido = 0; escolhido + 1 < n; ++escolhido) {
+                    alvo -= menor[escolhido] * pesos[escolhido];
+                    if (alvo <= 0.0) break;
+                }
+            }
+            r.centroides.push_back(pontos[escolhido]);
+        }
+
+        const size_t dimensoes = pontos[0].size();
+        for (uint32_t it = 0; it < iteracoes; ++it) {
+            bool mudou = it == 0;
+            for (size_t i = 0; i < n; ++i) {
+                uint32_t melhor = 0;
+                double melhor_distancia = distancia2(pontos[i], r.centroides[0]);
+                for (uint32_t c = 1; c < k; ++c) {
+                    double d = distancia2(pontos[i], r.centroides[c]);
+                    if (d < melhor_distancia) {
+                        melhor_distancia = d;
+                        melhor = c;
+                    }
+                }
+                if (r.cluster[i] != melhor) {
+                    r.cluster[i] = melhor;
+                    mudou = true;
+                }
+            }
+            if (!mudou) break;
+
+            // Um cluster que ficou vazio mantém o centroide anterior
+            std::vector<Ponto> soma(k, Ponto(dimensoes, 0.0));
+            std::vector<double> peso_cluster(k, 0.0);
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t d = 0; d < dimensoes; ++d) soma[r.cluster[i]][d] += pontos[i][d] * pesos[i];
+                peso_cluster[r.cluster[i]] += pesos[i];
+            }
+            for (uint32_t c = 0; c < k; ++c) {
+                if (peso_cluster[c] == 0.0) continue;
+                for (size_t d = 0; d < dimensoes; ++d) r.centroides[c][d] = soma[c][d] / peso_cluster[c];
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            r.distorcao += distancia2(pontos[i], r.centroides[r.cluster[i]]) * pesos[i];
+        }
+        return r;
+    }
+
+    // BIC do agrupamento sob o modelo de gaussianas esféricas com variância comum
+    // (Pelleg e Moore, X-means), o mesmo critério usado pelo SimPoint
+    double calcular_bic(const ResultadoKMeans& r, size_t n, uint32_t k, size_t dimensoes) {
+        const double R = static_cast<double>(n);
+        const double M = static_cast<double>(dimensoes);
+        double variancia = n > k ? r.distorcao / (R - k) : 0.0;
+        variancia = std::max(variancia, 1e-12);
+
+        std::vector<double> tamanho(k, 0.0);
+        for (uint32_t c : r.cluster) tamanho[c] += 1.0;
+
+        double log_verossimilhanca = 0.0;
+        for (double Rn : tamanho) {
+            if (Rn == 0.0) continue;
+            log_verossimilhanca += -Rn / 2.0 * std::log(2.0 * PI) - Rn * M / 2.0 * std::log(variancia) -
+                                   (Rn - k) / 2.0 + Rn * std::log(Rn) - Rn * std::log(R);
+        }
+        double parametros = k * (M + 1.0);
+        return log_verossimilhanca - parametros / 2.0 * std::log(R);
+    }
+}
+
+PerfiladorBlocos::PerfiladorBlocos(uint64_t tamanho_intervalo, uint32_t pc_inicial)
+    : tamanho_intervalo(std::max<uint64_t>(tamanho_intervalo, 1)), inicio_bloco(pc_inicial) {
+}
+
+void PerfiladorBlocos::fechar_bloco(uint32_t proximo_inicio) {
+    blocos_intervalo[inicio_bloco] += instrucoes_bloco;
+    inicio_bloco = proximo_inicio;
+    instrucoes_bloco = 0;
+}
+
+/**
+ * @brief Fecha o vetor do intervalo atual. Um bloco cortado pela fronteira é contado
+ * em parte em cada intervalo, com o mesmo endereço de início.
+ */
+void PerfiladorBlocos::fechar_intervalo() {
+    if (instrucoes_bloco > 0) {
+        blocos_intervalo[inicio_bloco] += instrucoes_bloco;
+        instrucoes_bloco = 0;
+    }
+
+    VetorBlocos vetor;
+    vetor.inicio = total_instrucoes;
+    vetor.instrucoes = instrucoes_intervalo;
+    vetor.blocos.assign(blocos_intervalo.begin(), blocos_intervalo.end());
+    std::sort(vetor.blocos.begin(), vetor.blocos.end());
+    intervalos.push_back(std::move(vetor));
+
+    total_instrucoes += instrucoes_intervalo;
+    instrucoes_intervalo = 0;
+    blocos_intervalo.clear();
+}
+
+void PerfiladorBlocos::finalizar() {
+    if (instrucoes_intervalo > 0) fechar_intervalo();
+}
+
+const std::vector<VetorBlocos>& PerfiladorBlocos::get_intervalos() const {
+    return intervalos;
+}
+
+uint64_t PerfiladorBlocos::get_total_instrucoes() const {
+    return total_instrucoes + instrucoes_intervalo;
+}
+
+/**
+ * @brief Escolhe os pontos de simulação.
+ *
+ * Cada vetor é normalizado e projetado em poucas dimensões; o k-means roda para
+ * cada k (com várias inicializações, ficando a de menor distorção) e o BIC de cada
+ * k decide quantos clusters usar. O representante de um cluster é o intervalo mais
+ * próximo do centroide, e seu peso é a fração das instruções que o cluster cobre.
+ */
+Agrupamento agrupar_intervalos(const std::vector<VetorBlocos>& intervalos, const ConfigSimPoint& config) {
+    Agrupamento resultado;
+    const size_t n = intervalos.size();
+    if (n == 0) return resultado;
+
+    const uint32_t dimensoes = std::max<uint32_t>(config.dimensoes, 1);
+    std::vector<Ponto> pontos;
+    std::vector<double> pesos;
+    uint64_t total_instrucoes = 0;
+    pontos.reserve(n);
+    for (const VetorBlocos& vetor : intervalos) {
+        pontos.push_back(projetar(vetor, dimensoes, config.semente));
+        pesos.push_back(static_cast<double>(vetor.instrucoes) / std::max<uint64_t>(config.tamanho_intervalo, 1));
+        total_instrucoes += vetor.instrucoes;
+    }
+
+    const uint32_t maximo_k = static_cast<uint32_t>(std::min<size_t>(std::max<uint32_t>(config.maximo_clusters, 1), n));
+    std::mt19937_64 gerador(config.semente);
+    std::vector<ResultadoKMeans> melhores;
+    for (uint32_t k = 1; k <= maximo_k; ++k) {
+        ResultadoKMeans melhor;
+        melhor.distorcao = std::numeric_limits<double>::max();
+        for (uint32_t tentativa = 0; tentativa < std::max<uint32_t>(config.inicializacoes, 1); ++tentativa) {
+            ResultadoKMeans r = kmeans(pontos, pesos, k, config.iteracoes, gerador);
+            if (r.distorcao < melhor.distorcao) melhor = std::move(r);
+        }
+        resultado.bic.push_back(calcular_bic(melhor, n, k, dimensoes));
+        melhores.push_back(std::move(melhor));
+    }
+
+    // Menor k cujo BIC chega a 'limiar_bic' da faixa observada
+    auto [minimo, maximo] = std::minmax_element(resultado.bic.begin(), resultado.bic.end());
+    double corte = *minimo + config.limiar_bic * (*maximo - *minimo);
+    uint32_t k = 1;
+    while (resultado.bic[k - 1] < corte) ++k;
+    ResultadoKMeans& escolhido = melhores[k - 1];
+
+    resultado.k = k;
+    resultado.cluster_intervalo = escolhido.cluster;
+
+    // Clusters vazios não geram ponto
+    std::vector<double> instrucoes_cluster(k, 0.0);
+    std::vector<size_t> representante(k, n);
+    std::vector<double> menor_distancia(k, std::numeric_limits<double>::max());
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t c = escolhido.cluster[i];
+        instrucoes_cluster[c] += static_cast<double>(intervalos[i].instrucoes);
+        // Intervalos parciais só representam o cluster se não houver outro
+        double d = distancia2(pontos[i], escolhido.centroides[c]);
+        if (intervalos[i].instrucoes < config.tamanho_intervalo) d = std::numeric_limits<double>::max() / 2;
+        if (d < menor_distancia[c]) {
+            menor_distancia[c] = d;
+            representante[c] = i;
+        }
+    }
+    for (uint32_t c = 0; c < k; ++c) {
+        if (representante[c] == n) continue;
+        const VetorBlocos& vetor = intervalos[representante[c]];
+        resultado.pontos.push_back({representante[c], c, vetor.inicio, vetor.instrucoes,
+                                    total_instrucoes ? instrucoes_cluster[c] / total_instrucoes : 0.0});
+    }
+    std::sort(resultado.pontos.begin(), resultado.pontos.end(),
+              [](const PontoSimulacao& a, const PontoSimulacao& b) { return a.inicio < b.inicio; });
+    return resultado;
+}
+
+/**
+ * @brief Estimativa do programa inteiro: CPI e faltas por mil instruções são médias
+ * ponderadas pelos pesos dos pontos; a taxa de faltas é a razão das duas médias
+ * (faltas e acessos por instrução), e não a média das taxas.
+ */
+EstimativaSimPoint estimar_programa(const std::vector<PontoSimulacao>& pontos,
+                                    const std::vector<MedidaDetalhada>& medidas,
+                                    uint64_t instrucoes_programa) {
+    EstimativaSimPoint estimativa;
+    estimativa.instrucoes_programa = instrucoes_programa;
+
+    double peso_total = 0.0;
+    double acessos_por_instrucao = 0.0;
+    double faltas_por_instrucao = 0.0;
+    for (size_t i = 0; i < pontos.size() && i < medidas.size(); ++i) {
+        const MedidaDetalhada& m = medidas[i];
+        estimativa.instrucoes_detalhadas += m.instrucoes;
+        if (m.instrucoes == 0) continue;
+        double peso = pontos[i].peso;
+        double instrucoes = static_cast<double>(m.instrucoes);
+        peso_total += peso;
+        estimativa.cpi_core += peso * m.ciclos_core / instrucoes;
+        estimativa.cpi_ooo += peso * m.ciclos_ooo / instrucoes;
+        acessos_por_instrucao += peso * m.acessos_cache / instrucoes;
+        faltas_por_instrucao += peso * m.faltas_cache / instrucoes;
+    }
+
+    // Renormaliza se algum ponto não pôde ser medido
+    if (peso_total > 0.0) {
+        estimativa.cpi_core /= peso_total;
+        estimativa.cpi_ooo /= peso_total;
+        acessos_por_instrucao /= peso_total;
+        faltas_por_instrucao /= peso_total;
+    }
+    estimativa.faltas_por_mil = faltas_por_instrucao * 1000.0;
+    estimativa.taxa_faltas = acessos_por_instrucao > 0.0 ? faltas_por_instrucao / acessos_por_instrucao : 0.0;
+    return estimativa;
+}
+
+std::string EstimativaSimPoint::formatar() const {
+    std::stringstream ss;
+    ss << "--- Estimativa SimPoint ---\n";
+    ss << "Instrucoes do programa: " << instrucoes_programa << "\n";
+    ss << "Instrucoes detalhadas: " << instrucoes_detalhadas;
+    if (instrucoes_programa) {
+        ss << " (" << std::fixed << std::setprecision(2)
+           << 100.0 * instrucoes_detalhadas / instrucoes_programa << "%)";
+    }
+    ss << "\n" << std::fixed << std::setprecision(4);
+    ss << "CPI (Core em ordem): " << cpi_core << "\n";
+    ss << "CPI (modelo fora de ordem): " << cpi_ooo << "\n";
+    ss << "Faltas do cache por mil instrucoes: " << faltas_por_mil << "\n";
+    ss << "Taxa de faltas do cache: " << 100.0 * taxa_faltas << "%\n";
+    return ss.str();
+}
+
+AmostragemSimPoint::AmostragemSimPoint(const ConfigSimPoint& config) : config(config) {
+    if (this->config.tamanho_intervalo == 0) this->config.tamanho_intervalo = 1;
+}
+
+/**
+ * @brief Executa o programa a partir do estado atual do Core, só com o modelo funcional,
+ * e guarda o estado inicial para a fase detalhada.
+ */
+std::string AmostragemSimPoint::perfilar(Core& core) {
+    if (core.is_finished()) {
+        return "[ERRO] O programa ja terminou; nao ha o que perfilar.";
+    }
+    estado_inicial = core.criar_snapshot();
+    agrupamento = Agrupamento{};
+    medidas.clear();
+
+    const ModoExecucao modo_anterior = core.get_modo();
+    const bool log_anterior = core.log_ligado();
+    core.trocar_modo(ModoExecucao::Funcional);
+    core.definir_log(false);
+    PerfiladorBlocos perfilador(config.tamanho_intervalo, core.get_program_counter());
+    const uint64_t limite = config.limite_instrucoes ? config.limite_instrucoes : UINT64_MAX;
+    for (uint64_t i = 0; i < limite && !core.is_finished(); ++i) {
+        core.step();
+        perfilador.registrar(core.get_ultimo_commit());
+    }
+    perfilador.finalizar();
+    core.trocar_modo(modo_anterior);
+    core.definir_log(log_anterior);
+
+    intervalos = perfilador.get_intervalos();
+    total_instrucoes = perfilador.get_total_instrucoes();
+    perfilado = true;
+    return "";
+}
+
+std::string AmostragemSimPoint::agrupar() {
+    if (!perfilado || intervalos.empty()) {
+        return "[ERRO] Nenhum intervalo perfilado.";
+    }
+    agrupamento = agrupar_intervalos(intervalos, config);
+    medidas.clear();
+    return "";
+}
+
+/**
+ * @brief Simula cada ponto em modo detalhado.
+ *
+ * Um único avanço funcional a partir do estado inicial tira um snapshot
+ * 'aquecimento' instruções antes de cada ponto, passando ao modo Aquecimento
+ * 'aquecimento_cache' instruções antes do snapshot; depois cada ponto é restaurado
+ * e executado em modo detalhado com o modelo fora de ordem. Só as instruções do
+ * intervalo entram na medida. O modo só muda nessas fronteiras e o log do Core
+ * fica desligado durante toda a fase.
+ */
+std::string AmostragemSimPoint::simular_pontos(Core& core, const ConfigOoO& config_ooo) {
+    if (agrupamento.pontos.empty()) {
+        return "[ERRO] Nenhum ponto de simulacao escolhido.";
+    }
+    std::string erro = core.restaurar_snapshot(estado_inicial);
+    if (!erro.empty()) return erro;
+    const ModoExecucao modo_anterior = core.get_modo();
+    const bool log_anterior = core.log_ligado();
+    auto restaurar_core = [&]() {
+        core.trocar_modo(modo_anterior);
+        core.definir_log(log_anterior);
+    };
+    core.definir_log(false);
+
+    std::vector<SnapshotCore> inicios;
+    std::vector<uint64_t> aquecimentos;
+    uint64_t posicao = 0;
+    for (const PontoSimulacao& ponto : agrupamento.pontos) {
+        uint64_t aquecimento = std::min(config.aquecimento, ponto.inicio);
+        uint64_t alvo = ponto.inicio - aquecimento;
+        uint64_t inicio_aquecimento = alvo - std::min(config.aquecimento_cache, alvo);
+        if (posicao < inicio_aquecimento) {
+            core.trocar_modo(ModoExecucao::Funcional);
+            for (; posicao < inicio_aquecimento && !core.is_finished(); ++posicao) {
+                core.step();
+            }
+        }
+        core.trocar_modo(ModoExecucao::Aquecimento);
+        for (; posicao < alvo && !core.is_finished(); ++posicao) {
+            core.step();
+        }
+        if (posicao < alvo) {
+            restaurar_core();
+            return "[ERRO] O programa terminou antes do ponto de simulacao (instrucao " +
+                   std::to_string(ponto.inicio) + "): a execucao nao e deterministica.";
+        }
+        inicios.push_back(core.criar_snapshot());
+        aquecimentos.push_back(aquecimento);
+    }
+
+    core.trocar_modo(ModoExecucao::Detalhado);
+    medidas.clear();
+    for (size_t i = 0; i < inicios.size(); ++i) {
+        erro = core.restaurar_snapshot(inicios[i]);
+        if (!erro.empty()) {
+            restaurar_core();
+            return erro;
+        }
+
+        ModeloOoO modelo(config_ooo);
+        for (uint64_t j = 0; j < aquecimentos[i] && !core.is_finished(); ++j) {
+            core.step();
+            modelo.consumir(core.get_ultimo_commit());
+        }
+
+        RelatorioOoO antes = modelo.relatorio();
+        ContadoresCore contadores_antes = core.get_contadores();
+        EstatisticasCache cache_antes = core.get_estatisticas_cache();
+
+        MedidaDetalhada medida;
+        for (uint64_t j = 0; j < agrupamento.pontos[i].instrucoes && !core.is_finished(); ++j) {
+            core.step();
+            modelo.consumir(core.get_ultimo_commit());
+            ++medida.instrucoes;
+        }
+
+        const EstatisticasCache& cache_depois = core.get_estatisticas_cache();
+        medida.ciclos_core = core.get_contadores().ciclos - contadores_antes.ciclos;
+        medida.ciclos_ooo = modelo.relatorio().ciclos - antes.ciclos;
+        medida.acessos_cache = (cache_depois.leituras + cache_depois.escritas) -
+                               (cache_antes.leituras + cache_antes.escritas);
+        medida.faltas_cache = (cache_depois.faltas_leitura + cache_depois.faltas_escrita) -
+                              (cache_antes.faltas_leitura + cache_antes.faltas_escrita);
+        medidas.push_back(medida);
+    }
+    restaurar_core();
+    return "";
+}
+
+const std::vector<VetorBlocos>& AmostragemSimPoint::get_intervalos() const {
+    return intervalos;
+}
+
+const Agrupamento& AmostragemSimPoint::get_agrupamento() const {
+    return agrupamento;
+}
+
+const std::vector<MedidaDetalhada>& AmostragemSimPoint::get_medidas() const {
+    return medidas;
+}
+
+EstimativaSimPoint AmostragemSimPoint::estimar() const {
+    return estimar_programa(agrupamento.pontos, medidas, total_instrucoes);
+}
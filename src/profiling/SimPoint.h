@@ -0,0 +1,198 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_SIMPOINT_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_SIMPOINT_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/Core.h"
+#include "timing/ModeloOoO.h"
+
+/**
+ * @struct ConfigSimPoint
+ * @brief Parâmetros da simulação amostrada no estilo SimPoint.
+ */
+struct ConfigSimPoint {
+    // Instruções por intervalo (cada intervalo gera um vetor de blocos básicos)
+    uint64_t tamanho_intervalo = 100000;
+    // Limite de instruções do perfil funcional (0 = até o programa terminar)
+    uint64_t limite_instrucoes = 0;
+
+    // Agrupamento: k-means para k = 1..maximo_clusters sobre os vetores projetados em
+    // 'dimensoes' dimensões; o k escolhido é o menor cujo BIC atinge 'limiar_bic' da
+    // faixa entre o pior e o melhor BIC
+    uint32_t maximo_clusters = 10;
+    uint32_t dimensoes = 15;
+    uint32_t inicializacoes = 5;
+    uint32_t iteracoes = 100;
+    double limiar_bic = 0.9;
+    uint64_t semente = 1;
+
+    // O avanço até cada ponto é funcional (sem cache); as últimas 'aquecimento_cache'
+    // instruções antes dele rodam em modo Aquecimento, para o cache chegar aquecido
+    uint64_t aquecimento_cache = 200000;
+    // Instruções executadas em modo detalhado antes de cada ponto, sem entrar na medida,
+    // para aquecer o modelo de timing
+    uint64_t aquecimento = 10000;
+};
+
+/**
+ * @struct VetorBlocos
+ * @brief Vetor de blocos básicos (BBV) de um intervalo: instruções executadas por bloco.
+ */
+struct VetorBlocos {
+    // Posição do intervalo, em instruções desde o início do perfil
+    uint64_t inicio = 0;
+    uint64_t instrucoes = 0;
+    // (endereço do início do bloco, instruções executadas nele), ordenado por endereço
+    std::vector<std::pair<uint32_t, uint32_t>> blocos;
+};
+
+/**
+ * @class PerfiladorBlocos
+ * @brief Monta os vetores de blocos básicos a partir do fluxo de commits.
+ *
+ * Deve ser chamado após cada Core::step(). Um bloco termina na instrução
+ * cujo próximo PC não é o sequencial (desvio tomado, salto ou ecall).
+ */
+class PerfiladorBlocos {
+public:
+    explicit PerfiladorBlocos(uint64_t tamanho_intervalo, uint32_t pc_inicial = 0);
+
+    void registrar(const RegistroCommit& commit) {
+        ++instrucoes_bloco;
+        if (commit.proximo_pc != commit.pc + 4) {
+            fechar_bloco(commit.proximo_pc);
+        }
+        if (++instrucoes_intervalo == tamanho_intervalo) {
+            fechar_intervalo();
+        }
+    }
+
+    // Fecha o intervalo parcial do fim da execução
+    void finalizar();
+
+    const std::vector<VetorBlocos>& get_intervalos() const;
+    uint64_t get_total_instrucoes() const;
+
+private:
+    void fechar_bloco(uint32_t proximo_inicio);
+    void fechar_intervalo();
+
+    uint64_t tamanho_intervalo;
+    uint64_t instrucoes_intervalo = 0;
+    uint64_t total_instrucoes = 0;
+
+    uint32_t inicio_bloco;
+    uint32_t instrucoes_bloco = 0;
+    std::unordered_map<uint32_t, uint32_t> blocos_intervalo;
+
+    std::vector<VetorBlocos> intervalos;
+};
+
+/**
+ * @struct PontoSimulacao
+ * @brief Intervalo que representa um cluster; o peso é a fração das instruções do programa no cluster.
+ */
+struct PontoSimulacao {
+    size_t intervalo = 0;
+    uint32_t cluster = 0;
+    uint64_t inicio = 0;
+    uint64_t instrucoes = 0;
+    double peso = 0.0;
+};
+
+/**
+ * @struct Agrupamento
+ * @brief Resultado do agrupamento dos intervalos.
+ */
+struct Agrupamento {
+    uint32_t k = 0;
+    // Cluster de cada intervalo
+    std::vector<uint32_t> cluster_intervalo;
+    // BIC de cada k testado (índice 0 = k 1)
+    std::vector<double> bic;
+    // Um ponto por cluster, em ordem de início
+    std::vector<PontoSimulacao> pontos;
+};
+
+// Agrupa os intervalos e escolhe, em cada cluster, o intervalo mais próximo do centroide
+Agrupamento agrupar_intervalos(const std::vector<VetorBlocos>& intervalos, const ConfigSimPoint& config);
+
+/**
+ * @struct MedidaDetalhada
+ * @brief O que o modo detalhado mediu em um ponto (deltas dentro do intervalo).
+ */
+struct MedidaDetalhada {
+    uint64_t instrucoes = 0;
+    // Ciclos do Core (em ordem, com as paradas do cache) e do modelo fora de ordem
+    uint64_t ciclos_core = 0;
+    uint64_t ciclos_ooo = 0;
+    uint64_t acessos_cache = 0;
+    uint64_t faltas_cache = 0;
+};
+
+/**
+ * @struct EstimativaSimPoint
+ * @brief Métricas do programa inteiro estimadas pela média ponderada dos pontos.
+ */
+struct EstimativaSimPoint {
+    uint64_t instrucoes_programa = 0;
+    uint64_t instrucoes_detalhadas = 0;
+    double cpi_core = 0.0;
+    double cpi_ooo = 0.0;
+    double faltas_por_mil = 0.0;
+    double taxa_faltas = 0.0;
+
+    std::string formatar() const;
+};
+
+// Combina as medidas (uma por ponto, na mesma ordem) com os pesos dos pontos
+EstimativaSimPoint estimar_programa(const std::vector<PontoSimulacao>& pontos,
+                                    const std::vector<MedidaDetalhada>& medidas,
+                                    uint64_t instrucoes_programa);
+
+/**
+ * @class AmostragemSimPoint
+ * @brief Perfil funcional, escolha dos pontos e simulação detalhada só nos pontos.
+ *
+ * 1. perfilar(): executa o programa em modo funcional coletando os vetores de blocos.
+ * 2. agrupar(): escolhe os pontos de simulação.
+ * 3. simular_pontos(): volta ao estado inicial, avança em modo funcional (aquecendo o
+ *    cache pouco antes de cada ponto) tirando um snapshot antes de cada ponto e executa
+ *    cada ponto em modo detalhado, com o modelo de timing.
+ *
+ * O Core volta ao modo em que estava ao fim de cada fase, sem mudar o modo do reset
+ * (definir_modo()). O log de step() fica desligado durante as fases.
+ *
+ * O estado inicial é um SnapshotCore: dispositivos e o estado das syscalls do host
+ * não voltam com ele, então o programa não deve depender deles entre os pontos.
+ */
+class AmostragemSimPoint {
+public:
+    explicit AmostragemSimPoint(const ConfigSimPoint& config = ConfigSimPoint{});
+
+    // Retornam uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string perfilar(Core& core);
+    std::string agrupar();
+    std::string simular_pontos(Core& core, const ConfigOoO& config_ooo = ConfigOoO{});
+
+    const std::vector<VetorBlocos>& get_intervalos() const;
+    const Agrupamento& get_agrupamento() const;
+    const std::vector<MedidaDetalhada>& get_medidas() const;
+    EstimativaSimPoint estimar() const;
+
+private:
+    ConfigSimPoint config;
+    SnapshotCore estado_inicial;
+    bool perfilado = false;
+    uint64_t total_instrucoes = 0;
+
+    std::vector<VetorBlocos> intervalos;
+    Agrupamento agrupamento;
+    std::vector<MedidaDetalhada> medidas;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_SIMPOINT_H
@@ -0,0 +1,116 @@
+#include "TabelaSimbolos.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    std::string formatar_endereco(uint32_t endereco) {
+        std::stringstream ss;
+        ss << "0x" << std::hex << endereco;
+        return ss.str();
+    }
+}
+
+std::string TabelaSimbolos::carregar_simbolos(const std::string &caminho) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir a tabela de simbolos: " + caminho;
+    }
+
+    std::string linha_texto;
+    while (std::getline(arquivo, linha_texto)) {
+        std::istringstream campos(linha_texto);
+        std::string endereco_texto, tipo, nome;
+        if (!(campos >> endereco_texto >> tipo)) continue;
+
+        // Aceita tanto "endereco tipo nome" (nm) quanto "endereco nome"
+        if (!(campos >> nome)) {
+            nome = tipo;
+            tipo = "T";
+        }
+        // Apenas símbolos de código (texto) interessam ao profiler
+        if (tipo != "T" && tipo != "t" && tipo != "W" && tipo != "w") continue;
+
+        try {
+            auto endereco = static_cast<uint32_t>(std::stoul(endereco_texto, nullptr, 16));
+            simbolos.push_back({endereco, nome});
+        } catch (const std::exception&) {
+            // Linha mal formada (cabeçalho, símbolo indefinido, etc.)
+        }
+    }
+
+    ordenar(simbolos);
+    return "";
+}
+
+std::string TabelaSimbolos::carregar_linhas(const std::string &caminho) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir a tabela de linhas: " + caminho;
+    }
+
+    std::string linha_texto;
+    while (std::getline(arquivo, linha_texto)) {
+        std::istringstream campos(linha_texto);
+        std::string endereco_texto, local;
+        if (!(campos >> endereco_texto >> local)) continue;
+
+        try {
+            auto endereco = static_cast<uint32_t>(std::stoul(endereco_texto, nullptr, 16));
+            linhas.push_back({endereco, local});
+        } catch (const std::exception&) {
+        }
+    }
+
+    ordenar(linhas);
+    return "";
+}
+
+void TabelaSimbolos::adicionar_simbolo(uint32_t endereco, const std::string &nome) {
+    simbolos.push_back({endereco, nome});
+    ordenar(simbolos);
+}
+
+void TabelaSimbolos::adicionar_linha(uint32_t endereco, const std::string &local) {
+    linhas.push_back({endereco, local});
+    ordenar(linhas);
+}
+
+bool TabelaSimbolos::vazia() const {
+    return simbolos.empty();
+}
+
+void TabelaSimbolos::ordenar(std::vector<Entrada> &entradas) {
+    std::stable_sort(entradas.begin(), entradas.end(), [](const Entrada& a, const Entrada& b) {
+        return a.endereco < b.endereco;
+    });
+}
+
+/**
+ * @brief Busca binária pela última entrada com endereço <= 'endereco'.
+ */
+const TabelaSimbolos::Entrada* TabelaSimbolos::procurar(const std::vector<Entrada> &entradas, uint32_t endereco) {
+    auto it = std::upper_bound(entradas.begin(), entradas.end(), endereco,
+                               [](uint32_t valor, const Entrada& e) { return valor < e.endereco; });
+    if (it == entradas.begin()) return nullptr;
+    return &*std::prev(it);
+}
+
+std::string TabelaSimbolos::funcao(uint32_t endereco) const {
+    const Entrada* e = procurar(simbolos, endereco);
+    return e ? e->nome : formatar_endereco(endereco);
+}
+
+std::string TabelaSimbolos::linha(uint32_t endereco) const {
+    if (const Entrada* e = procurar(linhas, endereco)) {
+        return e->nome;
+    }
+
+    const Entrada* s = procurar(simbolos, endereco);
+    if (!s) return formatar_endereco(endereco);
+
+    std::stringstream ss;
+    ss << s->nome << "+0x" << std::hex << (endereco - s->endereco);
+    return ss.str();
+}
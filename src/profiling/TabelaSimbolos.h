@@ -0,0 +1,45 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_TABELASIMBOLOS_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_TABELASIMBOLOS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class TabelaSimbolos
+ * @brief Traduz endereços do programa carregado em nomes de função e linhas de código.
+ *
+ * Os símbolos são lidos no formato de saída do 'nm' ("00000010 T main"),
+ * e a tabela de linhas opcional no formato "endereco arquivo:linha"
+ * (uma linha por endereço inicial, como extraído de 'objdump -dl').
+ */
+class TabelaSimbolos {
+public:
+    // Retorna uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string carregar_simbolos(const std::string& caminho);
+    std::string carregar_linhas(const std::string& caminho);
+
+    void adicionar_simbolo(uint32_t endereco, const std::string& nome);
+    void adicionar_linha(uint32_t endereco, const std::string& local);
+
+    bool vazia() const;
+
+    // Nome da função que contém 'endereco' (ou "0x...." se não houver símbolo)
+    std::string funcao(uint32_t endereco) const;
+    // "arquivo:linha" que contém 'endereco', ou "funcao+0xdesloc" sem tabela de linhas
+    std::string linha(uint32_t endereco) const;
+
+private:
+    struct Entrada {
+        uint32_t endereco;
+        std::string nome;
+    };
+
+    static const Entrada* procurar(const std::vector<Entrada>& entradas, uint32_t endereco);
+    static void ordenar(std::vector<Entrada>& entradas);
+
+    std::vector<Entrada> simbolos;
+    std::vector<Entrada> linhas;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_TABELASIMBOLOS_H
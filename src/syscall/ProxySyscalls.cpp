@@ -0,0 +1,285 @@
+#include "ProxySyscalls.h"
+
+#include "core/Core.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Maior caminho aceito em open/openat
+    constexpr uint32_t TAMANHO_MAXIMO_CAMINHO = 4096;
+    // Maior bloco transferido em uma única chamada read/write
+    constexpr uint32_t TAMANHO_MAXIMO_TRANSFERENCIA = 1u << 20;
+
+    void escrever_no_host(int descritor, const char* dados, size_t tamanho) {
+        while (tamanho > 0) {
+            auto escrito = ::write(descritor, dados, static_cast<unsigned>(tamanho));
+            if (escrito <= 0) return;
+            dados += escrito;
+            tamanho -= static_cast<size_t>(escrito);
+        }
+    }
+
+    // Traduz as flags de open do guest para as do host
+    int flags_host(uint32_t flags) {
+        int resultado = 0;
+        switch (flags & syscalls::ABERTURA_MODO_ACESSO) {
+            case 0: resultado = O_RDONLY;
+                break;
+            case 1: resultado = O_WRONLY;
+                break;
+            default: resultado = O_RDWR;
+                break;
+        }
+        if (flags & syscalls::ABERTURA_CRIAR) resultado |= O_CREAT;
+        if (flags & syscalls::ABERTURA_EXCLUSIVA) resultado |= O_EXCL;
+        if (flags & syscalls::ABERTURA_TRUNCAR) resultado |= O_TRUNC;
+        if (flags & syscalls::ABERTURA_ANEXAR) resultado |= O_APPEND;
+#ifdef _WIN32
+        resultado |= O_BINARY;
+#endif
+        return resultado;
+    }
+}
+
+ProxySyscalls::ProxySyscalls()
+    : destino_saida([](int descritor, const char* dados, size_t tamanho) {
+          escrever_no_host(descritor, dados, tamanho);
+      }) {
+    buffer_saida.reserve(TAMANHO_BUFFER_SAIDA);
+}
+
+ProxySyscalls::~ProxySyscalls() {
+    reset();
+}
+
+void ProxySyscalls::definir_destino_saida(DestinoSaida destino) {
+    descarregar();
+    destino_saida = std::move(destino);
+}
+
+void ProxySyscalls::definir_cancelamento(const std::atomic<bool> *sinal) {
+    cancelamento = sinal;
+}
+
+bool ProxySyscalls::consumir_interrupcao() {
+    bool resultado = interrompida;
+    interrompida = false;
+    return resultado;
+}
+
+bool ProxySyscalls::esperar_entrada() const {
+#ifndef _WIN32
+    pollfd descritor{0, POLLIN, 0};
+    while (!cancelamento->load(std::memory_order_relaxed)) {
+        int pronto = ::poll(&descritor, 1, ESPERA_ENTRADA_MS);
+        // Dados, fim do arquivo ou erro: o read() trata
+        if (pronto > 0 || (pronto < 0 && errno != EINTR)) return true;
+    }
+    return false;
+#else
+    return true;
+#endif
+}
+
+void ProxySyscalls::trocar_descritor_buffer(int descritor) {
+    if (descritor != descritor_buffer) {
+        descarregar();
+        descritor_buffer = descritor;
+    }
+}
+
+void ProxySyscalls::escrever_saida(int descritor, const char *dados, size_t tamanho) {
+    trocar_descritor_buffer(descritor);
+    buffer_saida.append(dados, tamanho);
+    if (buffer_saida.size() >= TAMANHO_BUFFER_SAIDA) {
+        descarregar();
+    }
+}
+
+void ProxySyscalls::descarregar() {
+    if (buffer_saida.empty()) return;
+    destino_saida(descritor_buffer, buffer_saida.data(), buffer_saida.size());
+    buffer_saida.clear();
+}
+
+void ProxySyscalls::reset() {
+    descarregar();
+    for (const auto& [descritor, host] : arquivos) {
+        ::close(host);
+    }
+    arquivos.clear();
+    proximo_descritor = 3;
+    brk_atual = 0;
+}
+
+const char* ProxySyscalls::nome_syscall(uint32_t numero) {
+    switch (numero) {
+        case syscalls::CLOSE: return "close";
+        case syscalls::OPENAT: return "openat";
+        case syscalls::READ: return "read";
+        case syscalls::WRITE: return "write";
+        case syscalls::EXIT: return "exit";
+        case syscalls::EXIT_GROUP: return "exit_group";
+        case syscalls::GETTIMEOFDAY: return "gettimeofday";
+        case syscalls::BRK: return "brk";
+        case syscalls::OPEN: return "open";
+        default: return "desconhecida";
+    }
+}
+
+int32_t ProxySyscalls::executar(Core &core, uint32_t numero, const std::array<uint32_t, 6> &argumentos) {
+    const auto& a = argumentos;
+    switch (numero) {
+        case syscalls::WRITE:
+            return sys_write(core, static_cast<int32_t>(a[0]), a[1], a[2]);
+        case syscalls::READ:
+            return sys_read(core, static_cast<int32_t>(a[0]), a[1], a[2]);
+        case syscalls::OPENAT:
+            if (static_cast<int32_t>(a[0]) != syscalls::DIRETORIO_ATUAL) return -EBADF;
+            return sys_open(core, a[1], a[2], a[3]);
+        case syscalls::OPEN:
+            return sys_open(core, a[0], a[1], a[2]);
+        case syscalls::CLOSE:
+            return sys_close(static_cast<int32_t>(a[0]));
+        case syscalls::BRK:
+            return sys_brk(core, a[0]);
+        case syscalls::GETTIMEOFDAY:
+            return sys_gettimeofday(core, a[0]);
+        case syscalls::EXIT:
+        case syscalls::EXIT_GROUP:
+            descarregar();
+            core.encerrar(static_cast<int32_t>(a[0]));
+            return 0;
+        default:
+            return -ENOSYS;
+    }
+}
+
+int ProxySyscalls::descritor_host(int32_t descritor) const {
+    if (descritor >= 0 && descritor <= 2) return descritor;
+    auto it = arquivos.find(descritor);
+    return it == arquivos.end() ? -1 : it->second;
+}
+
+int32_t ProxySyscalls::sys_write(Core &core, int32_t descritor, uint32_t endereco, uint32_t tamanho) {
+    if (descritor == 0 || descritor_host(descritor) < 0) return -EBADF;
+    tamanho = std::min(tamanho, TAMANHO_MAXIMO_TRANSFERENCIA);
+
+    if (descritor == 1 || descritor == 2) {
+        // Troca de stdout para stderr (ou vice-versa): entrega antes o que é do outro descritor
+        trocar_descritor_buffer(descritor);
+        size_t inicio = buffer_saida.size();
+        buffer_saida.resize(inicio + tamanho);
+        if (!core.ler_bloco_memoria(endereco, reinterpret_cast<uint8_t*>(buffer_saida.data() + inicio), tamanho)) {
+            buffer_saida.resize(inicio);
+            return -EFAULT;
+        }
+        if (buffer_saida.size() >= TAMANHO_BUFFER_SAIDA) {
+            descarregar();
+        }
+        return static_cast<int32_t>(tamanho);
+    }
+
+    std::vector<uint8_t> dados(tamanho);
+    if (!core.ler_bloco_memoria(endereco, dados.data(), tamanho)) return -EFAULT;
+    auto escrito = ::write(descritor_host(descritor), dados.data(), tamanho);
+    return escrito < 0 ? -errno : static_cast<int32_t>(escrito);
+}
+
+int32_t ProxySyscalls::sys_read(Core &core, int32_t descritor, uint32_t endereco, uint32_t tamanho) {
+    int host = descritor_host(descritor);
+    if (host < 0 || descritor == 1 || descritor == 2) return -EBADF;
+    tamanho = std::min(tamanho, TAMANHO_MAXIMO_TRANSFERENCIA);
+
+    // Um prompt impresso antes de uma leitura precisa aparecer antes de bloquear
+    descarregar();
+
+    if (host == 0 && cancelamento && !esperar_entrada()) {
+        interrompida = true;
+        return -EINTR;
+    }
+
+    std::vector<uint8_t> dados(tamanho);
+    auto lido = ::read(host, dados.data(), tamanho);
+    if (lido < 0) return -errno;
+    if (!core.escrever_bloco_memoria(endereco, dados.data(), static_cast<uint32_t>(lido))) return -EFAULT;
+    return static_cast<int32_t>(lido);
+}
+
+int32_t ProxySyscalls::sys_open(Core &core, uint32_t endereco_caminho, uint32_t flags, uint32_t modo) {
+    std::string caminho;
+    for (uint32_t i = 0;; ++i) {
+        if (i >= TAMANHO_MAXIMO_CAMINHO) return -ENAMETOOLONG;
+        uint8_t c = 0;
+        if (!core.ler_bloco_memoria(endereco_caminho + i, &c, 1)) return -EFAULT;
+        if (c == 0) break;
+        caminho.push_back(static_cast<char>(c));
+    }
+
+    int host = ::open(caminho.c_str(), flags_host(flags), static_cast<int>(modo));
+    if (host < 0) return -errno;
+
+    int32_t descritor = proximo_descritor++;
+    arquivos[descritor] = host;
+    return descritor;
+}
+
+int32_t ProxySyscalls::sys_close(int32_t descritor) {
+    // stdin/stdout/stderr pertencem ao host e nunca são fechados de verdade
+    if (descritor >= 0 && descritor <= 2) {
+        descarregar();
+        return 0;
+    }
+    auto it = arquivos.find(descritor);
+    if (it == arquivos.end()) return -EBADF;
+    int resultado = ::close(it->second);
+    arquivos.erase(it);
+    return resultado < 0 ? -errno : 0;
+}
+
+/**
+ * @brief brk(0) retorna o fim atual do heap; qualquer outro valor tenta movê-lo.
+ *
+ * O heap começa no primeiro endereço alinhado a 16 bytes depois do programa e
+ * não pode passar da pilha (sp). Como no Linux, uma falha retorna o fim atual.
+ */
+int32_t ProxySyscalls::sys_brk(Core &core, uint32_t endereco) {
+    uint32_t inicio = (core.get_fim_programa() + 15) & ~15u;
+    if (brk_atual == 0) brk_atual = inicio;
+
+    uint32_t limite = core.get_registradores()[2];
+    if (limite == 0) limite = static_cast<uint32_t>(core.get_tamanho_memoria());
+    if (endereco >= inicio && endereco <= limite) {
+        brk_atual = endereco;
+    }
+    return static_cast<int32_t>(brk_atual);
+}
+
+/**
+ * @brief Preenche struct timeval { int64_t tv_sec; int32_t tv_usec; } com a hora do host.
+ */
+int32_t ProxySyscalls::sys_gettimeofday(Core &core, uint32_t endereco) {
+    if (endereco == 0) return 0;
+
+    auto agora = std::chrono::system_clock::now().time_since_epoch();
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(agora).count();
+    auto segundos = static_cast<uint64_t>(micros / 1000000);
+    auto resto = static_cast<uint32_t>(micros % 1000000);
+
+    std::array<uint8_t, 16> timeval{};
+    for (uint32_t i = 0; i < 8; ++i) timeval[i] = static_cast<uint8_t>(segundos >> (8 * i));
+    for (uint32_t i = 0; i < 4; ++i) timeval[8 + i] = static_cast<uint8_t>(resto >> (8 * i));
+
+    return core.escrever_bloco_memoria(endereco, timeval.data(), timeval.size()) ? 0 : -EFAULT;
+}
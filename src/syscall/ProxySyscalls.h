@@ -0,0 +1,114 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_PROXYSYSCALLS_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_PROXYSYSCALLS_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+class Core;
+
+// Números das chamadas de sistema (ABI Linux/newlib para RISC-V)
+namespace syscalls {
+    constexpr uint32_t CLOSE = 57;
+    constexpr uint32_t OPENAT = 56;
+    constexpr uint32_t READ = 63;
+    constexpr uint32_t WRITE = 64;
+    constexpr uint32_t EXIT = 93;
+    constexpr uint32_t EXIT_GROUP = 94;
+    constexpr uint32_t GETTIMEOFDAY = 169;
+    constexpr uint32_t BRK = 214;
+    constexpr uint32_t OPEN = 1024;
+
+    // Valores usados pelo guest (asm-generic do Linux); os do host podem ser outros
+    constexpr int32_t DIRETORIO_ATUAL = -100;        // AT_FDCWD
+    constexpr uint32_t ABERTURA_MODO_ACESSO = 0x3;   // O_ACCMODE
+    constexpr uint32_t ABERTURA_CRIAR = 0x40;        // O_CREAT
+    constexpr uint32_t ABERTURA_EXCLUSIVA = 0x80;    // O_EXCL
+    constexpr uint32_t ABERTURA_TRUNCAR = 0x200;     // O_TRUNC
+    constexpr uint32_t ABERTURA_ANEXAR = 0x400;      // O_APPEND
+}
+
+/**
+ * @class ProxySyscalls
+ * @brief Emula as chamadas de sistema feitas com ECALL repassando-as ao sistema operacional do host.
+ *
+ * O número da chamada vem em a7 e os argumentos em a0..a5; o resultado volta
+ * em a0, com erros como -errno. A saída em stdout/stderr é acumulada em um
+ * buffer e entregue ao destino em blocos (ao encher, antes de um read, no
+ * close e no exit), para que programas que imprimem muito não paguem uma
+ * chamada ao host por caractere.
+ */
+class ProxySyscalls {
+public:
+    // Recebe o descritor do guest (1 ou 2) e um bloco de saída
+    using DestinoSaida = std::function<void(int descritor, const char* dados, size_t tamanho)>;
+
+    static constexpr size_t TAMANHO_BUFFER_SAIDA = 8192;
+    // Fatia de espera por entrada em stdin entre duas consultas ao pedido de cancelamento
+    static constexpr int ESPERA_ENTRADA_MS = 50;
+
+    ProxySyscalls();
+    ~ProxySyscalls();
+
+    ProxySyscalls(const ProxySyscalls&) = delete;
+    ProxySyscalls& operator=(const ProxySyscalls&) = delete;
+
+    // Executa a chamada 'numero' e retorna o valor que deve ir para a0
+    int32_t executar(Core& core, uint32_t numero, const std::array<uint32_t, 6>& argumentos);
+
+    // Acumula saída do guest para stdout (1) ou stderr (2) fora de um write (ex: a UART)
+    void escrever_saida(int descritor, const char* dados, size_t tamanho);
+    // Entrega ao destino o que estiver acumulado no buffer de saída
+    void descarregar();
+
+    // Descarrega a saída, fecha os arquivos abertos pelo guest e reinicia o brk
+    void reset();
+
+    // Troca o destino de stdout/stderr do guest (padrão: stdout/stderr do host)
+    void definir_destino_saida(DestinoSaida destino);
+
+    // Com um sinal definido, um read de stdin espera a entrada em fatias e desiste quando o
+    // sinal fica true: a chamada é marcada como interrompida e deve ser refeita depois.
+    // Sem sinal (padrão), o read bloqueia como no host. No Windows, sempre bloqueia.
+    void definir_cancelamento(const std::atomic<bool>* sinal);
+    // true (uma vez) se a última chamada foi interrompida pelo cancelamento
+    bool consumir_interrupcao();
+
+    static const char* nome_syscall(uint32_t numero);
+
+private:
+    int32_t sys_write(Core& core, int32_t descritor, uint32_t endereco, uint32_t tamanho);
+    int32_t sys_read(Core& core, int32_t descritor, uint32_t endereco, uint32_t tamanho);
+    int32_t sys_open(Core& core, uint32_t endereco_caminho, uint32_t flags, uint32_t modo);
+    int32_t sys_close(int32_t descritor);
+    int32_t sys_brk(Core& core, uint32_t endereco);
+    int32_t sys_gettimeofday(Core& core, uint32_t endereco);
+
+    // Entrega o buffer se ele pertence ao outro descritor de saída, e o passa a 'descritor'
+    void trocar_descritor_buffer(int descritor);
+    // Converte um descritor do guest no descritor do host (-1 se não existe)
+    int descritor_host(int32_t descritor) const;
+    // Espera stdin ter algo para ler; false se o cancelamento chegou antes
+    bool esperar_entrada() const;
+
+    DestinoSaida destino_saida;
+    std::string buffer_saida;
+    // Descritor do guest ao qual o conteúdo de buffer_saida pertence
+    int descritor_buffer = 1;
+
+    // Arquivos abertos pelo guest: descritor do guest -> descritor do host
+    std::unordered_map<int32_t, int> arquivos;
+    int32_t proximo_descritor = 3;
+
+    // Fim atual do heap; 0 até a primeira chamada brk após o reset
+    uint32_t brk_atual = 0;
+
+    const std::atomic<bool>* cancelamento = nullptr;
+    bool interrompida = false;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_PROXYSYSCALLS_H
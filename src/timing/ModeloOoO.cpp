@@ -0,0 +1,306 @@
+#include "ModeloOoO.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "core/Instruction.h"
+
+namespace {
+    // Tamanho inicial da janela circular de ciclos usada para limitar as emissões por ciclo
+    constexpr size_t TAMANHO_CALENDARIO = 4096;
+
+    const char* nome_classe(size_t classe) {
+        static const char* nomes[] = {"ALU", "MUL", "DIV", "LOAD", "STORE", "DESVIO"};
+        return nomes[classe];
+    }
+
+    const char* nome_causa(size_t causa) {
+        static const char* nomes[] = {
+            "ROB cheio", "Estacoes de reserva cheias", "LSQ cheia",
+            "Unidade funcional ocupada", "Largura de issue", "Largura de commit"
+        };
+        return nomes[causa];
+    }
+
+    void formatar_histograma(std::ostream& os, const char* titulo, const std::vector<uint64_t>& hist) {
+        uint64_t total = 0;
+        uint64_t soma = 0;
+        for (size_t i = 0; i < hist.size(); ++i) {
+            total += hist[i];
+            soma += hist[i] * i;
+        }
+        os << titulo << " (media " << std::fixed << std::setprecision(2)
+           << (total ? static_cast<double>(soma) / total : 0.0) << ")\n";
+        if (total == 0) return;
+
+        // Agrupa em até 8 faixas para manter o relatório legível
+        size_t faixa = std::max<size_t>(1, (hist.size() + 7) / 8);
+        for (size_t inicio = 0; inicio < hist.size(); inicio += faixa) {
+            size_t fim = std::min(hist.size(), inicio + faixa);
+            uint64_t contagem = 0;
+            for (size_t i = inicio; i < fim; ++i) contagem += hist[i];
+            double pct = 100.0 * contagem / total;
+            os << "  [" << std::setw(3) << inicio << "-" << std::setw(3) << (fim - 1) << "] "
+               << std::setw(6) << std::setprecision(2) << pct << "% "
+               << std::string(static_cast<size_t>(pct / 2), '#') << "\n";
+        }
+    }
+}
+
+ClasseInstrucao classificar_instrucao(uint32_t instrucao) {
+    Instruction inst(instrucao);
+    switch (inst.opcode()) {
+        case 0x03:
+        case 0x07: return ClasseInstrucao::Load;
+        case 0x23:
+        case 0x27: return ClasseInstrucao::Store;
+        case 0x63:
+        case 0x6F:
+        case 0x67: return ClasseInstrucao::Desvio;
+        case 0x33:
+            if (inst.funct7() == 0x01) {
+                return inst.funct3() < 0x4 ? ClasseInstrucao::Mul : ClasseInstrucao::Div;
+            }
+            return ClasseInstrucao::Alu;
+        default: return ClasseInstrucao::Alu;
+    }
+}
+
+ModeloOoO::ModeloOoO(const ConfigOoO& config) : config(config) {
+    reset();
+}
+
+void ModeloOoO::reset() {
+    ciclo_fetch = 0;
+    buscadas_no_ciclo = 0;
+    ultimo_despacho = 0;
+    despachos_no_ciclo = 0;
+    ultimo_commit = 0;
+    commits_no_ciclo = 0;
+
+    rob.clear();
+    lsq.clear();
+    estacoes = {};
+    registrador_pronto.fill(0);
+    store_pronto.clear();
+
+    for (size_t c = 0; c < NUM_CLASSES_INSTRUCAO; ++c) {
+        unidade_livre[c].assign(std::max<uint32_t>(1, config.unidades[c].quantidade), 0);
+    }
+    calendario.assign(TAMANHO_CALENDARIO, SlotCalendario{});
+
+    acumulado = RelatorioOoO{};
+    acumulado.ocupacao_rob.assign(config.tamanho_rob + 1, 0);
+    acumulado.ocupacao_estacoes.assign(config.estacoes_reserva + 1, 0);
+    acumulado.ocupacao_lsq.assign(config.tamanho_lsq + 1, 0);
+}
+
+/**
+ * @brief Encontra o primeiro ciclo >= 'ciclo' com largura de issue disponível
+ * e reserva uma emissão nele.
+ *
+ * Uma posição do calendário só pode ser reaproveitada se o ciclo que ela guarda já
+ * passou do último despacho (nenhuma instrução futura pode emitir nele); caso
+ * contrário o calendário é ampliado.
+ */
+uint64_t ModeloOoO::reservar_emissao(uint64_t ciclo) {
+    while (true) {
+        SlotCalendario& slot = calendario[ciclo & (calendario.size() - 1)];
+        if (slot.ciclo != ciclo) {
+            if (slot.ciclo != UINT64_MAX && slot.ciclo > ultimo_despacho) {
+                ampliar_calendario();
+                continue;
+            }
+            slot.ciclo = ciclo;
+            slot.emissoes = 0;
+        }
+        if (slot.emissoes < config.largura_issue) {
+            ++slot.emissoes;
+            return ciclo;
+        }
+        ++ciclo;
+    }
+}
+
+void ModeloOoO::ampliar_calendario() {
+    std::vector<SlotCalendario> antigo = std::move(calendario);
+    size_t tamanho = antigo.size();
+    bool colisao = true;
+    while (colisao) {
+        tamanho *= 2;
+        calendario.assign(tamanho, SlotCalendario{});
+        colisao = false;
+        for (const SlotCalendario& slot : antigo) {
+            if (slot.ciclo == UINT64_MAX || slot.ciclo <= ultimo_despacho) continue;
+            SlotCalendario& destino = calendario[slot.ciclo & (tamanho - 1)];
+            if (destino.ciclo != UINT64_MAX) {
+                colisao = true;
+                break;
+            }
+            destino = slot;
+        }
+    }
+}
+
+void ModeloOoO::consumir(const RegistroCommit& commit) {
+    if (commit.instrucao == 0) return;
+
+    Instruction inst(commit.instrucao);
+    ClasseInstrucao classe = classificar_instrucao(commit.instrucao);
+    auto indice_classe = static_cast<size_t>(classe);
+    bool memoria = classe == ClasseInstrucao::Load || classe == ClasseInstrucao::Store;
+
+    auto atrasar = [this](CausaParada causa, uint64_t ciclos) {
+        acumulado.atraso_instrucoes[static_cast<size_t>(causa)] += ciclos;
+    };
+
+    // 1. Fetch: no máximo 'largura_fetch' por ciclo; um desvio tomado encerra o grupo
+    if (buscadas_no_ciclo >= config.largura_fetch) {
+        ++ciclo_fetch;
+        buscadas_no_ciclo = 0;
+    }
+    uint64_t fetch = ciclo_fetch;
+    ++buscadas_no_ciclo;
+    if (commit.proximo_pc != commit.pc + 4) {
+        buscadas_no_ciclo = config.largura_fetch;
+    }
+
+    // 2. Despacho (decode/rename) em ordem, um ciclo após o fetch e no máximo
+    //    'largura_fetch' por ciclo
+    uint64_t despacho = std::max(fetch + 1, ultimo_despacho);
+    if (despacho == ultimo_despacho && despachos_no_ciclo >= config.largura_fetch) {
+        ++despacho;
+    }
+
+    while (!rob.empty() && rob.front() <= despacho) rob.pop_front();
+    if (rob.size() >= config.tamanho_rob) {
+        uint64_t liberado = rob.front();
+        rob.pop_front();
+        atrasar(CausaParada::RobCheio, liberado - despacho);
+        despacho = liberado;
+    }
+
+    while (!estacoes.empty() && estacoes.top() <= despacho) estacoes.pop();
+    if (estacoes.size() >= config.estacoes_reserva) {
+        uint64_t liberado = estacoes.top();
+        estacoes.pop();
+        atrasar(CausaParada::EstacoesCheias, liberado - despacho);
+        despacho = liberado;
+        while (!rob.empty() && rob.front() <= despacho) rob.pop_front();
+    }
+
+    if (memoria) {
+        while (!lsq.empty() && lsq.front() <= despacho) lsq.pop_front();
+        if (lsq.size() >= config.tamanho_lsq) {
+            uint64_t liberado = lsq.front();
+            lsq.pop_front();
+            atrasar(CausaParada::LsqCheia, liberado - despacho);
+            despacho = liberado;
+        }
+    }
+    if (despacho != ultimo_despacho) {
+        ultimo_despacho = despacho;
+        despachos_no_ciclo = 0;
+    }
+    ++despachos_no_ciclo;
+
+    // Com o despacho parado, o front-end também para: a próxima busca não acontece antes
+    // do ciclo anterior ao despacho (um desvio tomado ainda empurra o grupo para o seguinte)
+    if (despacho > ciclo_fetch + 1) {
+        ciclo_fetch = despacho - 1;
+        if (buscadas_no_ciclo < config.largura_fetch) buscadas_no_ciclo = 0;
+    }
+
+    acumulado.ocupacao_rob[std::min<size_t>(rob.size(), config.tamanho_rob)]++;
+    acumulado.ocupacao_estacoes[std::min<size_t>(estacoes.size(), config.estacoes_reserva)]++;
+    if (memoria) {
+        acumulado.ocupacao_lsq[std::min<size_t>(lsq.size(), config.tamanho_lsq)]++;
+    }
+
+    // 3. Operandos: rs1/rs2 conforme o formato da instrução
+    uint64_t operandos = despacho + 1;
+    switch (inst.opcode()) {
+        case 0x33: case 0x23: case 0x63:
+            operandos = std::max(operandos, registrador_pronto[inst.rs2()]);
+            [[fallthrough]];
+        case 0x13: case 0x03: case 0x67: case 0x73:
+            operandos = std::max(operandos, registrador_pronto[inst.rs1()]);
+            break;
+        default:
+            break;
+    }
+    uint32_t palavra = commit.endereco_memoria & ~0x3u;
+    if (classe == ClasseInstrucao::Load) {
+        auto it = store_pronto.find(palavra);
+        if (it != store_pronto.end()) operandos = std::max(operandos, it->second);
+    }
+
+    // 4. Emissão: escolhe a unidade funcional que fica livre primeiro
+    const UnidadeFuncional& uf = config.unidades[indice_classe];
+    auto unidade = std::min_element(unidade_livre[indice_classe].begin(), unidade_livre[indice_classe].end());
+    uint64_t emissao = std::max(operandos, *unidade);
+    atrasar(CausaParada::UnidadeOcupada, emissao - operandos);
+
+    uint64_t reservado = reservar_emissao(emissao);
+    atrasar(CausaParada::LarguraIssue, reservado - emissao);
+    emissao = reservado;
+
+    *unidade = uf.pipeline ? emissao + 1 : emissao + uf.latencia;
+    uint64_t conclusao = emissao + uf.latencia;
+
+    if (commit.rd != 0) registrador_pronto[commit.rd] = conclusao;
+    if (classe == ClasseInstrucao::Store) store_pronto[palavra] = conclusao;
+
+    // 5. Commit em ordem, no máximo 'largura_commit' por ciclo
+    uint64_t ciclo_commit = std::max(conclusao + 1, ultimo_commit);
+    if (ciclo_commit == ultimo_commit && commits_no_ciclo >= config.largura_commit) {
+        ++ciclo_commit;
+        atrasar(CausaParada::LarguraCommit, 1);
+    }
+    if (ciclo_commit != ultimo_commit) {
+        ultimo_commit = ciclo_commit;
+        commits_no_ciclo = 0;
+    }
+    ++commits_no_ciclo;
+
+    rob.push_back(ciclo_commit);
+    estacoes.push(emissao);
+    if (memoria) lsq.push_back(ciclo_commit);
+
+    acumulado.instrucoes++;
+    acumulado.instrucoes_por_classe[indice_classe]++;
+}
+
+RelatorioOoO ModeloOoO::relatorio() const {
+    RelatorioOoO rel = acumulado;
+    rel.ciclos = ultimo_commit;
+    rel.ipc = rel.ciclos ? static_cast<double>(rel.instrucoes) / rel.ciclos : 0.0;
+    return rel;
+}
+
+std::string RelatorioOoO::formatar() const {
+    std::stringstream ss;
+    ss << "--- Modelo Fora de Ordem ---\n";
+    ss << "Instrucoes: " << instrucoes << "\n";
+    ss << "Ciclos: " << ciclos << "\n";
+    ss << "IPC: " << std::fixed << std::setprecision(3) << ipc << "\n\n";
+
+    ss << "Mix de instrucoes:\n";
+    for (size_t c = 0; c < NUM_CLASSES_INSTRUCAO; ++c) {
+        ss << "  " << std::left << std::setw(8) << nome_classe(c) << std::right
+           << instrucoes_por_classe[c] << "\n";
+    }
+
+    // Um ciclo em que várias instruções esperam conta uma vez para cada uma
+    ss << "\nAtraso das instrucoes por causa estrutural (soma por instrucao, em ciclos):\n";
+    for (size_t c = 0; c < NUM_CAUSAS_PARADA; ++c) {
+        ss << "  " << std::left << std::setw(28) << nome_causa(c) << std::right << atraso_instrucoes[c] << "\n";
+    }
+
+    ss << "\n";
+    formatar_histograma(ss, "Ocupacao do ROB", ocupacao_rob);
+    formatar_histograma(ss, "Ocupacao das estacoes de reserva", ocupacao_estacoes);
+    formatar_histograma(ss, "Ocupacao da LSQ", ocupacao_lsq);
+    return ss.str();
+}
@@ -0,0 +1,166 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_MODELOOOO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_MODELOOOO_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/RegistroCommit.h"
+
+/**
+ * @enum ClasseInstrucao
+ * @brief Classe de unidade funcional que executa cada instrução.
+ */
+enum class ClasseInstrucao : uint8_t {
+    Alu,
+    Mul,
+    Div,
+    Load,
+    Store,
+    Desvio,
+    Total // Número de classes (não é uma classe)
+};
+
+constexpr size_t NUM_CLASSES_INSTRUCAO = static_cast<size_t>(ClasseInstrucao::Total);
+
+// Classifica uma instrução RV32IM pela unidade funcional que a executa.
+ClasseInstrucao classificar_instrucao(uint32_t instrucao);
+
+/**
+ * @struct UnidadeFuncional
+ * @brief Quantidade e latência de um tipo de unidade funcional.
+ */
+struct UnidadeFuncional {
+    uint32_t quantidade = 1;
+    uint32_t latencia = 1;
+    // Unidades com pipeline aceitam uma nova instrução por ciclo.
+    bool pipeline = true;
+};
+
+/**
+ * @struct ConfigOoO
+ * @brief Parâmetros do núcleo fora de ordem modelado.
+ */
+struct ConfigOoO {
+    uint32_t largura_fetch = 4;
+    uint32_t largura_issue = 4;
+    uint32_t largura_commit = 4;
+    uint32_t tamanho_rob = 64;
+    uint32_t estacoes_reserva = 32;
+    uint32_t tamanho_lsq = 16;
+
+    // Indexado por ClasseInstrucao
+    std::array<UnidadeFuncional, NUM_CLASSES_INSTRUCAO> unidades = {{
+        {2, 1, true},   // Alu
+        {1, 3, true},   // Mul
+        {1, 20, false}, // Div
+        {1, 2, true},   // Load
+        {1, 1, true},   // Store
+        {1, 1, true},   // Desvio
+    }};
+};
+
+/**
+ * @enum CausaParada
+ * @brief Recurso estrutural que atrasou o despacho ou a emissão.
+ */
+enum class CausaParada : uint8_t {
+    RobCheio,
+    EstacoesCheias,
+    LsqCheia,
+    UnidadeOcupada,
+    LarguraIssue,
+    LarguraCommit,
+    Total
+};
+
+constexpr size_t NUM_CAUSAS_PARADA = static_cast<size_t>(CausaParada::Total);
+
+/**
+ * @struct RelatorioOoO
+ * @brief Resultado acumulado do modelo de timing.
+ */
+struct RelatorioOoO {
+    uint64_t instrucoes = 0;
+    uint64_t ciclos = 0;
+    double ipc = 0.0;
+
+    // Ocupação observada no momento do despacho de cada instrução (índice = entradas ocupadas)
+    std::vector<uint64_t> ocupacao_rob;
+    std::vector<uint64_t> ocupacao_estacoes;
+    std::vector<uint64_t> ocupacao_lsq;
+
+    // Soma, sobre as instruções, dos ciclos que cada uma esperou por causa estrutural. Várias
+    // instruções esperam no mesmo ciclo, então o total pode passar de 'ciclos'
+    std::array<uint64_t, NUM_CAUSAS_PARADA> atraso_instrucoes{};
+    std::array<uint64_t, NUM_CLASSES_INSTRUCAO> instrucoes_por_classe{};
+
+    std::string formatar() const;
+};
+
+/**
+ * @class ModeloOoO
+ * @brief Modelo de timing paramétrico de um núcleo fora de ordem.
+ *
+ * É alimentado, em ordem de programa, pelos RegistroCommit produzidos por
+ * Core::execute. Para cada instrução calcula os ciclos de fetch, despacho,
+ * emissão, conclusão e commit, respeitando as larguras do pipeline, o
+ * tamanho do ROB, das estações de reserva e da LSQ, as dependências de
+ * registradores e a disponibilidade das unidades funcionais.
+ */
+class ModeloOoO {
+public:
+    explicit ModeloOoO(const ConfigOoO& config = ConfigOoO{});
+
+    void reset();
+    void consumir(const RegistroCommit& commit);
+    RelatorioOoO relatorio() const;
+
+private:
+    // Controle de emissões por ciclo (janela circular de ciclos)
+    struct SlotCalendario {
+        uint64_t ciclo = UINT64_MAX;
+        uint32_t emissoes = 0;
+    };
+
+    uint64_t reservar_emissao(uint64_t ciclo);
+    // Dobra o calendário até que os ciclos ainda reserváveis não dividam posições
+    void ampliar_calendario();
+
+    ConfigOoO config;
+
+    // Estado do front-end
+    uint64_t ciclo_fetch = 0;
+    uint32_t buscadas_no_ciclo = 0;
+    uint64_t ultimo_despacho = 0;
+    // O despacho tem a mesma largura do fetch
+    uint32_t despachos_no_ciclo = 0;
+
+    // Estado do commit
+    uint64_t ultimo_commit = 0;
+    uint32_t commits_no_ciclo = 0;
+
+    // Ciclos de commit das instruções no ROB e na LSQ (em ordem)
+    std::deque<uint64_t> rob;
+    std::deque<uint64_t> lsq;
+    // Ciclos de emissão das instruções que ainda ocupam estações de reserva
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<>> estacoes;
+
+    // Ciclo em que cada registrador arquitetural fica disponível
+    std::array<uint64_t, 32> registrador_pronto{};
+    // Ciclo em que cada unidade funcional pode aceitar uma nova instrução
+    std::array<std::vector<uint64_t>, NUM_CLASSES_INSTRUCAO> unidade_livre;
+    // Ciclo de conclusão do último store para cada palavra de memória
+    std::unordered_map<uint32_t, uint64_t> store_pronto;
+
+    // Tamanho potência de 2; cresce se dois ciclos vivos caírem na mesma posição
+    std::vector<SlotCalendario> calendario;
+
+    RelatorioOoO acumulado;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_MODELOOOO_H
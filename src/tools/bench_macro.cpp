@@ -0,0 +1,270 @@
+// Macrobenchmarks: executa cargas RV32IM completas (benchmarks/macro) pelo Core e confere o estado final.
+//
+// Uso: bench-macro diretorio [--filtro TEXTO] [--rodadas 7] [--baseline arquivo.csv]
+//                  [--tolerancia 0.25] [--gravar-baseline arquivo.csv]
+//
+// O diretório tem um manifesto (cargas.csv) com "nome,arquivo,codigo_saida,instrucoes":
+// cada carga termina com exit(a0) e o código de saída é um checksum do que ela calculou,
+// obtido de uma implementação de referência independente. Uma carga que sai com outro
+// código ou executa outro número de instruções é um erro de corretude.
+//
+// O resultado vai para a saída padrão em CSV ("nome,mips,instrucoes,taxa_acerto_cache,faltas_cache"),
+// o mesmo formato do arquivo de baseline. O MIPS é a mediana das rodadas, que ignora as poucas
+// perturbadas pelo resto da máquina. Com --baseline, cada carga abaixo de
+// baseline * (1 - tolerancia) é uma regressão. --gravar-baseline mantém os comentários (#) do
+// início do arquivo existente.
+//
+// Retorna 0 se tudo passou, 1 se houve erro de corretude ou regressão e 2 em caso de erro.
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+
+namespace {
+
+struct Carga {
+    std::string nome;
+    std::string arquivo;
+    uint32_t codigo_saida;
+    uint64_t instrucoes;
+};
+
+struct ResultadoCarga {
+    double segundos = 0.0;
+    uint64_t instrucoes = 0;
+    bool encerrado = false;
+    uint32_t codigo_saida = 0;
+    EstatisticasCache cache;
+};
+
+// Lê o manifesto; retorna uma mensagem de erro ou string vazia
+std::string ler_manifesto(const std::string &caminho, std::vector<Carga> &cargas) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o manifesto: " + caminho;
+    }
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        if (linha.empty() || linha[0] == '#' || linha.rfind("nome,", 0) == 0) continue;
+        std::stringstream campos(linha);
+        std::string nome, hex, codigo, instrucoes;
+        if (!std::getline(campos, nome, ',') || !std::getline(campos, hex, ',') ||
+            !std::getline(campos, codigo, ',') || !std::getline(campos, instrucoes, ',')) {
+            return "[ERRO] Linha invalida no manifesto: " + linha;
+        }
+        try {
+            cargas.push_back({nome, hex, static_cast<uint32_t>(std::stoul(codigo, nullptr, 0)),
+                              std::stoull(instrucoes)});
+        } catch (const std::exception &) {
+            return "[ERRO] Valor invalido no manifesto: " + linha;
+        }
+    }
+    return "";
+}
+
+// Lê um CSV no formato da saída (nome e MIPS); retorna uma mensagem de erro ou string vazia
+std::string ler_baseline(const std::string &caminho, std::map<std::string, double> &baseline) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o baseline: " + caminho;
+    }
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        if (linha.empty() || linha[0] == '#' || linha.rfind("nome,", 0) == 0) continue;
+        std::stringstream campos(linha);
+        std::string nome, mips;
+        if (!std::getline(campos, nome, ',') || !std::getline(campos, mips, ',')) {
+            return "[ERRO] Linha invalida no baseline: " + linha;
+        }
+        try {
+            baseline[nome] = std::stod(mips);
+        } catch (const std::exception &) {
+            return "[ERRO] Valor invalido no baseline: " + linha;
+        }
+    }
+    return "";
+}
+
+// Comentários (#) do início de um baseline existente, para regravá-lo sem perdê-los
+std::string ler_comentarios(const std::string &caminho) {
+    std::ifstream arquivo(caminho);
+    std::string comentarios;
+    std::string linha;
+    while (std::getline(arquivo, linha) && !linha.empty() && linha[0] == '#') {
+        comentarios += linha + '\n';
+    }
+    return comentarios;
+}
+
+double mediana(std::vector<double> valores) {
+    std::sort(valores.begin(), valores.end());
+    size_t meio = valores.size() / 2;
+    return valores.size() % 2 ? valores[meio] : (valores[meio - 1] + valores[meio]) / 2.0;
+}
+
+// Executa a carga do início ao fim. O Core já tem a imagem da carga marcada como base:
+// cada rodada parte da imagem restaurada. O limite de passos evita que uma regressão
+// de corretude transforme a carga num laço infinito.
+ResultadoCarga executar(Core &core, uint64_t limite) {
+    core.restaurar_imagem_base();
+
+    ResultadoCarga resultado;
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < limite && !core.is_finished(); ++i) {
+        core.step();
+    }
+    resultado.segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    resultado.instrucoes = core.get_contadores().instrucoes;
+    resultado.encerrado = core.encerrado();
+    resultado.codigo_saida = static_cast<uint32_t>(core.get_codigo_saida());
+    resultado.cache = core.get_estatisticas_cache();
+    return resultado;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Uso: " << argv[0] << " diretorio [--filtro TEXTO] [--rodadas 7] [--baseline arquivo.csv]"
+                  << " [--tolerancia 0.25] [--gravar-baseline arquivo.csv]" << std::endl;
+        return 2;
+    }
+
+    const std::string diretorio = argv[1];
+    std::string filtro;
+    std::string caminho_baseline;
+    std::string caminho_gravar;
+    double tolerancia = 0.25;
+    int rodadas = 7;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filtro") == 0 && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (std::strcmp(argv[i], "--rodadas") == 0 && i + 1 < argc) {
+            rodadas = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            caminho_baseline = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc) {
+            tolerancia = std::stod(argv[++i]);
+        } else if (std::strcmp(argv[i], "--gravar-baseline") == 0 && i + 1 < argc) {
+            caminho_gravar = argv[++i];
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<Carga> cargas;
+    std::string erro = ler_manifesto(diretorio + "/cargas.csv", cargas);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!caminho_baseline.empty()) {
+        erro = ler_baseline(caminho_baseline, baseline);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+    }
+
+    std::ostringstream csv;
+    if (!caminho_gravar.empty()) csv << ler_comentarios(caminho_gravar);
+    csv << "nome,mips,instrucoes,taxa_acerto_cache,faltas_cache\n";
+    std::cout << "nome,mips,instrucoes,taxa_acerto_cache,faltas_cache" << std::endl;
+    int falhas = 0;
+    int regressoes = 0;
+
+    for (const Carga &carga : cargas) {
+        if (!filtro.empty() && carga.nome.find(filtro) == std::string::npos) continue;
+
+        std::vector<uint32_t> programa;
+        erro = ler_programa_hex(diretorio + "/" + carga.arquivo, programa);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+
+        Core core(1024 * 1024);
+        core.load_program(programa);
+        core.marcar_imagem_base();
+        // Mede a simulação, não a formatação do texto de cada instrução, que ninguém lê aqui
+        core.definir_log(false);
+
+        // Toda rodada é verificada: além do simulador, isso confere a restauração da imagem base
+        ResultadoCarga resultado;
+        std::vector<double> tempos;
+        bool correta = true;
+        for (int rodada = 0; rodada < rodadas && correta; ++rodada) {
+            resultado = executar(core, carga.instrucoes * 2 + 1000);
+            correta = resultado.encerrado && resultado.codigo_saida == carga.codigo_saida &&
+                      resultado.instrucoes == carga.instrucoes;
+            tempos.push_back(resultado.segundos);
+        }
+        if (!correta) {
+            std::cerr << "[FALHA] " << carga.nome << ": "
+                      << (resultado.encerrado ? "saiu" : "nao encerrou") << " com codigo 0x" << std::hex
+                      << resultado.codigo_saida << " (esperado 0x" << carga.codigo_saida << std::dec
+                      << ") apos " << resultado.instrucoes << " instrucoes (esperado " << carga.instrucoes
+                      << ")" << std::endl;
+            ++falhas;
+            continue;
+        }
+        double mips = resultado.instrucoes / mediana(tempos) / 1e6;
+
+        const EstatisticasCache &cache = resultado.cache;
+        uint64_t acessos = cache.leituras + cache.escritas;
+        uint64_t faltas = cache.faltas_leitura + cache.faltas_escrita;
+        double taxa_acerto = acessos ? 100.0 * (acessos - faltas) / acessos : 100.0;
+
+        std::ostringstream linha;
+        linha << carga.nome << ',' << mips << ',' << resultado.instrucoes << ',' << taxa_acerto << ',' << faltas;
+        std::cout << linha.str() << std::endl;
+        csv << linha.str() << '\n';
+
+        auto referencia = baseline.find(carga.nome);
+        if (referencia != baseline.end() && mips < referencia->second * (1.0 - tolerancia)) {
+            std::cerr << "[REGRESSAO] " << carga.nome << ": " << mips << " MIPS (baseline "
+                      << referencia->second << " MIPS, " << (mips / referencia->second - 1.0) * 100.0 << "%)"
+                      << std::endl;
+            ++regressoes;
+        }
+    }
+
+    if (!caminho_gravar.empty()) {
+        std::ofstream arquivo(caminho_gravar);
+        arquivo << csv.str();
+        if (!arquivo) {
+            std::cerr << "[ERRO] Nao foi possivel gravar o baseline: " << caminho_gravar << std::endl;
+            return 2;
+        }
+        std::cerr << "[INFO] Baseline gravado em " << caminho_gravar << std::endl;
+    }
+
+    if (falhas > 0) {
+        std::cerr << "[ERRO] " << falhas << " carga(s) com estado final incorreto." << std::endl;
+        return 1;
+    }
+    if (regressoes > 0) {
+        std::cerr << "[ERRO] " << regressoes << " regressao(oes) acima de " << tolerancia * 100.0 << "%."
+                  << std::endl;
+        return 1;
+    }
+    if (!caminho_baseline.empty()) {
+        std::cerr << "[OK] Nenhuma regressao em relacao ao baseline." << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,305 @@
+// Microbenchmarks dos caminhos quentes do simulador: decodificação, cache e execução por classe de opcode.
+//
+// Uso: bench-micro [--filtro TEXTO] [--rapido] [--baseline arquivo.csv] [--tolerancia 0.15]
+//                  [--gravar-baseline arquivo.csv]
+//
+// O resultado vai para a saída padrão em CSV ("nome,ns_por_operacao,operacoes"),
+// o mesmo formato do arquivo de baseline. Cada medida é a melhor de algumas
+// rodadas, com entradas geradas por uma semente fixa. Com --baseline, cada
+// medida mais lenta que baseline * (1 + tolerancia) é uma regressão.
+//
+// Retorna 0 sem regressões, 1 se houve regressão e 2 em caso de erro.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "cache/Cache.h"
+#include "core/Core.h"
+#include "core/Instruction.h"
+#include "profiling/MicroBenchmark.h"
+
+namespace {
+
+struct Benchmark {
+    std::string nome;
+    uint64_t operacoes;
+    // Executa 'operacoes' vezes a operação medida e retorna o tempo em segundos
+    std::function<double(uint64_t)> executar;
+};
+
+// Impede que o compilador descarte os resultados calculados nos laços
+volatile uint64_t sumidouro = 0;
+
+// Gerador xorshift com semente fixa: as mesmas entradas em toda execução
+std::vector<uint32_t> palavras_aleatorias(size_t quantidade) {
+    std::vector<uint32_t> palavras(quantidade);
+    uint32_t estado = 0x9E3779B9u;
+    for (uint32_t &palavra : palavras) {
+        estado ^= estado << 13;
+        estado ^= estado >> 17;
+        estado ^= estado << 5;
+        palavra = estado;
+    }
+    return palavras;
+}
+
+template<typename Corpo>
+double cronometrar(Corpo corpo) {
+    auto inicio = std::chrono::steady_clock::now();
+    corpo();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+// Um laço de instruções executado por Core::step(), como no benchmark do DemoWindow
+Benchmark benchmark_execucao(const std::string &nome, const std::vector<uint32_t> &sequencia, uint64_t operacoes) {
+    std::array<uint32_t, 32> registradores{};
+    registradores[1] = 123456789;
+    registradores[2] = 97;
+    // Base dos loads e stores, longe do código do laço
+    registradores[5] = 0x10000;
+
+    std::vector<uint32_t> programa = microbenchmark::montar_laco(sequencia);
+    return {nome, operacoes, [programa, registradores](uint64_t n) {
+        ResultadoMicroBenchmark resultado;
+        std::string erro = microbenchmark::executar_laco(programa, registradores, n, resultado);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return -1.0;
+        }
+        return resultado.segundos;
+    }};
+}
+
+std::vector<Benchmark> criar_benchmarks(uint64_t escala) {
+    std::vector<Benchmark> lista;
+    static const std::vector<uint32_t> palavras = palavras_aleatorias(4096);
+
+    lista.push_back({"instrucao.campos", 20000000 / escala, [](uint64_t n) {
+        return cronometrar([n] {
+            uint64_t soma = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                Instruction inst(palavras[i & 4095]);
+                soma += inst.opcode() + inst.rd() + inst.funct3() + inst.rs1() + inst.rs2() + inst.funct7();
+            }
+            sumidouro = soma;
+        });
+    }});
+
+    lista.push_back({"instrucao.imediatos", 20000000 / escala, [](uint64_t n) {
+        return cronometrar([n] {
+            int64_t soma = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                Instruction inst(palavras[i & 4095]);
+                soma += inst.imediato_tipo_I() + inst.imediato_tipo_S() + inst.imediato_tipo_B() +
+                        inst.imediato_tipo_U() + inst.imediato_tipo_J();
+            }
+            sumidouro = static_cast<uint64_t>(soma);
+        });
+    }});
+
+    // Cache de 4 KiB com blocos de 16 bytes, como no Core
+    lista.push_back({"cache.ler_acerto", 20000000 / escala, [](uint64_t n) {
+        std::vector<uint8_t> memoria(1024 * 1024);
+        Cache cache(4096, 16, memoria);
+        for (uint32_t e = 0; e < 4096; e += 16) cache.lerDados(e);
+        return cronometrar([&] {
+            uint64_t soma = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                soma += cache.lerDados((palavras[i & 4095] & 0xFFC));
+            }
+            sumidouro = soma;
+        });
+    }});
+
+    // Endereços a 4 KiB de distância caem no mesmo conjunto: toda leitura é uma falta
+    lista.push_back({"cache.ler_falta", 5000000 / escala, [](uint64_t n) {
+        std::vector<uint8_t> memoria(1024 * 1024);
+        Cache cache(4096, 16, memoria);
+        return cronometrar([&] {
+            uint64_t soma = 0;
+            for (uint64_t i = 0; i < n; ++i) {
+                soma += cache.lerDados(static_cast<uint32_t>((i * 4096) & 0xFF000));
+            }
+            sumidouro = soma;
+        });
+    }});
+
+    lista.push_back({"cache.escrever_acerto", 20000000 / escala, [](uint64_t n) {
+        std::vector<uint8_t> memoria(1024 * 1024);
+        Cache cache(4096, 16, memoria);
+        for (uint32_t e = 0; e < 4096; e += 16) cache.lerDados(e);
+        return cronometrar([&] {
+            for (uint64_t i = 0; i < n; ++i) {
+                cache.escreverDados(palavras[i & 4095] & 0xFFC, static_cast<uint32_t>(i));
+            }
+        });
+    }});
+
+    lista.push_back({"cache.escrever_falta", 20000000 / escala, [](uint64_t n) {
+        std::vector<uint8_t> memoria(1024 * 1024);
+        Cache cache(4096, 16, memoria);
+        return cronometrar([&] {
+            for (uint64_t i = 0; i < n; ++i) {
+                cache.escreverDados(static_cast<uint32_t>((i * 4096) & 0xFF000), static_cast<uint32_t>(i));
+            }
+        });
+    }});
+
+    // Core::execute por classe de opcode (via step(), que inclui busca e log)
+    const uint64_t passos = 1000000 / escala;
+    lista.push_back(benchmark_execucao("core.op_imm", {0x00508193}, passos));        // addi x3, x1, 5
+    lista.push_back(benchmark_execucao("core.op", {0x002081b3}, passos));            // add x3, x1, x2
+    lista.push_back(benchmark_execucao("core.mul", {0x022081b3}, passos));           // mul x3, x1, x2
+    lista.push_back(benchmark_execucao("core.div", {0x0220c1b3}, passos));           // div x3, x1, x2
+    lista.push_back(benchmark_execucao("core.load", {0x0002a183}, passos));          // lw x3, 0(x5)
+    lista.push_back(benchmark_execucao("core.store", {0x0012a023}, passos));         // sw x1, 0(x5)
+    lista.push_back(benchmark_execucao("core.lui", {0x123451b7}, passos));           // lui x3, 0x12345
+    lista.push_back(benchmark_execucao("core.auipc", {0x00001197}, passos));         // auipc x3, 1
+    lista.push_back(benchmark_execucao("core.branch", {0x00208463}, passos));        // beq x1, x2, 8 (não tomado)
+    lista.push_back(benchmark_execucao("core.jal", {0x0040006f}, passos));           // jal x0, 4
+
+    lista.push_back({"core.load_program", 2000 / escala, [](uint64_t n) {
+        Core core(1024 * 1024);
+        std::vector<uint32_t> programa(palavras.begin(), palavras.end());
+        programa.resize(16384, 0x00000013);
+        return cronometrar([&] {
+            for (uint64_t i = 0; i < n; ++i) {
+                core.load_program(programa);
+            }
+        });
+    }});
+
+    lista.push_back({"core.reset", 200000 / escala, [](uint64_t n) {
+        Core core(1024 * 1024);
+        return cronometrar([&] {
+            for (uint64_t i = 0; i < n; ++i) {
+                core.reset();
+            }
+        });
+    }});
+
+    return lista;
+}
+
+// Lê um CSV no formato da saída; retorna uma mensagem de erro ou string vazia
+std::string ler_baseline(const std::string &caminho, std::map<std::string, double> &baseline) {
+    std::ifstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o baseline: " + caminho;
+    }
+    std::string linha;
+    while (std::getline(arquivo, linha)) {
+        if (linha.empty() || linha[0] == '#' || linha.rfind("nome,", 0) == 0) continue;
+        std::stringstream campos(linha);
+        std::string nome, ns;
+        if (!std::getline(campos, nome, ',') || !std::getline(campos, ns, ',')) {
+            return "[ERRO] Linha invalida no baseline: " + linha;
+        }
+        try {
+            baseline[nome] = std::stod(ns);
+        } catch (const std::exception &) {
+            return "[ERRO] Valor invalido no baseline: " + linha;
+        }
+    }
+    return "";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    std::string filtro;
+    std::string caminho_baseline;
+    std::string caminho_gravar;
+    double tolerancia = 0.15;
+    uint64_t escala = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--filtro") == 0 && i + 1 < argc) {
+            filtro = argv[++i];
+        } else if (std::strcmp(argv[i], "--rapido") == 0) {
+            escala = 10;
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            caminho_baseline = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerancia") == 0 && i + 1 < argc) {
+            tolerancia = std::stod(argv[++i]);
+        } else if (std::strcmp(argv[i], "--gravar-baseline") == 0 && i + 1 < argc) {
+            caminho_gravar = argv[++i];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--filtro TEXTO] [--rapido] [--baseline arquivo.csv]"
+                      << " [--tolerancia 0.15] [--gravar-baseline arquivo.csv]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!caminho_baseline.empty()) {
+        std::string erro = ler_baseline(caminho_baseline, baseline);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+    }
+
+    // Melhor de algumas rodadas: reduz o ruído de agendamento e frequência do host
+    const int RODADAS = 5;
+    std::ostringstream csv;
+    csv << "nome,ns_por_operacao,operacoes\n";
+    std::cout << "nome,ns_por_operacao,operacoes" << std::endl;
+    int regressoes = 0;
+
+    for (const Benchmark &benchmark : criar_benchmarks(escala)) {
+        if (!filtro.empty() && benchmark.nome.find(filtro) == std::string::npos) continue;
+        uint64_t operacoes = std::max<uint64_t>(benchmark.operacoes, 1);
+
+        double melhor = -1.0;
+        for (int rodada = 0; rodada < RODADAS; ++rodada) {
+            double segundos = benchmark.executar(operacoes);
+            if (segundos < 0) return 2;
+            melhor = melhor < 0 ? segundos : std::min(melhor, segundos);
+        }
+        double ns = melhor * 1e9 / operacoes;
+
+        std::ostringstream linha;
+        linha << benchmark.nome << ',' << ns << ',' << operacoes;
+        std::cout << linha.str() << std::endl;
+        csv << linha.str() << '\n';
+
+        auto referencia = baseline.find(benchmark.nome);
+        if (referencia != baseline.end() && ns > referencia->second * (1.0 + tolerancia)) {
+            std::cerr << "[REGRESSAO] " << benchmark.nome << ": " << ns << " ns (baseline "
+                      << referencia->second << " ns, +" << (ns / referencia->second - 1.0) * 100.0 << "%)"
+                      << std::endl;
+            ++regressoes;
+        }
+    }
+
+    if (!caminho_gravar.empty()) {
+        std::ofstream arquivo(caminho_gravar);
+        arquivo << csv.str();
+        if (!arquivo) {
+            std::cerr << "[ERRO] Nao foi possivel gravar o baseline: " << caminho_gravar << std::endl;
+            return 2;
+        }
+        std::cerr << "[INFO] Baseline gravado em " << caminho_gravar << std::endl;
+    }
+
+    if (!caminho_baseline.empty()) {
+        if (regressoes > 0) {
+            std::cerr << "[ERRO] " << regressoes << " regressao(oes) acima de " << tolerancia * 100.0 << "%."
+                      << std::endl;
+            return 1;
+        }
+        std::cerr << "[OK] Nenhuma regressao em relacao ao baseline." << std::endl;
+    }
+    return 0;
+}
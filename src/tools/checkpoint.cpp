@@ -0,0 +1,148 @@
+// Checkpoints em disco: avança um programa até um ponto, grava o estado e retoma dele depois.
+//
+// Uso: checkpoint gravar <programa.hex> <saida.rvck> --instrucoes N [--zstd]
+//      checkpoint retomar <entrada.rvck> [--max N]
+//
+// 'gravar' executa N instruções, tira um snapshot e o grava numa thread de fundo
+// enquanto a execução continua até o fim do programa. 'retomar' carrega o
+// checkpoint num Core novo e executa a partir dele.
+//
+// Retorna 0 em caso de sucesso, 1 se a retomada não terminou dentro de --max e 2 em caso de erro.
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Checkpoint.h"
+#include "core/Core.h"
+
+namespace {
+
+void imprimir_fim(const Core &core) {
+    std::cout << "Instrucoes: " << core.get_contadores().instrucoes << std::endl;
+    if (core.encerrado()) {
+        std::cout << "Codigo de saida: " << core.get_codigo_saida() << std::endl;
+    }
+}
+
+int gravar(int argc, char *argv[]) {
+    if (argc < 4) {
+        std::cerr << "Uso: " << argv[0] << " gravar <programa.hex> <saida.rvck> --instrucoes N [--zstd]" << std::endl;
+        return 2;
+    }
+
+    uint64_t instrucoes = 0;
+    auto compressao = checkpoint::Compressao::Nenhuma;
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--instrucoes") == 0 && i + 1 < argc) {
+            instrucoes = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--zstd") == 0) {
+            compressao = checkpoint::Compressao::Zstd;
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<uint32_t> programa;
+    std::string erro = ler_programa_hex(argv[2], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    core.load_program(programa);
+    for (uint64_t i = 0; i < instrucoes && !core.is_finished(); ++i) {
+        core.step();
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    SnapshotCore snapshot = core.criar_snapshot();
+    GravadorCheckpoint gravador;
+    erro = gravador.iniciar(snapshot, argv[3], compressao);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+    double pausa = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    // A execução segue enquanto o checkpoint é gravado
+    uint64_t durante_gravacao = 0;
+    while (!core.is_finished()) {
+        core.step();
+        if (gravador.em_andamento()) ++durante_gravacao;
+    }
+
+    erro = gravador.aguardar();
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+    std::cout << "Checkpoint gravado em " << argv[3] << " (" << gravador.get_bytes_escritos() << " bytes, "
+              << gravador.get_paginas_escritas() << " paginas) no PC 0x" << std::hex
+              << snapshot.get_program_counter() << std::dec << " apos " << snapshot.get_contadores().instrucoes
+              << " instrucoes" << std::endl;
+    std::cout << "Pausa da simulacao: " << pausa * 1e6 << " us; instrucoes executadas durante a gravacao: "
+              << durante_gravacao << std::endl;
+    imprimir_fim(core);
+    return 0;
+}
+
+int retomar(int argc, char *argv[]) {
+    if (argc < 3) {
+        std::cerr << "Uso: " << argv[0] << " retomar <entrada.rvck> [--max N]" << std::endl;
+        return 2;
+    }
+
+    uint64_t maximo = UINT64_MAX;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    SnapshotCore snapshot;
+    std::string erro = ler_checkpoint(argv[2], snapshot);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+    Core core(snapshot.get_tamanho_memoria());
+    erro = core.restaurar_snapshot(snapshot);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+    double carga = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    std::cout << "Checkpoint carregado em " << carga * 1e3 << " ms; retomando do PC 0x" << std::hex
+              << core.get_program_counter() << std::dec << " apos " << snapshot.get_contadores().instrucoes
+              << " instrucoes" << std::endl;
+
+    for (uint64_t i = 0; i < maximo && !core.is_finished(); ++i) {
+        core.step();
+    }
+    imprimir_fim(core);
+    return core.is_finished() ? 0 : 1;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 2 && std::strcmp(argv[1], "gravar") == 0) {
+        return gravar(argc, argv);
+    }
+    if (argc >= 2 && std::strcmp(argv[1], "retomar") == 0) {
+        return retomar(argc, argv);
+    }
+    std::cerr << "Uso: " << argv[0] << " gravar <programa.hex> <saida.rvck> --instrucoes N [--zstd]" << std::endl
+              << "     " << argv[0] << " retomar <entrada.rvck> [--max N]" << std::endl;
+    return 2;
+}
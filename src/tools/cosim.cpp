@@ -0,0 +1,83 @@
+// Co-simulação em lockstep contra um log de commits de referência (Spike --log-commits).
+//
+// Uso: cosim <programa.hex> <referencia.log> [--max N] [--sincronizar] [--base-referencia ENDERECO]
+//
+// O programa é carregado no endereço 0. Se a referência rodou com a RAM em outro endereço
+// (o Spike carrega em 0x80000000), --base-referencia rebaseia os PCs e endereços dela; com
+// --sincronizar, o código de boot da referência antes do primeiro PC do programa é pulado.
+//
+// Retorna 0 se todo o log conferiu, 1 na primeira divergência e 2 em caso de erro.
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+#include "cosim/CoSimulacao.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3) {
+        std::cerr << "Uso: " << argv[0] << " <programa.hex> <referencia.log> [--max N] [--sincronizar]"
+                  << " [--base-referencia ENDERECO]" << std::endl;
+        return 2;
+    }
+
+    uint64_t maximo = UINT64_MAX;
+    bool sincronizar = false;
+    uint32_t base_referencia = 0;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--sincronizar") == 0) {
+            sincronizar = true;
+        } else if (std::strcmp(argv[i], "--base-referencia") == 0 && i + 1 < argc) {
+            base_referencia = static_cast<uint32_t>(std::stoul(argv[++i], nullptr, 0));
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<uint32_t> programa;
+    std::string erro = ler_programa_hex(argv[1], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    LeitorLogCommits referencia;
+    erro = referencia.abrir(argv[2]);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    core.load_program(programa);
+
+    CoSimulacao cosim(core, referencia);
+    if (base_referencia != 0) {
+        cosim.definir_base_referencia(base_referencia, static_cast<uint32_t>(core.get_tamanho_memoria()));
+    }
+    if (sincronizar && !cosim.sincronizar()) {
+        std::cerr << "[ERRO] PC inicial do simulador nao encontrado na referencia." << std::endl;
+        return 2;
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    ResultadoCoSim resultado = cosim.executar(maximo);
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    std::cout << "[INFO] " << resultado.instrucoes << " instrucoes comparadas em " << segundos << " s ("
+              << (segundos > 0 ? resultado.instrucoes / segundos / 1e6 : 0.0) << " MIPS)" << std::endl;
+
+    if (resultado.divergiu) {
+        std::cout << "[DIVERGENCIA] " << resultado.motivo << "\n" << resultado.contexto;
+        return 1;
+    }
+    std::cout << "[OK] Nenhuma divergencia encontrada." << std::endl;
+    return 0;
+}
@@ -0,0 +1,54 @@
+// Converte um trace binário (.rvtr) de volta para texto, no formato de
+// commits do Spike (--log-commits), uma instrução por linha. Os loads levam
+// também o valor lido ("lido 0x..."), que o leitor de logs da cosimulação ignora.
+//
+// Uso: decodificar-trace <arquivo.rvtr> [saida.txt]
+
+#include <cstdio>
+#include <iostream>
+
+#include "trace/TraceBinario.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Uso: " << argv[0] << " <arquivo.rvtr> [saida.txt]" << std::endl;
+        return 1;
+    }
+
+    LeitorTrace leitor;
+    std::string erro = leitor.abrir(argv[1]);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 1;
+    }
+
+    std::FILE* saida = stdout;
+    if (argc >= 3) {
+        saida = std::fopen(argv[2], "w");
+        if (!saida) {
+            std::cerr << "[ERRO] Nao foi possivel criar " << argv[2] << std::endl;
+            return 1;
+        }
+    }
+
+    RegistroCommit r;
+    uint64_t total = 0;
+    while (leitor.proximo(r)) {
+        std::fprintf(saida, "core   0: 3 0x%08x (0x%08x)", r.pc, r.instrucao);
+        if (r.rd != 0) {
+            std::fprintf(saida, " x%-2u 0x%08x", r.rd, r.valor_rd);
+        }
+        if (r.acesso == AcessoMemoria::Leitura) {
+            std::fprintf(saida, " mem 0x%08x lido 0x%08x", r.endereco_memoria, r.dado_memoria);
+        } else if (r.acesso == AcessoMemoria::Escrita) {
+            std::fprintf(saida, " mem 0x%08x 0x%08x", r.endereco_memoria, r.dado_memoria);
+        }
+        std::fputc('\n', saida);
+        ++total;
+    }
+
+    if (saida != stdout) std::fclose(saida);
+    std::cerr << "[INFO] " << total << " registros decodificados." << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+// Modelo fora de ordem: executa um programa alimentando o ModeloOoO com cada commit e imprime
+// o relatório (IPC, mix de instruções, atraso por causa estrutural e ocupação das filas).
+//
+// Uso: modelo-ooo <programa.hex> [--largura N] [--rob N] [--estacoes N] [--lsq N]
+//                 [--unidades CLASSE N] [--latencia CLASSE N] [--sem-pipeline CLASSE]
+//                 [--com-pipeline CLASSE] [--max N]
+//
+// --largura define juntas as larguras de fetch, issue e commit. CLASSE é alu, mul, div,
+// load, store ou desvio; --unidades e --latencia mudam a quantidade e a latência das
+// unidades dessa classe. O CPI do Core em ordem é impresso para comparação.
+//
+// Retorna 0 se o programa terminou, 1 se parou em --max e 2 em caso de erro.
+
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+#include "timing/ModeloOoO.h"
+
+namespace {
+
+// Índice da classe em ConfigOoO::unidades ou NUM_CLASSES_INSTRUCAO se o nome não existir
+size_t classe_por_nome(const char *nome) {
+    static const char *nomes[] = {"alu", "mul", "div", "load", "store", "desvio"};
+    for (size_t c = 0; c < NUM_CLASSES_INSTRUCAO; ++c) {
+        if (std::strcmp(nome, nomes[c]) == 0) return c;
+    }
+    return NUM_CLASSES_INSTRUCAO;
+}
+
+// Lê um valor maior que zero; retorna uma mensagem de erro ou string vazia
+std::string ler_positivo(const char *texto, uint32_t &valor) {
+    try {
+        unsigned long lido = std::stoul(texto);
+        if (lido == 0 || lido > UINT32_MAX) return std::string("[ERRO] Valor invalido: ") + texto;
+        valor = static_cast<uint32_t>(lido);
+    } catch (const std::exception &) {
+        return std::string("[ERRO] Valor invalido: ") + texto;
+    }
+    return "";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Uso: " << argv[0] << " <programa.hex> [--largura N] [--rob N] [--estacoes N] [--lsq N]"
+                  << " [--unidades CLASSE N] [--latencia CLASSE N] [--sem-pipeline CLASSE]"
+                  << " [--com-pipeline CLASSE] [--max N]" << std::endl;
+        return 2;
+    }
+
+    ConfigOoO config;
+    uint64_t maximo = UINT64_MAX;
+    std::string erro;
+    for (int i = 2; i < argc && erro.empty(); ++i) {
+        if (std::strcmp(argv[i], "--largura") == 0 && i + 1 < argc) {
+            erro = ler_positivo(argv[++i], config.largura_fetch);
+            config.largura_issue = config.largura_commit = config.largura_fetch;
+        } else if (std::strcmp(argv[i], "--rob") == 0 && i + 1 < argc) {
+            erro = ler_positivo(argv[++i], config.tamanho_rob);
+        } else if (std::strcmp(argv[i], "--estacoes") == 0 && i + 1 < argc) {
+            erro = ler_positivo(argv[++i], config.estacoes_reserva);
+        } else if (std::strcmp(argv[i], "--lsq") == 0 && i + 1 < argc) {
+            erro = ler_positivo(argv[++i], config.tamanho_lsq);
+        } else if ((std::strcmp(argv[i], "--unidades") == 0 || std::strcmp(argv[i], "--latencia") == 0) &&
+                   i + 2 < argc) {
+            bool unidades = std::strcmp(argv[i], "--unidades") == 0;
+            size_t classe = classe_por_nome(argv[++i]);
+            if (classe == NUM_CLASSES_INSTRUCAO) {
+                erro = std::string("[ERRO] Classe de instrucao desconhecida: ") + argv[i];
+            } else {
+                UnidadeFuncional &uf = config.unidades[classe];
+                erro = ler_positivo(argv[++i], unidades ? uf.quantidade : uf.latencia);
+            }
+        } else if ((std::strcmp(argv[i], "--sem-pipeline") == 0 || std::strcmp(argv[i], "--com-pipeline") == 0) &&
+                   i + 1 < argc) {
+            bool pipeline = std::strcmp(argv[i], "--com-pipeline") == 0;
+            size_t classe = classe_por_nome(argv[++i]);
+            if (classe == NUM_CLASSES_INSTRUCAO) {
+                erro = std::string("[ERRO] Classe de instrucao desconhecida: ") + argv[i];
+            } else {
+                config.unidades[classe].pipeline = pipeline;
+            }
+        } else if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = std::stoull(argv[++i]);
+        } else {
+            erro = std::string("[ERRO] Opcao desconhecida: ") + argv[i];
+        }
+    }
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    std::vector<uint32_t> programa;
+    erro = ler_programa_hex(argv[1], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    core.load_program(programa);
+    // O modelo só usa o commit de cada passo, não o texto da instrução
+    core.definir_log(false);
+    ModeloOoO modelo(config);
+    for (uint64_t i = 0; i < maximo && !core.is_finished(); ++i) {
+        core.step();
+        modelo.consumir(core.get_ultimo_commit());
+    }
+
+    RelatorioOoO relatorio = modelo.relatorio();
+    std::cout << relatorio.formatar();
+    uint64_t instrucoes = core.get_contadores().instrucoes;
+    std::cout << "\nCPI do Core em ordem: " << std::fixed << std::setprecision(3)
+              << (instrucoes ? static_cast<double>(core.get_contadores().ciclos) / instrucoes : 0.0)
+              << "; CPI do modelo: " << (relatorio.ipc > 0.0 ? 1.0 / relatorio.ipc : 0.0) << std::endl;
+    return core.is_finished() ? 0 : 1;
+}
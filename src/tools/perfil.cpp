@@ -0,0 +1,103 @@
+// Perfil por amostragem de um programa: executa até o fim chamando o ProfilerAmostragem
+// depois de cada passo e imprime as funções e linhas com mais amostras.
+//
+// Uso: perfil <programa.hex> [--simbolos arquivo.nm] [--linhas arquivo] [--intervalo N]
+//             [--ciclos] [--pilha nenhuma|ra|fp] [--pilhas-dobradas saida.txt] [--top N] [--max N]
+//
+// --simbolos lê a saída do 'nm' e --linhas a tabela "endereco arquivo:linha"; sem eles os
+// PCs aparecem em hexadecimal. --intervalo é o período de amostragem em instruções (ou em
+// ciclos modelados com --ciclos). --pilha escolhe como a pilha de chamadas é reconstruída
+// (padrão fp: cadeia de frame pointers). --pilhas-dobradas grava as pilhas no formato
+// do flamegraph.pl.
+//
+// Retorna 0 se o programa terminou, 1 se parou em --max e 2 em caso de erro.
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+#include "profiling/ProfilerAmostragem.h"
+#include "profiling/TabelaSimbolos.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Uso: " << argv[0] << " <programa.hex> [--simbolos arquivo.nm] [--linhas arquivo]"
+                  << " [--intervalo N] [--ciclos] [--pilha nenhuma|ra|fp] [--pilhas-dobradas saida.txt]"
+                  << " [--top N] [--max N]" << std::endl;
+        return 2;
+    }
+
+    ConfigProfiler config;
+    TabelaSimbolos simbolos;
+    std::string caminho_pilhas;
+    size_t maximo_linhas = 20;
+    uint64_t maximo = UINT64_MAX;
+    std::string erro;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--simbolos") == 0 && i + 1 < argc) {
+            erro = simbolos.carregar_simbolos(argv[++i]);
+        } else if (std::strcmp(argv[i], "--linhas") == 0 && i + 1 < argc) {
+            erro = simbolos.carregar_linhas(argv[++i]);
+        } else if (std::strcmp(argv[i], "--intervalo") == 0 && i + 1 < argc) {
+            config.intervalo = std::stoull(argv[++i]);
+            if (config.intervalo == 0) erro = "[ERRO] O intervalo de amostragem deve ser maior que zero";
+        } else if (std::strcmp(argv[i], "--ciclos") == 0) {
+            config.base = ConfigProfiler::Base::Ciclos;
+        } else if (std::strcmp(argv[i], "--pilha") == 0 && i + 1 < argc) {
+            const char *pilha = argv[++i];
+            if (std::strcmp(pilha, "nenhuma") == 0) {
+                config.pilha = ConfigProfiler::Pilha::Nenhuma;
+            } else if (std::strcmp(pilha, "ra") == 0) {
+                config.pilha = ConfigProfiler::Pilha::EnderecoRetorno;
+            } else if (std::strcmp(pilha, "fp") == 0) {
+                config.pilha = ConfigProfiler::Pilha::FramePointer;
+            } else {
+                erro = std::string("[ERRO] Modo de pilha desconhecido: ") + pilha;
+            }
+        } else if (std::strcmp(argv[i], "--pilhas-dobradas") == 0 && i + 1 < argc) {
+            caminho_pilhas = argv[++i];
+        } else if (std::strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            maximo_linhas = std::stoul(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = std::stoull(argv[++i]);
+        } else {
+            erro = std::string("[ERRO] Opcao desconhecida: ") + argv[i];
+        }
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<uint32_t> programa;
+    erro = ler_programa_hex(argv[1], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    core.load_program(programa);
+    ProfilerAmostragem profiler(config);
+    for (uint64_t i = 0; i < maximo && !core.is_finished(); ++i) {
+        core.step();
+        profiler.registrar(core);
+    }
+
+    std::cout << "Instrucoes: " << core.get_contadores().instrucoes << std::endl;
+    std::cout << profiler.formatar_relatorio(simbolos, maximo_linhas);
+
+    if (!caminho_pilhas.empty()) {
+        std::ofstream saida(caminho_pilhas);
+        if (!saida) {
+            std::cerr << "[ERRO] Nao foi possivel criar " << caminho_pilhas << std::endl;
+            return 2;
+        }
+        profiler.exportar_pilhas_dobradas(saida, simbolos);
+    }
+    return core.is_finished() ? 0 : 1;
+}
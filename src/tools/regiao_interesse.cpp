@@ -0,0 +1,300 @@
+// Mede só a região de interesse de um programa: o resto roda em modo funcional (sem cache)
+// ou de aquecimento (cache sem estatísticas), e só o modo detalhado entra nas medidas.
+//
+// Uso: regiao-interesse <programa.hex> [--modo funcional|aquecimento|detalhado]
+//                       [--em-instrucao N:modo]... [--em-pc ENDERECO:modo]... [--max N]
+//                       [--dram chave=valor,...] [--buffer-escrita chave=valor,...]
+//                       [--trace arquivo.rvtr] [--trace-zstd] [--disco imagem.img]
+//
+// O modo inicial padrão é o funcional. --em-instrucao troca de modo quando minstret chega
+// a N; --em-pc troca toda vez que o PC passa pelo endereço. O próprio guest também troca
+// com as instruções mágicas "slti x0, x0, 1|2|3" (funcional, aquecimento, detalhado).
+// --dram configura a memória principal atrás do cache, com as chaves canais, ranks,
+// bancos, linha (bytes), politica (aberta|fechada), trcd, trp, tcas, burst e fila.
+// --buffer-escrita configura o buffer entre o cache write-through e a DRAM, com as chaves
+// entradas (0 desliga), limite (ocupação que dispara a drenagem), combinar e encaminhar (0|1).
+// --trace grava todas as instruções executadas num trace binário (comprimido com zstd se
+// --trace-zstd), que o decodificar-trace converte para texto.
+// --disco liga o dispositivo de bloco em 0x10001000 com a imagem dada (setores de 512 bytes),
+// que o guest lê e escreve. A saída da UART (0x10000000) aparece no stdout junto com a das syscalls.
+//
+// Retorna 0 se o programa terminou, 1 se parou em --max e 2 em caso de erro.
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "bus/Dispositivos.h"
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+#include "trace/TraceBinario.h"
+
+namespace {
+
+bool ler_modo(const std::string &texto, ModoExecucao &modo) {
+    if (texto == "funcional") {
+        modo = ModoExecucao::Funcional;
+    } else if (texto == "aquecimento") {
+        modo = ModoExecucao::Aquecimento;
+    } else if (texto == "detalhado") {
+        modo = ModoExecucao::Detalhado;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// "VALOR:modo" (VALOR em decimal ou 0x...); retorna uma mensagem de erro ou string vazia
+std::string ler_gatilho(const char *argumento, GatilhoModo::Tipo tipo, GatilhoModo &gatilho) {
+    std::string texto = argumento;
+    size_t separador = texto.find(':');
+    gatilho.tipo = tipo;
+    if (separador == std::string::npos || !ler_modo(texto.substr(separador + 1), gatilho.modo)) {
+        return "[ERRO] Gatilho invalido (use VALOR:modo): " + texto;
+    }
+    try {
+        gatilho.valor = std::stoull(texto.substr(0, separador), nullptr, 0);
+    } catch (const std::exception &) {
+        return "[ERRO] Valor invalido no gatilho: " + texto;
+    }
+    return "";
+}
+
+// Lista "chave=valor" separada por vírgulas; retorna uma mensagem de erro ou string vazia
+std::string ler_config_dram(const std::string &texto, ConfigDram &config) {
+    std::stringstream lista(texto);
+    std::string item;
+    while (std::getline(lista, item, ',')) {
+        size_t separador = item.find('=');
+        if (separador == std::string::npos) {
+            return "[ERRO] Item invalido em --dram (use chave=valor): " + item;
+        }
+        std::string chave = item.substr(0, separador);
+        std::string valor = item.substr(separador + 1);
+        if (chave == "politica") {
+            if (valor == "aberta") {
+                config.politica = PoliticaLinhaDram::Aberta;
+            } else if (valor == "fechada") {
+                config.politica = PoliticaLinhaDram::Fechada;
+            } else {
+                return "[ERRO] Politica de linha desconhecida: " + valor;
+            }
+            continue;
+        }
+
+        uint32_t *campo = nullptr;
+        if (chave == "canais") campo = &config.canais;
+        else if (chave == "ranks") campo = &config.ranks;
+        else if (chave == "bancos") campo = &config.bancos;
+        else if (chave == "linha") campo = &config.tamanho_linha;
+        else if (chave == "trcd") campo = &config.tRCD;
+        else if (chave == "trp") campo = &config.tRP;
+        else if (chave == "tcas") campo = &config.tCAS;
+        else if (chave == "burst") campo = &config.tBurst;
+        else if (chave == "fila") campo = &config.capacidade_fila;
+        if (campo == nullptr) {
+            return "[ERRO] Chave desconhecida em --dram: " + chave;
+        }
+        try {
+            *campo = static_cast<uint32_t>(std::stoul(valor, nullptr, 0));
+        } catch (const std::exception &) {
+            return "[ERRO] Valor invalido em --dram: " + item;
+        }
+    }
+    return "";
+}
+
+// Mesmo formato de --dram; retorna uma mensagem de erro ou string vazia
+std::string ler_config_buffer_escrita(const std::string &texto, ConfigBufferEscrita &config) {
+    std::stringstream lista(texto);
+    std::string item;
+    while (std::getline(lista, item, ',')) {
+        size_t separador = item.find('=');
+        if (separador == std::string::npos) {
+            return "[ERRO] Item invalido em --buffer-escrita (use chave=valor): " + item;
+        }
+        std::string chave = item.substr(0, separador);
+        uint32_t valor = 0;
+        try {
+            valor = static_cast<uint32_t>(std::stoul(item.substr(separador + 1), nullptr, 0));
+        } catch (const std::exception &) {
+            return "[ERRO] Valor invalido em --buffer-escrita: " + item;
+        }
+        if (chave == "entradas") config.entradas = valor;
+        else if (chave == "limite") config.limite_drenagem = valor;
+        else if (chave == "combinar") config.combinar = valor != 0;
+        else if (chave == "encaminhar") config.encaminhar = valor != 0;
+        else return "[ERRO] Chave desconhecida em --buffer-escrita: " + chave;
+    }
+    return "";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Uso: " << argv[0] << " <programa.hex> [--modo funcional|aquecimento|detalhado]"
+                  << " [--em-instrucao N:modo]... [--em-pc ENDERECO:modo]... [--max N] [--dram chave=valor,...]"
+                  << " [--buffer-escrita chave=valor,...] [--trace arquivo.rvtr] [--trace-zstd]"
+                  << " [--disco imagem.img]" << std::endl;
+        return 2;
+    }
+
+    ModoExecucao modo = ModoExecucao::Funcional;
+    std::vector<GatilhoModo> gatilhos;
+    uint64_t maximo = UINT64_MAX;
+    ConfigDram config_dram;
+    ConfigBufferEscrita config_buffer;
+    std::string caminho_trace;
+    std::string caminho_disco;
+    trace::Compressao compressao_trace = trace::Compressao::Nenhuma;
+    std::string erro;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--modo") == 0 && i + 1 < argc) {
+            if (!ler_modo(argv[++i], modo)) {
+                std::cerr << "[ERRO] Modo desconhecido: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else if ((std::strcmp(argv[i], "--em-instrucao") == 0 || std::strcmp(argv[i], "--em-pc") == 0) &&
+                   i + 1 < argc) {
+            auto tipo = argv[i][5] == 'i' ? GatilhoModo::Tipo::Instrucoes : GatilhoModo::Tipo::Pc;
+            GatilhoModo gatilho;
+            erro = ler_gatilho(argv[++i], tipo, gatilho);
+            if (!erro.empty()) {
+                std::cerr << erro << std::endl;
+                return 2;
+            }
+            gatilhos.push_back(gatilho);
+        } else if (std::strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            maximo = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dram") == 0 && i + 1 < argc) {
+            erro = ler_config_dram(argv[++i], config_dram);
+            if (!erro.empty()) {
+                std::cerr << erro << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--buffer-escrita") == 0 && i + 1 < argc) {
+            erro = ler_config_buffer_escrita(argv[++i], config_buffer);
+            if (!erro.empty()) {
+                std::cerr << erro << std::endl;
+                return 2;
+            }
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            caminho_trace = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace-zstd") == 0) {
+            compressao_trace = trace::Compressao::Zstd;
+        } else if (std::strcmp(argv[i], "--disco") == 0 && i + 1 < argc) {
+            caminho_disco = argv[++i];
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<uint32_t> programa;
+    erro = ler_programa_hex(argv[1], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    erro = core.configurar_dram(config_dram);
+    if (erro.empty()) erro = core.configurar_buffer_escrita(config_buffer);
+    if (erro.empty() && !caminho_disco.empty()) {
+        auto disco = std::make_unique<DispositivoBloco>();
+        erro = disco->abrir(caminho_disco);
+        if (erro.empty()) {
+            erro = core.get_barramento().adicionar_dispositivo(mapa::BLOCO_BASE, mapa::BLOCO_TAMANHO, std::move(disco));
+        }
+    }
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+    core.load_program(programa);
+    // O avanço rápido do modo funcional não pode pagar a formatação do texto de cada instrução
+    core.definir_log(false);
+    core.definir_modo(modo);
+    for (const GatilhoModo &gatilho : gatilhos) {
+        core.adicionar_gatilho_modo(gatilho);
+    }
+
+    GravadorTrace gravador;
+    if (!caminho_trace.empty()) {
+        erro = gravador.abrir(caminho_trace, compressao_trace);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < maximo && !core.is_finished(); ++i) {
+        core.step();
+        if (gravador.aberto() && core.get_ultimo_commit().instrucao != 0) {
+            gravador.registrar(core.get_ultimo_commit());
+        }
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    if (gravador.aberto()) {
+        erro = gravador.fechar();
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+        std::cout << "Trace: " << gravador.get_registros() << " registros, " << gravador.get_bytes_escritos()
+                  << " bytes em " << caminho_trace << std::endl;
+    }
+
+    const ContadoresCore &contadores = core.get_contadores();
+    const ContadoresDetalhado &regiao = core.get_contadores_detalhado();
+    const EstatisticasCache &cache = core.get_estatisticas_cache();
+    uint64_t acessos = cache.leituras + cache.escritas;
+    uint64_t faltas = cache.faltas_leitura + cache.faltas_escrita;
+
+    std::cout << "Instrucoes: " << contadores.instrucoes << " em " << std::fixed << std::setprecision(3)
+              << segundos << " s (" << (segundos > 0 ? contadores.instrucoes / segundos / 1e6 : 0.0)
+              << " MIPS)" << std::endl;
+    if (core.encerrado()) {
+        std::cout << "Codigo de saida: " << core.get_codigo_saida() << std::endl;
+    }
+    std::cout << "--- Regiao de interesse (modo detalhado) ---" << std::endl;
+    std::cout << "Instrucoes: " << regiao.instrucoes << std::endl;
+    std::cout << "Ciclos: " << regiao.ciclos << std::endl;
+    std::cout << "CPI: " << std::setprecision(4)
+              << (regiao.instrucoes ? static_cast<double>(regiao.ciclos) / regiao.instrucoes : 0.0) << std::endl;
+    std::cout << "Acessos ao cache: " << acessos << ", faltas: " << faltas << " ("
+              << (acessos ? 100.0 * faltas / acessos : 0.0) << "%)" << std::endl;
+
+    const EstatisticasDram &dram = core.get_estatisticas_dram();
+    uint64_t requisicoes = dram.acertos_linha + dram.linhas_fechadas + dram.conflitos_linha;
+    auto percentual = [requisicoes](uint64_t parte) { return requisicoes ? 100.0 * parte / requisicoes : 0.0; };
+    std::cout << "DRAM: " << dram.leituras << " leituras, " << dram.escritas << " escritas; latencia media de leitura "
+              << (dram.leituras ? static_cast<double>(dram.ciclos_leitura) / dram.leituras : 0.0) << " ciclos (max "
+              << dram.latencia_maxima_leitura << ")" << std::endl;
+    std::cout << "  Linha: acertos " << percentual(dram.acertos_linha) << "%, fechada "
+              << percentual(dram.linhas_fechadas) << "%, conflitos " << percentual(dram.conflitos_linha)
+              << "%; reordenacoes FR-FCFS: " << dram.reordenacoes << std::endl;
+    std::cout << "  Fila cheia: " << dram.paradas_fila_cheia << " vezes, " << dram.ciclos_fila_cheia << " ciclos"
+              << std::endl;
+
+    const EstatisticasBufferEscrita &buffer = core.get_estatisticas_buffer_escrita();
+    std::cout << "Buffer de escrita: " << buffer.escritas << " escritas, " << buffer.drenagens
+              << " para a DRAM (" << (buffer.drenagens ? static_cast<double>(buffer.escritas) / buffer.drenagens : 0.0)
+              << " por escrita na DRAM), " << buffer.combinadas << " combinadas ("
+              << (buffer.escritas ? 100.0 * buffer.combinadas / buffer.escritas : 0.0) << "%)" << std::endl;
+    std::cout << "  Ocupacao media " << (buffer.ciclos ? static_cast<double>(buffer.ocupacao_acumulada) / buffer.ciclos : 0.0)
+              << " de " << core.get_config_buffer_escrita().entradas << " (max " << buffer.ocupacao_maxima
+              << "); cheio: " << buffer.paradas_cheio << " vezes, " << buffer.ciclos_parados_cheio << " ciclos"
+              << std::endl;
+    std::cout << "  Leituras encaminhadas: " << buffer.encaminhamentos << ", conflitos (drenagem antes da leitura): "
+              << buffer.conflitos_leitura << std::endl;
+    return core.is_finished() ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Simulação amostrada no estilo SimPoint: perfila o programa em modo funcional, agrupa os
+// intervalos pelos vetores de blocos básicos e simula em modo detalhado só os representantes.
+//
+// Uso: simpoint <programa.hex> [--intervalo 100000] [--max-k 10] [--aquecimento 10000]
+//               [--aquecimento-cache 200000] [--limite N] [--semente 1] [--bbv saida.bb] [--completo]
+//
+// A estimativa (CPI do Core e do modelo fora de ordem, faltas do cache) é a média dos
+// pontos ponderada pela fração das instruções de cada cluster. --bbv grava os vetores no
+// formato de texto do SimPoint ("T:bloco:instrucoes ..." por intervalo, blocos numerados
+// a partir de 1). --completo também simula o programa inteiro em modo detalhado e
+// mostra o erro da estimativa.
+//
+// Retorna 0 em caso de sucesso e 2 em caso de erro.
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+#include "core/CarregadorPrograma.h"
+#include "core/Core.h"
+#include "profiling/SimPoint.h"
+
+namespace {
+
+double segundos_desde(std::chrono::steady_clock::time_point inicio) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+}
+
+std::string gravar_bbv(const std::string &caminho, const std::vector<VetorBlocos> &intervalos) {
+    std::ofstream arquivo(caminho);
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel criar o arquivo: " + caminho;
+    }
+    std::unordered_map<uint32_t, uint32_t> numeros;
+    for (const VetorBlocos &vetor : intervalos) {
+        arquivo << 'T';
+        for (const auto &[bloco, instrucoes] : vetor.blocos) {
+            auto [it, novo] = numeros.try_emplace(bloco, static_cast<uint32_t>(numeros.size() + 1));
+            arquivo << ':' << it->second << ':' << instrucoes << ' ';
+        }
+        arquivo << '\n';
+    }
+    return arquivo ? "" : "[ERRO] Falha ao gravar: " + caminho;
+}
+
+// Referência: o programa inteiro em modo detalhado
+MedidaDetalhada simular_completo(Core &core) {
+    ModeloOoO modelo;
+    MedidaDetalhada medida;
+    while (!core.is_finished()) {
+        core.step();
+        modelo.consumir(core.get_ultimo_commit());
+        ++medida.instrucoes;
+    }
+    const EstatisticasCache &cache = core.get_estatisticas_cache();
+    medida.ciclos_core = core.get_contadores().ciclos;
+    medida.ciclos_ooo = modelo.relatorio().ciclos;
+    medida.acessos_cache = cache.leituras + cache.escritas;
+    medida.faltas_cache = cache.faltas_leitura + cache.faltas_escrita;
+    return medida;
+}
+
+void imprimir_erro(const char *nome, double estimado, double real) {
+    std::cout << nome << ": " << estimado << " (real " << real << ", erro "
+              << (real != 0.0 ? 100.0 * (estimado - real) / real : 0.0) << "%)" << std::endl;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argv[1][0] == '-') {
+        std::cerr << "Uso: " << argv[0] << " <programa.hex> [--intervalo 100000] [--max-k 10] [--aquecimento 10000]"
+                  << " [--aquecimento-cache 200000] [--limite N] [--semente 1] [--bbv saida.bb] [--completo]" << std::endl;
+        return 2;
+    }
+
+    ConfigSimPoint config;
+    std::string caminho_bbv;
+    bool completo = false;
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--intervalo") == 0 && i + 1 < argc) {
+            config.tamanho_intervalo = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-k") == 0 && i + 1 < argc) {
+            config.maximo_clusters = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--aquecimento") == 0 && i + 1 < argc) {
+            config.aquecimento = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--aquecimento-cache") == 0 && i + 1 < argc) {
+            config.aquecimento_cache = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--limite") == 0 && i + 1 < argc) {
+            config.limite_instrucoes = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--semente") == 0 && i + 1 < argc) {
+            config.semente = std::stoull(argv[++i]);
+        } else if (std::strcmp(argv[i], "--bbv") == 0 && i + 1 < argc) {
+            caminho_bbv = argv[++i];
+        } else if (std::strcmp(argv[i], "--completo") == 0) {
+            completo = true;
+        } else {
+            std::cerr << "[ERRO] Opcao desconhecida: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<uint32_t> programa;
+    std::string erro = ler_programa_hex(argv[1], programa);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    Core core(1024 * 1024);
+    core.load_program(programa);
+    // O texto de cada instrução não é usado; sem ele, os tempos medem só os modelos
+    core.definir_log(false);
+    SnapshotCore inicial = core.criar_snapshot();
+
+    AmostragemSimPoint amostragem(config);
+    auto inicio = std::chrono::steady_clock::now();
+    erro = amostragem.perfilar(core);
+    double tempo_perfil = segundos_desde(inicio);
+    if (erro.empty()) erro = amostragem.agrupar();
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    if (!caminho_bbv.empty()) {
+        erro = gravar_bbv(caminho_bbv, amostragem.get_intervalos());
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+    }
+
+    const Agrupamento &agrupamento = amostragem.get_agrupamento();
+    std::cout << "Intervalos: " << amostragem.get_intervalos().size() << " de " << config.tamanho_intervalo
+              << " instrucoes; k escolhido: " << agrupamento.k << std::endl;
+    std::cout << "BIC por k:";
+    for (double bic : agrupamento.bic) std::cout << ' ' << std::fixed << std::setprecision(1) << bic;
+    std::cout << std::endl;
+
+    inicio = std::chrono::steady_clock::now();
+    erro = amostragem.simular_pontos(core);
+    double tempo_detalhado = segundos_desde(inicio);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 2;
+    }
+
+    std::cout << "ponto,intervalo,inicio,instrucoes,peso,cpi_core,cpi_ooo,faltas_cache" << std::endl;
+    const std::vector<MedidaDetalhada> &medidas = amostragem.get_medidas();
+    for (size_t i = 0; i < agrupamento.pontos.size(); ++i) {
+        const PontoSimulacao &ponto = agrupamento.pontos[i];
+        const MedidaDetalhada &m = medidas[i];
+        double instrucoes = std::max<double>(m.instrucoes, 1.0);
+        std::cout << i << ',' << ponto.intervalo << ',' << ponto.inicio << ',' << m.instrucoes << ','
+                  << std::setprecision(4) << ponto.peso << ',' << m.ciclos_core / instrucoes << ','
+                  << m.ciclos_ooo / instrucoes << ',' << m.faltas_cache << std::endl;
+    }
+
+    EstimativaSimPoint estimativa = amostragem.estimar();
+    std::cout << estimativa.formatar();
+    std::cout << std::setprecision(3) << "Tempo: perfil funcional " << tempo_perfil << " s, pontos detalhados "
+              << tempo_detalhado << " s" << std::endl;
+
+    if (completo) {
+        erro = core.restaurar_snapshot(inicial);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+            return 2;
+        }
+        inicio = std::chrono::steady_clock::now();
+        MedidaDetalhada real = simular_completo(core);
+        double tempo_completo = segundos_desde(inicio);
+        double instrucoes = std::max<double>(real.instrucoes, 1.0);
+
+        std::cout << "--- Simulacao detalhada completa (" << std::setprecision(3) << tempo_completo << " s) ---"
+                  << std::endl << std::setprecision(4);
+        imprimir_erro("CPI (Core em ordem)", estimativa.cpi_core, real.ciclos_core / instrucoes);
+        imprimir_erro("CPI (modelo fora de ordem)", estimativa.cpi_ooo, real.ciclos_ooo / instrucoes);
+        imprimir_erro("Faltas do cache por mil instrucoes", estimativa.faltas_por_mil,
+                      1000.0 * real.faltas_cache / instrucoes);
+    }
+    return 0;
+}
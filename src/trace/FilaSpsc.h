@@ -0,0 +1,69 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_FILASPSC_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_FILASPSC_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class FilaSpsc
+ * @brief Fila circular sem locks para um produtor e um consumidor.
+ *
+ * A capacidade é arredondada para potência de 2. O produtor só escreve
+ * 'cauda' e o consumidor só escreve 'cabeca', então basta ordenar as
+ * publicações com acquire/release.
+ */
+template<typename T>
+class FilaSpsc {
+public:
+    explicit FilaSpsc(size_t capacidade_minima) {
+        size_t capacidade = 1;
+        while (capacidade < capacidade_minima) capacidade <<= 1;
+        itens.resize(capacidade);
+        mascara = capacidade - 1;
+    }
+
+    // Produtor: retorna false se a fila estiver cheia
+    bool inserir(const T& item) {
+        size_t cauda_atual = cauda.load(std::memory_order_relaxed);
+        if (cauda_atual - cabeca_em_cache == itens.size()) {
+            cabeca_em_cache = cabeca.load(std::memory_order_acquire);
+            if (cauda_atual - cabeca_em_cache == itens.size()) return false;
+        }
+        itens[cauda_atual & mascara] = item;
+        cauda.store(cauda_atual + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumidor: copia até 'maximo' itens para 'destino' e retorna quantos foram retirados
+    size_t retirar(T* destino, size_t maximo) {
+        size_t cabeca_atual = cabeca.load(std::memory_order_relaxed);
+        size_t disponiveis = cauda.load(std::memory_order_acquire) - cabeca_atual;
+        size_t n = disponiveis < maximo ? disponiveis : maximo;
+        for (size_t i = 0; i < n; ++i) {
+            destino[i] = itens[(cabeca_atual + i) & mascara];
+        }
+        cabeca.store(cabeca_atual + n, std::memory_order_release);
+        return n;
+    }
+
+    bool vazia() const {
+        return cabeca.load(std::memory_order_acquire) == cauda.load(std::memory_order_acquire);
+    }
+
+    size_t capacidade() const {
+        return itens.size();
+    }
+
+private:
+    std::vector<T> itens;
+    size_t mascara = 0;
+
+    // Índices em linhas de cache separadas para evitar falso compartilhamento
+    alignas(64) std::atomic<size_t> cabeca{0};
+    alignas(64) std::atomic<size_t> cauda{0};
+    // Cópia local do produtor para evitar ler 'cabeca' a cada inserção
+    alignas(64) size_t cabeca_em_cache = 0;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_FILASPSC_H
@@ -0,0 +1,422 @@
+#include "TraceBinario.h"
+
+#include <chrono>
+#include <cstring>
+
+#ifdef SIMULADOR_COM_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+    constexpr char MAGICO[4] = {'R', 'V', 'T', 'R'};
+
+    // Bits do byte de flags de cada registro
+    constexpr uint8_t FLAG_PC = 0x01;          // PC diferente do previsto
+    constexpr uint8_t FLAG_SALTO = 0x02;       // proximo_pc != pc + 4
+    constexpr uint8_t FLAG_RD = 0x04;          // escrita em rd
+    constexpr uint8_t FLAG_INSTRUCAO = 0x08;   // palavra da instrução presente
+    constexpr uint8_t DESLOC_ACESSO = 4;       // 2 bits: AcessoMemoria
+    constexpr uint8_t DESLOC_TAMANHO = 6;      // 2 bits: log2(tamanho do acesso)
+
+    constexpr size_t REGISTROS_POR_LOTE = 4096;
+    constexpr size_t TAMANHO_BLOCO_ARQUIVO = 1 << 16;
+
+    uint32_t zigzag(int32_t valor) {
+        return (static_cast<uint32_t>(valor) << 1) ^ static_cast<uint32_t>(valor >> 31);
+    }
+
+    int32_t dezigzag(uint32_t valor) {
+        return static_cast<int32_t>((valor >> 1) ^ (~(valor & 1) + 1));
+    }
+
+    void escrever_varint(std::vector<uint8_t>& saida, uint32_t valor) {
+        while (valor >= 0x80) {
+            saida.push_back(static_cast<uint8_t>(valor | 0x80));
+            valor >>= 7;
+        }
+        saida.push_back(static_cast<uint8_t>(valor));
+    }
+
+    // Retorna false se os bytes acabarem no meio do número
+    bool ler_varint(const uint8_t*& p, const uint8_t* fim, uint32_t& valor) {
+        valor = 0;
+        for (uint32_t desloc = 0; desloc < 35; desloc += 7) {
+            if (p == fim) return false;
+            uint8_t byte = *p++;
+            valor |= static_cast<uint32_t>(byte & 0x7F) << desloc;
+            if (!(byte & 0x80)) return true;
+        }
+        return true;
+    }
+
+    uint32_t log2_tamanho(uint32_t tamanho) {
+        switch (tamanho) {
+            case 2: return 1;
+            case 4: return 2;
+            case 8: return 3;
+            default: return 0;
+        }
+    }
+}
+
+bool trace::zstd_disponivel() {
+#ifdef SIMULADOR_COM_ZSTD
+    return true;
+#else
+    return false;
+#endif
+}
+
+// --- CodificadorTrace ---
+
+CodificadorTrace::CodificadorTrace() {
+    reset();
+}
+
+void CodificadorTrace::reset() {
+    pc_previsto = 0;
+    ultimo_endereco = 0;
+    registradores.fill(0);
+    pcs_instrucoes.fill(UINT32_MAX);
+    palavras_instrucoes.fill(0);
+}
+
+void CodificadorTrace::codificar(const RegistroCommit &registro, std::vector<uint8_t> &saida) {
+    size_t slot = (registro.pc >> 2) & (TAMANHO_CACHE_INSTRUCOES - 1);
+    bool instrucao_conhecida = pcs_instrucoes[slot] == registro.pc &&
+                               palavras_instrucoes[slot] == registro.instrucao;
+
+    uint8_t flags = 0;
+    if (registro.pc != pc_previsto) flags |= FLAG_PC;
+    if (registro.proximo_pc != registro.pc + 4) flags |= FLAG_SALTO;
+    if (registro.rd != 0) flags |= FLAG_RD;
+    if (!instrucao_conhecida) flags |= FLAG_INSTRUCAO;
+    flags |= static_cast<uint8_t>(registro.acesso) << DESLOC_ACESSO;
+    flags |= static_cast<uint8_t>(log2_tamanho(registro.tamanho_acesso) << DESLOC_TAMANHO);
+    saida.push_back(flags);
+
+    if (flags & FLAG_PC) {
+        escrever_varint(saida, zigzag(static_cast<int32_t>(registro.pc - pc_previsto)));
+    }
+    if (flags & FLAG_INSTRUCAO) {
+        for (int i = 0; i < 4; ++i) saida.push_back(static_cast<uint8_t>(registro.instrucao >> (8 * i)));
+        pcs_instrucoes[slot] = registro.pc;
+        palavras_instrucoes[slot] = registro.instrucao;
+    }
+    if (flags & FLAG_SALTO) {
+        escrever_varint(saida, zigzag(static_cast<int32_t>(registro.proximo_pc - registro.pc)));
+    }
+    if (flags & FLAG_RD) {
+        saida.push_back(static_cast<uint8_t>(registro.rd));
+        escrever_varint(saida, zigzag(static_cast<int32_t>(registro.valor_rd - registradores[registro.rd & 0x1F])));
+        registradores[registro.rd & 0x1F] = registro.valor_rd;
+    }
+    if (registro.acesso != AcessoMemoria::Nenhum) {
+        escrever_varint(saida, zigzag(static_cast<int32_t>(registro.endereco_memoria - ultimo_endereco)));
+        escrever_varint(saida, registro.dado_memoria);
+        ultimo_endereco = registro.endereco_memoria;
+    }
+
+    pc_previsto = registro.proximo_pc;
+}
+
+size_t CodificadorTrace::decodificar(const uint8_t *dados, size_t tamanho, RegistroCommit &registro) {
+    const uint8_t* p = dados;
+    const uint8_t* fim = dados + tamanho;
+    if (p == fim) return 0;
+
+    // Decodifica em variáveis locais: o estado só muda se o registro estiver completo
+    uint8_t flags = *p++;
+    RegistroCommit r;
+    uint32_t valor = 0;
+
+    r.pc = pc_previsto;
+    if (flags & FLAG_PC) {
+        if (!ler_varint(p, fim, valor)) return 0;
+        r.pc = pc_previsto + static_cast<uint32_t>(dezigzag(valor));
+    }
+
+    size_t slot = (r.pc >> 2) & (TAMANHO_CACHE_INSTRUCOES - 1);
+    if (flags & FLAG_INSTRUCAO) {
+        if (fim - p < 4) return 0;
+        r.instrucao = 0;
+        for (int i = 0; i < 4; ++i) r.instrucao |= static_cast<uint32_t>(*p++) << (8 * i);
+    } else {
+        r.instrucao = palavras_instrucoes[slot];
+    }
+
+    r.proximo_pc = r.pc + 4;
+    if (flags & FLAG_SALTO) {
+        if (!ler_varint(p, fim, valor)) return 0;
+        r.proximo_pc = r.pc + static_cast<uint32_t>(dezigzag(valor));
+    }
+
+    if (flags & FLAG_RD) {
+        if (p == fim) return 0;
+        r.rd = *p++ & 0x1F;
+        if (!ler_varint(p, fim, valor)) return 0;
+        r.valor_rd = registradores[r.rd] + static_cast<uint32_t>(dezigzag(valor));
+    }
+
+    r.acesso = static_cast<AcessoMemoria>((flags >> DESLOC_ACESSO) & 0x3);
+    if (r.acesso != AcessoMemoria::Nenhum) {
+        r.tamanho_acesso = 1u << ((flags >> DESLOC_TAMANHO) & 0x3);
+        if (!ler_varint(p, fim, valor)) return 0;
+        r.endereco_memoria = ultimo_endereco + static_cast<uint32_t>(dezigzag(valor));
+        if (!ler_varint(p, fim, r.dado_memoria)) return 0;
+        ultimo_endereco = r.endereco_memoria;
+    }
+
+    if (flags & FLAG_INSTRUCAO) {
+        pcs_instrucoes[slot] = r.pc;
+        palavras_instrucoes[slot] = r.instrucao;
+    }
+    if (flags & FLAG_RD) registradores[r.rd] = r.valor_rd;
+    pc_previsto = r.proximo_pc;
+
+    registro = r;
+    return static_cast<size_t>(p - dados);
+}
+
+// --- GravadorTrace ---
+
+GravadorTrace::~GravadorTrace() {
+    fechar();
+}
+
+std::string GravadorTrace::abrir(const std::string &caminho, trace::Compressao compressao, size_t capacidade_fila) {
+    fechar();
+
+    if (compressao == trace::Compressao::Zstd && !trace::zstd_disponivel()) {
+        return "[ERRO] Compressao zstd nao disponivel nesta compilacao.";
+    }
+
+    arquivo = std::fopen(caminho.c_str(), "wb");
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel criar o arquivo de trace: " + caminho;
+    }
+
+    uint8_t cabecalho[trace::TAMANHO_CABECALHO] = {};
+    std::memcpy(cabecalho, MAGICO, 4);
+    cabecalho[4] = trace::VERSAO;
+    cabecalho[5] = static_cast<uint8_t>(compressao);
+    std::fwrite(cabecalho, 1, sizeof(cabecalho), arquivo);
+
+    this->compressao = compressao;
+#ifdef SIMULADOR_COM_ZSTD
+    if (compressao == trace::Compressao::Zstd) {
+        ZSTD_CCtx* ctx = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, 3);
+        contexto_compressao = ctx;
+    }
+#endif
+
+    fila = std::make_unique<FilaSpsc<RegistroCommit>>(capacidade_fila);
+    registros = 0;
+    esperas = 0;
+    bytes_escritos = trace::TAMANHO_CABECALHO;
+    erro_escrita.clear();
+    encerrar = false;
+    escritor = std::thread(&GravadorTrace::laco_escritor, this);
+    return "";
+}
+
+std::string GravadorTrace::fechar() {
+    if (!arquivo) return "";
+
+    encerrar = true;
+    if (escritor.joinable()) escritor.join();
+    fila.reset();
+
+#ifdef SIMULADOR_COM_ZSTD
+    if (contexto_compressao) {
+        ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(contexto_compressao));
+        contexto_compressao = nullptr;
+    }
+#endif
+
+    if (std::fclose(arquivo) != 0 && erro_escrita.empty()) {
+        erro_escrita = "[ERRO] Falha ao fechar o arquivo de trace.";
+    }
+    arquivo = nullptr;
+    return erro_escrita;
+}
+
+bool GravadorTrace::aberto() const {
+    return arquivo != nullptr;
+}
+
+void GravadorTrace::registrar_com_espera(const RegistroCommit &registro) {
+    ++esperas;
+    while (!fila->inserir(registro)) {
+        std::this_thread::yield();
+    }
+}
+
+uint64_t GravadorTrace::get_registros() const {
+    return registros;
+}
+
+uint64_t GravadorTrace::get_esperas() const {
+    return esperas;
+}
+
+uint64_t GravadorTrace::get_bytes_escritos() const {
+    return bytes_escritos.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Laço da thread escritora: retira lotes da fila, codifica e grava.
+ */
+void GravadorTrace::laco_escritor() {
+    CodificadorTrace codificador;
+    std::vector<RegistroCommit> lote(REGISTROS_POR_LOTE);
+    std::vector<uint8_t> bytes;
+    bytes.reserve(TAMANHO_BLOCO_ARQUIVO + 64);
+
+    while (true) {
+        // Lê 'encerrar' antes de esvaziar a fila para não perder os últimos registros
+        bool ultimo = encerrar.load(std::memory_order_acquire);
+        size_t n = fila->retirar(lote.data(), lote.size());
+
+        for (size_t i = 0; i < n; ++i) {
+            codificador.codificar(lote[i], bytes);
+            if (bytes.size() >= TAMANHO_BLOCO_ARQUIVO) {
+                escrever_bloco(bytes.data(), bytes.size(), false);
+                bytes.clear();
+            }
+        }
+
+        if (n == 0) {
+            if (ultimo) break;
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    escrever_bloco(bytes.data(), bytes.size(), true);
+}
+
+bool GravadorTrace::escrever_bloco(const uint8_t *dados, size_t tamanho, [[maybe_unused]] bool final) {
+    if (compressao == trace::Compressao::Nenhuma) {
+        if (tamanho > 0 && std::fwrite(dados, 1, tamanho, arquivo) != tamanho) {
+            erro_escrita = "[ERRO] Falha ao gravar o trace.";
+            return false;
+        }
+        bytes_escritos += tamanho;
+        return true;
+    }
+
+#ifdef SIMULADOR_COM_ZSTD
+    auto* ctx = static_cast<ZSTD_CCtx*>(contexto_compressao);
+    std::vector<uint8_t> comprimido(ZSTD_CStreamOutSize());
+    ZSTD_inBuffer entrada{dados, tamanho, 0};
+    ZSTD_EndDirective modo = final ? ZSTD_e_end : ZSTD_e_continue;
+
+    while (true) {
+        ZSTD_outBuffer saida{comprimido.data(), comprimido.size(), 0};
+        size_t restante = ZSTD_compressStream2(ctx, &saida, &entrada, modo);
+        if (ZSTD_isError(restante)) {
+            erro_escrita = std::string("[ERRO] Falha na compressao do trace: ") + ZSTD_getErrorName(restante);
+            return false;
+        }
+        if (saida.pos > 0 && std::fwrite(comprimido.data(), 1, saida.pos, arquivo) != saida.pos) {
+            erro_escrita = "[ERRO] Falha ao gravar o trace.";
+            return false;
+        }
+        bytes_escritos += saida.pos;
+
+        bool consumiu = entrada.pos == entrada.size;
+        if (final ? restante == 0 : consumiu) break;
+    }
+#endif
+    return true;
+}
+
+// --- LeitorTrace ---
+
+LeitorTrace::~LeitorTrace() {
+#ifdef SIMULADOR_COM_ZSTD
+    if (contexto_descompressao) ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(contexto_descompressao));
+#endif
+    if (arquivo) std::fclose(arquivo);
+}
+
+std::string LeitorTrace::abrir(const std::string &caminho) {
+    arquivo = std::fopen(caminho.c_str(), "rb");
+    if (!arquivo) {
+        return "[ERRO] Nao foi possivel abrir o arquivo de trace: " + caminho;
+    }
+
+    uint8_t cabecalho[trace::TAMANHO_CABECALHO];
+    if (std::fread(cabecalho, 1, sizeof(cabecalho), arquivo) != sizeof(cabecalho) ||
+        std::memcmp(cabecalho, MAGICO, 4) != 0) {
+        return "[ERRO] Arquivo nao e um trace binario: " + caminho;
+    }
+    if (cabecalho[4] != trace::VERSAO) {
+        return "[ERRO] Versao de trace nao suportada: " + std::to_string(cabecalho[4]);
+    }
+
+    compressao = static_cast<trace::Compressao>(cabecalho[5]);
+    if (compressao == trace::Compressao::Zstd) {
+#ifdef SIMULADOR_COM_ZSTD
+        contexto_descompressao = ZSTD_createDCtx();
+#else
+        return "[ERRO] Trace comprimido com zstd, mas o suporte nao foi compilado.";
+#endif
+    } else if (compressao != trace::Compressao::Nenhuma) {
+        return "[ERRO] Compressao de trace desconhecida.";
+    }
+
+    bruto.resize(TAMANHO_BLOCO_ARQUIVO);
+    codificador.reset();
+    return "";
+}
+
+/**
+ * @brief Acrescenta mais bytes decodificáveis em 'dados'. Retorna false se nada foi lido.
+ */
+bool LeitorTrace::preencher() {
+    // Descarta o que já foi consumido
+    dados.erase(dados.begin(), dados.begin() + static_cast<std::ptrdiff_t>(inicio));
+    inicio = 0;
+
+    if (inicio_bruto == fim_bruto && !fim_arquivo) {
+        fim_bruto = std::fread(bruto.data(), 1, bruto.size(), arquivo);
+        inicio_bruto = 0;
+        if (fim_bruto == 0) fim_arquivo = true;
+    }
+
+    if (compressao == trace::Compressao::Nenhuma) {
+        if (inicio_bruto == fim_bruto) return false;
+        dados.insert(dados.end(), bruto.begin() + static_cast<std::ptrdiff_t>(inicio_bruto),
+                     bruto.begin() + static_cast<std::ptrdiff_t>(fim_bruto));
+        inicio_bruto = fim_bruto;
+        return true;
+    }
+
+#ifdef SIMULADOR_COM_ZSTD
+    auto* ctx = static_cast<ZSTD_DCtx*>(contexto_descompressao);
+    size_t anterior = dados.size();
+    dados.resize(anterior + ZSTD_DStreamOutSize());
+    ZSTD_inBuffer entrada{bruto.data() + inicio_bruto, fim_bruto - inicio_bruto, 0};
+    ZSTD_outBuffer saida{dados.data() + anterior, dados.size() - anterior, 0};
+    size_t r = ZSTD_decompressStream(ctx, &saida, &entrada);
+    dados.resize(anterior + saida.pos);
+    inicio_bruto += entrada.pos;
+    // Mesmo sem entrada nova o zstd pode ter saída pendente; para quando não houver progresso
+    return !ZSTD_isError(r) && (saida.pos > 0 || entrada.pos > 0);
+#else
+    return false;
+#endif
+}
+
+bool LeitorTrace::proximo(RegistroCommit &registro) {
+    while (true) {
+        size_t n = codificador.decodificar(dados.data() + inicio, dados.size() - inicio, registro);
+        if (n > 0) {
+            inicio += n;
+            return true;
+        }
+        if (!preencher()) return false;
+    }
+}
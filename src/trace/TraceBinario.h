@@ -0,0 +1,153 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_TRACEBINARIO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_TRACEBINARIO_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/RegistroCommit.h"
+#include "FilaSpsc.h"
+
+/**
+ * Formato do trace binário de commits (.rvtr):
+ *
+ *   cabeçalho: "RVTR", versão (1 byte), compressão (1 byte), 2 bytes reservados
+ *   corpo:     sequência de registros, comprimida inteira se compressão != 0
+ *
+ * Cada registro começa com um byte de flags e guarda apenas o que não pode
+ * ser previsto: o PC só aparece quando não é o próximo PC esperado, a palavra
+ * da instrução só quando muda naquele endereço, o valor de rd como delta do
+ * valor anterior do mesmo registrador e o endereço de memória como delta do
+ * último acesso. Deltas usam zigzag + varint (LEB128).
+ */
+namespace trace {
+    enum class Compressao : uint8_t {
+        Nenhuma = 0,
+        Zstd = 1
+    };
+
+    constexpr uint8_t VERSAO = 1;
+    constexpr size_t TAMANHO_CABECALHO = 8;
+
+    // Informa se o binário foi compilado com suporte a zstd
+    bool zstd_disponivel();
+}
+
+/**
+ * @class CodificadorTrace
+ * @brief Converte RegistroCommit em bytes (e vice-versa) mantendo o estado dos deltas.
+ *
+ * O codificador e o decodificador guardam o mesmo estado, então precisam
+ * ver os registros na mesma ordem.
+ */
+class CodificadorTrace {
+public:
+    CodificadorTrace();
+
+    void reset();
+    void codificar(const RegistroCommit& registro, std::vector<uint8_t>& saida);
+    // Retorna quantos bytes foram consumidos, ou 0 se o registro estiver incompleto
+    size_t decodificar(const uint8_t* dados, size_t tamanho, RegistroCommit& registro);
+
+private:
+    static constexpr size_t TAMANHO_CACHE_INSTRUCOES = 1024;
+
+    uint32_t pc_previsto = 0;
+    uint32_t ultimo_endereco = 0;
+    std::array<uint32_t, 32> registradores{};
+    // Palavra vista por último em cada PC (mapeamento direto por pc >> 2)
+    std::array<uint32_t, TAMANHO_CACHE_INSTRUCOES> pcs_instrucoes{};
+    std::array<uint32_t, TAMANHO_CACHE_INSTRUCOES> palavras_instrucoes{};
+};
+
+/**
+ * @class GravadorTrace
+ * @brief Grava o trace em disco a partir de uma thread de fundo.
+ *
+ * O simulador só copia cada RegistroCommit para uma fila sem locks; a
+ * codificação, a compressão e a escrita acontecem na thread escritora.
+ * Se a fila encher, o produtor espera (e conta a espera) em vez de perder
+ * registros.
+ */
+class GravadorTrace {
+public:
+    GravadorTrace() = default;
+    ~GravadorTrace();
+
+    GravadorTrace(const GravadorTrace&) = delete;
+    GravadorTrace& operator=(const GravadorTrace&) = delete;
+
+    // Retorna uma mensagem de erro, ou string vazia em caso de sucesso
+    std::string abrir(const std::string& caminho, trace::Compressao compressao = trace::Compressao::Nenhuma,
+                      size_t capacidade_fila = 1 << 16);
+    std::string fechar();
+    bool aberto() const;
+
+    // Sem abrir() (ou depois de fechar()), o registro é descartado
+    void registrar(const RegistroCommit& registro) {
+        if (!fila) return;
+        if (!fila->inserir(registro)) registrar_com_espera(registro);
+        ++registros;
+    }
+
+    uint64_t get_registros() const;
+    uint64_t get_esperas() const;
+    uint64_t get_bytes_escritos() const;
+
+private:
+    void registrar_com_espera(const RegistroCommit& registro);
+    void laco_escritor();
+    bool escrever_bloco(const uint8_t* dados, size_t tamanho, bool final);
+
+    std::unique_ptr<FilaSpsc<RegistroCommit>> fila;
+    std::thread escritor;
+    std::atomic<bool> encerrar{false};
+
+    std::FILE* arquivo = nullptr;
+    trace::Compressao compressao = trace::Compressao::Nenhuma;
+    void* contexto_compressao = nullptr;
+    std::string erro_escrita;
+
+    uint64_t registros = 0;
+    uint64_t esperas = 0;
+    std::atomic<uint64_t> bytes_escritos{0};
+};
+
+/**
+ * @class LeitorTrace
+ * @brief Lê sequencialmente um trace gravado pelo GravadorTrace.
+ */
+class LeitorTrace {
+public:
+    LeitorTrace() = default;
+    ~LeitorTrace();
+
+    LeitorTrace(const LeitorTrace&) = delete;
+    LeitorTrace& operator=(const LeitorTrace&) = delete;
+
+    std::string abrir(const std::string& caminho);
+    // Retorna false no fim do arquivo
+    bool proximo(RegistroCommit& registro);
+
+private:
+    bool preencher();
+
+    std::FILE* arquivo = nullptr;
+    trace::Compressao compressao = trace::Compressao::Nenhuma;
+    void* contexto_descompressao = nullptr;
+
+    CodificadorTrace codificador;
+    std::vector<uint8_t> bruto;      // bytes lidos do arquivo
+    size_t inicio_bruto = 0;
+    size_t fim_bruto = 0;
+    std::vector<uint8_t> dados;      // bytes já descomprimidos
+    size_t inicio = 0;
+    bool fim_arquivo = false;
+};
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_TRACEBINARIO_H
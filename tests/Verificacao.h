@@ -0,0 +1,67 @@
+#ifndef SIMULADOR_DE_PROCESSADOR_RISC_V_VERIFICACAO_H
+#define SIMULADOR_DE_PROCESSADOR_RISC_V_VERIFICACAO_H
+
+// Verificações mínimas para os testes do ctest (sem dependência de framework).
+// Uma falha é impressa e contada, e o teste continua; o main retorna resultado_testes().
+
+#include <cstdint>
+#include <iostream>
+
+namespace verificacao {
+    inline int falhas = 0;
+
+    template <typename A, typename B>
+    void comparar(const A& obtido, const B& esperado, const char* expressao, const char* arquivo, int linha) {
+        if (obtido == esperado) return;
+        ++falhas;
+        std::cerr << arquivo << ":" << linha << ": FALHOU " << expressao
+                  << " (obtido " << obtido << ", esperado " << esperado << ")\n";
+    }
+
+    inline void verdadeiro(bool condicao, const char* expressao, const char* arquivo, int linha) {
+        if (condicao) return;
+        ++falhas;
+        std::cerr << arquivo << ":" << linha << ": FALHOU " << expressao << "\n";
+    }
+
+    // Codificação das instruções usadas nos programas de teste
+    inline uint32_t tipo_r(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+        return (funct7 << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+    }
+
+    inline uint32_t tipo_i(int32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+        return (static_cast<uint32_t>(imm & 0xFFF) << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | opcode;
+    }
+
+    inline uint32_t tipo_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+        uint32_t u = static_cast<uint32_t>(imm & 0xFFF);
+        return ((u >> 5) << 25) | (rs2 << 20) | (rs1 << 15) | (funct3 << 12) | ((u & 0x1F) << 7) | 0x23;
+    }
+
+    inline uint32_t addi(uint32_t rd, uint32_t rs1, int32_t imm) { return tipo_i(imm, rs1, 0x0, rd, 0x13); }
+    inline uint32_t lw(uint32_t rd, uint32_t rs1, int32_t imm) { return tipo_i(imm, rs1, 0x2, rd, 0x03); }
+    inline uint32_t sw(uint32_t rs2, uint32_t rs1, int32_t imm) { return tipo_s(imm, rs2, rs1, 0x2); }
+    inline uint32_t lui(uint32_t rd, uint32_t imm20) { return (imm20 << 12) | (rd << 7) | 0x37; }
+    // csrrw/csrrs/csrrc (funct3 1..3) e as versões com imediato (5..7)
+    inline uint32_t csr(uint32_t funct3, uint32_t rd, uint32_t endereco, uint32_t rs1) {
+        return (endereco << 20) | (rs1 << 15) | (funct3 << 12) | (rd << 7) | 0x73;
+    }
+    inline uint32_t csrr(uint32_t rd, uint32_t endereco) { return csr(0x2, rd, endereco, 0); }
+    inline uint32_t csrw(uint32_t endereco, uint32_t rs1) { return csr(0x1, 0, endereco, rs1); }
+    constexpr uint32_t NOP = 0x00000013;
+
+    inline int resultado_testes(const char* nome) {
+        if (falhas == 0) {
+            std::cout << nome << ": OK\n";
+            return 0;
+        }
+        std::cerr << nome << ": " << falhas << " verificacao(oes) falharam\n";
+        return 1;
+    }
+}
+
+#define VERIFICAR(expr) ::verificacao::verdadeiro(static_cast<bool>(expr), #expr, __FILE__, __LINE__)
+#define VERIFICAR_IGUAL(obtido, esperado) \
+    ::verificacao::comparar((obtido), (esperado), #obtido " == " #esperado, __FILE__, __LINE__)
+
+#endif //SIMULADOR_DE_PROCESSADOR_RISC_V_VERIFICACAO_H
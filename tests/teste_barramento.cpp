@@ -0,0 +1,160 @@
+// Mapa de endereços: execução a partir da ROM, fim do programa pelo tipo da região do PC e dispositivos
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "bus/Dispositivos.h"
+#include "core/Core.h"
+#include "syscall/ProxySyscalls.h"
+
+using namespace verificacao;
+
+namespace {
+    uint32_t jalr(uint32_t rd, uint32_t rs1, int32_t imm) { return tipo_i(imm, rs1, 0x0, rd, 0x67); }
+    uint32_t sb(uint32_t rs2, uint32_t rs1, int32_t imm) { return tipo_s(imm, rs2, rs1, 0x0); }
+
+    std::vector<uint8_t> bytes_programa(const std::vector<uint32_t>& palavras) {
+        std::vector<uint8_t> bytes;
+        for (uint32_t palavra : palavras) {
+            for (int i = 0; i < 4; ++i) bytes.push_back(static_cast<uint8_t>(palavra >> (8 * i)));
+        }
+        return bytes;
+    }
+
+    // Chama uma rotina na ROM (logo depois do fim da RAM) e volta para a RAM
+    void testar_execucao_rom(ModoExecucao modo) {
+        const uint32_t tamanho_ram = 64 * 1024;
+        Core core(tamanho_ram);
+        core.definir_modo(modo);
+        VERIFICAR_IGUAL(core.get_barramento().adicionar_rom(tamanho_ram, bytes_programa({
+            addi(5, 0, 42),
+            addi(6, 5, 1),
+            jalr(0, 1, 0),
+        })), std::string());
+
+        core.load_program({lui(2, tamanho_ram >> 12), jalr(1, 2, 0), addi(7, 6, 1), 0});
+        for (int i = 0; i < 20 && !core.is_finished(); ++i) core.step();
+
+        auto regs = core.get_registradores();
+        VERIFICAR_IGUAL(regs[5], 42u);
+        VERIFICAR_IGUAL(regs[6], 43u);
+        VERIFICAR_IGUAL(regs[7], 44u);
+        VERIFICAR(core.is_finished());
+        VERIFICAR_IGUAL(core.get_program_counter(), Core::PC_FINALIZADO);
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, 6u);
+    }
+
+    void testar_fim_fora_do_mapa() {
+        Core core(64 * 1024);
+        // Saltar para fora da RAM, sem região mapeada, termina a simulação
+        core.load_program({lui(2, 0x40000), jalr(0, 2, 0)});
+        core.step();
+        VERIFICAR(!core.is_finished());
+        core.step();
+        VERIFICAR(core.is_finished());
+        VERIFICAR_IGUAL(core.get_program_counter(), 0x40000000u);
+
+        // Um dispositivo também não é executável
+        Core outro(64 * 1024);
+        TipoRegiao tipo;
+        if (outro.tipo_memoria(0x10000000, tipo) && tipo == TipoRegiao::Mmio) {
+            outro.load_program({lui(2, 0x10000), jalr(0, 2, 0)});
+            outro.step();
+            outro.step();
+            VERIFICAR(outro.is_finished());
+        }
+    }
+
+    uint32_t ler(Core& core, uint32_t endereco) {
+        uint32_t valor = 0;
+        VERIFICAR(core.get_barramento().ler(endereco, 4, valor));
+        return valor;
+    }
+
+    void testar_uart_e_clint() {
+        Core core(64 * 1024);
+        std::string saida;
+        core.get_proxy_syscalls().definir_destino_saida([&saida](int descritor, const char* dados, size_t tamanho) {
+            if (descritor == 1) saida.append(dados, tamanho);
+        });
+
+        // Imprime "Ok" pela UART, arma mtimecmp = 100, liga msip e escreve mtime = 100
+        core.load_program({
+            lui(1, 0x10000), addi(2, 0, 'O'), sb(2, 1, 0), addi(2, 0, 'k'), sb(2, 1, 0),
+            lui(3, 0x02004), addi(4, 0, 100), sw(4, 3, 0), sw(0, 3, 4),
+            lui(5, 0x02000), addi(6, 0, 1), sw(6, 5, 0),
+            lui(7, 0x0200C), sw(4, 7, -8),
+            0,
+        });
+        for (int i = 0; i < 50 && !core.is_finished(); ++i) core.step();
+
+        // A saída da UART vai para o mesmo destino do stdout das syscalls, entregue no fim
+        VERIFICAR_IGUAL(saida, std::string("Ok"));
+        VERIFICAR_IGUAL(core.get_uart().consumir_saida(), std::string());
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MTIMECMP), 100u);
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MSIP), 1u);
+        VERIFICAR(ler(core, mapa::CLINT_BASE + Clint::REG_MTIME) >= 100u);
+
+        // O reset volta o CLINT e a UART ao estado inicial
+        core.get_uart().enviar_entrada("abc");
+        core.reset();
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MTIMECMP), 0xFFFFFFFFu);
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MTIMECMP + 4), 0xFFFFFFFFu);
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MSIP), 0u);
+        VERIFICAR_IGUAL(ler(core, mapa::CLINT_BASE + Clint::REG_MTIME), 0u);
+        VERIFICAR_IGUAL(ler(core, mapa::UART_BASE + Uart::REG_LSR) & Uart::LSR_DADO_PRONTO, 0u);
+
+        // Sem destino, a saída acumulada é limitada
+        core.get_uart().definir_destino_saida(nullptr);
+        for (size_t i = 0; i < Uart::TAMANHO_MAXIMO_SAIDA + 10; ++i) {
+            core.get_barramento().escrever(mapa::UART_BASE, 'a' + i % 26, 1);
+        }
+        std::string acumulada = core.get_uart().consumir_saida();
+        VERIFICAR(acumulada.size() <= Uart::TAMANHO_MAXIMO_SAIDA && acumulada.size() > Uart::TAMANHO_MAXIMO_SAIDA / 2);
+        VERIFICAR_IGUAL(acumulada.back(), static_cast<char>('a' + (Uart::TAMANHO_MAXIMO_SAIDA + 9) % 26));
+    }
+
+    void testar_disco() {
+        const std::string caminho = "teste_barramento.img";
+        {
+            std::ofstream imagem(caminho, std::ios::binary);
+            imagem << std::string(2 * DispositivoBloco::TAMANHO_SETOR, '\0');
+        }
+
+        Core core(64 * 1024);
+        auto disco = std::make_unique<DispositivoBloco>();
+        VERIFICAR_IGUAL(disco->abrir(caminho), std::string());
+        VERIFICAR_IGUAL(core.get_barramento().adicionar_dispositivo(mapa::BLOCO_BASE, mapa::BLOCO_TAMANHO,
+                                                                    std::move(disco)), std::string());
+
+        // Grava 0x12345678 no início do setor 1 e o lê de volta
+        Barramento& barramento = core.get_barramento();
+        VERIFICAR_IGUAL(ler(core, mapa::BLOCO_BASE + DispositivoBloco::REG_NUM_SETORES), 2u);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::JANELA_DADOS, 0x12345678, 4);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::REG_SETOR, 1, 4);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::REG_COMANDO, DispositivoBloco::COMANDO_ESCREVER, 4);
+        VERIFICAR_IGUAL(ler(core, mapa::BLOCO_BASE + DispositivoBloco::REG_STATUS), 0u);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::JANELA_DADOS, 0, 4);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::REG_COMANDO, DispositivoBloco::COMANDO_LER, 4);
+        VERIFICAR_IGUAL(ler(core, mapa::BLOCO_BASE + DispositivoBloco::JANELA_DADOS), 0x12345678u);
+
+        // Setor fora da imagem
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::REG_SETOR, 2, 4);
+        barramento.escrever(mapa::BLOCO_BASE + DispositivoBloco::REG_COMANDO, DispositivoBloco::COMANDO_LER, 4);
+        VERIFICAR_IGUAL(ler(core, mapa::BLOCO_BASE + DispositivoBloco::REG_STATUS), 1u);
+        std::remove(caminho.c_str());
+    }
+}
+
+int main() {
+    testar_execucao_rom(ModoExecucao::Detalhado);
+    testar_execucao_rom(ModoExecucao::Funcional);
+    testar_fim_fora_do_mapa();
+    testar_uart_e_clint();
+    testar_disco();
+    return resultado_testes("teste_barramento");
+}
@@ -0,0 +1,146 @@
+// Buffer de escrita: combinação, buffer cheio, encaminhamento para leituras e drenagem pelo limite
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "cache/BufferEscrita.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    constexpr uint32_t BLOCO = 32;
+    // Bloco do cache do Core (Cache(4096, 16, ...))
+    constexpr int32_t BLOCO_CORE = 16;
+
+    void testar_combinacao_e_cheio() {
+        MemoriaDram dram;
+        BufferEscrita buffer(dram, BLOCO);
+        VERIFICAR_IGUAL(buffer.configurar(ConfigBufferEscrita{}), std::string());
+
+        // Duas palavras do mesmo bloco viram uma entrada
+        buffer.escrever(0x100, 4);
+        buffer.escrever(0x104, 4);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().escritas, 2u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().combinadas, 1u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().ocupacao_maxima, 1u);
+
+        // Oito blocos enchem o buffer; o nono drena o mais antigo (0x100)
+        for (uint32_t bloco = 0x200; bloco <= 0x800; bloco += 0x100) buffer.escrever(bloco, 4);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().ocupacao_maxima, 8u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().drenagens, 0u);
+        buffer.escrever(0x900, 4);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().paradas_cheio, 1u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().drenagens, 1u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().escritas, 1u);
+
+        // Passar o tempo amostra a ocupação e drena o que passa do limite (4)
+        buffer.avancar(10);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().ocupacao_acumulada, 80u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().ciclos, 10u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().drenagens, 5u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().escritas, 5u);
+
+        // Sem combinação, cada escrita ocupa uma entrada
+        ConfigBufferEscrita sem_combinar;
+        sem_combinar.combinar = false;
+        VERIFICAR_IGUAL(buffer.configurar(sem_combinar), std::string());
+        buffer.escrever(0x100, 4);
+        buffer.escrever(0x104, 4);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().combinadas, 0u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().ocupacao_maxima, 2u);
+
+        ConfigBufferEscrita invalida;
+        invalida.limite_drenagem = invalida.entradas + 1;
+        VERIFICAR(!buffer.configurar(invalida).empty());
+    }
+
+    void testar_encaminhamento() {
+        MemoriaDram dram;
+        BufferEscrita buffer(dram, BLOCO);
+        buffer.escrever(0x200, 4);
+        for (uint32_t endereco = 0x300; endereco < 0x300 + BLOCO; endereco += 4) buffer.escrever(endereco, 4);
+
+        uint32_t espera = 0;
+        VERIFICAR(buffer.consultarLeitura(0x200, 4, espera) == EncaminhamentoBuffer::Palavra);
+        VERIFICAR(buffer.consultarLeitura(0x310, 4, espera) == EncaminhamentoBuffer::Bloco);
+        VERIFICAR(buffer.consultarLeitura(0x400, 4, espera) == EncaminhamentoBuffer::Nenhum);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().encaminhamentos, 2u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().escritas, 0u);
+
+        // Só parte dos bytes: a entrada do bloco vai para a DRAM antes da leitura
+        VERIFICAR(buffer.consultarLeitura(0x202, 4, espera) == EncaminhamentoBuffer::Conflito);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().conflitos_leitura, 1u);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().drenagens, 1u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().escritas, 1u);
+        VERIFICAR(buffer.consultarLeitura(0x200, 4, espera) == EncaminhamentoBuffer::Nenhum);
+
+        // Sem encaminhamento, toda leitura coberta é um conflito
+        ConfigBufferEscrita sem_encaminhar;
+        sem_encaminhar.encaminhar = false;
+        buffer.configurar(sem_encaminhar);
+        buffer.escrever(0x200, 4);
+        VERIFICAR(buffer.consultarLeitura(0x200, 4, espera) == EncaminhamentoBuffer::Conflito);
+        VERIFICAR_IGUAL(buffer.getEstatisticas().encaminhamentos, 0u);
+    }
+
+    struct Resultado {
+        uint32_t x3 = 0;
+        uint32_t x4 = 0;
+        uint64_t encaminhamentos = 0;
+        uint64_t leituras_dram = 0;
+        uint64_t faltas_leitura = 0;
+        uint64_t acertos_leitura = 0;
+    };
+
+    // Store seguido de um load do mesmo endereço e, opcionalmente, de um segundo load. Com
+    // 'bloco_inteiro', os stores cobrem o bloco de 0x400 antes dos loads
+    Resultado executar(bool segundo_load, bool bloco_inteiro = false) {
+        std::vector<uint32_t> programa = {addi(1, 0, 0x400), addi(2, 0, 7)};
+        for (int32_t deslocamento = bloco_inteiro ? 4 : BLOCO_CORE; deslocamento < BLOCO_CORE; deslocamento += 4) {
+            programa.push_back(sw(2, 1, deslocamento));
+        }
+        programa.insert(programa.end(), {sw(2, 1, 0), lw(3, 1, 0), segundo_load ? lw(4, 1, 0) : NOP, 0});
+        Core core(64 * 1024);
+        core.load_program(programa);
+        for (int i = 0; i < 100 && !core.is_finished(); ++i) core.step();
+        return {core.get_registradores()[3], core.get_registradores()[4],
+                core.get_estatisticas_buffer_escrita().encaminhamentos, core.get_estatisticas_dram().leituras,
+                core.get_estatisticas_cache().faltas_leitura, core.get_estatisticas_cache().acertos_leitura};
+    }
+
+    void testar_core() {
+        // As buscas de instrução também passam pelo cache: compara-se com o programa sem o segundo load
+        Resultado um = executar(false);
+        Resultado dois = executar(true);
+        VERIFICAR_IGUAL(dois.x3, 7u);
+        VERIFICAR_IGUAL(dois.x4, 7u);
+
+        // Só a palavra está no buffer: o load é encaminhado sem ler a DRAM e a linha não é
+        // alocada, então o segundo load falta de novo e também é encaminhado
+        VERIFICAR_IGUAL(um.encaminhamentos, 1u);
+        VERIFICAR_IGUAL(dois.encaminhamentos, 2u);
+        VERIFICAR_IGUAL(dois.leituras_dram, um.leituras_dram);
+        VERIFICAR_IGUAL(dois.faltas_leitura, um.faltas_leitura + 1);
+        VERIFICAR_IGUAL(dois.acertos_leitura, um.acertos_leitura);
+
+        // Com o bloco inteiro no buffer, a linha é preenchida sem ler a DRAM: o segundo load acerta
+        Resultado bloco_um = executar(false, true);
+        Resultado bloco_dois = executar(true, true);
+        VERIFICAR_IGUAL(bloco_dois.x3, 7u);
+        VERIFICAR_IGUAL(bloco_dois.x4, 7u);
+        VERIFICAR_IGUAL(bloco_um.encaminhamentos, 1u);
+        VERIFICAR_IGUAL(bloco_dois.encaminhamentos, 1u);
+        VERIFICAR_IGUAL(bloco_dois.leituras_dram, bloco_um.leituras_dram);
+        VERIFICAR_IGUAL(bloco_dois.faltas_leitura, bloco_um.faltas_leitura);
+        VERIFICAR_IGUAL(bloco_dois.acertos_leitura, bloco_um.acertos_leitura + 1);
+    }
+}
+
+int main() {
+    testar_combinacao_e_cheio();
+    testar_encaminhamento();
+    testar_core();
+    return resultado_testes("teste_buffer_escrita");
+}
@@ -0,0 +1,177 @@
+// Snapshots e checkpoints em disco: restaurar e seguir dá o mesmo estado final, com o CLINT e a UART
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "bus/Dispositivos.h"
+#include "core/Checkpoint.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    const std::vector<uint32_t> PROGRAMA = {
+        addi(1, 0, 0x400), addi(2, 0, 200),
+        sw(2, 1, 0), lw(3, 1, 0), addi(1, 1, 4), addi(2, 2, -1),
+        0xFE0118E3, // bne x2, x0, -16
+        0,
+    };
+
+    void executar_ate_o_fim(Core& core) {
+        for (int i = 0; i < 10000 && !core.is_finished(); ++i) core.step();
+    }
+
+    void verificar_mesmo_estado(const Core& obtido, const Core& esperado) {
+        VERIFICAR(obtido.get_registradores() == esperado.get_registradores());
+        VERIFICAR_IGUAL(obtido.get_program_counter(), esperado.get_program_counter());
+        VERIFICAR_IGUAL(obtido.get_contadores().instrucoes, esperado.get_contadores().instrucoes);
+        VERIFICAR_IGUAL(obtido.get_contadores().ciclos, esperado.get_contadores().ciclos);
+        VERIFICAR_IGUAL(obtido.get_estatisticas_cache().leituras, esperado.get_estatisticas_cache().leituras);
+        VERIFICAR_IGUAL(obtido.get_estatisticas_cache().faltas_leitura,
+                        esperado.get_estatisticas_cache().faltas_leitura);
+        bool memoria_igual = true;
+        for (uint32_t endereco = 0; endereco < 0x1000; endereco += 4) {
+            memoria_igual &= obtido.get_palavra_memoria(endereco) == esperado.get_palavra_memoria(endereco);
+        }
+        VERIFICAR(memoria_igual);
+    }
+
+    void testar_snapshot() {
+        Core referencia(64 * 1024);
+        referencia.load_program(PROGRAMA);
+        executar_ate_o_fim(referencia);
+
+        Core core(64 * 1024);
+        core.load_program(PROGRAMA);
+        for (int i = 0; i < 300; ++i) core.step();
+        SnapshotCore snapshot = core.criar_snapshot();
+        VERIFICAR_IGUAL(snapshot.get_contadores().instrucoes, 300u);
+
+        executar_ate_o_fim(core);
+        verificar_mesmo_estado(core, referencia);
+
+        // Restaurar no mesmo Core desfaz as escritas feitas depois do snapshot
+        VERIFICAR_IGUAL(core.restaurar_snapshot(snapshot), std::string());
+        VERIFICAR_IGUAL(core.get_program_counter(), snapshot.get_program_counter());
+        VERIFICAR_IGUAL(core.get_palavra_memoria(0x400 + 4 * 100), 0u);
+        executar_ate_o_fim(core);
+        verificar_mesmo_estado(core, referencia);
+
+        // E num Core novo, que segue de forma independente
+        Core outro(64 * 1024);
+        VERIFICAR_IGUAL(outro.restaurar_snapshot(snapshot), std::string());
+        executar_ate_o_fim(outro);
+        verificar_mesmo_estado(outro, referencia);
+
+        Core menor(32 * 1024);
+        VERIFICAR(!menor.restaurar_snapshot(snapshot).empty());
+    }
+
+    void testar_checkpoint() {
+        Core referencia(64 * 1024);
+        referencia.load_program(PROGRAMA);
+        executar_ate_o_fim(referencia);
+
+        Core core(64 * 1024);
+        core.load_program(PROGRAMA);
+        for (int i = 0; i < 500; ++i) core.step();
+
+        std::string caminho = "teste_checkpoint.rvck";
+        GravadorCheckpoint gravador;
+        VERIFICAR_IGUAL(gravador.iniciar(core.criar_snapshot(), caminho), std::string());
+        // A simulação segue enquanto a gravação acontece
+        executar_ate_o_fim(core);
+        VERIFICAR_IGUAL(gravador.aguardar(), std::string());
+        VERIFICAR(gravador.get_paginas_escritas() > 0);
+
+        SnapshotCore lido;
+        VERIFICAR_IGUAL(ler_checkpoint(caminho, lido), std::string());
+        VERIFICAR_IGUAL(lido.get_contadores().instrucoes, 500u);
+        VERIFICAR_IGUAL(lido.get_tamanho_memoria(), 64u * 1024);
+
+        Core restaurado(64 * 1024);
+        VERIFICAR_IGUAL(restaurado.restaurar_snapshot(lido), std::string());
+        executar_ate_o_fim(restaurado);
+        verificar_mesmo_estado(restaurado, referencia);
+
+        // Tamanho de RAM absurdo no cabeçalho: erro, sem tentar alocar o índice de páginas
+        {
+            std::fstream arquivo(caminho, std::ios::in | std::ios::out | std::ios::binary);
+            arquivo.seekp(checkpoint::TAMANHO_CABECALHO);
+            const char enorme[8] = {0, 0, 0, 0, 0, 0, 0, 0x40};
+            arquivo.write(enorme, sizeof(enorme));
+        }
+        SnapshotCore invalido;
+        std::string erro = ler_checkpoint(caminho, invalido);
+        VERIFICAR(erro.rfind("[ERRO]", 0) == 0);
+        std::remove(caminho.c_str());
+
+        VERIFICAR(!ler_checkpoint("inexistente.rvck", invalido).empty());
+    }
+
+    uint32_t ler_dispositivo(Core& core, uint32_t endereco) {
+        uint32_t valor = 0;
+        VERIFICAR(core.get_barramento().ler(endereco, 4, valor));
+        return valor;
+    }
+
+    // mtimecmp = 0x1234, msip = 1, mtime adiantado em 1000, "bc" na entrada e "Z" na saída da UART
+    void verificar_dispositivos(Core& core, uint32_t mtime) {
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MTIMECMP), 0x1234u);
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MTIMECMP + 4), 0u);
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MSIP), 1u);
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MTIME), mtime);
+        VERIFICAR_IGUAL(core.get_uart().consumir_saida(), std::string("Z"));
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::UART_BASE + Uart::REG_DADOS), static_cast<uint32_t>('b'));
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::UART_BASE + Uart::REG_DADOS), static_cast<uint32_t>('c'));
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::UART_BASE + Uart::REG_LSR) & Uart::LSR_DADO_PRONTO, 0u);
+    }
+
+    void testar_dispositivos() {
+        Core core(64 * 1024);
+        core.load_program(PROGRAMA);
+        for (int i = 0; i < 300; ++i) core.step();
+
+        Barramento& barramento = core.get_barramento();
+        barramento.escrever(mapa::CLINT_BASE + Clint::REG_MTIMECMP, 0x1234, 4);
+        barramento.escrever(mapa::CLINT_BASE + Clint::REG_MTIMECMP + 4, 0, 4);
+        barramento.escrever(mapa::CLINT_BASE + Clint::REG_MSIP, 1, 4);
+        uint32_t mtime = ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MTIME) + 1000;
+        barramento.escrever(mapa::CLINT_BASE + Clint::REG_MTIME, mtime, 4);
+        core.get_uart().enviar_entrada("abc");
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::UART_BASE + Uart::REG_DADOS), static_cast<uint32_t>('a'));
+        core.get_uart().definir_destino_saida(nullptr);
+        barramento.escrever(mapa::UART_BASE + Uart::REG_DADOS, 'Z', 1);
+
+        SnapshotCore snapshot = core.criar_snapshot();
+        std::string caminho = "teste_checkpoint_dispositivos.rvck";
+        GravadorCheckpoint gravador;
+        VERIFICAR_IGUAL(gravador.iniciar(snapshot, caminho), std::string());
+        VERIFICAR_IGUAL(gravador.aguardar(), std::string());
+
+        // Depois do reset os dispositivos estão zerados; o snapshot os traz de volta
+        core.reset();
+        VERIFICAR_IGUAL(ler_dispositivo(core, mapa::CLINT_BASE + Clint::REG_MSIP), 0u);
+        VERIFICAR_IGUAL(core.restaurar_snapshot(snapshot), std::string());
+        verificar_dispositivos(core, mtime);
+
+        // O checkpoint em disco também, num Core novo
+        SnapshotCore lido;
+        VERIFICAR_IGUAL(ler_checkpoint(caminho, lido), std::string());
+        Core restaurado(64 * 1024);
+        restaurado.get_uart().definir_destino_saida(nullptr);
+        VERIFICAR_IGUAL(restaurado.restaurar_snapshot(lido), std::string());
+        verificar_dispositivos(restaurado, mtime);
+        std::remove(caminho.c_str());
+    }
+}
+
+int main() {
+    testar_snapshot();
+    testar_checkpoint();
+    testar_dispositivos();
+    return resultado_testes("teste_checkpoint");
+}
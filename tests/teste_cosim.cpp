@@ -0,0 +1,114 @@
+// Co-simulação: log de referência no formato do Spike que confere e divergências de cada tipo
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+#include "cosim/CoSimulacao.h"
+
+using namespace verificacao;
+
+namespace {
+    const std::vector<uint32_t> PROGRAMA = {
+        addi(1, 0, 5), addi(2, 0, 0x100), sw(1, 2, 0), lw(3, 2, 0), addi(4, 3, 1), 0,
+    };
+
+    // Linhas do Spike para PROGRAMA carregado em 0x80000000
+    std::vector<std::string> referencia_correta() {
+        return {
+            "core   0: 3 0x80000000 (0x00500093) x1  0x00000005",
+            "core   0: 3 0x80000004 (0x10000113) x2  0x00000100",
+            "core   0: 3 0x80000008 (0x00112023) mem 0x00000100 0x00000005",
+            "core   0: 3 0x8000000c (0x00012183) x3  0x00000005 mem 0x00000100",
+            "core   0: 3 0x80000010 (0x00118213) x4  0x00000006",
+        };
+    }
+
+    ResultadoCoSim executar(const std::vector<std::string>& linhas, bool log = true) {
+        const std::string caminho = "teste_cosim.log";
+        {
+            std::ofstream arquivo(caminho);
+            // Linhas que não começam com "core" são ignoradas
+            arquivo << "bbl loader\n";
+            for (const std::string& linha : linhas) arquivo << linha << "\n";
+        }
+
+        Core core(64 * 1024);
+        core.load_program(PROGRAMA);
+        core.definir_log(log);
+        LeitorLogCommits referencia;
+        VERIFICAR_IGUAL(referencia.abrir(caminho), std::string());
+        CoSimulacao cosim(core, referencia, 4);
+        cosim.definir_base_referencia(0x80000000u, static_cast<uint32_t>(core.get_tamanho_memoria()));
+        ResultadoCoSim resultado = cosim.executar();
+        // O log é desligado só durante a comparação
+        VERIFICAR_IGUAL(core.log_ligado(), log);
+        std::remove(caminho.c_str());
+        return resultado;
+    }
+
+    bool contem(const std::string& texto, const std::string& trecho) {
+        return texto.find(trecho) != std::string::npos;
+    }
+
+    void testar_confere() {
+        ResultadoCoSim resultado = executar(referencia_correta());
+        VERIFICAR(!resultado.divergiu);
+        VERIFICAR_IGUAL(resultado.instrucoes, 5u);
+        VERIFICAR(resultado.motivo.empty());
+
+        // Sem log, o resultado é o mesmo
+        VERIFICAR_IGUAL(executar(referencia_correta(), false).instrucoes, 5u);
+    }
+
+    void testar_divergencias() {
+        std::vector<std::string> linhas = referencia_correta();
+        linhas[1] = "core   0: 3 0x80000004 (0x10000113) x2  0x00000104";
+        ResultadoCoSim registrador = executar(linhas);
+        VERIFICAR(registrador.divergiu);
+        VERIFICAR_IGUAL(registrador.instrucoes, 1u);
+        VERIFICAR(contem(registrador.motivo, "Escrita em registrador diverge em 0x00000004"));
+        VERIFICAR(contem(registrador.motivo, "linha 3 da referencia"));
+        VERIFICAR(contem(registrador.contexto, "Ultimas 2 instrucoes"));
+
+        linhas = referencia_correta();
+        linhas[2] = "core   0: 3 0x80000008 (0x00112023) mem 0x00000100 0x00000007";
+        ResultadoCoSim store = executar(linhas);
+        VERIFICAR(store.divergiu);
+        VERIFICAR_IGUAL(store.instrucoes, 2u);
+        VERIFICAR(contem(store.motivo, "Store diverge em 0x00000008"));
+
+        // Store de um byte: só o byte menos significativo é comparado
+        linhas[2] = "core   0: 3 0x80000008 (0x00112023) mem 0x00000100 0x05";
+        VERIFICAR(!executar(linhas).divergiu);
+
+        linhas = referencia_correta();
+        linhas[3] = "core   0: 3 0x8000000c (0x00012183) x3  0x00000005 mem 0x00000104";
+        VERIFICAR(contem(executar(linhas).motivo, "Endereco de load diverge"));
+
+        linhas = referencia_correta();
+        linhas[4] = "core   0: 3 0x80000014 (0x00118213) x4  0x00000006";
+        ResultadoCoSim pc = executar(linhas);
+        VERIFICAR_IGUAL(pc.instrucoes, 4u);
+        VERIFICAR(contem(pc.motivo, "PC diverge: simulador 0x00000010, referencia 0x00000014"));
+
+        linhas = referencia_correta();
+        linhas[4] = "core   0: 3 0x80000010 (0x00218213) x4  0x00000006";
+        VERIFICAR(contem(executar(linhas).motivo, "Instrucao diverge em 0x00000010"));
+
+        // Referência que continua depois da instrução 0, que encerra o simulador
+        linhas = referencia_correta();
+        linhas.push_back("core   0: 3 0x80000014 (0x00000000)");
+        linhas.push_back("core   0: 3 0x80000018 (0x00000013)");
+        VERIFICAR(contem(executar(linhas).motivo, "Simulador finalizou"));
+    }
+}
+
+int main() {
+    testar_confere();
+    testar_divergencias();
+    return resultado_testes("teste_cosim");
+}
@@ -0,0 +1,138 @@
+// Contadores Zicsr: cycle/time/instret, mhpmcounterN com mhpmeventN e mcountinhibit
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    // Carrega 'programa' num Core novo e executa todas as suas instruções
+    void executar(Core& core, const std::vector<uint32_t>& programa) {
+        core.load_program(programa);
+        for (size_t i = 0; i < programa.size(); ++i) {
+            std::string log = core.step();
+            VERIFICAR(log.find("ERRO") == std::string::npos);
+        }
+    }
+
+    void testar_instret_e_cycle() {
+        Core core(64 * 1024);
+        std::vector<uint32_t> programa(10, NOP);
+        programa.push_back(csrr(5, csr::INSTRET));
+        programa.push_back(csrr(6, csr::CYCLE));
+        programa.push_back(csrr(7, csr::MINSTRET));
+        executar(core, programa);
+
+        auto regs = core.get_registradores();
+        // A leitura vê as instruções completadas antes dela
+        VERIFICAR_IGUAL(regs[5], 10u);
+        VERIFICAR_IGUAL(regs[7], 12u);
+        VERIFICAR(regs[6] >= 11u);
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, programa.size());
+    }
+
+    void testar_evento_loads() {
+        Core core(64 * 1024);
+        VERIFICAR_IGUAL(core.configurar_evento_hpm(3, EventoHpm::Loads), std::string());
+        VERIFICAR_IGUAL(core.configurar_evento_hpm(4, EventoHpm::Stores), std::string());
+        VERIFICAR(!core.configurar_evento_hpm(2, EventoHpm::Loads).empty());
+        VERIFICAR(!core.configurar_evento_hpm(32, EventoHpm::Loads).empty());
+
+        executar(core, {
+            lw(1, 0, 0x400), lw(2, 0, 0x404), sw(1, 0, 0x408), lw(3, 0, 0x40C),
+            csrr(5, csr::HPMCOUNTER3), csrr(6, csr::HPMCOUNTER3 + 1), csrr(7, csr::MHPMEVENT3),
+        });
+        auto regs = core.get_registradores();
+        VERIFICAR_IGUAL(regs[5], 3u);
+        VERIFICAR_IGUAL(regs[6], 1u);
+        VERIFICAR_IGUAL(regs[7], static_cast<uint32_t>(EventoHpm::Loads));
+    }
+
+    void testar_inibicao() {
+        Core core(64 * 1024);
+        core.configurar_evento_hpm(3, EventoHpm::Loads);
+        executar(core, {
+            lw(1, 0, 0x400),
+            addi(10, 0, 1 << 3), csrw(csr::MCOUNTINHIBIT, 10),
+            lw(1, 0, 0x400), lw(1, 0, 0x400),
+            csrr(5, csr::MHPMCOUNTER3),
+            csrw(csr::MCOUNTINHIBIT, 0),
+            lw(1, 0, 0x400),
+            csrr(6, csr::MHPMCOUNTER3),
+            csrr(7, csr::MCOUNTINHIBIT),
+        });
+        auto regs = core.get_registradores();
+        // Inibido, o contador congela; liberado, continua do valor congelado
+        VERIFICAR_IGUAL(regs[5], 1u);
+        VERIFICAR_IGUAL(regs[6], 2u);
+        VERIFICAR_IGUAL(regs[7], 0u);
+    }
+
+    void testar_escrita_contadores() {
+        Core core(64 * 1024);
+        executar(core, {
+            addi(1, 0, 100),
+            csrw(csr::MCYCLE, 1),
+            csrr(5, csr::CYCLE),
+            addi(2, 0, 7),
+            csrw(csr::MHPMCOUNTER3H, 2),
+            csrr(6, csr::HPMCOUNTER3H),
+            csrr(7, csr::HPMCOUNTER3),
+        });
+        auto regs = core.get_registradores();
+        VERIFICAR(regs[5] >= 100u && regs[5] < 200u);
+        // Sem evento, o contador só muda por escrita
+        VERIFICAR_IGUAL(regs[6], 7u);
+        VERIFICAR_IGUAL(regs[7], 0u);
+    }
+
+    void testar_time_independente() {
+        Core core(64 * 1024);
+        // mtime do CLINT em 0x0200BFF8 = 0x0200C000 - 8
+        std::vector<uint32_t> programa(30, NOP);
+        programa.insert(programa.end(), {
+            csrr(5, csr::TIME), lui(1, 0x0200C), lw(6, 1, -8),
+            csrw(csr::MCYCLE, 0),
+            csrr(7, csr::TIME), lw(8, 1, -8),
+            addi(10, 0, 1), csrw(csr::MCOUNTINHIBIT, 10), csrr(13, csr::CYCLE),
+        });
+        programa.insert(programa.end(), 30, NOP);
+        programa.insert(programa.end(), {csrr(11, csr::TIME), lw(12, 1, -8), csrr(14, csr::CYCLE)});
+        executar(core, programa);
+
+        auto regs = core.get_registradores();
+        VERIFICAR(regs[5] >= 3u);
+        // Zerar mcycle não faz 'time' nem mtime voltarem
+        VERIFICAR(regs[7] >= regs[5]);
+        VERIFICAR(regs[8] >= regs[6]);
+        VERIFICAR(regs[6] >= regs[5]);
+        // Com mcycle inibido, 'time' e mtime continuam avançando
+        VERIFICAR(regs[11] >= regs[7] + 3);
+        VERIFICAR(regs[12] >= regs[8] + 3);
+        VERIFICAR_IGUAL(regs[14], regs[13]);
+    }
+
+    void testar_csr_somente_leitura() {
+        Core core(64 * 1024);
+        core.load_program({addi(1, 0, 5), csrw(csr::CYCLE, 1), csrr(2, 0x7C0)});
+        core.step();
+        std::string log = core.step();
+        VERIFICAR(log.find("somente leitura") != std::string::npos);
+        log = core.step();
+        VERIFICAR(log.find("inexistente") != std::string::npos);
+        VERIFICAR_IGUAL(core.get_registradores()[2], 0u);
+    }
+}
+
+int main() {
+    testar_instret_e_cycle();
+    testar_evento_loads();
+    testar_inibicao();
+    testar_escrita_contadores();
+    testar_time_independente();
+    testar_csr_somente_leitura();
+    return resultado_testes("teste_csr");
+}
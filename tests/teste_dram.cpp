@@ -0,0 +1,160 @@
+// Modelo de temporização da DRAM: latência de cada caso do banco, FR-FCFS, fila cheia e estatísticas
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "cache/MemoriaDram.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    // Configuração padrão: 8 bancos, linhas de 2 KiB, tRCD = tRP = tCAS = 14, tBurst = 4
+    constexpr uint32_t LINHA_FECHADA = 14 + 14 + 4;
+    constexpr uint32_t ACERTO = 14 + 4;
+    constexpr uint32_t CONFLITO = 14 + 14 + 14 + 4;
+
+    // Endereço da linha 'linha' no banco 'banco' (linha | banco | coluna)
+    uint32_t endereco(uint32_t linha, uint32_t banco, uint32_t coluna = 0) {
+        return (linha << 14) | (banco << 11) | coluna;
+    }
+
+    void testar_latencias() {
+        MemoriaDram dram;
+        VERIFICAR_IGUAL(dram.ler(endereco(0, 0)), LINHA_FECHADA);
+        VERIFICAR_IGUAL(dram.ler(endereco(0, 0, 64)), ACERTO);
+        VERIFICAR_IGUAL(dram.ler(endereco(1, 0)), CONFLITO);
+        VERIFICAR_IGUAL(dram.ler(endereco(1, 3)), LINHA_FECHADA);
+
+        const EstatisticasDram& estatisticas = dram.getEstatisticas();
+        VERIFICAR_IGUAL(estatisticas.leituras, 4u);
+        VERIFICAR_IGUAL(estatisticas.escritas, 0u);
+        VERIFICAR_IGUAL(estatisticas.linhas_fechadas, 2u);
+        VERIFICAR_IGUAL(estatisticas.acertos_linha, 1u);
+        VERIFICAR_IGUAL(estatisticas.conflitos_linha, 1u);
+        VERIFICAR_IGUAL(estatisticas.ciclos_leitura, uint64_t{2 * LINHA_FECHADA + ACERTO + CONFLITO});
+        VERIFICAR_IGUAL(estatisticas.latencia_maxima_leitura, uint64_t{CONFLITO});
+
+        // Política fechada: o segundo acesso à mesma linha paga a ativação de novo
+        ConfigDram config;
+        config.politica = PoliticaLinhaDram::Fechada;
+        MemoriaDram fechada(config);
+        VERIFICAR_IGUAL(fechada.ler(endereco(0, 0)), LINHA_FECHADA);
+        VERIFICAR_IGUAL(fechada.ler(endereco(0, 0, 64)), LINHA_FECHADA);
+        VERIFICAR_IGUAL(fechada.getEstatisticas().linhas_fechadas, 2u);
+        VERIFICAR_IGUAL(fechada.getEstatisticas().acertos_linha, 0u);
+    }
+
+    void testar_fr_fcfs() {
+        MemoriaDram dram;
+        // A primeira escrita abre a linha 0 do banco 0 e o deixa ocupado; as outras duas esperam
+        VERIFICAR_IGUAL(dram.escrever(endereco(0, 0)), 0u);
+        VERIFICAR_IGUAL(dram.escrever(endereco(1, 0)), 0u);
+        VERIFICAR_IGUAL(dram.escrever(endereco(0, 0, 64)), 0u);
+        VERIFICAR_IGUAL(dram.getVagasFila(), 14u);
+
+        // A mais nova acerta a linha aberta e passa na frente da mais antiga
+        dram.avancar(1000);
+        VERIFICAR_IGUAL(dram.getVagasFila(), 16u);
+        const EstatisticasDram& estatisticas = dram.getEstatisticas();
+        VERIFICAR_IGUAL(estatisticas.escritas, 3u);
+        VERIFICAR_IGUAL(estatisticas.reordenacoes, 1u);
+        VERIFICAR_IGUAL(estatisticas.linhas_fechadas, 1u);
+        VERIFICAR_IGUAL(estatisticas.acertos_linha, 1u);
+        VERIFICAR_IGUAL(estatisticas.conflitos_linha, 1u);
+    }
+
+    void testar_fila_cheia() {
+        ConfigDram config;
+        config.capacidade_fila = 2;
+        MemoriaDram dram(config);
+        dram.escrever(endereco(0, 0));
+        dram.escrever(endereco(1, 0));
+        dram.escrever(endereco(2, 0));
+        VERIFICAR_IGUAL(dram.getVagasFila(), 0u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().paradas_fila_cheia, 0u);
+
+        // Sem vaga: espera o banco 0 ficar livre (ativação + CAS - CAS + burst) para a mais antiga sair
+        VERIFICAR_IGUAL(dram.escrever(endereco(3, 0)), 18u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().paradas_fila_cheia, 1u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().ciclos_fila_cheia, 18u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().escritas, 4u);
+    }
+
+    void testar_coleta_e_estado() {
+        MemoriaDram dram;
+        // Sem coleta (aquecimento) a linha é aberta, mas nada é contado
+        dram.definirColetaEstatisticas(false);
+        dram.ler(endereco(0, 0));
+        VERIFICAR_IGUAL(dram.getEstatisticas().leituras, 0u);
+        VERIFICAR_IGUAL(dram.getEstatisticas().linhas_fechadas, 0u);
+        dram.definirColetaEstatisticas(true);
+        VERIFICAR_IGUAL(dram.ler(endereco(0, 0, 64)), ACERTO);
+        VERIFICAR_IGUAL(dram.getEstatisticas().acertos_linha, 1u);
+
+        // Restaurar o estado repete a mesma latência e as mesmas estatísticas
+        ImagemDram imagem;
+        dram.salvarEstado(imagem);
+        VERIFICAR_IGUAL(dram.ler(endereco(1, 0)), CONFLITO);
+        dram.restaurarEstado(imagem);
+        VERIFICAR_IGUAL(dram.getEstatisticas().leituras, 1u);
+        VERIFICAR_IGUAL(dram.ler(endereco(1, 0)), CONFLITO);
+        VERIFICAR_IGUAL(dram.getEstatisticas().conflitos_linha, 1u);
+
+        // Imagem de outra geometria: o modelo fica zerado
+        ConfigDram config;
+        config.bancos = 4;
+        MemoriaDram outra(config);
+        outra.restaurarEstado(imagem);
+        VERIFICAR_IGUAL(outra.getEstatisticas().leituras, 0u);
+        VERIFICAR_IGUAL(outra.ler(endereco(1, 0)), LINHA_FECHADA);
+
+        config.bancos = 3;
+        VERIFICAR(!MemoriaDram::validar(config).empty());
+        config.bancos = 8;
+        config.capacidade_fila = 0;
+        VERIFICAR(!MemoriaDram::validar(config).empty());
+    }
+
+    void testar_core() {
+        // Laço com 200 stores e loads em 0x400, 0x404, ...
+        const std::vector<uint32_t> programa = {
+            addi(1, 0, 0x400), addi(2, 0, 200),
+            sw(2, 1, 0), lw(3, 1, 0), addi(1, 1, 4), addi(2, 2, -1),
+            0xFE0118E3, // bne x2, x0, -16
+            0,
+        };
+        Core core(64 * 1024);
+        // Sem buffer de escrita, cada store vai direto para a fila da DRAM e cada falta de leitura a espera
+        ConfigBufferEscrita sem_buffer;
+        sem_buffer.entradas = 0;
+        sem_buffer.limite_drenagem = 0;
+        VERIFICAR_IGUAL(core.configurar_buffer_escrita(sem_buffer), std::string());
+        ConfigDram invalida;
+        invalida.tamanho_linha = 32;
+        VERIFICAR(!core.configurar_dram(invalida).empty());
+        VERIFICAR_IGUAL(core.configurar_dram(ConfigDram{}), std::string());
+        core.load_program(programa);
+        for (int i = 0; i < 10000 && !core.is_finished(); ++i) core.step();
+
+        const EstatisticasDram& dram = core.get_estatisticas_dram();
+        const EstatisticasCache& cache = core.get_estatisticas_cache();
+        VERIFICAR_IGUAL(dram.escritas, cache.escritas);
+        VERIFICAR_IGUAL(dram.leituras, cache.faltas_leitura);
+        VERIFICAR(dram.leituras > 0);
+        // Escritas ainda na fila no fim do programa não foram classificadas
+        uint64_t atendidas = dram.acertos_linha + dram.linhas_fechadas + dram.conflitos_linha;
+        VERIFICAR(atendidas >= dram.leituras && atendidas <= dram.leituras + dram.escritas);
+        VERIFICAR(dram.ciclos_leitura >= dram.leituras * ACERTO);
+    }
+}
+
+int main() {
+    testar_latencias();
+    testar_fr_fcfs();
+    testar_fila_cheia();
+    testar_coleta_e_estado();
+    testar_core();
+    return resultado_testes("teste_dram");
+}
@@ -0,0 +1,124 @@
+// Execução reversa: voltar pelo anel, por snapshot e de forma exata reproduz o estado anterior
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    // Laço com 200 stores em 0x400, 0x404, ...; ~1000 instruções
+    const std::vector<uint32_t> PROGRAMA = {
+        addi(1, 0, 0x400), addi(2, 0, 200),
+        sw(2, 1, 0), lw(3, 1, 0), addi(1, 1, 4), addi(2, 2, -1),
+        0xFE0118E3, // bne x2, x0, -16
+        0,
+    };
+
+    struct Estado {
+        std::array<uint32_t, 32> registradores;
+        uint32_t pc;
+        uint64_t instrucoes;
+        uint64_t leituras_cache;
+        uint64_t faltas_cache;
+        std::vector<uint32_t> memoria;
+    };
+
+    Estado capturar(const Core& core) {
+        Estado estado{core.get_registradores(), core.get_program_counter(), core.get_contadores().instrucoes,
+                      core.get_estatisticas_cache().leituras, core.get_estatisticas_cache().faltas_leitura, {}};
+        for (uint32_t endereco = 0x400; endereco < 0x400 + 200 * 4; endereco += 4) {
+            estado.memoria.push_back(core.get_palavra_memoria(endereco));
+        }
+        return estado;
+    }
+
+    bool mesma_arquitetura(const Estado& a, const Estado& b) {
+        return a.registradores == b.registradores && a.pc == b.pc && a.instrucoes == b.instrucoes &&
+               a.memoria == b.memoria;
+    }
+
+    bool mesmo_cache(const Estado& a, const Estado& b) {
+        return a.leituras_cache == b.leituras_cache && a.faltas_cache == b.faltas_cache;
+    }
+
+    void testar_voltar() {
+        Core core(64 * 1024);
+        // Anel pequeno e snapshots a cada 100 instruções: as voltas longas usam a reexecução
+        core.definir_execucao_reversa(64, 100);
+        core.load_program(PROGRAMA);
+
+        std::vector<Estado> estados{capturar(core)};
+        for (int i = 0; i < 600; ++i) {
+            core.step();
+            estados.push_back(capturar(core));
+        }
+        VERIFICAR(core.get_passos_reversiveis() >= 64);
+
+        // Dentro do anel: arquitetura volta, o cache não
+        VERIFICAR_IGUAL(core.voltar_instrucoes(10), std::string());
+        VERIFICAR(mesma_arquitetura(capturar(core), estados[590]));
+
+        // Além do anel: snapshot e reexecução, o cache volta junto
+        VERIFICAR_IGUAL(core.voltar_instrucoes(200), std::string());
+        VERIFICAR(mesma_arquitetura(capturar(core), estados[390]));
+        VERIFICAR(mesmo_cache(capturar(core), estados[390]));
+
+        // Seguir em frente depois de voltar dá os mesmos estados de antes
+        for (int i = 0; i < 30; ++i) core.step();
+        VERIFICAR(mesma_arquitetura(capturar(core), estados[420]));
+
+        // Volta exata, mesmo dentro do anel
+        VERIFICAR_IGUAL(core.voltar_instrucoes(5, true), std::string());
+        VERIFICAR(mesma_arquitetura(capturar(core), estados[415]));
+        VERIFICAR(mesmo_cache(capturar(core), estados[415]));
+
+        VERIFICAR(!core.voltar_instrucoes(1000000).empty());
+        VERIFICAR(mesma_arquitetura(capturar(core), estados[415]));
+    }
+
+    void testar_voltar_ate_escrita() {
+        Core core(64 * 1024);
+        core.definir_execucao_reversa(1024);
+        core.load_program(PROGRAMA);
+        for (int i = 0; i < 100; ++i) core.step();
+
+        // O store em 0x404 é a segunda iteração do laço (x2 = 199)
+        VERIFICAR_IGUAL(core.get_palavra_memoria(0x404), 199u);
+        uint64_t distancia = 0;
+        VERIFICAR_IGUAL(core.voltar_ate_escrita(0x404, distancia), std::string());
+        VERIFICAR(distancia > 0);
+        VERIFICAR_IGUAL(core.get_palavra_memoria(0x404), 0u);
+        VERIFICAR_IGUAL(core.get_program_counter(), 8u);
+        core.step();
+        VERIFICAR_IGUAL(core.get_palavra_memoria(0x404), 199u);
+
+        VERIFICAR(!core.voltar_ate_escrita(0x2000, distancia).empty());
+    }
+
+    void testar_janela_escritas() {
+        Core core(64 * 1024);
+        core.definir_execucao_reversa(1024, 100);
+        core.load_program(PROGRAMA);
+        core.definir_janela_escritas(0x400, 200 * 4);
+        for (int i = 0; i < 450; ++i) core.step();
+        core.consumir_escritas_janela();
+
+        // Voltar restaura a página pelo snapshot: o byte de um store desfeito aparece como escrito
+        uint32_t ultimo = 0x400;
+        while (core.get_palavra_memoria(ultimo + 4) != 0) ultimo += 4;
+        VERIFICAR_IGUAL(core.voltar_instrucoes(150, true), std::string());
+        VERIFICAR_IGUAL(core.get_palavra_memoria(ultimo), 0u);
+        std::vector<uint8_t> marcas = core.consumir_escritas_janela();
+        VERIFICAR(marcas[ultimo - 0x400] != 0);
+    }
+}
+
+int main() {
+    testar_voltar();
+    testar_voltar_ate_escrita();
+    testar_janela_escritas();
+    return resultado_testes("teste_execucao_reversa");
+}
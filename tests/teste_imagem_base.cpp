@@ -0,0 +1,129 @@
+// Imagem base: restaurar desfaz stores, read de syscall e stores vetoriais, só as páginas tocadas
+// ficam sujas, e a restauração continua correta intercalada com snapshots
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+#include "syscall/ProxySyscalls.h"
+
+using namespace verificacao;
+
+namespace {
+    constexpr uint32_t ECALL = 0x00000073;
+    constexpr uint32_t PAGINA = Core::TAMANHO_PAGINA_BASE;
+    constexpr uint32_t CAMINHO = 0x700;
+    const std::string ARQUIVO = "teste_imagem_base.dat";
+
+    // vsetvli rd, rs1, e32, m1
+    uint32_t vsetvli_e32(uint32_t rd, uint32_t rs1) { return (0x10u << 20) | (rs1 << 15) | (0x7 << 12) | (rd << 7) | 0x57; }
+    // vmv.v.x vd, rs1
+    uint32_t vmv_v_x(uint32_t vd, uint32_t rs1) { return (0x17u << 26) | (1u << 25) | (rs1 << 15) | (0x4 << 12) | (vd << 7) | 0x57; }
+    // vse32.v vs3, (rs1)
+    uint32_t vse32(uint32_t vs3, uint32_t rs1) { return (1u << 25) | (rs1 << 15) | (0x6 << 12) | (vs3 << 7) | 0x27; }
+
+    // Um store nas páginas 1 e 2, read de 3 bytes do arquivo na página 3 e um store vetorial na página 4
+    const std::vector<uint32_t> PROGRAMA = {
+        addi(1, 0, 0x7F), lui(2, 1), sw(1, 2, 0), lui(2, 2), sw(1, 2, 4),
+        addi(10, 0, CAMINHO), addi(11, 0, 0), addi(12, 0, 0), addi(17, 0, syscalls::OPEN), ECALL,
+        lui(11, 3), addi(12, 0, 16), addi(17, 0, syscalls::READ), ECALL,
+        addi(6, 0, 4), vsetvli_e32(5, 6), addi(7, 0, 0x55), vmv_v_x(1, 7), lui(8, 4), vse32(1, 8),
+        0,
+    };
+    // Instruções antes do open: as duas primeiras páginas já foram escritas
+    constexpr int ANTES_DO_OPEN = 5;
+
+    uint32_t palavra(Core& core, uint32_t endereco) {
+        uint32_t valor = 0;
+        for (uint32_t i = 0; i < 4; ++i) valor |= static_cast<uint32_t>(core.get_byte_memoria(endereco + i)) << (8 * i);
+        return valor;
+    }
+
+    void executar(Core& core) {
+        for (int i = 0; i < 100 && !core.is_finished(); ++i) core.step();
+    }
+
+    void verificar_executado(Core& core) {
+        VERIFICAR(core.is_finished());
+        VERIFICAR_IGUAL(palavra(core, PAGINA), 0x7Fu);
+        VERIFICAR_IGUAL(palavra(core, 2 * PAGINA + 4), 0x7Fu);
+        VERIFICAR_IGUAL(core.get_registradores()[10], 3u);
+        VERIFICAR_IGUAL(palavra(core, 3 * PAGINA) & 0xFFFFFF, 0x7A7978u); // "xyz"
+        VERIFICAR_IGUAL(palavra(core, 4 * PAGINA), 0x55u);
+        VERIFICAR_IGUAL(palavra(core, 4 * PAGINA + 12), 0x55u);
+    }
+
+    void verificar_base(Core& core) {
+        VERIFICAR(!core.is_finished());
+        VERIFICAR_IGUAL(core.get_program_counter(), 0u);
+        VERIFICAR_IGUAL(core.get_registradores()[1], 0u);
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, 0u);
+        VERIFICAR_IGUAL(core.get_paginas_sujas(), 0u);
+        VERIFICAR_IGUAL(palavra(core, 0), PROGRAMA[0]);
+        VERIFICAR_IGUAL(core.get_byte_memoria(CAMINHO), static_cast<uint8_t>(ARQUIVO[0]));
+        for (uint32_t endereco : {PAGINA, 2 * PAGINA + 4, 3 * PAGINA, 4 * PAGINA, 4 * PAGINA + 12}) {
+            VERIFICAR_IGUAL(palavra(core, endereco), 0u);
+        }
+    }
+
+    void testar_restauracao() {
+        Core core(64 * 1024);
+        core.definir_log(false);
+        core.load_program(PROGRAMA);
+        std::vector<uint8_t> caminho(ARQUIVO.begin(), ARQUIVO.end());
+        caminho.push_back(0);
+        VERIFICAR(core.escrever_bloco_memoria(CAMINHO, caminho.data(), static_cast<uint32_t>(caminho.size())));
+        VERIFICAR(!core.tem_imagem_base());
+        core.marcar_imagem_base();
+        VERIFICAR(core.tem_imagem_base());
+        VERIFICAR_IGUAL(core.get_paginas_sujas(), 0u);
+
+        // Só as páginas 1 a 4 foram escritas, cada uma contada uma vez
+        executar(core);
+        verificar_executado(core);
+        VERIFICAR_IGUAL(core.get_paginas_sujas(), 4u);
+
+        core.restaurar_imagem_base();
+        verificar_base(core);
+        executar(core);
+        verificar_executado(core);
+
+        // Um snapshot no meio troca a imagem sincronizada: a base já não é a imagem de referência
+        // das páginas sujas, e a restauração precisa comparar as duas imagens
+        core.restaurar_imagem_base();
+        for (int i = 0; i < ANTES_DO_OPEN; ++i) core.step();
+        SnapshotCore snapshot = core.criar_snapshot();
+        VERIFICAR_IGUAL(core.get_paginas_sujas(), 0u);
+        executar(core);
+        verificar_executado(core);
+        VERIFICAR_IGUAL(core.get_paginas_sujas(), 2u);
+
+        core.restaurar_imagem_base();
+        verificar_base(core);
+
+        // O snapshot continua restaurável depois, com as páginas 1 e 2 já escritas
+        VERIFICAR_IGUAL(core.restaurar_snapshot(snapshot), std::string());
+        VERIFICAR_IGUAL(palavra(core, PAGINA), 0x7Fu);
+        VERIFICAR_IGUAL(palavra(core, 3 * PAGINA), 0u);
+        executar(core);
+        verificar_executado(core);
+
+        core.restaurar_imagem_base();
+        verificar_base(core);
+        executar(core);
+        verificar_executado(core);
+    }
+}
+
+int main() {
+    {
+        std::ofstream arquivo(ARQUIVO, std::ios::binary);
+        arquivo << "xyz";
+    }
+    testar_restauracao();
+    std::remove(ARQUIVO.c_str());
+    return resultado_testes("teste_imagem_base");
+}
@@ -0,0 +1,105 @@
+// Modelo fora de ordem: IPC conhecido para largura, dependências e latência das unidades
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "timing/ModeloOoO.h"
+
+using namespace verificacao;
+
+namespace {
+    // Sem paradas, uma instrução buscada no ciclo f despacha em f+1, emite em f+2, conclui
+    // (latência 1) em f+3 e faz commit em f+4: o último commit vem 3 ciclos depois do último fetch
+    constexpr uint64_t PIPELINE = 3;
+    constexpr uint64_t N = 4000;
+
+    uint32_t mul(uint32_t rd, uint32_t rs1, uint32_t rs2) { return tipo_r(0x01, rs2, rs1, 0x0, rd, 0x33); }
+    uint32_t div(uint32_t rd, uint32_t rs1, uint32_t rs2) { return tipo_r(0x01, rs2, rs1, 0x4, rd, 0x33); }
+
+    // Alimenta o modelo com 'n' instruções sequenciais geradas por 'instrucao(i)'
+    template <typename Gerador>
+    RelatorioOoO executar(const ConfigOoO& config, uint64_t n, Gerador instrucao) {
+        ModeloOoO modelo(config);
+        for (uint64_t i = 0; i < n; ++i) {
+            RegistroCommit commit;
+            commit.pc = static_cast<uint32_t>(4 * i);
+            commit.proximo_pc = commit.pc + 4;
+            commit.instrucao = instrucao(i);
+            commit.rd = (commit.instrucao >> 7) & 0x1F;
+            modelo.consumir(commit);
+        }
+        return modelo.relatorio();
+    }
+
+    // addi independentes, cada uma num registrador diferente
+    uint32_t independente(uint64_t i) { return addi(1 + static_cast<uint32_t>(i % 31), 0, 1); }
+
+    void testar_largura() {
+        // Com ALUs suficientes, só a largura limita: N/largura ciclos de fetch
+        for (uint32_t largura : {1u, 2u, 4u}) {
+            ConfigOoO config;
+            config.largura_fetch = config.largura_issue = config.largura_commit = largura;
+            config.unidades[static_cast<size_t>(ClasseInstrucao::Alu)].quantidade = 4;
+            RelatorioOoO relatorio = executar(config, N, independente);
+            VERIFICAR_IGUAL(relatorio.instrucoes, N);
+            VERIFICAR_IGUAL(relatorio.ciclos, N / largura + PIPELINE);
+        }
+
+        // A largura 4 com as 2 ALUs padrão: as unidades limitam o IPC a 2
+        RelatorioOoO relatorio = executar(ConfigOoO{}, N, independente);
+        VERIFICAR(relatorio.ipc > 1.99 && relatorio.ipc <= 2.0);
+        VERIFICAR(relatorio.atraso_instrucoes[static_cast<size_t>(CausaParada::UnidadeOcupada)] > 0);
+    }
+
+    void testar_dependencias() {
+        // addi x1, x1, 1 em cadeia: uma instrução por ciclo, mesmo com largura 4
+        RelatorioOoO cadeia = executar(ConfigOoO{}, N, [](uint64_t) { return addi(1, 1, 1); });
+        VERIFICAR_IGUAL(cadeia.ciclos, N + PIPELINE);
+
+        // mul x1, x1, x1 em cadeia: cada uma espera a latência (3) da anterior
+        RelatorioOoO multiplicacoes = executar(ConfigOoO{}, N, [](uint64_t) { return mul(1, 1, 1); });
+        VERIFICAR_IGUAL(multiplicacoes.ciclos, 3 * (N - 1) + 1 + 3 + 2);
+        VERIFICAR_IGUAL(multiplicacoes.instrucoes_por_classe[static_cast<size_t>(ClasseInstrucao::Mul)], N);
+
+        // Independentes, as multiplicações usam o pipeline da unidade: uma por ciclo
+        RelatorioOoO independentes = executar(ConfigOoO{}, N, [](uint64_t i) {
+            return mul(1 + static_cast<uint32_t>(i % 31), 0, 0);
+        });
+        VERIFICAR_IGUAL(independentes.ciclos, (N - 1) + 1 + 3 + 2);
+    }
+
+    void testar_latencia() {
+        // A divisão não tem pipeline: divisões independentes saem a cada 'latencia' ciclos
+        const uint64_t divisoes = 200;
+        for (uint32_t latencia : {20u, 5u}) {
+            ConfigOoO config;
+            config.unidades[static_cast<size_t>(ClasseInstrucao::Div)].latencia = latencia;
+            RelatorioOoO relatorio = executar(config, divisoes, [](uint64_t i) {
+                return div(1 + static_cast<uint32_t>(i % 31), 0, 0);
+            });
+            VERIFICAR_IGUAL(relatorio.ciclos, latencia * (divisoes - 1) + 2 + latencia + 1);
+        }
+
+        // Duas unidades de divisão dobram a vazão
+        ConfigOoO duas;
+        duas.unidades[static_cast<size_t>(ClasseInstrucao::Div)].quantidade = 2;
+        RelatorioOoO relatorio = executar(duas, divisoes, [](uint64_t i) {
+            return div(1 + static_cast<uint32_t>(i % 31), 0, 0);
+        });
+        VERIFICAR_IGUAL(relatorio.ciclos, 20 * (divisoes / 2 - 1) + 2 + 20 + 1);
+
+        // O atraso é somado por instrução: com várias divisões esperando a mesma unidade, passa dos ciclos
+        RelatorioOoO uma = executar(ConfigOoO{}, divisoes, [](uint64_t i) {
+            return div(1 + static_cast<uint32_t>(i % 31), 0, 0);
+        });
+        VERIFICAR(uma.atraso_instrucoes[static_cast<size_t>(CausaParada::UnidadeOcupada)] > uma.ciclos);
+    }
+}
+
+int main() {
+    testar_largura();
+    testar_dependencias();
+    testar_latencia();
+    return resultado_testes("teste_modelo_ooo");
+}
@@ -0,0 +1,160 @@
+// Modos de execução: gatilhos por instrução e por PC, instruções mágicas e aquecimento sem estatísticas
+
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+
+using namespace verificacao;
+
+namespace {
+    // slti x0, x0, modo: troca de modo pelo próprio guest
+    uint32_t magica(int32_t modo) { return tipo_i(modo, 0, 0x2, 0, 0x13); }
+
+    // 'n' instruções addi x1, x1, 1 seguidas da instrução nula
+    std::vector<uint32_t> sequencia(size_t n) {
+        std::vector<uint32_t> programa(n, addi(1, 1, 1));
+        programa.push_back(0);
+        return programa;
+    }
+
+    void executar(Core& core) {
+        for (int i = 0; i < 1000 && !core.is_finished(); ++i) core.step();
+    }
+
+    void testar_gatilho_instrucoes() {
+        Core core(64 * 1024);
+        core.definir_log(false);
+        core.definir_modo(ModoExecucao::Funcional);
+        GatilhoModo gatilho;
+        gatilho.tipo = GatilhoModo::Tipo::Instrucoes;
+        gatilho.valor = 10;
+        gatilho.modo = ModoExecucao::Detalhado;
+        core.adicionar_gatilho_modo(gatilho);
+        core.load_program(sequencia(30));
+
+        // A troca acontece antes da busca da instrução com minstret = 10
+        for (int i = 0; i < 10; ++i) core.step();
+        VERIFICAR(core.get_modo() == ModoExecucao::Funcional);
+        executar(core);
+        VERIFICAR(core.get_modo() == ModoExecucao::Detalhado);
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, 30u);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 20u);
+
+        // O reset volta ao modo inicial e rearma o gatilho
+        core.reset();
+        VERIFICAR(core.get_modo() == ModoExecucao::Funcional);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 0u);
+        executar(core);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 20u);
+    }
+
+    void testar_gatilho_pc() {
+        Core core(64 * 1024);
+        core.definir_log(false);
+        core.definir_modo(ModoExecucao::Funcional);
+        // Detalhado de 0x28 (instrução 10) até 0x50 (instrução 20), a cada passagem
+        GatilhoModo entrada;
+        entrada.tipo = GatilhoModo::Tipo::Pc;
+        entrada.valor = 0x28;
+        entrada.modo = ModoExecucao::Detalhado;
+        GatilhoModo saida = entrada;
+        saida.valor = 0x50;
+        saida.modo = ModoExecucao::Funcional;
+        core.adicionar_gatilho_modo(entrada);
+        core.adicionar_gatilho_modo(saida);
+
+        std::vector<uint32_t> programa = sequencia(30);
+        core.load_program(programa);
+        executar(core);
+        VERIFICAR(core.get_modo() == ModoExecucao::Funcional);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 10u);
+
+        // Sem os gatilhos, o programa roda todo no modo inicial
+        core.limpar_gatilhos_modo();
+        core.reset();
+        executar(core);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 0u);
+    }
+
+    void testar_instrucoes_magicas() {
+        Core core(64 * 1024);
+        core.definir_log(false);
+        core.definir_modo(ModoExecucao::Funcional);
+        std::vector<uint32_t> programa(5, addi(1, 1, 1));
+        programa.push_back(magica(instrucao_magica::MODO_DETALHADO));
+        programa.insert(programa.end(), 10, addi(1, 1, 1));
+        programa.push_back(magica(instrucao_magica::MODO_AQUECIMENTO));
+        programa.insert(programa.end(), 5, addi(1, 1, 1));
+        programa.push_back(0);
+        core.load_program(programa);
+        executar(core);
+
+        // A instrução que liga o modo detalhado já conta nele; a que o desliga, não
+        VERIFICAR(core.get_modo() == ModoExecucao::Aquecimento);
+        VERIFICAR_IGUAL(core.get_contadores_detalhado().instrucoes, 11u);
+        // Como HINTs, as mágicas não escrevem em x0 e não mudam o resultado do programa
+        VERIFICAR_IGUAL(core.get_registradores()[1], 20u);
+        VERIFICAR_IGUAL(core.get_registradores()[0], 0u);
+    }
+
+    struct Resultado {
+        uint64_t leituras_antes = 0;
+        uint64_t faltas_antes = 0;
+        uint64_t leituras_dram_antes = 0;
+        uint64_t ciclos_antes = 0;
+        uint64_t detalhado_antes = 0;
+        uint64_t faltas_leitura = 0;
+        uint64_t acertos_leitura = 0;
+    };
+
+    // Quatro loads em linhas diferentes no modo 'inicial', e os mesmos quatro no modo detalhado
+    Resultado executar_regiao(ModoExecucao inicial) {
+        std::vector<uint32_t> programa = {addi(1, 0, 0x400)};
+        for (int32_t i = 0; i < 4; ++i) programa.push_back(lw(2, 1, 64 * i));
+        programa.push_back(magica(instrucao_magica::MODO_DETALHADO));
+        for (int32_t i = 0; i < 4; ++i) programa.push_back(lw(2, 1, 64 * i));
+        programa.push_back(0);
+
+        Core core(64 * 1024);
+        core.definir_log(false);
+        core.definir_modo(inicial);
+        core.load_program(programa);
+        Resultado resultado;
+        for (int i = 0; i < 5; ++i) core.step();
+        resultado.leituras_antes = core.get_estatisticas_cache().leituras;
+        resultado.faltas_antes = core.get_estatisticas_cache().faltas_leitura;
+        resultado.leituras_dram_antes = core.get_estatisticas_dram().leituras;
+        resultado.ciclos_antes = core.get_contadores().ciclos;
+        resultado.detalhado_antes = core.get_contadores_detalhado().instrucoes;
+        executar(core);
+        resultado.faltas_leitura = core.get_estatisticas_cache().faltas_leitura;
+        resultado.acertos_leitura = core.get_estatisticas_cache().acertos_leitura;
+        return resultado;
+    }
+
+    void testar_aquecimento() {
+        Resultado funcional = executar_regiao(ModoExecucao::Funcional);
+        Resultado aquecido = executar_regiao(ModoExecucao::Aquecimento);
+
+        // Aquecendo, nada é contado: nem acessos ao cache e à DRAM, nem ciclos parados
+        VERIFICAR_IGUAL(aquecido.leituras_antes, 0u);
+        VERIFICAR_IGUAL(aquecido.faltas_antes, 0u);
+        VERIFICAR_IGUAL(aquecido.leituras_dram_antes, 0u);
+        VERIFICAR_IGUAL(aquecido.detalhado_antes, 0u);
+        VERIFICAR_IGUAL(aquecido.ciclos_antes, funcional.ciclos_antes);
+
+        // Mas as linhas ficam no cache: os quatro loads da região acertam
+        VERIFICAR(funcional.faltas_leitura >= aquecido.faltas_leitura + 4);
+        VERIFICAR(aquecido.acertos_leitura >= funcional.acertos_leitura + 4);
+    }
+}
+
+int main() {
+    testar_gatilho_instrucoes();
+    testar_gatilho_pc();
+    testar_instrucoes_magicas();
+    testar_aquecimento();
+    return resultado_testes("teste_modo_execucao");
+}
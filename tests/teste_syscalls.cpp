@@ -0,0 +1,114 @@
+// Proxy de syscalls: read de stdin na thread do ExecutorSimulacao é interrompido pela parada
+// e refeito depois, sem contar a ECALL interrompida. Publicação do executor sem o log do Core
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+#include "execution/ExecutorSimulacao.h"
+#include "syscall/ProxySyscalls.h"
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace verificacao;
+
+namespace {
+    constexpr uint32_t ECALL = 0x00000073;
+
+#ifndef _WIN32
+    void testar_read_interrompido() {
+        // stdin do processo passa a ser um pipe controlado pelo teste
+        int tubo[2];
+        VERIFICAR_IGUAL(::pipe(tubo), 0);
+        int stdin_original = ::dup(0);
+        ::dup2(tubo[0], 0);
+
+        Core core(64 * 1024);
+        // read(0, 0x400, 16); o resultado fica em a0 e o programa termina
+        core.load_program({
+            addi(10, 0, 0), addi(11, 0, 0x400), addi(12, 0, 16), addi(17, 0, syscalls::READ),
+            ECALL, addi(5, 10, 0), 0,
+        });
+
+        ExecutorSimulacao executor(core);
+        executor.iniciar();
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto inicio = std::chrono::steady_clock::now();
+        executor.parar();
+        auto espera = std::chrono::steady_clock::now() - inicio;
+
+        // A parada não espera a entrada, e a ECALL não foi concluída
+        VERIFICAR(espera < std::chrono::seconds(1));
+        VERIFICAR(!core.is_finished());
+        VERIFICAR_IGUAL(core.get_program_counter(), 16u);
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, 4u);
+        VERIFICAR_IGUAL(core.get_registradores()[10], 0u);
+
+        // Com entrada disponível, a mesma ECALL é refeita e completa
+        const std::string texto = "abc\n";
+        VERIFICAR_IGUAL(::write(tubo[1], texto.data(), texto.size()), static_cast<ssize_t>(texto.size()));
+        executor.iniciar();
+        for (int i = 0; i < 200 && executor.executando(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        executor.parar();
+
+        VERIFICAR(core.is_finished());
+        VERIFICAR_IGUAL(core.get_registradores()[5], 4u);
+        // A instrução nula que encerra o programa não conta
+        VERIFICAR_IGUAL(core.get_contadores().instrucoes, 6u);
+        VERIFICAR_IGUAL(static_cast<char>(core.get_byte_memoria(0x400)), 'a');
+        VERIFICAR_IGUAL(static_cast<char>(core.get_byte_memoria(0x403)), '\n');
+
+        // O executor roda sem log e o religa ao parar; a última publicação traz a mensagem de fim
+        VERIFICAR(core.log_ligado());
+        const InstantaneoCore* instantaneo = executor.consumir_instantaneo();
+        VERIFICAR(instantaneo != nullptr && instantaneo->finalizado);
+        if (instantaneo) VERIFICAR_IGUAL(instantaneo->ultimo_log, std::string("Instrucao nula, finalizando."));
+
+        ::dup2(stdin_original, 0);
+        ::close(stdin_original);
+        ::close(tubo[0]);
+        ::close(tubo[1]);
+    }
+#endif
+
+    void testar_publicacao_sem_log() {
+        Core core(64 * 1024);
+        // Laço infinito: addi x1, x1, 1; jal x0, -4
+        core.load_program({addi(1, 1, 1), 0xFFDFF06F});
+        ExecutorSimulacao executor(core);
+        executor.definir_intervalo_publicacao(std::chrono::milliseconds(0));
+        executor.iniciar();
+        const InstantaneoCore* instantaneo = nullptr;
+        for (int i = 0; i < 200 && !instantaneo; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            instantaneo = executor.consumir_instantaneo();
+        }
+        // O texto publicado é montado do commit da última instrução
+        VERIFICAR(instantaneo != nullptr);
+        if (instantaneo) {
+            const std::string& texto = instantaneo->ultimo_log;
+            VERIFICAR(texto.find("addi") != std::string::npos || texto.find("jal") != std::string::npos);
+        }
+        executor.parar();
+        VERIFICAR(core.log_ligado());
+
+        core.definir_log(false);
+        executor.iniciar();
+        executor.parar();
+        VERIFICAR(!core.log_ligado());
+    }
+}
+
+int main() {
+#ifndef _WIN32
+    testar_read_interrompido();
+#endif
+    testar_publicacao_sem_log();
+    return resultado_testes("teste_syscalls");
+}
@@ -0,0 +1,128 @@
+// Trace binário: codificação/decodificação registro a registro e ida e volta por arquivo
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/Core.h"
+#include "trace/TraceBinario.h"
+
+using namespace verificacao;
+
+namespace {
+    bool iguais(const RegistroCommit& a, const RegistroCommit& b) {
+        bool memoria_igual = a.acesso == b.acesso &&
+                             (a.acesso == AcessoMemoria::Nenhum ||
+                              (a.tamanho_acesso == b.tamanho_acesso && a.endereco_memoria == b.endereco_memoria &&
+                               a.dado_memoria == b.dado_memoria));
+        return a.pc == b.pc && a.proximo_pc == b.proximo_pc && a.instrucao == b.instrucao && a.rd == b.rd &&
+               a.valor_rd == b.valor_rd && memoria_igual;
+    }
+
+    RegistroCommit registro(uint32_t pc, uint32_t proximo_pc, uint32_t instrucao, uint32_t rd = 0, uint32_t valor = 0) {
+        RegistroCommit r;
+        r.pc = pc;
+        r.proximo_pc = proximo_pc;
+        r.instrucao = instrucao;
+        r.rd = rd;
+        r.valor_rd = valor;
+        return r;
+    }
+
+    std::vector<RegistroCommit> registros_variados() {
+        std::vector<RegistroCommit> registros;
+        registros.push_back(registro(0x0, 0x4, addi(1, 0, 5), 1, 5));
+        registros.push_back(registro(0x4, 0x8, addi(1, 1, -10), 1, 0xFFFFFFFB));
+        // Salto para trás e PC fora da sequência
+        registros.push_back(registro(0x8, 0x0, 0x0000006F | (0x3FF << 21) | (1u << 31)));
+        registros.push_back(registro(0x80000000, 0x80000004, NOP));
+
+        RegistroCommit load = registro(0x80000004, 0x80000008, lw(2, 1, 0), 2, 0xDEADBEEF);
+        load.acesso = AcessoMemoria::Leitura;
+        load.tamanho_acesso = 4;
+        load.endereco_memoria = 0x10000;
+        load.dado_memoria = 0xDEADBEEF;
+        registros.push_back(load);
+
+        RegistroCommit store = registro(0x80000008, 0x8000000C, sw(2, 1, -4));
+        store.acesso = AcessoMemoria::Escrita;
+        store.tamanho_acesso = 1;
+        store.endereco_memoria = 0xFFFC;
+        store.dado_memoria = 0xEF;
+        registros.push_back(store);
+
+        // A mesma instrução de novo (palavra omitida) e outra palavra no mesmo PC
+        registros.push_back(registro(0x0, 0x4, addi(1, 0, 5), 1, 5));
+        registros.push_back(registro(0x0, 0x4, addi(3, 0, 7), 3, 7));
+        return registros;
+    }
+
+    void testar_codificador() {
+        std::vector<RegistroCommit> registros = registros_variados();
+        CodificadorTrace codificador;
+        std::vector<uint8_t> bytes;
+        for (const RegistroCommit& r : registros) codificador.codificar(r, bytes);
+
+        CodificadorTrace decodificador;
+        size_t posicao = 0;
+        for (const RegistroCommit& esperado : registros) {
+            RegistroCommit lido;
+            size_t n = decodificador.decodificar(bytes.data() + posicao, bytes.size() - posicao, lido);
+            VERIFICAR(n > 0);
+            if (n == 0) return;
+            VERIFICAR(iguais(lido, esperado));
+            posicao += n;
+        }
+        VERIFICAR_IGUAL(posicao, bytes.size());
+
+        // Um registro truncado não é consumido
+        CodificadorTrace outro;
+        RegistroCommit lido;
+        VERIFICAR_IGUAL(outro.decodificar(bytes.data(), 1, lido), 0u);
+    }
+
+    void testar_arquivo() {
+        // Commits reais do Core: laço com load, store e desvio
+        Core core(64 * 1024);
+        core.load_program({
+            addi(1, 0, 0x400), addi(2, 0, 50),
+            sw(2, 1, 0), lw(3, 1, 0), addi(1, 1, 4), addi(2, 2, -1),
+            0xFE0118E3, // bne x2, x0, -16
+        });
+        std::vector<RegistroCommit> esperados;
+        while (esperados.size() < 2 + 50 * 5) {
+            core.step();
+            esperados.push_back(core.get_ultimo_commit());
+        }
+
+        std::string caminho = "teste_trace.rvtr";
+        GravadorTrace gravador;
+        // Antes de abrir, registrar não faz nada
+        gravador.registrar(esperados[0]);
+        VERIFICAR_IGUAL(gravador.get_registros(), 0u);
+
+        VERIFICAR_IGUAL(gravador.abrir(caminho, trace::Compressao::Nenhuma, 16), std::string());
+        for (const RegistroCommit& r : esperados) gravador.registrar(r);
+        VERIFICAR_IGUAL(gravador.fechar(), std::string());
+        VERIFICAR_IGUAL(gravador.get_registros(), esperados.size());
+        gravador.registrar(esperados[0]);
+
+        LeitorTrace leitor;
+        VERIFICAR_IGUAL(leitor.abrir(caminho), std::string());
+        RegistroCommit lido;
+        size_t total = 0;
+        while (leitor.proximo(lido)) {
+            if (total < esperados.size()) VERIFICAR(iguais(lido, esperados[total]));
+            ++total;
+        }
+        VERIFICAR_IGUAL(total, esperados.size());
+        std::remove(caminho.c_str());
+    }
+}
+
+int main() {
+    testar_codificador();
+    testar_arquivo();
+    return resultado_testes("teste_trace");
+}
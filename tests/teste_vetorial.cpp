@@ -0,0 +1,206 @@
+// Kernels da extensão V (SSE2/AVX2, conforme a compilação) contra a semântica de referência por elemento
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <vector>
+
+#include "Verificacao.h"
+#include "core/KernelsVetoriais.h"
+
+using namespace verificacao;
+using namespace vetorial;
+
+namespace {
+    // LMUL = 8: o maior grupo de registradores
+    constexpr uint32_t BYTES = 8 * VLENB;
+
+    // Quantidades que cobrem blocos inteiros de 16 e 32 bytes e as sobras de cada lado
+    const std::vector<uint32_t> QUANTIDADES = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 128, 256};
+
+    const std::vector<Operacao> OPERACOES = {
+        Operacao::Add, Operacao::Sub, Operacao::Rsub, Operacao::And, Operacao::Or, Operacao::Xor,
+        Operacao::MinU, Operacao::Min, Operacao::MaxU, Operacao::Max, Operacao::Sll, Operacao::Srl,
+        Operacao::Sra, Operacao::Mul, Operacao::Mulh, Operacao::MulhU, Operacao::MulhSU,
+    };
+
+    const std::vector<Comparacao> COMPARACOES = {
+        Comparacao::Eq, Comparacao::Ne, Comparacao::LtU, Comparacao::Lt,
+        Comparacao::LeU, Comparacao::Le, Comparacao::GtU, Comparacao::Gt,
+    };
+
+    using Banco = std::array<uint8_t, BYTES>;
+
+    uint32_t semente = 12345;
+
+    uint32_t aleatorio() {
+        semente = semente * 1664525u + 1013904223u;
+        return semente;
+    }
+
+    // Bytes aleatórios misturados com os extremos de cada largura (0, 1, -1, mínimo e máximo com sinal)
+    Banco gerar(uint32_t sew) {
+        Banco banco{};
+        uint32_t elementos = BYTES / sew;
+        for (uint32_t i = 0; i < elementos; ++i) {
+            uint32_t valor = aleatorio();
+            uint32_t bits = 8 * sew;
+            switch (aleatorio() % 8) {
+                case 0: valor = 0; break;
+                case 1: valor = 1; break;
+                case 2: valor = UINT32_MAX; break;
+                case 3: valor = 1u << (bits - 1); break;
+                case 4: valor = (1u << (bits - 1)) - 1; break;
+                default: break;
+            }
+            escrever_elemento(banco.data(), i, sew, valor);
+        }
+        return banco;
+    }
+
+    void conferir(bool ok, const char* funcao, int caso, uint32_t sew, uint32_t n, int linha) {
+        if (ok) return;
+        char descricao[96];
+        std::snprintf(descricao, sizeof(descricao), "%s (caso %d, sew %u, n %u)", funcao, caso, sew, n);
+        verdadeiro(false, descricao, __FILE__, linha);
+    }
+
+    void testar_operar() {
+        for (uint32_t sew : {1u, 2u, 4u}) {
+            for (Operacao op : OPERACOES) {
+                for (uint32_t n : QUANTIDADES) {
+                    if (n * sew > BYTES) continue;
+                    Banco vs2 = gerar(sew), vs1 = gerar(sew), inicial = gerar(sew);
+                    uint32_t escalar = aleatorio();
+
+                    Banco esperado = inicial, esperado_escalar = inicial;
+                    for (uint32_t i = 0; i < n; ++i) {
+                        uint32_t a = ler_elemento(vs2.data(), i, sew);
+                        escrever_elemento(esperado.data(), i, sew,
+                                          operar_elemento(op, sew, a, ler_elemento(vs1.data(), i, sew)));
+                        escrever_elemento(esperado_escalar.data(), i, sew, operar_elemento(op, sew, a, escalar));
+                    }
+
+                    Banco destino = inicial;
+                    operar(op, sew, destino.data(), vs2.data(), vs1.data(), n);
+                    conferir(destino == esperado, "operar", static_cast<int>(op), sew, n, __LINE__);
+
+                    destino = inicial;
+                    operar_escalar(op, sew, destino.data(), vs2.data(), escalar, n);
+                    conferir(destino == esperado_escalar, "operar_escalar", static_cast<int>(op), sew, n, __LINE__);
+
+                    // Destino sobreposto a vs2 (vadd.vv v8, v8, v16)
+                    Banco sobreposto = vs2;
+                    operar(op, sew, sobreposto.data(), sobreposto.data(), vs1.data(), n);
+                    Banco esperado_sobreposto = vs2;
+                    for (uint32_t i = 0; i < n; ++i) {
+                        escrever_elemento(esperado_sobreposto.data(), i, sew, ler_elemento(esperado.data(), i, sew));
+                    }
+                    conferir(sobreposto == esperado_sobreposto, "operar sobreposto", static_cast<int>(op), sew, n,
+                             __LINE__);
+                }
+            }
+        }
+    }
+
+    void testar_comparar() {
+        for (uint32_t sew : {1u, 2u, 4u}) {
+            for (Comparacao cmp : COMPARACOES) {
+                for (uint32_t n : QUANTIDADES) {
+                    if (n * sew > BYTES) continue;
+                    Banco vs2 = gerar(sew), vs1 = gerar(sew);
+                    // Metade dos elementos iguais, para Eq/Le/Ge terem casos verdadeiros
+                    for (uint32_t i = 0; i < n; i += 2) {
+                        escrever_elemento(vs1.data(), i, sew, ler_elemento(vs2.data(), i, sew));
+                    }
+                    uint32_t escalar = ler_elemento(vs2.data(), n / 2, sew);
+
+                    std::array<uint8_t, VLENB> esperado{}, esperado_escalar{};
+                    for (uint32_t i = 0; i < n; ++i) {
+                        uint32_t a = ler_elemento(vs2.data(), i, sew);
+                        if (comparar_elemento(cmp, sew, a, ler_elemento(vs1.data(), i, sew))) {
+                            esperado[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+                        }
+                        if (comparar_elemento(cmp, sew, a, escalar)) {
+                            esperado_escalar[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+                        }
+                    }
+
+                    // Só os bytes com bits da máscara entram na comparação
+                    uint32_t bytes = (n + 7) / 8;
+                    std::array<uint8_t, VLENB> mascara;
+                    mascara.fill(0xA5);
+                    vetorial::comparar(cmp, sew, mascara.data(), vs2.data(), vs1.data(), n);
+                    conferir(std::equal(mascara.begin(), mascara.begin() + bytes, esperado.begin()), "comparar",
+                             static_cast<int>(cmp), sew, n, __LINE__);
+
+                    mascara.fill(0xA5);
+                    comparar_escalar(cmp, sew, mascara.data(), vs2.data(), escalar, n);
+                    conferir(std::equal(mascara.begin(), mascara.begin() + bytes, esperado_escalar.begin()),
+                             "comparar_escalar", static_cast<int>(cmp), sew, n, __LINE__);
+                }
+            }
+        }
+    }
+
+    void testar_preencher_mesclar() {
+        for (uint32_t sew : {1u, 2u, 4u}) {
+            for (uint32_t n : QUANTIDADES) {
+                if (n * sew > BYTES) continue;
+                Banco inicial = gerar(sew), origem = gerar(sew);
+                std::array<uint8_t, VLENB> bits_mascara{};
+                for (uint8_t& byte : bits_mascara) byte = static_cast<uint8_t>(aleatorio());
+                uint32_t valor = aleatorio();
+
+                Banco esperado = inicial;
+                for (uint32_t i = 0; i < n; ++i) escrever_elemento(esperado.data(), i, sew, valor);
+                Banco destino = inicial;
+                preencher(sew, destino.data(), valor, n);
+                conferir(destino == esperado, "preencher", 0, sew, n, __LINE__);
+
+                // Faixa [inicio, n) com e sem máscara
+                uint32_t inicio = n / 3;
+                for (const uint8_t* mascara : {static_cast<const uint8_t*>(nullptr),
+                                               static_cast<const uint8_t*>(bits_mascara.data())}) {
+                    esperado = inicial;
+                    for (uint32_t i = inicio; i < n; ++i) {
+                        if (!mascara || bit_mascara(mascara, i)) {
+                            escrever_elemento(esperado.data(), i, sew, ler_elemento(origem.data(), i, sew));
+                        }
+                    }
+                    destino = inicial;
+                    mesclar(sew, destino.data(), origem.data(), mascara, inicio, n);
+                    conferir(destino == esperado, "mesclar", mascara != nullptr, sew, n, __LINE__);
+                }
+            }
+        }
+
+        // mesclar_bits: a faixa pode começar e terminar no meio de um byte
+        for (uint32_t inicio : {0u, 3u, 8u, 13u}) {
+            for (uint32_t fim : {inicio, inicio + 1, inicio + 7, inicio + 30, 256u}) {
+                std::array<uint8_t, VLENB> destino{}, origem{}, mascara{};
+                for (uint32_t i = 0; i < VLENB; ++i) {
+                    destino[i] = static_cast<uint8_t>(aleatorio());
+                    origem[i] = static_cast<uint8_t>(aleatorio());
+                    mascara[i] = static_cast<uint8_t>(aleatorio());
+                }
+                std::array<uint8_t, VLENB> esperado = destino;
+                for (uint32_t i = inicio; i < fim; ++i) {
+                    if (!bit_mascara(mascara.data(), i)) continue;
+                    uint8_t bit = static_cast<uint8_t>(1u << (i & 7));
+                    esperado[i >> 3] = static_cast<uint8_t>((esperado[i >> 3] & ~bit) | (origem[i >> 3] & bit));
+                }
+                mesclar_bits(destino.data(), origem.data(), mascara.data(), inicio, fim);
+                conferir(destino == esperado, "mesclar_bits", static_cast<int>(inicio), 0, fim, __LINE__);
+            }
+        }
+    }
+}
+
+int main() {
+    std::printf("Kernels: %s\n", implementacao());
+    testar_operar();
+    testar_comparar();
+    testar_preencher_mesclar();
+    return resultado_testes("teste_vetorial");
+}